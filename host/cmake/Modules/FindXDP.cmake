@@ -0,0 +1,31 @@
+#
+# Copyright 2019 Ettus Research, a National Instruments Brand
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+# - Find AF_XDP support
+# The AF_XDP transport talks to the kernel through its uAPI headers only,
+# so no library is needed. This checks that the headers are recent enough
+# (Linux 5.9: need-wakeup rings and BPF links for XDP).
+# This module defines
+#  XDP_FOUND, If false, do not try to use AF_XDP.
+
+include(CheckCXXSourceCompiles)
+CHECK_CXX_SOURCE_COMPILES("
+    #include <linux/bpf.h>
+    #include <linux/if_link.h>
+    #include <linux/if_xdp.h>
+    #include <sys/syscall.h>
+    int main(){
+        xdp_mmap_offsets offsets;
+        offsets.rx.flags = XDP_RING_NEED_WAKEUP;
+        bpf_attr attr;
+        attr.link_create.attach_type = BPF_XDP;
+        return XDP_USE_NEED_WAKEUP + __NR_bpf + XDP_FLAGS_SKB_MODE
+            + int(offsets.rx.flags + attr.link_create.attach_type);
+    }
+    " HAVE_XDP_UAPI
+)
+
+include(FindPackageHandleStandardArgs)
+FIND_PACKAGE_HANDLE_STANDARD_ARGS(XDP DEFAULT_MSG HAVE_XDP_UAPI)
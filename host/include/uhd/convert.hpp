@@ -9,14 +9,45 @@
 #define INCLUDED_UHD_CONVERT_HPP
 
 #include <uhd/config.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/types/dict.hpp>
 #include <uhd/types/ref_vector.hpp>
 #include <boost/function.hpp>
 #include <boost/operators.hpp>
 #include <boost/shared_ptr.hpp>
+#include <complex>
 #include <string>
 
 namespace uhd { namespace convert {
 
+/*!
+ * IQ imbalance and DC offset correction, for converters that can apply it
+ *
+ * The correction consists of a real 2x2 matrix M = {{ii, iq}, {qi, qq}},
+ * which is applied to the vector (I, Q) of a sample, and a DC offset in
+ * normalized (floating point) units:
+ * - On receive, a sample x is corrected as y = M * (x - dc_offset).
+ * - On transmit, a sample x is corrected as y = M * x + dc_offset.
+ *
+ * The default values don't change the samples.
+ */
+struct iq_dc_correction_t
+{
+    double ii = 1.0;
+    double iq = 0.0;
+    double qi = 0.0;
+    double qq = 1.0;
+    std::complex<double> dc_offset = 0.0;
+};
+
+/*!
+ * Suffix of the host format of converters that apply an iq_dc_correction_t.
+ *
+ * For example, the converter from "sc16_item32_le" to "fc32" + this suffix
+ * works like the one to "fc32", but also corrects the samples.
+ */
+static const std::string IQ_DC_FORMAT_SUFFIX = "_iqdc";
+
 //! A conversion class that implements a conversion from inputs -> outputs.
 class converter
 {
@@ -30,6 +61,13 @@ public:
     //! Set the scale factor (used in floating point conversions)
     virtual void set_scalar(const double) = 0;
 
+    //! Set the IQ imbalance and DC offset correction, see iq_dc_correction_t
+    virtual void set_iq_dc_correction(const iq_dc_correction_t&)
+    {
+        throw uhd::not_implemented_error(
+            "This converter does not support IQ/DC correction");
+    }
+
     //! The public conversion method to convert inputs -> outputs
     UHD_INLINE void conv(const input_type& in, const output_type& out, const size_t num)
     {
@@ -70,6 +108,9 @@ struct UHD_API id_type : boost::equality_comparable<id_type>
 //! Implement equality_comparable interface
 UHD_API bool operator==(const id_type&, const id_type&);
 
+//! Hash an ID, for boost::hash and for indexing a uhd::dict
+UHD_API size_t hash_value(const id_type&);
+
 /*!
  * Register a converter function.
  *
@@ -102,4 +143,11 @@ UHD_API size_t get_bytes_per_item(const std::string& format);
 
 }} // namespace uhd::convert
 
+namespace uhd {
+template <> struct dict_key_is_hashable<convert::id_type>
+{
+    static const bool value = true;
+};
+} // namespace uhd
+
 #endif /* INCLUDED_UHD_CONVERT_HPP */
@@ -70,6 +70,7 @@ public:
     typedef boost::function<void(const T&)> subscriber_type;
     typedef boost::function<T(void)> publisher_type;
     typedef boost::function<T(const T&)> coercer_type;
+    typedef boost::shared_ptr<property<T> > sptr;
 
     virtual ~property<T>(void) = 0;
 
@@ -239,12 +240,24 @@ public:
     //! Get access to a property in the tree
     template <typename T> property<T>& access(const fs_path& path);
 
+    /*!
+     * Get a handle to a property in the tree.
+     *
+     * Unlike the reference returned by access(), the handle may be kept
+     * and used without going through the tree again. It keeps the
+     * property alive even if it is removed from the tree.
+     */
+    template <typename T> typename property<T>::sptr get_handle(const fs_path& path) const;
+
 private:
     //! Internal create property with wild-card type
     virtual void _create(const fs_path& path, const boost::shared_ptr<void>& prop) = 0;
 
     //! Internal access property with wild-card type
     virtual boost::shared_ptr<void>& _access(const fs_path& path) const = 0;
+
+    //! Internal get property handle with wild-card type
+    virtual boost::shared_ptr<void> _get_handle(const fs_path& path) const = 0;
 };
 
 } // namespace uhd
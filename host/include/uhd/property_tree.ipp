@@ -152,6 +152,10 @@ namespace uhd{
         return *boost::static_pointer_cast<property<T> >(this->_access(path));
     }
 
+    template <typename T> typename property<T>::sptr property_tree::get_handle(const fs_path &path) const{
+        return boost::static_pointer_cast<property<T> >(this->_get_handle(path));
+    }
+
 } //namespace uhd
 
 #endif /* INCLUDED_UHD_PROPERTY_TREE_IPP */
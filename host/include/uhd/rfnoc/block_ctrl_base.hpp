@@ -21,6 +21,8 @@
 #include <uhd/utils/static.hpp>
 #include <stdint.h>
 #include <boost/shared_ptr.hpp>
+#include <utility>
+#include <vector>
 
 namespace uhd { namespace rfnoc {
 // Forward declarations
@@ -180,6 +182,19 @@ public:
      */
     void sr_write(const std::string& reg, const uint32_t data, const size_t port = 0);
 
+    /*! Allows setting many registers on the settings bus in one go.
+     *
+     * The writes are pipelined: as many as the block can ACK are kept in
+     * flight. This is the way to load coefficient tables and the like.
+     * Returns once all writes have been ACKed, so a failure is reported by
+     * this call, including which of the writes failed.
+     *
+     * \param writes Pairs of settings register and value, written in order.
+     * \param port Port on which to write
+     */
+    void sr_write_burst(
+        const std::vector<std::pair<uint32_t, uint32_t>>& writes, const size_t port = 0);
+
     /*! Allows reading one register on the settings bus (64-Bit version).
      *
      * \param reg The settings register to be read.
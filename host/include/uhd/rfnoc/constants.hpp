@@ -20,6 +20,9 @@ namespace uhd { namespace rfnoc {
 static const std::string XML_DEFAULT_PATH = "share/uhd/rfnoc";
 //! The name of the environment variable storing the bath to the block definition files
 static const std::string XML_PATH_ENV = "UHD_RFNOC_DIR";
+//! The name of the environment variable storing the path to a file where the
+// NoC ID index of the block definition files is kept between sessions
+static const std::string XML_INDEX_ENV = "UHD_RFNOC_INDEX";
 
 //! If the block name can't be automatically detected, this name is used
 static const std::string DEFAULT_BLOCK_NAME = "Block";
@@ -9,6 +9,8 @@
 #define INCLUDED_UHD_STREAM_HPP
 
 #include <uhd/config.hpp>
+#include <uhd/convert.hpp>
+#include <uhd/transport/zero_copy.hpp>
 #include <uhd/types/device_addr.hpp>
 #include <uhd/types/metadata.hpp>
 #include <uhd/types/ref_vector.hpp>
@@ -16,6 +18,7 @@
 #include <uhd/utils/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/utility.hpp>
+#include <stdint.h>
 #include <string>
 #include <vector>
 
@@ -131,6 +134,31 @@ struct UHD_API stream_args_t
      *
      * - noclear: Used by tx_dsp_core_200 and rx_dsp_core_200
      *
+     * - convert_threads: number of threads used to convert the samples of a
+     * multi-channel streamer. The thread calling recv() or send() is one of
+     * them, so the default of 1 converts all channels on the calling thread.
+     *
+     * - convert_cpus: colon-separated list of CPUs to pin the additional
+     * conversion threads to (e.g. "convert_cpus=2:3"). Only used together with
+     * convert_threads.
+     *
+     * - convert_spin: how often an idle conversion thread polls for the next
+     * packet before it goes to sleep (default 2000, 0 sleeps right away).
+     * Spinning keeps the latency down but keeps a core busy between
+     * packets. Only used together with convert_threads.
+     *
+     * - resamp_interp, resamp_decim: resample the samples on the host, by
+     * the rational factor resamp_interp/resamp_decim (e.g. "resamp_interp=4,
+     * resamp_decim=5"). For RX, the host gets the device rate times this
+     * factor; for TX, the device gets the host rate times this factor. Only
+     * the fc32 CPU format can be resampled. The first samples of a burst are
+     * the transient of the filter, and recv_views() is not resampled. On TX,
+     * resampled samples are held back until they fill a packet, so send
+     * end of burst to get the last ones out.
+     *
+     * - resamp_taps: length of the resampling filter, in samples at the
+     * lower of the two rates (default 16). Longer filters are sharper.
+     *
      * The following are not implemented, but are listed for conceptual purposes:
      * - function: magnitude or phase/magnitude
      * - units: numeric units like counts or dBm
@@ -162,6 +190,93 @@ struct UHD_API stream_args_t
     std::vector<size_t> channels;
 };
 
+/*!
+ * Counters of a streamer, accumulated since the streamer was created.
+ *
+ * The counters are summed over all channels of the streamer. Counters
+ * which don't apply to a direction, or which a device does not report,
+ * stay at zero.
+ */
+struct stream_stats_t
+{
+    stream_stats_t(void)
+        : num_packets(0)
+        , num_bytes(0)
+        , num_seq_errors(0)
+        , num_overflows(0)
+        , num_late_packets(0)
+        , num_underflows(0)
+        , num_fc_stalls(0)
+        , convert_time(0.0)
+        , get_buff_time(0.0)
+    { /* NOP */
+    }
+
+    //! Data packets received or sent
+    uint64_t num_packets;
+
+    //! Payload bytes received or sent, in the over-the-wire format
+    uint64_t num_bytes;
+
+    //! RX: gaps in the packet sequence, i.e. packets dropped on the way
+    uint64_t num_seq_errors;
+
+    //! RX: overflows reported by the device
+    uint64_t num_overflows;
+
+    //! TX: packets the device reported as late
+    uint64_t num_late_packets;
+
+    //! TX: underflows reported by the device
+    uint64_t num_underflows;
+
+    //! TX: packets which had to wait for flow control credit
+    uint64_t num_fc_stalls;
+
+    //! Time in seconds spent converting samples
+    double convert_time;
+
+    //! Time in seconds spent waiting for buffers from the transport
+    double get_buff_time;
+};
+
+/*!
+ * One packet's worth of received samples, see rx_streamer::recv_views().
+ */
+struct rx_view_t
+{
+    rx_view_t(void) : nsamps(0) {}
+
+    /*!
+     * Read-only pointers to the samples of each channel. The samples are
+     * left in the over-the-wire format of the streamer (stream_args_t::otw_format)
+     * and sit in the transport's receive frames.
+     */
+    std::vector<const void*> buffs;
+
+    //! The number of samples per channel
+    size_t nsamps;
+
+    //! Describes the samples, or an error with nsamps == 0
+    rx_metadata_t metadata;
+};
+
+/*!
+ * A batch of received packets, filled by rx_streamer::recv_views().
+ *
+ * The batch holds on to the transport frames the views point into. The
+ * frames go back to the transport when the batch is handed to
+ * rx_streamer::release_views(), refilled, or destroyed.
+ */
+struct rx_view_batch_t
+{
+    //! The received packets, in order
+    std::vector<rx_view_t> views;
+
+    //! The transport frames behind the views
+    std::vector<transport::managed_recv_buffer::sptr> frames;
+};
+
 /*!
  * The RX streamer is the host interface to receiving samples.
  * It represents the layer between the samples on the host
@@ -235,6 +350,79 @@ public:
      * \param stream_cmd the stream command to issue
      */
     virtual void issue_stream_cmd(const stream_cmd_t& stream_cmd) = 0;
+
+    /*!
+     * Get the counters of this streamer.
+     *
+     * Unlike recv(), this may be called from any thread while streaming.
+     * Streamers which don't keep counters return all zeros.
+     *
+     * \return a snapshot of the counters
+     */
+    virtual stream_stats_t get_stats(void) const;
+
+    /*!
+     * Receive packets without copying or converting their samples.
+     *
+     * Instead of converting into buffers supplied by the caller, this
+     * hands out pointers into the transport's receive frames. This saves
+     * the copy when the application can use the over-the-wire format
+     * as-is, e.g. when recording sc16 samples to disk.
+     *
+     * Waits up to timeout for the first packet, then adds packets which
+     * are already available, up to max_packets. The batch ends early at
+     * an end of burst or an error; an error is reported by a last view
+     * with no samples. A remaining fragment of a packet which recv() did
+     * not consume is returned as the first view.
+     *
+     * The frames stay out of the transport until the batch is released,
+     * so hold on to fewer frames than the transport has (see the
+     * num_recv_frames transport argument), or packets will be dropped.
+     *
+     * Like recv(), this is not thread-safe. Streamers which can't hand out
+     * their frames throw a uhd::not_implemented_error.
+     *
+     * \param batch the batch to fill, previous contents are released
+     * \param max_packets the maximum number of packets to return
+     * \param timeout the timeout in seconds to wait for the first packet
+     * \return the number of views in the batch
+     */
+    virtual size_t recv_views(
+        rx_view_batch_t& batch, const size_t max_packets, const double timeout = 0.1);
+
+    /*!
+     * Return the frames of a batch to the transport.
+     *
+     * The pointers in the views are invalid afterwards. The views
+     * themselves are kept, so refilling a batch of the same size does not
+     * allocate.
+     *
+     * \param batch the batch filled by recv_views()
+     */
+    virtual void release_views(rx_view_batch_t& batch);
+
+    /*!
+     * Correct IQ imbalance and DC offset of a channel on the host.
+     *
+     * The correction is applied while the samples are converted to the host
+     * format, so it doesn't take another pass over the samples. This is
+     * meant for devices or modes where the front end can't correct the
+     * samples itself.
+     *
+     * Samples handed out by recv_views() are not corrected. Like recv(),
+     * this is not thread-safe.
+     *
+     * \param chan the channel index of this streamer
+     * \param correction the correction to apply to all following samples
+     * \throws uhd::not_implemented_error if this streamer can't correct
+     *         samples at all
+     * \throws uhd::key_error if there's no correcting converter for this
+     *         streamer's formats (only fc32 on the host and sc16 on the wire
+     *         are supported)
+     * \throws uhd::index_error if \p chan is not a channel of this streamer
+     */
+    virtual void set_iq_dc_correction(
+        const size_t chan, const uhd::convert::iq_dc_correction_t& correction);
 };
 
 /*!
@@ -292,6 +480,34 @@ public:
      */
     virtual bool recv_async_msg(
         async_metadata_t& async_metadata, double timeout = 0.1) = 0;
+
+    /*!
+     * Get the counters of this streamer.
+     *
+     * Unlike send(), this may be called from any thread while streaming.
+     * Streamers which don't keep counters return all zeros.
+     *
+     * \return a snapshot of the counters
+     */
+    virtual stream_stats_t get_stats(void) const;
+
+    /*!
+     * Correct IQ imbalance and DC offset of a channel on the host.
+     *
+     * Works like rx_streamer::set_iq_dc_correction(), the correction is
+     * applied to the samples before they are converted to the wire format.
+     *
+     * \param chan the channel index of this streamer
+     * \param correction the correction to apply to all following samples
+     * \throws uhd::not_implemented_error if this streamer can't correct
+     *         samples at all
+     * \throws uhd::key_error if there's no correcting converter for this
+     *         streamer's formats (only fc32 on the host and sc16 on the wire
+     *         are supported)
+     * \throws uhd::index_error if \p chan is not a channel of this streamer
+     */
+    virtual void set_iq_dc_correction(
+        const size_t chan, const uhd::convert::iq_dc_correction_t& correction);
 };
 
 } // namespace uhd
@@ -16,7 +16,8 @@ namespace uhd { namespace transport {
 
 /*!
  * A buffer pool manages memory for a homogeneous set of buffers.
- * Each buffer is the pool start at a 16-byte alignment boundary.
+ * Each buffer in the pool starts at an alignment boundary, which defaults
+ * to the size of a cache line.
  */
 class UHD_API buffer_pool : uhd::noncopyable
 {
@@ -24,6 +25,26 @@ public:
     typedef boost::shared_ptr<buffer_pool> sptr;
     typedef void* ptr_type;
 
+    //! Don't place the memory on a particular NUMA node
+    static const int NUMA_NODE_ANY;
+    //! Place the memory on the NUMA node of the calling thread
+    static const int NUMA_NODE_LOCAL;
+
+    //! How to allocate the memory behind a pool
+    struct alloc_params
+    {
+        alloc_params()
+            : alignment(64), use_huge_pages(false), numa_node(NUMA_NODE_ANY)
+        { /* NOP */
+        }
+        //! The alignment boundary of each buffer in bytes
+        size_t alignment;
+        //! Back the pool with 2 MiB huge pages when the system has them
+        bool use_huge_pages;
+        //! The NUMA node to place the memory on (Linux only)
+        int numa_node;
+    };
+
     virtual ~buffer_pool(void) = 0;
 
     /*!
@@ -34,7 +55,25 @@ public:
      * \return a new buffer pool buff_size X num_buffs
      */
     static sptr make(
-        const size_t num_buffs, const size_t buff_size, const size_t alignment = 16);
+        const size_t num_buffs, const size_t buff_size, const size_t alignment = 64);
+
+    /*!
+     * Make a new buffer pool with control over the memory placement.
+     *
+     * With huge pages, the pool needs far fewer TLB entries, which matters
+     * for transports with thousands of frames. When no huge pages are
+     * available (see /proc/sys/vm/nr_hugepages), the pool falls back to
+     * normal pages. The memory is touched before this returns, so it is
+     * placed on the requested NUMA node and no page faults happen while
+     * streaming.
+     *
+     * \param num_buffs the number of buffers to allocate
+     * \param buff_size the size of each buffer in bytes
+     * \param params the alignment and placement of the memory
+     * \return a new buffer pool buff_size X num_buffs
+     */
+    static sptr make(
+        const size_t num_buffs, const size_t buff_size, const alloc_params& params);
 
     //! Get a pointer to the buffer start at the specified index
     virtual ptr_type at(const size_t index) const = 0;
@@ -51,7 +51,7 @@ public:
     //! Unregister the stream number. All packets destined to the stream will be dropped.
     virtual void remove_stream(const uint32_t stream_num) = 0;
 
-    //! Get number of frames dropped due to unregistered streams
+    //! Get number of frames dropped due to unregistered or full streams
     virtual size_t get_num_dropped_frames() const = 0;
 
     //! Make a new demuxer from a transport and parameters
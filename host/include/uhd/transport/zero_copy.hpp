@@ -148,6 +148,8 @@ struct zero_copy_xport_params
         , num_send_frames(0)
         , recv_buff_size(0)
         , send_buff_size(0)
+        , use_huge_pages(false)
+        , numa_node(-1)
     { /* NOP */
     }
     size_t recv_frame_size;
@@ -156,6 +158,13 @@ struct zero_copy_xport_params
     size_t num_send_frames;
     size_t recv_buff_size;
     size_t send_buff_size;
+    // The memory placement options are only honored by udp_zero_copy so
+    // far, other transports ignore them. They were added in UHD 3.15 and
+    // change the size of this struct.
+    //! Back the frames with huge pages, see buffer_pool::alloc_params
+    bool use_huge_pages;
+    //! NUMA node of the frames, or one of the buffer_pool::NUMA_NODE_* values
+    int numa_node;
 };
 
 /*!
@@ -194,6 +203,17 @@ public:
      */
     virtual size_t get_recv_frame_size(void) const = 0;
 
+    /*!
+     * Get a file descriptor that becomes readable when there's something
+     * to receive, e.g. the socket of a UDP transport.
+     * This allows waiting for many transports at once.
+     * \return the file descriptor, or -1 if the transport has none
+     */
+    virtual int get_recv_fd(void) const
+    {
+        return -1;
+    }
+
     /*!
      * Get a new send buffer from this transport object.
      * \param timeout the timeout to get the buffer in seconds
@@ -9,13 +9,118 @@
 #define INCLUDED_UHD_TYPES_DICT_HPP
 
 #include <uhd/config.hpp>
+#include <boost/functional/hash.hpp>
 #include <list>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 namespace uhd {
 
+/*!
+ * Key types for which a dict keeps a hash index, see dict.
+ * Specialize this for other key types which boost::hash supports.
+ */
+template <typename Key, typename Enable = void> struct dict_key_is_hashable
+{
+    static const bool value = false;
+};
+
+template <typename Key>
+struct dict_key_is_hashable<Key,
+    typename std::enable_if<std::is_integral<Key>::value or std::is_enum<Key>::value>::type>
+{
+    static const bool value = true;
+};
+
+template <> struct dict_key_is_hashable<std::string>
+{
+    static const bool value = true;
+};
+
+namespace detail {
+
+//! A dict's hash index: nothing for keys that can't be hashed
+template <typename Key, typename Iter, bool hashable> class dict_index
+{
+public:
+    bool active(void) const
+    {
+        return false;
+    }
+    bool find(const Key&, Iter&) const
+    {
+        return false;
+    }
+    void insert(const Key&, const Iter&) {}
+    void erase(const Key&) {}
+    template <typename List> void rebuild(List&) {}
+};
+
+//! A dict's hash index: built once the dict is large enough to profit
+template <typename Key, typename Iter> class dict_index<Key, Iter, true>
+{
+public:
+    //! Dicts smaller than this are scanned, which is faster (see dict_benchmark)
+    static const size_t THRESHOLD = 32;
+
+    bool active(void) const
+    {
+        return bool(_index);
+    }
+
+    bool find(const Key& key, Iter& it) const
+    {
+        const typename index_type::const_iterator i = _index->find(key);
+        if (i == _index->end()) {
+            return false;
+        }
+        it = i->second;
+        return true;
+    }
+
+    void insert(const Key& key, const Iter& it)
+    {
+        if (_index) {
+            _index->insert(std::make_pair(key, it));
+        }
+    }
+
+    void erase(const Key& key)
+    {
+        if (_index) {
+            _index->erase(key);
+        }
+    }
+
+    template <typename List> void rebuild(List& list)
+    {
+        if (list.size() < THRESHOLD) {
+            _index.reset();
+            return;
+        }
+        _index.reset(new index_type(list.size()));
+        for (Iter it = list.begin(); it != list.end(); ++it) {
+            _index->insert(std::make_pair(it->first, it));
+        }
+    }
+
+private:
+    typedef std::unordered_map<Key, Iter, boost::hash<Key> > index_type;
+    std::unique_ptr<index_type> _index;
+};
+
+} // namespace detail
+
 /*!
  * A templated dictionary class with a python-like interface.
+ *
+ * Items are kept in the order of insertion. Lookups scan the items,
+ * unless the key type is hashable (see dict_key_is_hashable) and the
+ * dict has grown past a few dozen items: then a hash index makes lookups
+ * take constant time.
  */
 template <typename Key, typename Val> class dict
 {
@@ -25,6 +130,19 @@ public:
      */
     dict(void);
 
+    /*!
+     * Copy constructor: copies the items, and indexes them if needed.
+     * \param other the dict to copy
+     */
+    dict(const dict<Key, Val>& other);
+
+    /*!
+     * Assignment operator: copies the items, and indexes them if needed.
+     * \param other the dict to copy
+     * \return a reference to this dict
+     */
+    dict<Key, Val>& operator=(const dict<Key, Val>& other);
+
     /*!
      * Input iterator constructor:
      * Makes boost::assign::map_list_of work.
@@ -140,7 +258,13 @@ public:
 
 private:
     typedef std::pair<Key, Val> pair_t;
+    typedef typename std::list<pair_t>::iterator iterator;
+    typedef typename std::list<pair_t>::const_iterator const_iterator;
+    iterator _find(const Key& key);
+    const_iterator _find(const Key& key) const;
+
     std::list<pair_t> _map; // private container
+    detail::dict_index<Key, iterator, dict_key_is_hashable<Key>::value> _index;
 };
 
 } // namespace uhd
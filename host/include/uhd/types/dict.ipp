@@ -40,7 +40,48 @@ namespace uhd{
     dict<Key, Val>::dict(InputIterator first, InputIterator last):
         _map(first, last)
     {
-        /* NOP */
+        _index.rebuild(_map);
+    }
+
+    template <typename Key, typename Val>
+    dict<Key, Val>::dict(const dict<Key, Val> &other):
+        _map(other._map)
+    {
+        _index.rebuild(_map);
+    }
+
+    template <typename Key, typename Val>
+    dict<Key, Val> &dict<Key, Val>::operator=(const dict<Key, Val> &other){
+        if (this != &other){
+            _map = other._map;
+            _index.rebuild(_map);
+        }
+        return *this;
+    }
+
+    template <typename Key, typename Val>
+    typename dict<Key, Val>::iterator dict<Key, Val>::_find(const Key &key){
+        iterator it;
+        if (_index.active()){
+            return _index.find(key, it) ? it : _map.end();
+        }
+        for (it = _map.begin(); it != _map.end(); ++it){
+            if (it->first == key) break;
+        }
+        return it;
+    }
+
+    template <typename Key, typename Val>
+    typename dict<Key, Val>::const_iterator dict<Key, Val>::_find(const Key &key) const{
+        if (_index.active()){
+            iterator it;
+            return _index.find(key, it) ? const_iterator(it) : _map.end();
+        }
+        const_iterator it;
+        for (it = _map.begin(); it != _map.end(); ++it){
+            if (it->first == key) break;
+        }
+        return it;
     }
 
     template <typename Key, typename Val>
@@ -51,6 +92,7 @@ namespace uhd{
     template <typename Key, typename Val>
     std::vector<Key> dict<Key, Val>::keys(void) const{
         std::vector<Key> keys;
+        keys.reserve(_map.size());
         BOOST_FOREACH(const pair_t &p, _map){
             keys.push_back(p.first);
         }
@@ -60,6 +102,7 @@ namespace uhd{
     template <typename Key, typename Val>
     std::vector<Val> dict<Key, Val>::vals(void) const{
         std::vector<Val> vals;
+        vals.reserve(_map.size());
         BOOST_FOREACH(const pair_t &p, _map){
             vals.push_back(p.second);
         }
@@ -68,26 +111,20 @@ namespace uhd{
 
     template <typename Key, typename Val>
     bool dict<Key, Val>::has_key(const Key &key) const{
-        BOOST_FOREACH(const pair_t &p, _map){
-            if (p.first == key) return true;
-        }
-        return false;
+        return _find(key) != _map.end();
     }
 
     template <typename Key, typename Val>
     const Val &dict<Key, Val>::get(const Key &key, const Val &other) const{
-        BOOST_FOREACH(const pair_t &p, _map){
-            if (p.first == key) return p.second;
-        }
-        return other;
+        const const_iterator it = _find(key);
+        return it == _map.end() ? other : it->second;
     }
 
     template <typename Key, typename Val>
     const Val &dict<Key, Val>::get(const Key &key) const{
-        BOOST_FOREACH(const pair_t &p, _map){
-            if (p.first == key) return p.second;
-        }
-        throw key_not_found<Key, Val>(key);
+        const const_iterator it = _find(key);
+        if (it == _map.end()) throw key_not_found<Key, Val>(key);
+        return it->second;
     }
 
     template <typename Key, typename Val>
@@ -97,18 +134,19 @@ namespace uhd{
 
     template <typename Key, typename Val>
     const Val &dict<Key, Val>::operator[](const Key &key) const{
-        BOOST_FOREACH(const pair_t &p, _map){
-            if (p.first == key) return p.second;
-        }
-        throw key_not_found<Key, Val>(key);
+        return this->get(key);
     }
 
     template <typename Key, typename Val>
     Val &dict<Key, Val>::operator[](const Key &key){
-        BOOST_FOREACH(pair_t &p, _map){
-            if (p.first == key) return p.second;
-        }
+        const iterator it = _find(key);
+        if (it != _map.end()) return it->second;
         _map.push_back(std::make_pair(key, Val()));
+        if (_index.active()){
+            _index.insert(key, --_map.end());
+        } else {
+            _index.rebuild(_map); //indexes the dict once it is large enough
+        }
         return _map.back().second;
     }
 
@@ -132,15 +170,12 @@ namespace uhd{
 
     template <typename Key, typename Val>
     Val dict<Key, Val>::pop(const Key &key){
-        typename std::list<pair_t>::iterator it;
-        for (it = _map.begin(); it != _map.end(); it++){
-            if (it->first == key){
-                Val val = it->second;
-                _map.erase(it);
-                return val;
-            }
-        }
-        throw key_not_found<Key, Val>(key);
+        const iterator it = _find(key);
+        if (it == _map.end()) throw key_not_found<Key, Val>(key);
+        Val val = it->second;
+        _index.erase(key);
+        _map.erase(it);
+        return val;
     }
 
     template <typename Key, typename Val>
@@ -23,6 +23,7 @@
 #define UHD_USRP_MULTI_USRP_FILTER_API
 #define UHD_USRP_MULTI_USRP_LO_CONFIG_API
 #define UHD_USRP_MULTI_USRP_TX_LO_CONFIG_API
+#define UHD_USRP_MULTI_USRP_BATCH_TUNE_API
 
 #include <uhd/config.hpp>
 #include <uhd/deprecated.hpp>
@@ -663,6 +664,32 @@ public:
     virtual tune_result_t set_rx_freq(
         const tune_request_t& tune_request, size_t chan = 0) = 0;
 
+    /*!
+     * Set the RX center frequency of several channels at once.
+     *
+     * The channels of each motherboard are tuned on a thread of their own,
+     * so the register round trips of different motherboards overlap. If a
+     * command time is given, it is set on all motherboards involved for the
+     * duration of the call, so all channels retune at that time. It is
+     * cleared again when the call throws, too.
+     *
+     * Only the tuning of the given channels runs on the motherboard
+     * threads. The channel lookup, the external LO check (which reads the
+     * other channels) and the command time are handled on the calling
+     * thread. Like the other calls, this must not run concurrently with
+     * other calls on the same multi_usrp.
+     *
+     * \param tune_requests one tune request per channel, or a single tune
+     *                      request for all channels
+     * \param chans the channel indexes 0 to N-1
+     * \param cmd_time the command time, or 0.0 to tune immediately
+     * \return one tune result object per channel
+     */
+    virtual std::vector<tune_result_t> set_rx_freqs(
+        const std::vector<tune_request_t>& tune_requests,
+        const std::vector<size_t>& chans,
+        const time_spec_t& cmd_time = time_spec_t(0.0)) = 0;
+
     /*!
      * Get the RX center frequency.
      * \param chan the channel index 0 to N-1
@@ -987,6 +1014,18 @@ public:
         return this->set_rx_gain(gain, ALL_GAINS, chan);
     }
 
+    /*!
+     * Set the overall RX gain of several channels at once.
+     * Motherboards are handled in parallel, as in set_rx_freqs().
+     * \param gains one gain in dB per channel, or a single gain for all
+     *              channels
+     * \param chans the channel indexes 0 to N-1
+     * \param cmd_time the command time, or 0.0 to set the gains immediately
+     */
+    virtual void set_rx_gains(const std::vector<double>& gains,
+        const std::vector<size_t>& chans,
+        const time_spec_t& cmd_time = time_spec_t(0.0)) = 0;
+
     /*!
      * Set the normalized RX gain value.
      *
@@ -1244,6 +1283,32 @@ public:
     virtual tune_result_t set_tx_freq(
         const tune_request_t& tune_request, size_t chan = 0) = 0;
 
+    /*!
+     * Set the TX center frequency of several channels at once.
+     *
+     * The channels of each motherboard are tuned on a thread of their own,
+     * so the register round trips of different motherboards overlap. If a
+     * command time is given, it is set on all motherboards involved for the
+     * duration of the call, so all channels retune at that time. It is
+     * cleared again when the call throws, too.
+     *
+     * Only the tuning of the given channels runs on the motherboard
+     * threads. The channel lookup, the external LO check (which reads the
+     * other channels) and the command time are handled on the calling
+     * thread. Like the other calls, this must not run concurrently with
+     * other calls on the same multi_usrp.
+     *
+     * \param tune_requests one tune request per channel, or a single tune
+     *                      request for all channels
+     * \param chans the channel indexes 0 to N-1
+     * \param cmd_time the command time, or 0.0 to tune immediately
+     * \return one tune result object per channel
+     */
+    virtual std::vector<tune_result_t> set_tx_freqs(
+        const std::vector<tune_request_t>& tune_requests,
+        const std::vector<size_t>& chans,
+        const time_spec_t& cmd_time = time_spec_t(0.0)) = 0;
+
     /*!
      * Get the TX center frequency.
      * \param chan the channel index 0 to N-1
@@ -1313,6 +1378,18 @@ public:
         return this->set_tx_gain(gain, ALL_GAINS, chan);
     }
 
+    /*!
+     * Set the overall TX gain of several channels at once.
+     * Motherboards are handled in parallel, as in set_tx_freqs().
+     * \param gains one gain in dB per channel, or a single gain for all
+     *              channels
+     * \param chans the channel indexes 0 to N-1
+     * \param cmd_time the command time, or 0.0 to set the gains immediately
+     */
+    virtual void set_tx_gains(const std::vector<double>& gains,
+        const std::vector<size_t>& chans,
+        const time_spec_t& cmd_time = time_spec_t(0.0)) = 0;
+
     /*!
      * Set the normalized TX gain value.
      *
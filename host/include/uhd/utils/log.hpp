@@ -11,10 +11,13 @@
 #include <uhd/config.hpp>
 #include <boost/current_function.hpp>
 #include <boost/thread/thread.hpp>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <ostream>
 #include <sstream>
 #include <string>
+#include <type_traits>
 
 /*! \file log.hpp
  *
@@ -81,6 +84,22 @@
  * - `-DUHD_LOG_CONSOLE_TIME` adds a timestamp [2017-01-01 00:00:00.000000]
  * - `-DUHD_LOG_CONSOLE_THREAD` adds a thread-id `[0x001234]`
  * - `-DUHD_LOG_CONSOLE_SRC` adds a sourcefile and line tag `[src_file:line]`
+ *
+ * \subsection loghpp_fast Fast logging
+ *
+ * The UHD_LOG_* macros format the message on the calling thread, and wait
+ * for the log queue when it's full. For code that must not be slowed down,
+ * such as the streaming paths, there is UHD_LOG_FAST:
+ *
+ *     UHD_LOG_FAST(uhd::log::info, "STREAMER", "Got %d packets", num_packets);
+ *
+ * The format string is a boost::format string, and has to be a literal.
+ * Up to four numeric (integer, floating point or bool) arguments can be
+ * passed. The call only stores a fixed-size binary record in a lock-free
+ * queue of the calling thread; the logging thread does the formatting and
+ * hands the message to the same loggers as all other messages. When a
+ * thread's queue is full, its messages are counted and dropped, and the
+ * number of dropped messages gets logged later on.
  */
 
 /*
@@ -225,12 +244,21 @@ UHD_API void set_logger_level(const std::string& logger, uhd::log::severity_leve
 //! Extra-fast logging macro for when speed matters.
 // No metadata is tracked. Only the message is displayed. This does not go
 // through the regular backends. Mostly used for printing the UOSDL characters
-// during streaming.
+// during streaming. Messages are truncated to 32 characters.
 #    define UHD_LOG_FASTPATH(message) uhd::_log::log_fastpath(message);
 #else
 #    define UHD_LOG_FASTPATH(message)
 #endif
 
+//! Logging macro that never blocks, and formats on the logging thread
+// See \ref loghpp_fast. The call site is registered on its first call.
+#define UHD_LOG_FAST(level, component, format, ...)                              \
+    do {                                                                         \
+        static const uint32_t _uhd_log_site = uhd::_log::register_fast_log_site( \
+            level, component, format, __FILE__, __LINE__);                       \
+        uhd::_log::log_fast(level, _uhd_log_site, ##__VA_ARGS__);                \
+    } while (0)
+
 // iostream-style logging
 #define UHD_LOGGER_TRACE(component) _UHD_LOG_INTERNAL(component, uhd::log::trace)
 #define UHD_LOGGER_DEBUG(component) _UHD_LOG_INTERNAL(component, uhd::log::debug)
@@ -265,6 +293,91 @@ namespace _log {
 //! Fastpath logging
 void UHD_API log_fastpath(const std::string&);
 
+//! Binary record of a UHD_LOG_FAST call, formatted by the logging thread
+struct fast_log_record
+{
+    enum arg_type_t : uint8_t { ARG_INT, ARG_UINT, ARG_DOUBLE, ARG_BOOL };
+    static const size_t MAX_ARGS = 4;
+
+    //! Time of the call, in ns since the epoch of the system clock
+    int64_t time_ns;
+    //! Call site, see register_fast_log_site(). 0 is for UHD_LOG_FASTPATH
+    uint32_t site;
+    uint8_t num_args;
+    arg_type_t arg_types[MAX_ARGS];
+    //! The arguments, or the text of a UHD_LOG_FASTPATH message
+    uint64_t args[MAX_ARGS];
+};
+
+//! Register a UHD_LOG_FAST call site, and return its ID
+uint32_t UHD_API register_fast_log_site(const uhd::log::severity_level level,
+    const char* component,
+    const char* format,
+    const char* file,
+    const unsigned int line);
+
+//! Queue a fast log record on the calling thread's queue, never blocks
+void UHD_API push_fast_log(const uhd::log::severity_level level, fast_log_record& record);
+
+//! \cond
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value and std::is_signed<T>::value>::type
+pack_fast_log_arg(fast_log_record& record, const T value)
+{
+    const int64_t arg                         = value;
+    record.arg_types[record.num_args]         = fast_log_record::ARG_INT;
+    std::memcpy(&record.args[record.num_args++], &arg, sizeof(arg));
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value
+                               and std::is_unsigned<T>::value
+                               and not std::is_same<T, bool>::value>::type
+pack_fast_log_arg(fast_log_record& record, const T value)
+{
+    record.arg_types[record.num_args] = fast_log_record::ARG_UINT;
+    record.args[record.num_args++]    = value;
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_floating_point<T>::value>::type pack_fast_log_arg(
+    fast_log_record& record, const T value)
+{
+    const double arg                  = value;
+    record.arg_types[record.num_args] = fast_log_record::ARG_DOUBLE;
+    std::memcpy(&record.args[record.num_args++], &arg, sizeof(arg));
+}
+
+inline void pack_fast_log_arg(fast_log_record& record, const bool value)
+{
+    record.arg_types[record.num_args] = fast_log_record::ARG_BOOL;
+    record.args[record.num_args++]    = value;
+}
+
+inline void pack_fast_log_args(fast_log_record&) {}
+
+template <typename T, typename... Args>
+inline void pack_fast_log_args(fast_log_record& record, const T value, Args... args)
+{
+    pack_fast_log_arg(record, value);
+    pack_fast_log_args(record, args...);
+}
+//! \endcond
+
+//! Log a UHD_LOG_FAST message (called by UHD_LOG_FAST)
+template <typename... Args>
+inline void log_fast(
+    const uhd::log::severity_level level, const uint32_t site, Args... args)
+{
+    static_assert(sizeof...(Args) <= fast_log_record::MAX_ARGS,
+        "UHD_LOG_FAST takes at most 4 arguments");
+    fast_log_record record;
+    record.site     = site;
+    record.num_args = 0;
+    pack_fast_log_args(record, args...);
+    push_fast_log(level, record);
+}
+
 //! Internal logging object (called by UHD_LOG* macros)
 class UHD_API log
 {
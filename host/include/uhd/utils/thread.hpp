@@ -11,6 +11,7 @@
 #include <uhd/config.hpp>
 #include <boost/thread/thread.hpp>
 #include <string>
+#include <vector>
 
 namespace uhd {
 
@@ -48,6 +49,14 @@ UHD_API bool set_thread_priority_safe(
  */
 UHD_API void set_thread_name(boost::thread* thread, const std::string& name);
 
+/*!
+ * Set the CPU affinity of the current thread.
+ * Failure to set the affinity is logged but does not throw.
+ * \param cpu_affinity_list list of CPU numbers the thread may run on;
+ *                          an empty list leaves the affinity unchanged
+ */
+UHD_API void set_thread_affinity(const std::vector<size_t>& cpu_affinity_list);
+
 } // namespace uhd
 
 #endif /* INCLUDED_UHD_UTILS_THREAD_HPP */
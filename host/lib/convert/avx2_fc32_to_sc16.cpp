@@ -0,0 +1,62 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_avx_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+
+using namespace uhd::convert;
+
+template <xtox_t to_wire>
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE void convert_fc32_1_to_item32_1_avx2(
+    const fc32_t *input,
+    item32_t *output,
+    const size_t nsamps,
+    const double scale_factor,
+    const __m128i lane_mask
+){
+    const __m256 scalar = _mm256_set1_ps(float(scale_factor));
+    const __m256i wire_mask = _mm256_broadcastsi128_si256(lane_mask);
+
+    // convert 8 samples at a time, unaligned loads are as fast as aligned
+    // loads on AVX2 capable CPUs, so there is no alignment dispatch
+    size_t i = 0;
+    for (; i+7 < nsamps; i+=8){
+        /* load from input */
+        __m256 tmplo = _mm256_loadu_ps(reinterpret_cast<const float *>(input+i+0));
+        __m256 tmphi = _mm256_loadu_ps(reinterpret_cast<const float *>(input+i+4));
+
+        /* convert and scale */
+        __m256i tmpilo = _mm256_cvtps_epi32(_mm256_mul_ps(tmplo, scalar));
+        __m256i tmpihi = _mm256_cvtps_epi32(_mm256_mul_ps(tmphi, scalar));
+
+        /* pack (within 128-bit lanes), restore sample order, swap to wire order */
+        __m256i tmpi = _mm256_packs_epi32(tmpilo, tmpihi);
+        tmpi = _mm256_permute4x64_epi64(tmpi, _MM_SHUFFLE(3, 1, 2, 0));
+        tmpi = _mm256_shuffle_epi8(tmpi, wire_mask);
+
+        /* store to output */
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(output+i), tmpi);
+    }
+
+    // convert any remaining samples
+    xx_to_item32_sc16<to_wire>(input+i, output+i, nsamps-i, scale_factor);
+}
+
+DECLARE_ISA_CONVERTER(fc32, 1, sc16_item32_le, 1, PRIORITY_SIMD_AVX2, AVX2){
+    convert_fc32_1_to_item32_1_avx2<uhd::htowx>(
+        reinterpret_cast<const fc32_t *>(inputs[0]),
+        reinterpret_cast<item32_t *>(outputs[0]),
+        nsamps, scale_factor, sc16_item32_le_lane_mask()
+    );
+}
+
+DECLARE_ISA_CONVERTER(fc32, 1, sc16_item32_be, 1, PRIORITY_SIMD_AVX2, AVX2){
+    convert_fc32_1_to_item32_1_avx2<uhd::htonx>(
+        reinterpret_cast<const fc32_t *>(inputs[0]),
+        reinterpret_cast<item32_t *>(outputs[0]),
+        nsamps, scale_factor, sc16_item32_be_lane_mask()
+    );
+}
@@ -0,0 +1,69 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_avx_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+
+using namespace uhd::convert;
+
+template <xtox_t to_wire>
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE void convert_fc32_1_to_sc8_item32_1_avx2(
+    const fc32_t *input,
+    item32_t *output,
+    const size_t nsamps,
+    const double scale_factor,
+    const __m128i lane_mask
+){
+    const __m256 scalar = _mm256_set1_ps(float(scale_factor));
+    const __m256i wire_mask = _mm256_broadcastsi128_si256(lane_mask);
+    // undoes the lane interleaving of the two pack instructions
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    size_t i = 0;
+    for (size_t j = 0; i+15 < nsamps; i+=16, j+=8){
+        /* load from input */
+        __m256 tmp0 = _mm256_loadu_ps(reinterpret_cast<const float *>(input+i+0));
+        __m256 tmp1 = _mm256_loadu_ps(reinterpret_cast<const float *>(input+i+4));
+        __m256 tmp2 = _mm256_loadu_ps(reinterpret_cast<const float *>(input+i+8));
+        __m256 tmp3 = _mm256_loadu_ps(reinterpret_cast<const float *>(input+i+12));
+
+        /* convert and scale */
+        __m256i tmpi0 = _mm256_cvtps_epi32(_mm256_mul_ps(tmp0, scalar));
+        __m256i tmpi1 = _mm256_cvtps_epi32(_mm256_mul_ps(tmp1, scalar));
+        __m256i tmpi2 = _mm256_cvtps_epi32(_mm256_mul_ps(tmp2, scalar));
+        __m256i tmpi3 = _mm256_cvtps_epi32(_mm256_mul_ps(tmp3, scalar));
+
+        /* pack to 8 bit, restore sample order, swap to wire order */
+        __m256i tmpi = _mm256_packs_epi16(
+            _mm256_packs_epi32(tmpi0, tmpi1),
+            _mm256_packs_epi32(tmpi2, tmpi3)
+        );
+        tmpi = _mm256_permutevar8x32_epi32(tmpi, order);
+        tmpi = _mm256_shuffle_epi8(tmpi, wire_mask);
+
+        /* store to output */
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(output+j), tmpi);
+    }
+
+    // convert remainder
+    xx_to_item32_sc8<to_wire>(input+i, output+(i/2), nsamps-i, scale_factor);
+}
+
+DECLARE_ISA_CONVERTER(fc32, 1, sc8_item32_be, 1, PRIORITY_SIMD_AVX2, AVX2){
+    convert_fc32_1_to_sc8_item32_1_avx2<uhd::htonx>(
+        reinterpret_cast<const fc32_t *>(inputs[0]),
+        reinterpret_cast<item32_t *>(outputs[0]),
+        nsamps, scale_factor, sc8_item32_be_lane_mask()
+    );
+}
+
+DECLARE_ISA_CONVERTER(fc32, 1, sc8_item32_le, 1, PRIORITY_SIMD_AVX2, AVX2){
+    convert_fc32_1_to_sc8_item32_1_avx2<uhd::htowx>(
+        reinterpret_cast<const fc32_t *>(inputs[0]),
+        reinterpret_cast<item32_t *>(outputs[0]),
+        nsamps, scale_factor, sc8_item32_le_lane_mask()
+    );
+}
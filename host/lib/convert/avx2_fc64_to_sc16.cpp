@@ -0,0 +1,65 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_avx_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+
+using namespace uhd::convert;
+
+template <xtox_t to_wire>
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE void convert_fc64_1_to_item32_1_avx2(
+    const fc64_t *input,
+    item32_t *output,
+    const size_t nsamps,
+    const double scale_factor,
+    const __m128i lane_mask
+){
+    const __m256d scalar = _mm256_set1_pd(scale_factor);
+    const __m256i wire_mask = _mm256_broadcastsi128_si256(lane_mask);
+
+    size_t i = 0;
+    for (; i+7 < nsamps; i+=8){
+        /* load from input */
+        __m256d tmp0 = _mm256_loadu_pd(reinterpret_cast<const double *>(input+i+0));
+        __m256d tmp1 = _mm256_loadu_pd(reinterpret_cast<const double *>(input+i+2));
+        __m256d tmp2 = _mm256_loadu_pd(reinterpret_cast<const double *>(input+i+4));
+        __m256d tmp3 = _mm256_loadu_pd(reinterpret_cast<const double *>(input+i+6));
+
+        /* convert and scale */
+        __m128i tmpi0 = _mm256_cvttpd_epi32(_mm256_mul_pd(tmp0, scalar));
+        __m128i tmpi1 = _mm256_cvttpd_epi32(_mm256_mul_pd(tmp1, scalar));
+        __m128i tmpi2 = _mm256_cvttpd_epi32(_mm256_mul_pd(tmp2, scalar));
+        __m128i tmpi3 = _mm256_cvttpd_epi32(_mm256_mul_pd(tmp3, scalar));
+
+        /* pack + swap to wire order */
+        __m128i tmpilo = _mm_packs_epi32(tmpi0, tmpi1);
+        __m128i tmpihi = _mm_packs_epi32(tmpi2, tmpi3);
+        __m256i tmpi = _mm256_inserti128_si256(_mm256_castsi128_si256(tmpilo), tmpihi, 1);
+        tmpi = _mm256_shuffle_epi8(tmpi, wire_mask);
+
+        /* store to output */
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(output+i), tmpi);
+    }
+
+    // convert any remaining samples
+    xx_to_item32_sc16<to_wire>(input+i, output+i, nsamps-i, scale_factor);
+}
+
+DECLARE_ISA_CONVERTER(fc64, 1, sc16_item32_le, 1, PRIORITY_SIMD_AVX2, AVX2){
+    convert_fc64_1_to_item32_1_avx2<uhd::htowx>(
+        reinterpret_cast<const fc64_t *>(inputs[0]),
+        reinterpret_cast<item32_t *>(outputs[0]),
+        nsamps, scale_factor, sc16_item32_le_lane_mask()
+    );
+}
+
+DECLARE_ISA_CONVERTER(fc64, 1, sc16_item32_be, 1, PRIORITY_SIMD_AVX2, AVX2){
+    convert_fc64_1_to_item32_1_avx2<uhd::htonx>(
+        reinterpret_cast<const fc64_t *>(inputs[0]),
+        reinterpret_cast<item32_t *>(outputs[0]),
+        nsamps, scale_factor, sc16_item32_be_lane_mask()
+    );
+}
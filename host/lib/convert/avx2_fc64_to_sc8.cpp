@@ -0,0 +1,72 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_avx_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+
+using namespace uhd::convert;
+
+//! Scale and convert 2 samples to 32-bit integers
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE __m128i convert_fc64_2x_avx2(
+    const fc64_t *input, const __m256d &scalar
+){
+    const __m256d tmp = _mm256_loadu_pd(reinterpret_cast<const double *>(input));
+    return _mm256_cvttpd_epi32(_mm256_mul_pd(tmp, scalar));
+}
+
+template <xtox_t to_wire>
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE void convert_fc64_1_to_sc8_item32_1_avx2(
+    const fc64_t *input,
+    item32_t *output,
+    const size_t nsamps,
+    const double scale_factor,
+    const __m128i lane_mask
+){
+    const __m256d scalar = _mm256_set1_pd(scale_factor);
+    const __m256i wire_mask = _mm256_broadcastsi128_si256(lane_mask);
+
+    size_t i = 0;
+    for (size_t j = 0; i+15 < nsamps; i+=16, j+=8){
+        /* load, convert and pack to 16 bit */
+        const __m128i tmpi0 = _mm_packs_epi32(
+            convert_fc64_2x_avx2(input+i+0, scalar), convert_fc64_2x_avx2(input+i+2, scalar));
+        const __m128i tmpi1 = _mm_packs_epi32(
+            convert_fc64_2x_avx2(input+i+4, scalar), convert_fc64_2x_avx2(input+i+6, scalar));
+        const __m128i tmpi2 = _mm_packs_epi32(
+            convert_fc64_2x_avx2(input+i+8, scalar), convert_fc64_2x_avx2(input+i+10, scalar));
+        const __m128i tmpi3 = _mm_packs_epi32(
+            convert_fc64_2x_avx2(input+i+12, scalar), convert_fc64_2x_avx2(input+i+14, scalar));
+
+        /* pack to 8 bit, swap to wire order */
+        __m256i tmpi = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_packs_epi16(tmpi0, tmpi1)),
+            _mm_packs_epi16(tmpi2, tmpi3), 1
+        );
+        tmpi = _mm256_shuffle_epi8(tmpi, wire_mask);
+
+        /* store to output */
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(output+j), tmpi);
+    }
+
+    // convert remainder
+    xx_to_item32_sc8<to_wire>(input+i, output+(i/2), nsamps-i, scale_factor);
+}
+
+DECLARE_ISA_CONVERTER(fc64, 1, sc8_item32_be, 1, PRIORITY_SIMD_AVX2, AVX2){
+    convert_fc64_1_to_sc8_item32_1_avx2<uhd::htonx>(
+        reinterpret_cast<const fc64_t *>(inputs[0]),
+        reinterpret_cast<item32_t *>(outputs[0]),
+        nsamps, scale_factor, sc8_item32_be_lane_mask()
+    );
+}
+
+DECLARE_ISA_CONVERTER(fc64, 1, sc8_item32_le, 1, PRIORITY_SIMD_AVX2, AVX2){
+    convert_fc64_1_to_sc8_item32_1_avx2<uhd::htowx>(
+        reinterpret_cast<const fc64_t *>(inputs[0]),
+        reinterpret_cast<item32_t *>(outputs[0]),
+        nsamps, scale_factor, sc8_item32_le_lane_mask()
+    );
+}
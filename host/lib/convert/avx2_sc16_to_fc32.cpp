@@ -0,0 +1,60 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_avx_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+
+using namespace uhd::convert;
+
+template <xtox_t to_host>
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE void convert_item32_1_to_fc32_1_avx2(
+    const item32_t *input,
+    fc32_t *output,
+    const size_t nsamps,
+    const double scale_factor,
+    const __m128i lane_mask
+){
+    const __m256 scalar = _mm256_set1_ps(float(scale_factor));
+    const __m256i wire_mask = _mm256_broadcastsi128_si256(lane_mask);
+
+    size_t i = 0;
+    for (; i+7 < nsamps; i+=8){
+        /* load from input, swap to host order */
+        __m256i tmpi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input+i));
+        tmpi = _mm256_shuffle_epi8(tmpi, wire_mask);
+
+        /* sign extend to 32 bit */
+        __m256i tmpilo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(tmpi));
+        __m256i tmpihi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(tmpi, 1));
+
+        /* convert and scale */
+        __m256 tmplo = _mm256_mul_ps(_mm256_cvtepi32_ps(tmpilo), scalar);
+        __m256 tmphi = _mm256_mul_ps(_mm256_cvtepi32_ps(tmpihi), scalar);
+
+        /* store to output */
+        _mm256_storeu_ps(reinterpret_cast<float *>(output+i+0), tmplo);
+        _mm256_storeu_ps(reinterpret_cast<float *>(output+i+4), tmphi);
+    }
+
+    // convert any remaining samples
+    item32_sc16_to_xx<to_host>(input+i, output+i, nsamps-i, scale_factor);
+}
+
+DECLARE_ISA_CONVERTER(sc16_item32_le, 1, fc32, 1, PRIORITY_SIMD_AVX2, AVX2){
+    convert_item32_1_to_fc32_1_avx2<uhd::wtohx>(
+        reinterpret_cast<const item32_t *>(inputs[0]),
+        reinterpret_cast<fc32_t *>(outputs[0]),
+        nsamps, scale_factor, sc16_item32_le_lane_mask()
+    );
+}
+
+DECLARE_ISA_CONVERTER(sc16_item32_be, 1, fc32, 1, PRIORITY_SIMD_AVX2, AVX2){
+    convert_item32_1_to_fc32_1_avx2<uhd::ntohx>(
+        reinterpret_cast<const item32_t *>(inputs[0]),
+        reinterpret_cast<fc32_t *>(outputs[0]),
+        nsamps, scale_factor, sc16_item32_be_lane_mask()
+    );
+}
@@ -0,0 +1,64 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_avx_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+
+using namespace uhd::convert;
+
+template <xtox_t to_host>
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE void convert_item32_1_to_fc64_1_avx2(
+    const item32_t *input,
+    fc64_t *output,
+    const size_t nsamps,
+    const double scale_factor,
+    const __m128i lane_mask
+){
+    const __m256d scalar = _mm256_set1_pd(scale_factor);
+    const __m256i wire_mask = _mm256_broadcastsi128_si256(lane_mask);
+
+    size_t i = 0;
+    for (; i+7 < nsamps; i+=8){
+        /* load from input, swap to host order */
+        __m256i tmpi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input+i));
+        tmpi = _mm256_shuffle_epi8(tmpi, wire_mask);
+
+        /* sign extend to 32 bit */
+        __m256i tmpilo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(tmpi));
+        __m256i tmpihi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(tmpi, 1));
+
+        /* convert and scale */
+        __m256d tmp0 = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(tmpilo)), scalar);
+        __m256d tmp1 = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(tmpilo, 1)), scalar);
+        __m256d tmp2 = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(tmpihi)), scalar);
+        __m256d tmp3 = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(tmpihi, 1)), scalar);
+
+        /* store to output */
+        _mm256_storeu_pd(reinterpret_cast<double *>(output+i+0), tmp0);
+        _mm256_storeu_pd(reinterpret_cast<double *>(output+i+2), tmp1);
+        _mm256_storeu_pd(reinterpret_cast<double *>(output+i+4), tmp2);
+        _mm256_storeu_pd(reinterpret_cast<double *>(output+i+6), tmp3);
+    }
+
+    // convert any remaining samples
+    item32_sc16_to_xx<to_host>(input+i, output+i, nsamps-i, scale_factor);
+}
+
+DECLARE_ISA_CONVERTER(sc16_item32_le, 1, fc64, 1, PRIORITY_SIMD_AVX2, AVX2){
+    convert_item32_1_to_fc64_1_avx2<uhd::wtohx>(
+        reinterpret_cast<const item32_t *>(inputs[0]),
+        reinterpret_cast<fc64_t *>(outputs[0]),
+        nsamps, scale_factor, sc16_item32_le_lane_mask()
+    );
+}
+
+DECLARE_ISA_CONVERTER(sc16_item32_be, 1, fc64, 1, PRIORITY_SIMD_AVX2, AVX2){
+    convert_item32_1_to_fc64_1_avx2<uhd::ntohx>(
+        reinterpret_cast<const item32_t *>(inputs[0]),
+        reinterpret_cast<fc64_t *>(outputs[0]),
+        nsamps, scale_factor, sc16_item32_be_lane_mask()
+    );
+}
@@ -0,0 +1,75 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_avx_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+
+using namespace uhd::convert;
+
+//
+// AVX2 byte shuffle, 8 complex 16-bit integers at a time. The same lane
+// mask converts from host to wire order and back.
+//
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE size_t convert_sc16_1_to_sc16_1_avx2(
+    const void *input,
+    void *output,
+    const size_t nsamps,
+    const __m128i lane_mask
+){
+    const __m256i wire_mask = _mm256_broadcastsi128_si256(lane_mask);
+    const __m256i *in = reinterpret_cast<const __m256i *>(input);
+    __m256i *out = reinterpret_cast<__m256i *>(output);
+
+    size_t i = 0;
+    for (; i+7 < nsamps; i+=8){
+        _mm256_storeu_si256(out++, _mm256_shuffle_epi8(_mm256_loadu_si256(in++), wire_mask));
+    }
+    return i;
+}
+
+DECLARE_ISA_CONVERTER(sc16, 1, sc16_item32_le, 1, PRIORITY_SIMD_AVX2, AVX2){
+    const sc16_t *input = reinterpret_cast<const sc16_t *>(inputs[0]);
+    item32_t *output = reinterpret_cast<item32_t *>(outputs[0]);
+
+    const size_t i = convert_sc16_1_to_sc16_1_avx2(
+        input, output, nsamps, sc16_item32_le_lane_mask());
+
+    // convert any remaining samples
+    xx_to_item32_sc16<uhd::htowx>(input+i, output+i, nsamps-i, 1.0);
+}
+
+DECLARE_ISA_CONVERTER(sc16, 1, sc16_item32_be, 1, PRIORITY_SIMD_AVX2, AVX2){
+    const sc16_t *input = reinterpret_cast<const sc16_t *>(inputs[0]);
+    item32_t *output = reinterpret_cast<item32_t *>(outputs[0]);
+
+    const size_t i = convert_sc16_1_to_sc16_1_avx2(
+        input, output, nsamps, sc16_item32_be_lane_mask());
+
+    // convert any remaining samples
+    xx_to_item32_sc16<uhd::htonx>(input+i, output+i, nsamps-i, 1.0);
+}
+
+DECLARE_ISA_CONVERTER(sc16_item32_le, 1, sc16, 1, PRIORITY_SIMD_AVX2, AVX2){
+    const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
+    sc16_t *output = reinterpret_cast<sc16_t *>(outputs[0]);
+
+    const size_t i = convert_sc16_1_to_sc16_1_avx2(
+        input, output, nsamps, sc16_item32_le_lane_mask());
+
+    // convert any remaining samples
+    item32_sc16_to_xx<uhd::htowx>(input+i, output+i, nsamps-i, 1.0);
+}
+
+DECLARE_ISA_CONVERTER(sc16_item32_be, 1, sc16, 1, PRIORITY_SIMD_AVX2, AVX2){
+    const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
+    sc16_t *output = reinterpret_cast<sc16_t *>(outputs[0]);
+
+    const size_t i = convert_sc16_1_to_sc16_1_avx2(
+        input, output, nsamps, sc16_item32_be_lane_mask());
+
+    // convert any remaining samples
+    item32_sc16_to_xx<uhd::htonx>(input+i, output+i, nsamps-i, 1.0);
+}
@@ -0,0 +1,69 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_avx_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+
+using namespace uhd::convert;
+
+template <xtox_t to_host>
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE void convert_sc8_item32_1_to_fc32_1_avx2(
+    const void *input_addr,
+    fc32_t *output,
+    const size_t nsamps,
+    const double scale_factor,
+    const __m128i lane_mask
+){
+    const item32_t *input = reinterpret_cast<const item32_t *>(size_t(input_addr) & ~0x3);
+
+    const __m256 scalar = _mm256_set1_ps(float(scale_factor));
+    const __m256i wire_mask = _mm256_broadcastsi128_si256(lane_mask);
+
+    size_t i = 0, j = 0;
+    size_t num_samps = nsamps;
+
+    if ((size_t(input_addr) & 0x3) != 0){
+        item32_sc8_to_xx<to_host>(input++, output++, 1, scale_factor);
+        num_samps--;
+    }
+
+    for (; j+15 < num_samps; j+=16, i+=8){
+        /* load from input, swap to host order */
+        __m256i tmpi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input+i));
+        tmpi = _mm256_shuffle_epi8(tmpi, wire_mask);
+        const __m128i tmpilo = _mm256_castsi256_si128(tmpi);
+        const __m128i tmpihi = _mm256_extracti128_si256(tmpi, 1);
+
+        /* sign extend, convert and scale */
+        __m256 tmp0 = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(tmpilo)), scalar);
+        __m256 tmp1 = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_srli_si128(tmpilo, 8))), scalar);
+        __m256 tmp2 = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(tmpihi)), scalar);
+        __m256 tmp3 = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_srli_si128(tmpihi, 8))), scalar);
+
+        /* store to output */
+        _mm256_storeu_ps(reinterpret_cast<float *>(output+j+0), tmp0);
+        _mm256_storeu_ps(reinterpret_cast<float *>(output+j+4), tmp1);
+        _mm256_storeu_ps(reinterpret_cast<float *>(output+j+8), tmp2);
+        _mm256_storeu_ps(reinterpret_cast<float *>(output+j+12), tmp3);
+    }
+
+    //convert remainder
+    item32_sc8_to_xx<to_host>(input+i, output+j, num_samps-j, scale_factor);
+}
+
+DECLARE_ISA_CONVERTER(sc8_item32_be, 1, fc32, 1, PRIORITY_SIMD_AVX2, AVX2){
+    convert_sc8_item32_1_to_fc32_1_avx2<uhd::ntohx>(
+        inputs[0], reinterpret_cast<fc32_t *>(outputs[0]),
+        nsamps, scale_factor, sc8_item32_be_lane_mask()
+    );
+}
+
+DECLARE_ISA_CONVERTER(sc8_item32_le, 1, fc32, 1, PRIORITY_SIMD_AVX2, AVX2){
+    convert_sc8_item32_1_to_fc32_1_avx2<uhd::wtohx>(
+        inputs[0], reinterpret_cast<fc32_t *>(outputs[0]),
+        nsamps, scale_factor, sc8_item32_le_lane_mask()
+    );
+}
@@ -0,0 +1,62 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_avx_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+
+using namespace uhd::convert;
+
+template <xtox_t to_wire>
+UHD_CONVERT_TARGET_AVX512 UHD_INLINE void convert_fc32_1_to_item32_1_avx512(
+    const fc32_t *input,
+    item32_t *output,
+    const size_t nsamps,
+    const double scale_factor,
+    const __m128i lane_mask
+){
+    const __m512 scalar = _mm512_set1_ps(float(scale_factor));
+    const __m512i wire_mask = _mm512_broadcast_i32x4(lane_mask);
+
+    size_t i = 0;
+    for (; i+15 < nsamps; i+=16){
+        /* load from input */
+        __m512 tmplo = _mm512_loadu_ps(reinterpret_cast<const float *>(input+i+0));
+        __m512 tmphi = _mm512_loadu_ps(reinterpret_cast<const float *>(input+i+8));
+
+        /* convert and scale */
+        __m512i tmpilo = _mm512_cvtps_epi32(_mm512_mul_ps(tmplo, scalar));
+        __m512i tmpihi = _mm512_cvtps_epi32(_mm512_mul_ps(tmphi, scalar));
+
+        /* saturate to 16 bit (keeps sample order), swap to wire order */
+        __m512i tmpi = _mm512_inserti64x4(
+            _mm512_castsi256_si512(_mm512_cvtsepi32_epi16(tmpilo)),
+            _mm512_cvtsepi32_epi16(tmpihi), 1
+        );
+        tmpi = _mm512_shuffle_epi8(tmpi, wire_mask);
+
+        /* store to output */
+        _mm512_storeu_si512(reinterpret_cast<__m512i *>(output+i), tmpi);
+    }
+
+    // convert any remaining samples
+    xx_to_item32_sc16<to_wire>(input+i, output+i, nsamps-i, scale_factor);
+}
+
+DECLARE_ISA_CONVERTER(fc32, 1, sc16_item32_le, 1, PRIORITY_SIMD_AVX512, AVX512){
+    convert_fc32_1_to_item32_1_avx512<uhd::htowx>(
+        reinterpret_cast<const fc32_t *>(inputs[0]),
+        reinterpret_cast<item32_t *>(outputs[0]),
+        nsamps, scale_factor, sc16_item32_le_lane_mask()
+    );
+}
+
+DECLARE_ISA_CONVERTER(fc32, 1, sc16_item32_be, 1, PRIORITY_SIMD_AVX512, AVX512){
+    convert_fc32_1_to_item32_1_avx512<uhd::htonx>(
+        reinterpret_cast<const fc32_t *>(inputs[0]),
+        reinterpret_cast<item32_t *>(outputs[0]),
+        nsamps, scale_factor, sc16_item32_be_lane_mask()
+    );
+}
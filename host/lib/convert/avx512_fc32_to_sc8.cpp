@@ -0,0 +1,64 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_avx_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+
+using namespace uhd::convert;
+
+//! Scale, convert and saturate 8 samples to 8-bit integers
+UHD_CONVERT_TARGET_AVX512 UHD_INLINE __m128i convert_fc32_8x_avx512(
+    const fc32_t *input, const __m512 &scalar
+){
+    const __m512 tmp = _mm512_loadu_ps(reinterpret_cast<const float *>(input));
+    return _mm512_cvtsepi32_epi8(_mm512_cvtps_epi32(_mm512_mul_ps(tmp, scalar)));
+}
+
+template <xtox_t to_wire>
+UHD_CONVERT_TARGET_AVX512 UHD_INLINE void convert_fc32_1_to_sc8_item32_1_avx512(
+    const fc32_t *input,
+    item32_t *output,
+    const size_t nsamps,
+    const double scale_factor,
+    const __m128i lane_mask
+){
+    const __m512 scalar = _mm512_set1_ps(float(scale_factor));
+    const __m512i wire_mask = _mm512_broadcast_i32x4(lane_mask);
+
+    size_t i = 0;
+    for (size_t j = 0; i+31 < nsamps; i+=32, j+=16){
+        /* load, convert and pack to 8 bit */
+        __m512i tmpi = _mm512_castsi128_si512(convert_fc32_8x_avx512(input+i+0, scalar));
+        tmpi = _mm512_inserti32x4(tmpi, convert_fc32_8x_avx512(input+i+8, scalar), 1);
+        tmpi = _mm512_inserti32x4(tmpi, convert_fc32_8x_avx512(input+i+16, scalar), 2);
+        tmpi = _mm512_inserti32x4(tmpi, convert_fc32_8x_avx512(input+i+24, scalar), 3);
+
+        /* swap to wire order */
+        tmpi = _mm512_shuffle_epi8(tmpi, wire_mask);
+
+        /* store to output */
+        _mm512_storeu_si512(reinterpret_cast<__m512i *>(output+j), tmpi);
+    }
+
+    // convert remainder
+    xx_to_item32_sc8<to_wire>(input+i, output+(i/2), nsamps-i, scale_factor);
+}
+
+DECLARE_ISA_CONVERTER(fc32, 1, sc8_item32_be, 1, PRIORITY_SIMD_AVX512, AVX512){
+    convert_fc32_1_to_sc8_item32_1_avx512<uhd::htonx>(
+        reinterpret_cast<const fc32_t *>(inputs[0]),
+        reinterpret_cast<item32_t *>(outputs[0]),
+        nsamps, scale_factor, sc8_item32_be_lane_mask()
+    );
+}
+
+DECLARE_ISA_CONVERTER(fc32, 1, sc8_item32_le, 1, PRIORITY_SIMD_AVX512, AVX512){
+    convert_fc32_1_to_sc8_item32_1_avx512<uhd::htowx>(
+        reinterpret_cast<const fc32_t *>(inputs[0]),
+        reinterpret_cast<item32_t *>(outputs[0]),
+        nsamps, scale_factor, sc8_item32_le_lane_mask()
+    );
+}
@@ -0,0 +1,72 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_avx_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+
+using namespace uhd::convert;
+
+//! Scale and convert 4 samples to 32-bit integers
+UHD_CONVERT_TARGET_AVX512 UHD_INLINE __m256i convert_fc64_4x_avx512(
+    const fc64_t *input, const __m512d &scalar
+){
+    const __m512d tmp = _mm512_loadu_pd(reinterpret_cast<const double *>(input));
+    return _mm512_cvttpd_epi32(_mm512_mul_pd(tmp, scalar));
+}
+
+template <xtox_t to_wire>
+UHD_CONVERT_TARGET_AVX512 UHD_INLINE void convert_fc64_1_to_item32_1_avx512(
+    const fc64_t *input,
+    item32_t *output,
+    const size_t nsamps,
+    const double scale_factor,
+    const __m128i lane_mask
+){
+    const __m512d scalar = _mm512_set1_pd(scale_factor);
+    const __m512i wire_mask = _mm512_broadcast_i32x4(lane_mask);
+
+    size_t i = 0;
+    for (; i+15 < nsamps; i+=16){
+        /* load, convert and scale */
+        const __m512i tmpilo = _mm512_inserti64x4(
+            _mm512_castsi256_si512(convert_fc64_4x_avx512(input+i+0, scalar)),
+            convert_fc64_4x_avx512(input+i+4, scalar), 1
+        );
+        const __m512i tmpihi = _mm512_inserti64x4(
+            _mm512_castsi256_si512(convert_fc64_4x_avx512(input+i+8, scalar)),
+            convert_fc64_4x_avx512(input+i+12, scalar), 1
+        );
+
+        /* saturate to 16 bit, swap to wire order */
+        __m512i tmpi = _mm512_inserti64x4(
+            _mm512_castsi256_si512(_mm512_cvtsepi32_epi16(tmpilo)),
+            _mm512_cvtsepi32_epi16(tmpihi), 1
+        );
+        tmpi = _mm512_shuffle_epi8(tmpi, wire_mask);
+
+        /* store to output */
+        _mm512_storeu_si512(reinterpret_cast<__m512i *>(output+i), tmpi);
+    }
+
+    // convert any remaining samples
+    xx_to_item32_sc16<to_wire>(input+i, output+i, nsamps-i, scale_factor);
+}
+
+DECLARE_ISA_CONVERTER(fc64, 1, sc16_item32_le, 1, PRIORITY_SIMD_AVX512, AVX512){
+    convert_fc64_1_to_item32_1_avx512<uhd::htowx>(
+        reinterpret_cast<const fc64_t *>(inputs[0]),
+        reinterpret_cast<item32_t *>(outputs[0]),
+        nsamps, scale_factor, sc16_item32_le_lane_mask()
+    );
+}
+
+DECLARE_ISA_CONVERTER(fc64, 1, sc16_item32_be, 1, PRIORITY_SIMD_AVX512, AVX512){
+    convert_fc64_1_to_item32_1_avx512<uhd::htonx>(
+        reinterpret_cast<const fc64_t *>(inputs[0]),
+        reinterpret_cast<item32_t *>(outputs[0]),
+        nsamps, scale_factor, sc16_item32_be_lane_mask()
+    );
+}
@@ -0,0 +1,69 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_avx_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+
+using namespace uhd::convert;
+
+//! Scale, convert and saturate 8 samples to 8-bit integers
+UHD_CONVERT_TARGET_AVX512 UHD_INLINE __m128i convert_fc64_8x_avx512(
+    const fc64_t *input, const __m512d &scalar
+){
+    const __m512d tmplo = _mm512_loadu_pd(reinterpret_cast<const double *>(input+0));
+    const __m512d tmphi = _mm512_loadu_pd(reinterpret_cast<const double *>(input+4));
+    const __m512i tmpi = _mm512_inserti64x4(
+        _mm512_castsi256_si512(_mm512_cvttpd_epi32(_mm512_mul_pd(tmplo, scalar))),
+        _mm512_cvttpd_epi32(_mm512_mul_pd(tmphi, scalar)), 1
+    );
+    return _mm512_cvtsepi32_epi8(tmpi);
+}
+
+template <xtox_t to_wire>
+UHD_CONVERT_TARGET_AVX512 UHD_INLINE void convert_fc64_1_to_sc8_item32_1_avx512(
+    const fc64_t *input,
+    item32_t *output,
+    const size_t nsamps,
+    const double scale_factor,
+    const __m128i lane_mask
+){
+    const __m512d scalar = _mm512_set1_pd(scale_factor);
+    const __m512i wire_mask = _mm512_broadcast_i32x4(lane_mask);
+
+    size_t i = 0;
+    for (size_t j = 0; i+31 < nsamps; i+=32, j+=16){
+        /* load, convert and pack to 8 bit */
+        __m512i tmpi = _mm512_castsi128_si512(convert_fc64_8x_avx512(input+i+0, scalar));
+        tmpi = _mm512_inserti32x4(tmpi, convert_fc64_8x_avx512(input+i+8, scalar), 1);
+        tmpi = _mm512_inserti32x4(tmpi, convert_fc64_8x_avx512(input+i+16, scalar), 2);
+        tmpi = _mm512_inserti32x4(tmpi, convert_fc64_8x_avx512(input+i+24, scalar), 3);
+
+        /* swap to wire order */
+        tmpi = _mm512_shuffle_epi8(tmpi, wire_mask);
+
+        /* store to output */
+        _mm512_storeu_si512(reinterpret_cast<__m512i *>(output+j), tmpi);
+    }
+
+    // convert remainder
+    xx_to_item32_sc8<to_wire>(input+i, output+(i/2), nsamps-i, scale_factor);
+}
+
+DECLARE_ISA_CONVERTER(fc64, 1, sc8_item32_be, 1, PRIORITY_SIMD_AVX512, AVX512){
+    convert_fc64_1_to_sc8_item32_1_avx512<uhd::htonx>(
+        reinterpret_cast<const fc64_t *>(inputs[0]),
+        reinterpret_cast<item32_t *>(outputs[0]),
+        nsamps, scale_factor, sc8_item32_be_lane_mask()
+    );
+}
+
+DECLARE_ISA_CONVERTER(fc64, 1, sc8_item32_le, 1, PRIORITY_SIMD_AVX512, AVX512){
+    convert_fc64_1_to_sc8_item32_1_avx512<uhd::htowx>(
+        reinterpret_cast<const fc64_t *>(inputs[0]),
+        reinterpret_cast<item32_t *>(outputs[0]),
+        nsamps, scale_factor, sc8_item32_le_lane_mask()
+    );
+}
@@ -0,0 +1,60 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_avx_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+
+using namespace uhd::convert;
+
+template <xtox_t to_host>
+UHD_CONVERT_TARGET_AVX512 UHD_INLINE void convert_item32_1_to_fc32_1_avx512(
+    const item32_t *input,
+    fc32_t *output,
+    const size_t nsamps,
+    const double scale_factor,
+    const __m128i lane_mask
+){
+    const __m512 scalar = _mm512_set1_ps(float(scale_factor));
+    const __m512i wire_mask = _mm512_broadcast_i32x4(lane_mask);
+
+    size_t i = 0;
+    for (; i+15 < nsamps; i+=16){
+        /* load from input, swap to host order */
+        __m512i tmpi = _mm512_loadu_si512(reinterpret_cast<const __m512i *>(input+i));
+        tmpi = _mm512_shuffle_epi8(tmpi, wire_mask);
+
+        /* sign extend to 32 bit */
+        __m512i tmpilo = _mm512_cvtepi16_epi32(_mm512_castsi512_si256(tmpi));
+        __m512i tmpihi = _mm512_cvtepi16_epi32(_mm512_extracti64x4_epi64(tmpi, 1));
+
+        /* convert and scale */
+        __m512 tmplo = _mm512_mul_ps(_mm512_cvtepi32_ps(tmpilo), scalar);
+        __m512 tmphi = _mm512_mul_ps(_mm512_cvtepi32_ps(tmpihi), scalar);
+
+        /* store to output */
+        _mm512_storeu_ps(reinterpret_cast<float *>(output+i+0), tmplo);
+        _mm512_storeu_ps(reinterpret_cast<float *>(output+i+8), tmphi);
+    }
+
+    // convert any remaining samples
+    item32_sc16_to_xx<to_host>(input+i, output+i, nsamps-i, scale_factor);
+}
+
+DECLARE_ISA_CONVERTER(sc16_item32_le, 1, fc32, 1, PRIORITY_SIMD_AVX512, AVX512){
+    convert_item32_1_to_fc32_1_avx512<uhd::wtohx>(
+        reinterpret_cast<const item32_t *>(inputs[0]),
+        reinterpret_cast<fc32_t *>(outputs[0]),
+        nsamps, scale_factor, sc16_item32_le_lane_mask()
+    );
+}
+
+DECLARE_ISA_CONVERTER(sc16_item32_be, 1, fc32, 1, PRIORITY_SIMD_AVX512, AVX512){
+    convert_item32_1_to_fc32_1_avx512<uhd::ntohx>(
+        reinterpret_cast<const item32_t *>(inputs[0]),
+        reinterpret_cast<fc32_t *>(outputs[0]),
+        nsamps, scale_factor, sc16_item32_be_lane_mask()
+    );
+}
@@ -0,0 +1,69 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_avx_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+
+using namespace uhd::convert;
+
+//! Convert and scale 16 32-bit integers (8 samples)
+UHD_CONVERT_TARGET_AVX512 UHD_INLINE void unpack_sc32_8x_avx512(
+    const __m512i &in, __m512d &out0, __m512d &out1, const __m512d &scalar
+){
+    out0 = _mm512_mul_pd(_mm512_cvtepi32_pd(_mm512_castsi512_si256(in)), scalar);
+    out1 = _mm512_mul_pd(_mm512_cvtepi32_pd(_mm512_extracti64x4_epi64(in, 1)), scalar);
+}
+
+template <xtox_t to_host>
+UHD_CONVERT_TARGET_AVX512 UHD_INLINE void convert_item32_1_to_fc64_1_avx512(
+    const item32_t *input,
+    fc64_t *output,
+    const size_t nsamps,
+    const double scale_factor,
+    const __m128i lane_mask
+){
+    const __m512d scalar = _mm512_set1_pd(scale_factor);
+    const __m512i wire_mask = _mm512_broadcast_i32x4(lane_mask);
+
+    size_t i = 0;
+    for (; i+15 < nsamps; i+=16){
+        /* load from input, swap to host order */
+        __m512i tmpi = _mm512_loadu_si512(reinterpret_cast<const __m512i *>(input+i));
+        tmpi = _mm512_shuffle_epi8(tmpi, wire_mask);
+
+        /* sign extend, convert and scale */
+        __m512d tmp0, tmp1, tmp2, tmp3;
+        unpack_sc32_8x_avx512(
+            _mm512_cvtepi16_epi32(_mm512_castsi512_si256(tmpi)), tmp0, tmp1, scalar);
+        unpack_sc32_8x_avx512(
+            _mm512_cvtepi16_epi32(_mm512_extracti64x4_epi64(tmpi, 1)), tmp2, tmp3, scalar);
+
+        /* store to output */
+        _mm512_storeu_pd(reinterpret_cast<double *>(output+i+0), tmp0);
+        _mm512_storeu_pd(reinterpret_cast<double *>(output+i+4), tmp1);
+        _mm512_storeu_pd(reinterpret_cast<double *>(output+i+8), tmp2);
+        _mm512_storeu_pd(reinterpret_cast<double *>(output+i+12), tmp3);
+    }
+
+    // convert any remaining samples
+    item32_sc16_to_xx<to_host>(input+i, output+i, nsamps-i, scale_factor);
+}
+
+DECLARE_ISA_CONVERTER(sc16_item32_le, 1, fc64, 1, PRIORITY_SIMD_AVX512, AVX512){
+    convert_item32_1_to_fc64_1_avx512<uhd::wtohx>(
+        reinterpret_cast<const item32_t *>(inputs[0]),
+        reinterpret_cast<fc64_t *>(outputs[0]),
+        nsamps, scale_factor, sc16_item32_le_lane_mask()
+    );
+}
+
+DECLARE_ISA_CONVERTER(sc16_item32_be, 1, fc64, 1, PRIORITY_SIMD_AVX512, AVX512){
+    convert_item32_1_to_fc64_1_avx512<uhd::ntohx>(
+        reinterpret_cast<const item32_t *>(inputs[0]),
+        reinterpret_cast<fc64_t *>(outputs[0]),
+        nsamps, scale_factor, sc16_item32_be_lane_mask()
+    );
+}
@@ -0,0 +1,69 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_avx_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+
+using namespace uhd::convert;
+
+//! Sign extend, convert and scale 16 bytes (8 samples)
+UHD_CONVERT_TARGET_AVX512 UHD_INLINE void unpack_sc8_8x_avx512(
+    const __m128i &in, fc32_t *output, const __m512 &scalar
+){
+    const __m512 tmp = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(in)), scalar);
+    _mm512_storeu_ps(reinterpret_cast<float *>(output), tmp);
+}
+
+template <xtox_t to_host>
+UHD_CONVERT_TARGET_AVX512 UHD_INLINE void convert_sc8_item32_1_to_fc32_1_avx512(
+    const void *input_addr,
+    fc32_t *output,
+    const size_t nsamps,
+    const double scale_factor,
+    const __m128i lane_mask
+){
+    const item32_t *input = reinterpret_cast<const item32_t *>(size_t(input_addr) & ~0x3);
+
+    const __m512 scalar = _mm512_set1_ps(float(scale_factor));
+    const __m512i wire_mask = _mm512_broadcast_i32x4(lane_mask);
+
+    size_t i = 0, j = 0;
+    size_t num_samps = nsamps;
+
+    if ((size_t(input_addr) & 0x3) != 0){
+        item32_sc8_to_xx<to_host>(input++, output++, 1, scale_factor);
+        num_samps--;
+    }
+
+    for (; j+31 < num_samps; j+=32, i+=16){
+        /* load from input, swap to host order */
+        __m512i tmpi = _mm512_loadu_si512(reinterpret_cast<const __m512i *>(input+i));
+        tmpi = _mm512_shuffle_epi8(tmpi, wire_mask);
+
+        /* unpack and store to output */
+        unpack_sc8_8x_avx512(_mm512_extracti32x4_epi32(tmpi, 0), output+j+0, scalar);
+        unpack_sc8_8x_avx512(_mm512_extracti32x4_epi32(tmpi, 1), output+j+8, scalar);
+        unpack_sc8_8x_avx512(_mm512_extracti32x4_epi32(tmpi, 2), output+j+16, scalar);
+        unpack_sc8_8x_avx512(_mm512_extracti32x4_epi32(tmpi, 3), output+j+24, scalar);
+    }
+
+    //convert remainder
+    item32_sc8_to_xx<to_host>(input+i, output+j, num_samps-j, scale_factor);
+}
+
+DECLARE_ISA_CONVERTER(sc8_item32_be, 1, fc32, 1, PRIORITY_SIMD_AVX512, AVX512){
+    convert_sc8_item32_1_to_fc32_1_avx512<uhd::ntohx>(
+        inputs[0], reinterpret_cast<fc32_t *>(outputs[0]),
+        nsamps, scale_factor, sc8_item32_be_lane_mask()
+    );
+}
+
+DECLARE_ISA_CONVERTER(sc8_item32_le, 1, fc32, 1, PRIORITY_SIMD_AVX512, AVX512){
+    convert_sc8_item32_1_to_fc32_1_avx512<uhd::wtohx>(
+        inputs[0], reinterpret_cast<fc32_t *>(outputs[0]),
+        nsamps, scale_factor, sc8_item32_le_lane_mask()
+    );
+}
@@ -0,0 +1,54 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_LIBUHD_CONVERT_AVX_COMMON_HPP
+#define INCLUDED_LIBUHD_CONVERT_AVX_COMMON_HPP
+
+#include "convert_common.hpp"
+// GCC 12 before 12.3 warns about the _mm512_undefined_*() pass-through
+// operands of its own AVX512 intrinsics when they are inlined (GCC bug
+// 105593). The warnings point into the header, so silence them there.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ == 12
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wuninitialized"
+#    pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include <immintrin.h>
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ == 12
+#    pragma GCC diagnostic pop
+#endif
+
+/***********************************************************************
+ * Byte shuffle masks between host and wire order
+ *
+ * The AVX2 and AVX512 converters first bring the samples into host order
+ * (real, imag, real, imag, ...) and then swap them into wire order with a
+ * single byte shuffle. The shuffles operate within 128-bit lanes, so the
+ * masks below are broadcast to the full vector width. Every mask is its
+ * own inverse, so the same mask also converts from wire to host order.
+ **********************************************************************/
+
+//! sc16_item32_le: swap the 16-bit real and imag parts of every item
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE __m128i sc16_item32_le_lane_mask(void){
+    return _mm_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+}
+
+//! sc16_item32_be: byteswap every 16-bit word
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE __m128i sc16_item32_be_lane_mask(void){
+    return _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+}
+
+//! sc8_item32_le: reverse the four bytes (two samples) of every item
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE __m128i sc8_item32_le_lane_mask(void){
+    return _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+}
+
+//! sc8_item32_be: the wire order is the host order
+UHD_CONVERT_TARGET_AVX2 UHD_INLINE __m128i sc8_item32_be_lane_mask(void){
+    return _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+}
+
+#endif /* INCLUDED_LIBUHD_CONVERT_AVX_COMMON_HPP */
@@ -32,6 +32,49 @@
         const input_type &inputs, const output_type &outputs, const size_t nsamps \
     )
 
+#define _DECLARE_ISA_CONVERTER(name, in_form, num_in, out_form, num_out, prio, isa) \
+    struct name : public uhd::convert::converter{ \
+        static sptr make(void){return sptr(new name());} \
+        double scale_factor; \
+        void set_scalar(const double s){scale_factor = s;} \
+        UHD_CONVERT_TARGET_##isa \
+        void operator()(const input_type&, const output_type&, const size_t); \
+    }; \
+    UHD_STATIC_BLOCK(__register_##name##_##prio){ \
+        if (not cpu_has_##isa()) return; \
+        uhd::convert::id_type id; \
+        id.input_format = #in_form; \
+        id.num_inputs = num_in; \
+        id.output_format = #out_form; \
+        id.num_outputs = num_out; \
+        uhd::convert::register_converter(id, &name::make, prio); \
+    } \
+    UHD_CONVERT_TARGET_##isa \
+    void name::operator()( \
+        const input_type &inputs, const output_type &outputs, const size_t nsamps \
+    )
+
+#define _DECLARE_IQ_DC_CONVERTER(name, in_form, num_in, out_form, num_out, prio) \
+    struct name : public uhd::convert::converter{ \
+        static sptr make(void){return sptr(new name());} \
+        double scale_factor; \
+        uhd::convert::iq_dc_correction_t correction; \
+        void set_scalar(const double s){scale_factor = s;} \
+        void set_iq_dc_correction(const uhd::convert::iq_dc_correction_t &c){correction = c;} \
+        void operator()(const input_type&, const output_type&, const size_t); \
+    }; \
+    UHD_STATIC_BLOCK(__register_##name##_##prio){ \
+        uhd::convert::id_type id; \
+        id.input_format = #in_form; \
+        id.num_inputs = num_in; \
+        id.output_format = #out_form; \
+        id.num_outputs = num_out; \
+        uhd::convert::register_converter(id, &name::make, prio); \
+    } \
+    void name::operator()( \
+        const input_type &inputs, const output_type &outputs, const size_t nsamps \
+    )
+
 /*! Convenience macro to declare a single-function converter
  *
  * Most converters consist of a single for loop, and can make use of
@@ -48,6 +91,79 @@
 #define DECLARE_CONVERTER(in_form, num_in, out_form, num_out, prio) \
     _DECLARE_CONVERTER(__convert_##in_form##_##num_in##_##out_form##_##num_out##_##prio, in_form, num_in, out_form, num_out, prio)
 
+/*! Declare a converter that requires an instruction set extension
+ *
+ * Works like DECLARE_CONVERTER(), but the conversion function is compiled
+ * for the given instruction set (AVX2 or AVX512) only, and the converter is
+ * only registered if the CPU we're running on supports it. This way, a
+ * single build of the library picks the widest kernel available on the host.
+ * Helper functions called from the conversion function must be declared
+ * with the matching UHD_CONVERT_TARGET_* attribute.
+ */
+#define DECLARE_ISA_CONVERTER(in_form, num_in, out_form, num_out, prio, isa) \
+    _DECLARE_ISA_CONVERTER(__convert_##in_form##_##num_in##_##out_form##_##num_out##_##prio, in_form, num_in, out_form, num_out, prio, isa)
+
+/*! Declare a converter that also corrects IQ imbalance and DC offset
+ *
+ * Works like DECLARE_CONVERTER(), but the host format is expected to carry
+ * the _iqdc suffix (see uhd::convert::IQ_DC_FORMAT_SUFFIX), and the function
+ * block can also use `correction`, the uhd::convert::iq_dc_correction_t that
+ * was last set on the converter.
+ */
+#define DECLARE_IQ_DC_CONVERTER(in_form, num_in, out_form, num_out, prio) \
+    _DECLARE_IQ_DC_CONVERTER(__convert_##in_form##_##num_in##_##out_form##_##num_out##_##prio, in_form, num_in, out_form, num_out, prio)
+
+/***********************************************************************
+ * Runtime CPU feature detection
+ **********************************************************************/
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define UHD_CONVERT_TARGET_AVX2   __attribute__((target("avx2")))
+#define UHD_CONVERT_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+
+//! True if the CPU and the OS support AVX2
+static UHD_INLINE bool cpu_has_AVX2(void){
+    // This may run from a static constructor, before libgcc has
+    // initialized its CPU model
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+//! True if the CPU and the OS support AVX512F and AVX512BW
+static UHD_INLINE bool cpu_has_AVX512(void){
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f") and __builtin_cpu_supports("avx512bw");
+}
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define UHD_CONVERT_TARGET_AVX2
+#define UHD_CONVERT_TARGET_AVX512
+
+static UHD_INLINE bool _cpu_os_saves_xstate(const unsigned long long mask){
+    int regs[4];
+    __cpuid(regs, 1);
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    return osxsave and ((_xgetbv(0) & mask) == mask);
+}
+
+static UHD_INLINE bool cpu_has_AVX2(void){
+    int regs[4];
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0 and _cpu_os_saves_xstate(0x6);
+}
+
+static UHD_INLINE bool cpu_has_AVX512(void){
+    int regs[4];
+    __cpuidex(regs, 7, 0);
+    const bool f_bw = (regs[1] & (1 << 16)) != 0 and (regs[1] & (1 << 30)) != 0;
+    return f_bw and _cpu_os_saves_xstate(0xe6);
+}
+#else
+#define UHD_CONVERT_TARGET_AVX2
+#define UHD_CONVERT_TARGET_AVX512
+static UHD_INLINE bool cpu_has_AVX2(void){ return false; }
+static UHD_INLINE bool cpu_has_AVX512(void){ return false; }
+#endif
+
 /***********************************************************************
  * Setup priorities
  **********************************************************************/
@@ -62,6 +178,9 @@ static const int PRIORITY_TABLE = 1; //tables require large cache, so they are s
 static const int PRIORITY_SIMD = 3;
 static const int PRIORITY_TABLE = 1;
 #endif
+// Wider vector extensions, only registered when the CPU supports them
+static const int PRIORITY_SIMD_AVX2 = PRIORITY_SIMD + 1;
+static const int PRIORITY_SIMD_AVX512 = PRIORITY_SIMD + 2;
 
 /***********************************************************************
  * Typedefs
@@ -279,4 +398,45 @@ UHD_INLINE void item32_sc8_to_xx(
     }
 }
 
+/***********************************************************************
+ * IQ imbalance and DC offset correction, see uhd::convert::iq_dc_correction_t
+ **********************************************************************/
+template <xtox_t to_host>
+UHD_INLINE void item32_sc16_to_fc32_iq_dc(
+    const item32_t *input,
+    fc32_t *output,
+    const size_t nsamps,
+    const double scale_factor,
+    const uhd::convert::iq_dc_correction_t &correction
+){
+    const float ii = float(correction.ii), iq = float(correction.iq);
+    const float qi = float(correction.qi), qq = float(correction.qq);
+    const float dc_i = float(correction.dc_offset.real());
+    const float dc_q = float(correction.dc_offset.imag());
+    for (size_t i = 0; i < nsamps; i++){
+        const fc32_t x = item32_sc16_x1_to_xx<float>(to_host(input[i]), scale_factor);
+        const float x_i = x.real() - dc_i, x_q = x.imag() - dc_q;
+        output[i] = fc32_t(ii*x_i + iq*x_q, qi*x_i + qq*x_q);
+    }
+}
+
+template <xtox_t to_wire>
+UHD_INLINE void fc32_iq_dc_to_item32_sc16(
+    const fc32_t *input,
+    item32_t *output,
+    const size_t nsamps,
+    const double scale_factor,
+    const uhd::convert::iq_dc_correction_t &correction
+){
+    const float ii = float(correction.ii), iq = float(correction.iq);
+    const float qi = float(correction.qi), qq = float(correction.qq);
+    const float dc_i = float(correction.dc_offset.real());
+    const float dc_q = float(correction.dc_offset.imag());
+    for (size_t i = 0; i < nsamps; i++){
+        const float x_i = input[i].real(), x_q = input[i].imag();
+        const fc32_t y(ii*x_i + iq*x_q + dc_i, qi*x_i + qq*x_q + dc_q);
+        output[i] = to_wire(xx_to_item32_sc16_x1(y, scale_factor));
+    }
+}
+
 #endif /* INCLUDED_LIBUHD_CONVERT_COMMON_HPP */
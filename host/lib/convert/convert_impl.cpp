@@ -29,6 +29,15 @@ bool convert::operator==(const convert::id_type &lhs, const convert::id_type &rh
     ;
 }
 
+size_t convert::hash_value(const convert::id_type &id){
+    size_t seed = 0;
+    boost::hash_combine(seed, id.input_format);
+    boost::hash_combine(seed, id.num_inputs);
+    boost::hash_combine(seed, id.output_format);
+    boost::hash_combine(seed, id.num_outputs);
+    return seed;
+}
+
 std::string convert::id_type::to_pp_string(void) const{
     return str(boost::format(
         "conversion ID\n"
@@ -81,19 +90,21 @@ convert::function_type convert::get_converter(
     const id_type &id,
     const priority_type prio
 ){
-    if (not get_table().has_key(id)) throw uhd::key_error(
+    fcn_table_type &table = get_table();
+    if (not table.has_key(id)) throw uhd::key_error(
         "Cannot find a conversion routine for " + id.to_pp_string());
+    const uhd::dict<priority_type, function_type> &prio_table = table[id];
 
     //find a matching priority
     priority_type best_prio = -1;
-    for(priority_type prio_i:  get_table()[id].keys()){
+    for(priority_type prio_i:  prio_table.keys()){
         if (prio_i == prio) {
             //----------------------------------------------------------------//
             UHD_LOGGER_DEBUG("CONVERT") << "get_converter: For converter ID: " << id.to_pp_string()
                                         << " Using prio: " << prio;
             ;
             //----------------------------------------------------------------//
-            return get_table()[id][prio];
+            return prio_table[prio];
         }
         best_prio = std::max(best_prio, prio_i);
     }
@@ -108,7 +119,7 @@ convert::function_type convert::get_converter(
     //----------------------------------------------------------------//
 
     //otherwise, return best prio
-    return get_table()[id][best_prio];
+    return prio_table[best_prio];
 }
 
 /***********************************************************************
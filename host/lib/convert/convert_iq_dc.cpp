@@ -0,0 +1,41 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+
+using namespace uhd::convert;
+
+/***********************************************************************
+ * Generic converters that correct IQ imbalance and DC offset on the fly
+ **********************************************************************/
+DECLARE_IQ_DC_CONVERTER(sc16_item32_le, 1, fc32_iqdc, 1, PRIORITY_GENERAL){
+    const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
+    fc32_t *output = reinterpret_cast<fc32_t *>(outputs[0]);
+
+    item32_sc16_to_fc32_iq_dc<uhd::wtohx>(input, output, nsamps, scale_factor, correction);
+}
+
+DECLARE_IQ_DC_CONVERTER(sc16_item32_be, 1, fc32_iqdc, 1, PRIORITY_GENERAL){
+    const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
+    fc32_t *output = reinterpret_cast<fc32_t *>(outputs[0]);
+
+    item32_sc16_to_fc32_iq_dc<uhd::ntohx>(input, output, nsamps, scale_factor, correction);
+}
+
+DECLARE_IQ_DC_CONVERTER(fc32_iqdc, 1, sc16_item32_le, 1, PRIORITY_GENERAL){
+    const fc32_t *input = reinterpret_cast<const fc32_t *>(inputs[0]);
+    item32_t *output = reinterpret_cast<item32_t *>(outputs[0]);
+
+    fc32_iq_dc_to_item32_sc16<uhd::htowx>(input, output, nsamps, scale_factor, correction);
+}
+
+DECLARE_IQ_DC_CONVERTER(fc32_iqdc, 1, sc16_item32_be, 1, PRIORITY_GENERAL){
+    const fc32_t *input = reinterpret_cast<const fc32_t *>(inputs[0]);
+    item32_t *output = reinterpret_cast<item32_t *>(outputs[0]);
+
+    fc32_iq_dc_to_item32_sc16<uhd::htonx>(input, output, nsamps, scale_factor, correction);
+}
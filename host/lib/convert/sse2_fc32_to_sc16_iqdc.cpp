@@ -0,0 +1,127 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <emmintrin.h>
+
+using namespace uhd::convert;
+
+/*!
+ * Apply the IQ matrix to two (I, Q) samples at once:
+ * out = x*(ii, qq, ii, qq) + (Q, I, Q, I)*(iq, qi, iq, qi) + offset
+ */
+static UHD_INLINE __m128 iq_dc_correct(
+    const __m128 x, const __m128 diag, const __m128 cross, const __m128 offset
+){
+    const __m128 x_swapped = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, diag), _mm_mul_ps(x_swapped, cross)), offset);
+}
+
+/*!
+ * The scaling is folded into the matrix and the DC offset, so
+ * y = s*M*x + s*dc
+ */
+#define setup_iq_dc_correction_tx                                       \
+    const float s = float(scale_factor);                                \
+    const float ii = float(correction.ii), iq = float(correction.iq);   \
+    const float qi = float(correction.qi), qq = float(correction.qq);   \
+    const float dc_i = float(correction.dc_offset.real());              \
+    const float dc_q = float(correction.dc_offset.imag());              \
+    const __m128 diag = _mm_set_ps(qq*s, ii*s, qq*s, ii*s);             \
+    const __m128 cross = _mm_set_ps(qi*s, iq*s, qi*s, iq*s);            \
+    const __m128 offset = _mm_set_ps(dc_q*s, dc_i*s, dc_q*s, dc_i*s);
+
+DECLARE_IQ_DC_CONVERTER(fc32_iqdc, 1, sc16_item32_le, 1, PRIORITY_SIMD){
+    const fc32_t *input = reinterpret_cast<const fc32_t *>(inputs[0]);
+    item32_t *output = reinterpret_cast<item32_t *>(outputs[0]);
+
+    setup_iq_dc_correction_tx
+
+    // this macro corrects and converts 4 values at a time, like in sse2_fc32_to_sc16.cpp
+    #define convert_fc32_iqdc_1_to_item32_1_nswap_guts(_al_)           \
+    for (; i+3 < nsamps; i+=4){                                         \
+        /* load from input */                                           \
+        __m128 tmplo = _mm_load ## _al_ ## ps(reinterpret_cast<const float *>(input+i+0)); \
+        __m128 tmphi = _mm_load ## _al_ ## ps(reinterpret_cast<const float *>(input+i+2)); \
+                                                                        \
+        /* correct, scale and convert */                                \
+        __m128i tmpilo = _mm_cvtps_epi32(iq_dc_correct(tmplo, diag, cross, offset)); \
+        __m128i tmpihi = _mm_cvtps_epi32(iq_dc_correct(tmphi, diag, cross, offset)); \
+                                                                        \
+        /* pack + swap 16-bit pairs */                                  \
+        __m128i tmpi = _mm_packs_epi32(tmpilo, tmpihi);                 \
+        tmpi = _mm_shufflelo_epi16(tmpi, _MM_SHUFFLE(2, 3, 0, 1));      \
+        tmpi = _mm_shufflehi_epi16(tmpi, _MM_SHUFFLE(2, 3, 0, 1));      \
+                                                                        \
+        /* store to output */                                           \
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(output+i), tmpi);  \
+    }                                                                   \
+
+    size_t i = 0;
+
+    // need to dispatch according to alignment for fastest conversion
+    switch (size_t(input) & 0xf){
+    case 0x0:
+        convert_fc32_iqdc_1_to_item32_1_nswap_guts(_)
+        break;
+    case 0x8:
+        fc32_iq_dc_to_item32_sc16<uhd::htowx>(input, output, 1, scale_factor, correction);
+        i++;
+        convert_fc32_iqdc_1_to_item32_1_nswap_guts(_)
+        break;
+    default:
+        convert_fc32_iqdc_1_to_item32_1_nswap_guts(u_)
+    }
+
+    // convert any remaining samples
+    fc32_iq_dc_to_item32_sc16<uhd::htowx>(input+i, output+i, nsamps-i, scale_factor, correction);
+}
+
+DECLARE_IQ_DC_CONVERTER(fc32_iqdc, 1, sc16_item32_be, 1, PRIORITY_SIMD){
+    const fc32_t *input = reinterpret_cast<const fc32_t *>(inputs[0]);
+    item32_t *output = reinterpret_cast<item32_t *>(outputs[0]);
+
+    setup_iq_dc_correction_tx
+
+    // this macro corrects and converts 4 values at a time, like in sse2_fc32_to_sc16.cpp
+    #define convert_fc32_iqdc_1_to_item32_1_bswap_guts(_al_)           \
+    for (; i+3 < nsamps; i+=4){                                         \
+        /* load from input */                                           \
+        __m128 tmplo = _mm_load ## _al_ ## ps(reinterpret_cast<const float *>(input+i+0)); \
+        __m128 tmphi = _mm_load ## _al_ ## ps(reinterpret_cast<const float *>(input+i+2)); \
+                                                                        \
+        /* correct, scale and convert */                                \
+        __m128i tmpilo = _mm_cvtps_epi32(iq_dc_correct(tmplo, diag, cross, offset)); \
+        __m128i tmpihi = _mm_cvtps_epi32(iq_dc_correct(tmphi, diag, cross, offset)); \
+                                                                        \
+        /* pack + byteswap -> byteswap 16 bit words */                  \
+        __m128i tmpi = _mm_packs_epi32(tmpilo, tmpihi);                 \
+        tmpi = _mm_or_si128(_mm_srli_epi16(tmpi, 8), _mm_slli_epi16(tmpi, 8)); \
+                                                                        \
+        /* store to output */                                           \
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(output+i), tmpi);  \
+    }                                                                   \
+
+    size_t i = 0;
+
+    // need to dispatch according to alignment for fastest conversion
+    switch (size_t(input) & 0xf){
+    case 0x0:
+        convert_fc32_iqdc_1_to_item32_1_bswap_guts(_)
+        break;
+    case 0x8:
+        fc32_iq_dc_to_item32_sc16<uhd::htonx>(input, output, 1, scale_factor, correction);
+        i++;
+        convert_fc32_iqdc_1_to_item32_1_bswap_guts(_)
+        break;
+    default:
+        convert_fc32_iqdc_1_to_item32_1_bswap_guts(u_)
+    }
+
+    // convert any remaining samples
+    fc32_iq_dc_to_item32_sc16<uhd::htonx>(input+i, output+i, nsamps-i, scale_factor, correction);
+}
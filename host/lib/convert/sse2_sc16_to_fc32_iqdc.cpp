@@ -0,0 +1,132 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <emmintrin.h>
+
+using namespace uhd::convert;
+
+/*!
+ * Apply the IQ matrix to two (I, Q) samples at once:
+ * out = x*(ii, qq, ii, qq) + (Q, I, Q, I)*(iq, qi, iq, qi) + offset
+ */
+static UHD_INLINE __m128 iq_dc_correct(
+    const __m128 x, const __m128 diag, const __m128 cross, const __m128 offset
+){
+    const __m128 x_swapped = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, diag), _mm_mul_ps(x_swapped, cross)), offset);
+}
+
+/*!
+ * The scaling is folded into the matrix, and the DC offset is subtracted
+ * before the matrix is applied, so y = s*M*x - M*dc
+ */
+#define setup_iq_dc_correction_rx                                       \
+    const float s = float(scale_factor)/(1 << 16);                      \
+    const float ii = float(correction.ii), iq = float(correction.iq);   \
+    const float qi = float(correction.qi), qq = float(correction.qq);   \
+    const float dc_i = float(correction.dc_offset.real());              \
+    const float dc_q = float(correction.dc_offset.imag());              \
+    const __m128 diag = _mm_set_ps(qq*s, ii*s, qq*s, ii*s);             \
+    const __m128 cross = _mm_set_ps(qi*s, iq*s, qi*s, iq*s);            \
+    const __m128 offset = _mm_set_ps(                                   \
+        -(qi*dc_i + qq*dc_q), -(ii*dc_i + iq*dc_q),                     \
+        -(qi*dc_i + qq*dc_q), -(ii*dc_i + iq*dc_q));                    \
+    const __m128i zeroi = _mm_setzero_si128();
+
+DECLARE_IQ_DC_CONVERTER(sc16_item32_le, 1, fc32_iqdc, 1, PRIORITY_SIMD){
+    const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
+    fc32_t *output = reinterpret_cast<fc32_t *>(outputs[0]);
+
+    setup_iq_dc_correction_rx
+
+    // this macro converts and corrects 4 values at a time, like in sse2_sc16_to_fc32.cpp
+    #define convert_item32_1_to_fc32_iqdc_1_nswap_guts(_al_)           \
+    for (; i+3 < nsamps; i+=4){                                         \
+        /* load from input */                                           \
+        __m128i tmpi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input+i)); \
+                                                                        \
+        /* unpack + swap 16-bit pairs */                                \
+        tmpi = _mm_shufflelo_epi16(tmpi, _MM_SHUFFLE(2, 3, 0, 1));      \
+        tmpi = _mm_shufflehi_epi16(tmpi, _MM_SHUFFLE(2, 3, 0, 1));      \
+        __m128i tmpilo = _mm_unpacklo_epi16(zeroi, tmpi); /* value in upper 16 bits */ \
+        __m128i tmpihi = _mm_unpackhi_epi16(zeroi, tmpi);               \
+                                                                        \
+        /* convert, scale and correct */                                \
+        __m128 tmplo = iq_dc_correct(_mm_cvtepi32_ps(tmpilo), diag, cross, offset); \
+        __m128 tmphi = iq_dc_correct(_mm_cvtepi32_ps(tmpihi), diag, cross, offset); \
+                                                                        \
+        /* store to output */                                           \
+        _mm_store ## _al_ ## ps(reinterpret_cast<float *>(output+i+0), tmplo); \
+        _mm_store ## _al_ ## ps(reinterpret_cast<float *>(output+i+2), tmphi); \
+    }                                                                   \
+
+    size_t i = 0;
+
+    // need to dispatch according to alignment for fastest conversion
+    switch (size_t(output) & 0xf){
+    case 0x0:
+        convert_item32_1_to_fc32_iqdc_1_nswap_guts(_)
+        break;
+    case 0x8:
+        item32_sc16_to_fc32_iq_dc<uhd::wtohx>(input, output, 1, scale_factor, correction);
+        i++;
+        convert_item32_1_to_fc32_iqdc_1_nswap_guts(_)
+        break;
+    default:
+        convert_item32_1_to_fc32_iqdc_1_nswap_guts(u_)
+    }
+
+    // convert any remaining samples
+    item32_sc16_to_fc32_iq_dc<uhd::wtohx>(input+i, output+i, nsamps-i, scale_factor, correction);
+}
+
+DECLARE_IQ_DC_CONVERTER(sc16_item32_be, 1, fc32_iqdc, 1, PRIORITY_SIMD){
+    const item32_t *input = reinterpret_cast<const item32_t *>(inputs[0]);
+    fc32_t *output = reinterpret_cast<fc32_t *>(outputs[0]);
+
+    setup_iq_dc_correction_rx
+
+    // this macro converts and corrects 4 values at a time, like in sse2_sc16_to_fc32.cpp
+    #define convert_item32_1_to_fc32_iqdc_1_bswap_guts(_al_)           \
+    for (; i+3 < nsamps; i+=4){                                         \
+        /* load from input */                                           \
+        __m128i tmpi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input+i)); \
+                                                                        \
+        /* byteswap + unpack -> byteswap 16 bit words */                \
+        tmpi = _mm_or_si128(_mm_srli_epi16(tmpi, 8), _mm_slli_epi16(tmpi, 8)); \
+        __m128i tmpilo = _mm_unpacklo_epi16(zeroi, tmpi); /* value in upper 16 bits */ \
+        __m128i tmpihi = _mm_unpackhi_epi16(zeroi, tmpi);               \
+                                                                        \
+        /* convert, scale and correct */                                \
+        __m128 tmplo = iq_dc_correct(_mm_cvtepi32_ps(tmpilo), diag, cross, offset); \
+        __m128 tmphi = iq_dc_correct(_mm_cvtepi32_ps(tmpihi), diag, cross, offset); \
+                                                                        \
+        /* store to output */                                           \
+        _mm_store ## _al_ ## ps(reinterpret_cast<float *>(output+i+0), tmplo); \
+        _mm_store ## _al_ ## ps(reinterpret_cast<float *>(output+i+2), tmphi); \
+    }                                                                   \
+
+    size_t i = 0;
+
+    // need to dispatch according to alignment for fastest conversion
+    switch (size_t(output) & 0xf){
+    case 0x0:
+        convert_item32_1_to_fc32_iqdc_1_bswap_guts(_)
+        break;
+    case 0x8:
+        item32_sc16_to_fc32_iq_dc<uhd::ntohx>(input, output, 1, scale_factor, correction);
+        i++;
+        convert_item32_1_to_fc32_iqdc_1_bswap_guts(_)
+        break;
+    default:
+        convert_item32_1_to_fc32_iqdc_1_bswap_guts(u_)
+    }
+
+    // convert any remaining samples
+    item32_sc16_to_fc32_iq_dc<uhd::ntohx>(input+i, output+i, nsamps-i, scale_factor, correction);
+}
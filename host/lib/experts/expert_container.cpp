@@ -19,6 +19,8 @@
 #include <boost/graph/depth_first_search.hpp>
 #include <boost/graph/topological_sort.hpp>
 #include <boost/graph/adjacency_list.hpp>
+#include <algorithm>
+#include <iterator>
 
 #ifdef UHD_EXPERT_LOGGING
 #define EX_LOG(depth, str) _log(depth, str)
@@ -39,10 +41,11 @@ typedef boost::adjacency_list<
 > expert_graph_t;
 
 typedef std::map<std::string, expert_graph_t::vertex_descriptor> vertex_map_t;
-typedef std::list<expert_graph_t::vertex_descriptor>             node_queue_t;
+typedef std::vector<expert_graph_t::vertex_descriptor>           node_queue_t;
 
 typedef boost::graph_traits<expert_graph_t>::edge_iterator       edge_iter;
 typedef boost::graph_traits<expert_graph_t>::vertex_iterator     vertex_iter;
+typedef boost::graph_traits<expert_graph_t>::out_edge_iterator   out_edge_iter;
 
 class expert_container_impl : public expert_container
 {
@@ -62,7 +65,7 @@ private:    //Visitor class for cycle detection algorithm
 
 public:
     expert_container_impl(const std::string& name):
-        _name(name)
+        _name(name), _sorted_nodes_valid(false)
     {
     }
 
@@ -85,14 +88,14 @@ public:
         _resolve_helper("", "", force);
     }
 
-    void resolve_from(const std::string&)
+    void resolve_from(const std::string& node_name)
     {
         boost::lock_guard<boost::recursive_mutex> resolve_lock(_resolve_mutex);
         boost::lock_guard<boost::mutex> lock(_mutex);
-        EX_LOG(0, "resolve_from (overridden to resolve_all)");
-        // Do a full resolve of the graph
-        // Not optimizing the traversal using node_name to reduce experts complexity
-        _resolve_helper("", "", false);
+        EX_LOG(0, str(boost::format("resolve_from(%s)") % node_name));
+        // node_name is dirty, so it is one of the nodes to start from
+        _lookup_vertex(node_name);
+        _resolve_dirty();
     }
 
     void resolve_to(const std::string&)
@@ -293,6 +296,7 @@ protected:
         try {
             //Add a vertex in this graph for the data node
             expert_graph_t::vertex_descriptor gr_node = boost::add_vertex(data_node, _expert_dag);
+            _sorted_nodes_valid = false;
             EX_LOG(1, str(boost::format("added vertex %s") % data_node->get_name()));
             _datanode_map.insert(vertex_map_t::value_type(data_node->get_name(), gr_node));
 
@@ -332,6 +336,7 @@ protected:
         try {
             //Add a vertex in this graph for the worker node
             expert_graph_t::vertex_descriptor gr_node = boost::add_vertex(worker, _expert_dag);
+            _sorted_nodes_valid = false;
             EX_LOG(1, str(boost::format("added vertex %s") % worker->get_name()));
             _worker_map.insert(vertex_map_t::value_type(worker->get_name(), gr_node));
 
@@ -396,16 +401,22 @@ protected:
         // Release all nodes in the map
         _worker_map.clear();
         _datanode_map.clear();
+        _sorted_nodes.clear();
+        _sorted_nodes_valid = false;
     }
 
 private:
-    void _resolve_helper(std::string start, std::string stop, bool force)
+    //Sort the graph topologically. This ensures that for all dependencies, the dependant
+    //is always after all of its dependencies. The order only changes when nodes are
+    //added or removed, so it is cached until then.
+    const node_queue_t& _get_sorted_nodes()
     {
-        //Sort the graph topologically. This ensures that for all dependencies, the dependant
-        //is always after all of its dependencies.
-        node_queue_t sorted_nodes;
+        if (_sorted_nodes_valid) {
+            return _sorted_nodes;
+        }
+        _sorted_nodes.clear();
         try {
-            boost::topological_sort(_expert_dag, std::front_inserter(sorted_nodes));
+            boost::topological_sort(_expert_dag, std::back_inserter(_sorted_nodes));
         } catch (boost::not_a_dag&) {
             std::vector<std::string> back_edges;
             cycle_det_visitor cdet_vis(back_edges);
@@ -419,6 +430,18 @@ private:
                                          "The following back-edges were found:" + edges);
             }
         }
+        std::reverse(_sorted_nodes.begin(), _sorted_nodes.end());
+        _sorted_index.resize(boost::num_vertices(_expert_dag));
+        for (size_t i = 0; i < _sorted_nodes.size(); i++) {
+            _sorted_index[_sorted_nodes[i]] = i;
+        }
+        _sorted_nodes_valid = true;
+        return _sorted_nodes;
+    }
+
+    void _resolve_helper(std::string start, std::string stop, bool force)
+    {
+        const node_queue_t& sorted_nodes = _get_sorted_nodes();
         if (sorted_nodes.empty()) return;
 
         //Determine the start and stop node. If one is not explicitly specified then
@@ -431,7 +454,7 @@ private:
         //First Pass: Resolve all nodes if they are dirty, in a topological order
         std::list<dag_vertex_t*> resolved_workers;
         bool start_node_encountered = false;
-        for (node_queue_t::iterator node_iter = sorted_nodes.begin();
+        for (node_queue_t::const_iterator node_iter = sorted_nodes.begin();
              node_iter != sorted_nodes.end();
              ++node_iter
         ) {
@@ -470,6 +493,60 @@ private:
         }
     }
 
+    void _resolve_dirty()
+    {
+        const node_queue_t& sorted_nodes = _get_sorted_nodes();
+        if (sorted_nodes.empty()) return;
+
+        //Start from all dirty data nodes, not just the one that was written: a
+        //worker marks all of its inputs clean, so the other readers of a dirty
+        //input must resolve in the same pass.
+        _reached.assign(sorted_nodes.size(), false);
+        size_t first = sorted_nodes.size();
+        for (const vertex_map_t::value_type& v : _datanode_map) {
+            if (_get_vertex(v.second).is_dirty()) {
+                _reached[v.second] = true;
+                first = std::min(first, _sorted_index[v.second]);
+            }
+        }
+
+        //Walk the topological order, but only visit nodes that a resolved node
+        //feeds into. A clean node can't dirty anything downstream, so the
+        //workers outside of the dirty part of the graph are never touched.
+        std::list<dag_vertex_t*> resolved_workers;
+        for (size_t i = first; i < sorted_nodes.size(); i++) {
+            const expert_graph_t::vertex_descriptor vertex = sorted_nodes[i];
+            if (not _reached[vertex]) continue;
+
+            dag_vertex_t& node = _get_vertex(vertex);
+            if (not node.is_dirty()) {
+                EX_LOG(1, str(boost::format("skipped node %s (clean) [%s]") %
+                                node.get_name() % node.to_string()));
+                continue;
+            }
+            node.resolve();
+            if (node.get_class() == CLASS_WORKER) {
+                resolved_workers.push_back(&node);
+            }
+            EX_LOG(1, str(boost::format("resolved node %s (%s) [%s]") %
+                            node.get_name() % (node.is_dirty()?"dirty":"clean") % node.to_string()));
+            for (std::pair<out_edge_iter, out_edge_iter> ei = boost::out_edges(vertex, _expert_dag);
+                 ei.first != ei.second;
+                 ++ei.first
+            ) {
+                _reached[boost::target(*ei.first, _expert_dag)] = true;
+            }
+        }
+
+        //Mark the workers clean, see _resolve_helper()
+        for (std::list<dag_vertex_t*>::iterator worker = resolved_workers.begin();
+             worker != resolved_workers.end();
+             ++worker
+        ) {
+            (*worker)->mark_clean();
+        }
+    }
+
     expert_graph_t::vertex_descriptor _lookup_vertex(const std::string& name) const
     {
         expert_graph_t::vertex_descriptor vertex;
@@ -511,6 +588,10 @@ private:
     expert_graph_t          _expert_dag;        //The primary graph data structure as an adjacency list
     vertex_map_t            _worker_map;        //A map from vertex name to vertex descriptor for workers
     vertex_map_t            _datanode_map;      //A map from vertex name to vertex descriptor for data nodes
+    node_queue_t            _sorted_nodes;      //Cached topological order of the graph
+    std::vector<size_t>     _sorted_index;      //Position of each vertex in _sorted_nodes
+    bool                    _sorted_nodes_valid;
+    std::vector<bool>       _reached;           //Scratch space for _resolve_dirty()
     boost::mutex            _mutex;
     boost::recursive_mutex  _resolve_mutex;
 };
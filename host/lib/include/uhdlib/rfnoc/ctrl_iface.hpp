@@ -11,6 +11,8 @@
 #include "xports.hpp"
 #include <boost/shared_ptr.hpp>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace uhd { namespace rfnoc {
 
@@ -21,6 +23,8 @@ class ctrl_iface
 {
 public:
     typedef boost::shared_ptr<ctrl_iface> sptr;
+    //! A register write as (address, value), see send_cmd_burst()
+    typedef std::pair<uint32_t, uint32_t> reg_write_t;
     virtual ~ctrl_iface(void) {}
 
     /*! Make a new control object
@@ -59,6 +63,29 @@ public:
             const bool readback=false,
             const uint64_t timestamp=0
     ) = 0;
+
+    /*! Send a burst of register writes.
+     *
+     * Keeps as many command packets in flight as the response transport can
+     * hold ACKs for, and collects the ACKs in batches. Unlike send_cmd_pkt(),
+     * this returns only once every write in the burst has been ACKed, so
+     * any error is reported by this call and not by a later one.
+     *
+     * \param writes Register addresses and values, written in this order.
+     * \param timestamp Optional timestamp, applied to every command packet.
+     *
+     * \throws uhd::io_error if a response is missing or malformed;
+     *         uhd::runtime_error if a packet could not be sent. The message
+     *         says which write of the burst failed.
+     */
+    virtual void send_cmd_burst(
+            const std::vector<reg_write_t> &writes,
+            const uint64_t timestamp=0
+    ) {
+        for (const reg_write_t &write : writes) {
+            send_cmd_pkt(write.first, write.second, false, timestamp);
+        }
+    }
 };
 
 }} /* namespace uhd::rfnoc */
@@ -0,0 +1,79 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_TRANSPORT_CONVERT_WORKER_POOL_HPP
+#define INCLUDED_UHDLIB_TRANSPORT_CONVERT_WORKER_POOL_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace uhd { namespace transport {
+
+/*!
+ * A pool of threads which run the per-channel sample conversion of a
+ * streamer in parallel.
+ *
+ * The thread calling run() takes part in the work as worker 0, the pool
+ * threads are workers 1 to size()-1. Idle pool threads spin for a short
+ * while (with a pause instruction on x86) before going to sleep, so
+ * back-to-back packets are picked up without a wakeup.
+ */
+class UHD_API convert_worker_pool : uhd::noncopyable
+{
+public:
+    typedef std::shared_ptr<convert_worker_pool> sptr;
+
+    //! Number of times an idle pool thread polls for work before it sleeps
+    static constexpr size_t DEFAULT_SPIN_ITERATIONS = 2000;
+
+    //! The work for one channel: (channel index, worker index)
+    typedef std::function<void(const size_t, const size_t)> task_type;
+
+    virtual ~convert_worker_pool(void) = 0;
+
+    //! Number of workers, including the calling thread
+    virtual size_t size(void) const = 0;
+
+    /*!
+     * Run the task for every channel in [0, num_chans) and wait for all of
+     * them to finish. Exceptions thrown by a task are rethrown here.
+     * Not thread-safe: only one thread may call run() at a time.
+     * \param num_chans the number of channels to process
+     * \param task the work to do for a single channel
+     */
+    virtual void run(const size_t num_chans, const task_type& task) = 0;
+
+    /*!
+     * Make a new worker pool
+     * \param num_threads the number of workers, including the calling thread
+     * \param cpu_affinity CPUs to pin the pool threads to, assigned in turn
+     * \param spin_iterations how often an idle pool thread polls for work
+     *        before it goes to sleep (0 sleeps right away)
+     * \return a new worker pool
+     */
+    static sptr make(const size_t num_threads,
+        const std::vector<size_t>& cpu_affinity = {},
+        const size_t spin_iterations            = DEFAULT_SPIN_ITERATIONS);
+
+    /*!
+     * Make a worker pool from the stream args, if requested:
+     * - convert_threads: number of threads converting samples
+     * - convert_cpus: colon-separated list of CPUs for the pool threads
+     * - convert_spin: how often an idle pool thread polls for work before
+     *   it goes to sleep
+     * \param args the stream args
+     * \return a new worker pool or nullptr when no pool was requested
+     */
+    static sptr make(const uhd::device_addr_t& args);
+};
+
+}} // namespace uhd::transport
+
+#endif /* INCLUDED_UHDLIB_TRANSPORT_CONVERT_WORKER_POOL_HPP */
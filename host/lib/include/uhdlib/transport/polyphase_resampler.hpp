@@ -0,0 +1,101 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_TRANSPORT_POLYPHASE_RESAMPLER_HPP
+#define INCLUDED_UHDLIB_TRANSPORT_POLYPHASE_RESAMPLER_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <complex>
+#include <memory>
+
+namespace uhd { namespace transport {
+
+/*!
+ * A rational polyphase resampler for the fc32 samples of a streamer.
+ *
+ * The output rate is the input rate times interp/decim. All channels are
+ * resampled in lock step, so they share the filter phase, and only the
+ * filter history is kept per channel. The filter is a windowed sinc with
+ * its cutoff at the lower of the two Nyquist rates, and unity gain.
+ *
+ * Output positions are reported relative to the input samples (see
+ * get_next_output_offset()), with the delay of the filter already taken
+ * out, so timestamps of the input carry over to the output.
+ */
+class UHD_API polyphase_resampler : uhd::noncopyable
+{
+public:
+    typedef std::shared_ptr<polyphase_resampler> sptr;
+    typedef std::complex<float> sample_type;
+
+    virtual ~polyphase_resampler(void) = 0;
+
+    //! Interpolation factor, after reducing interp/decim
+    virtual size_t get_interp(void) const = 0;
+
+    //! Decimation factor, after reducing interp/decim
+    virtual size_t get_decim(void) const = 0;
+
+    /*!
+     * Resample a block of samples on all channels.
+     *
+     * Stops when all inputs are consumed, or max_out outputs were written.
+     * Inputs which are consumed are kept in the filter history, so the next
+     * call continues seamlessly with the following input samples.
+     *
+     * \param in pointers to the input samples, one per channel
+     * \param num_in the number of input samples per channel
+     * \param out pointers to the output buffers, one per channel
+     * \param max_out the number of output samples that fit into each buffer
+     * \param num_consumed set to the number of inputs consumed per channel
+     * \return the number of output samples written per channel
+     */
+    virtual size_t process(const sample_type* const* in,
+        const size_t num_in,
+        sample_type* const* out,
+        const size_t max_out,
+        size_t& num_consumed) = 0;
+
+    /*!
+     * Get the position of the next output sample, in input samples after
+     * the next input sample to be consumed (it may be negative).
+     */
+    virtual double get_next_output_offset(void) const = 0;
+
+    //! Clear the filter history, e.g. at the start of a new burst
+    virtual void reset(void) = 0;
+
+    /*!
+     * Make a new resampler
+     * \param num_chans the number of channels
+     * \param interp the interpolation factor
+     * \param decim the decimation factor
+     * \param taps_per_phase the filter length, in samples at the lower of
+     *                       the input and the output rate
+     * \return a new resampler
+     */
+    static sptr make(const size_t num_chans,
+        const size_t interp,
+        const size_t decim,
+        const size_t taps_per_phase = 16);
+
+    /*!
+     * Make a resampler from the stream args, if requested:
+     * - resamp_interp: interpolation factor on the host
+     * - resamp_decim: decimation factor on the host
+     * - resamp_taps: filter length, see above
+     * \param num_chans the number of channels
+     * \param args the stream args
+     * \return a new resampler or nullptr when no resampling was requested
+     */
+    static sptr make(const size_t num_chans, const uhd::device_addr_t& args);
+};
+
+}} // namespace uhd::transport
+
+#endif /* INCLUDED_UHDLIB_TRANSPORT_POLYPHASE_RESAMPLER_HPP */
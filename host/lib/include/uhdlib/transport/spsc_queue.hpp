@@ -0,0 +1,356 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_TRANSPORT_SPSC_QUEUE_HPP
+#define INCLUDED_UHDLIB_TRANSPORT_SPSC_QUEUE_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <atomic>
+#include <chrono>
+#include <utility>
+#include <vector>
+#ifdef UHD_PLATFORM_LINUX
+#    include <linux/futex.h>
+#    include <sys/syscall.h>
+#    include <time.h>
+#    include <unistd.h>
+#else
+#    include <condition_variable>
+#    include <mutex>
+#endif
+
+namespace uhd { namespace transport {
+
+namespace spsc_detail {
+
+//! Number of times a waiting side polls the queue before it goes to sleep
+static const size_t SPIN_ITERATIONS = 1000;
+
+static const size_t CACHE_LINE_SIZE = 64;
+
+/*!
+ * A wakeup event for one waiting thread.
+ *
+ * The waiter reads the sequence number, announces itself, re-checks its
+ * condition and then sleeps until the sequence number changes. The
+ * notifier only bumps the sequence number (and makes a system call) when
+ * somebody announced itself, so the fast path is a fence and an atomic load.
+ */
+class event : uhd::noncopyable
+{
+public:
+    event(void) : _seq(0), _num_waiters(0) {}
+
+    UHD_INLINE uint32_t prepare_wait(void)
+    {
+        const uint32_t seq = _seq.load();
+        _num_waiters.fetch_add(1);
+        // order the announcement before the caller re-checks its condition
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return seq;
+    }
+
+    UHD_INLINE void cancel_wait(void)
+    {
+        _num_waiters.fetch_sub(1);
+    }
+
+    //! Sleep until notified or the timeout expires, then cancel the wait
+    void wait(const uint32_t seq, const std::chrono::nanoseconds timeout)
+    {
+#ifdef UHD_PLATFORM_LINUX
+        timespec ts;
+        ts.tv_sec  = time_t(timeout.count() / 1000000000);
+        ts.tv_nsec = long(timeout.count() % 1000000000);
+        ::syscall(SYS_futex,
+            reinterpret_cast<uint32_t*>(&_seq),
+            FUTEX_WAIT_PRIVATE,
+            seq,
+            &ts,
+            nullptr,
+            0);
+#else
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cond.wait_for(lock, timeout, [this, seq]() { return _seq.load() != seq; });
+#endif
+        cancel_wait();
+    }
+
+    UHD_INLINE void notify(void)
+    {
+        // order the caller's index update before the check for waiters
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_num_waiters.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+#ifdef UHD_PLATFORM_LINUX
+        _seq.fetch_add(1);
+        ::syscall(SYS_futex,
+            reinterpret_cast<uint32_t*>(&_seq),
+            FUTEX_WAKE_PRIVATE,
+            1,
+            nullptr,
+            nullptr,
+            0);
+#else
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _seq.fetch_add(1);
+        }
+        _cond.notify_one();
+#endif
+    }
+
+private:
+    std::atomic<uint32_t> _seq;
+    std::atomic<uint32_t> _num_waiters;
+#ifndef UHD_PLATFORM_LINUX
+    std::mutex _mutex;
+    std::condition_variable _cond;
+#endif
+};
+
+} // namespace spsc_detail
+
+/*!
+ * A bounded single-producer/single-consumer queue.
+ *
+ * This is a drop-in alternative to bounded_buffer for the case where
+ * exactly one thread pushes and exactly one thread pops. Pushing and
+ * popping never take a lock. A side that has to wait first spins for a
+ * short while and then sleeps on a futex (or a condition variable on
+ * platforms without futexes) until the other side makes progress.
+ *
+ * push_with_pop_on_full() is not available, because it would make the
+ * producer pop as well.
+ */
+template <typename elem_type> class spsc_queue : uhd::noncopyable
+{
+public:
+    /*!
+     * Create a new queue.
+     * \param capacity the maximum number of elements in the queue
+     */
+    spsc_queue(const size_t capacity)
+        : _buffer(capacity)
+        , _capacity(capacity)
+        , _write_index(0)
+        , _cached_read_index(0)
+        , _read_index(0)
+        , _cached_write_index(0)
+    {
+        /* NOP */
+    }
+
+    /*!
+     * Push a new element into the queue immediately.
+     * \param elem the new element to push
+     * \return false when the queue is full
+     */
+    UHD_INLINE bool push_with_haste(const elem_type& elem)
+    {
+        elem_type* slot = free_slot();
+        if (not slot) {
+            return false;
+        }
+        *slot = elem;
+        commit_push();
+        return true;
+    }
+
+    /*!
+     * Move a new element into the queue immediately.
+     * The producer keeps no reference to the element once it is queued.
+     * \param elem the new element to push, left untouched when the queue is full
+     * \return false when the queue is full
+     */
+    UHD_INLINE bool push_with_haste(elem_type&& elem)
+    {
+        elem_type* slot = free_slot();
+        if (not slot) {
+            return false;
+        }
+        *slot = std::move(elem);
+        commit_push();
+        return true;
+    }
+
+    /*!
+     * Push a new element into the queue.
+     * Wait until the queue becomes non-full.
+     * \param elem the new element to push
+     */
+    UHD_INLINE void push_with_wait(const elem_type& elem)
+    {
+        while (not push_with_timed_wait(elem, 1.0)) {
+            /* NOP */
+        }
+    }
+
+    /*!
+     * Push a new element into the queue.
+     * Wait until the queue becomes non-full or timeout.
+     * \param elem the new element to push
+     * \param timeout the timeout in seconds
+     * \return false when the operation times out
+     */
+    UHD_INLINE bool push_with_timed_wait(const elem_type& elem, double timeout)
+    {
+        if (push_with_haste(elem)) {
+            return true;
+        }
+        if (not wait_for(_not_full, timeout, [this]() { return not this->full(); })) {
+            return false;
+        }
+        return push_with_haste(elem);
+    }
+
+    /*!
+     * Pop an element from the queue immediately.
+     * \param elem the element reference pop to
+     * \return false when the queue is empty
+     */
+    UHD_INLINE bool pop_with_haste(elem_type& elem)
+    {
+        const size_t read_index = _read_index.load(std::memory_order_relaxed);
+        if (read_index == _cached_write_index) {
+            _cached_write_index = _write_index.load(std::memory_order_acquire);
+            if (read_index == _cached_write_index) {
+                return false;
+            }
+        }
+        // like bounded_buffer, don't keep a reference to the popped element
+        elem_type& slot = _buffer[read_index % _capacity];
+        elem            = slot;
+        slot            = elem_type();
+        _read_index.store(read_index + 1, std::memory_order_release);
+        _not_full.notify();
+        return true;
+    }
+
+    /*!
+     * Pop an element from the queue.
+     * Wait until the queue becomes non-empty.
+     * \param elem the element reference pop to
+     */
+    UHD_INLINE void pop_with_wait(elem_type& elem)
+    {
+        while (not pop_with_timed_wait(elem, 1.0)) {
+            /* NOP */
+        }
+    }
+
+    /*!
+     * Pop an element from the queue.
+     * Wait until the queue becomes non-empty or timeout.
+     * \param elem the element reference pop to
+     * \param timeout the timeout in seconds
+     * \return false when the operation times out
+     */
+    UHD_INLINE bool pop_with_timed_wait(elem_type& elem, double timeout)
+    {
+        if (pop_with_haste(elem)) {
+            return true;
+        }
+        if (not wait_for(_not_empty, timeout, [this]() { return not this->empty(); })) {
+            return false;
+        }
+        return pop_with_haste(elem);
+    }
+
+private:
+    //! The slot for the next push, or nullptr when the queue is full
+    UHD_INLINE elem_type* free_slot(void)
+    {
+        const size_t write_index = _write_index.load(std::memory_order_relaxed);
+        if (write_index - _cached_read_index == _capacity) {
+            _cached_read_index = _read_index.load(std::memory_order_acquire);
+            if (write_index - _cached_read_index == _capacity) {
+                return nullptr;
+            }
+        }
+        return &_buffer[write_index % _capacity];
+    }
+
+    UHD_INLINE void commit_push(void)
+    {
+        _write_index.store(
+            _write_index.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        _not_empty.notify();
+    }
+
+    UHD_INLINE bool full(void) const
+    {
+        return _write_index.load(std::memory_order_acquire)
+                   - _read_index.load(std::memory_order_acquire)
+               == _capacity;
+    }
+
+    UHD_INLINE bool empty(void) const
+    {
+        return _write_index.load(std::memory_order_acquire)
+               == _read_index.load(std::memory_order_acquire);
+    }
+
+    /*!
+     * Spin, then sleep on the event, until the condition is true.
+     * \return false when the condition is still false after the timeout
+     */
+    template <typename cond_type>
+    static bool wait_for(spsc_detail::event& event, double timeout, cond_type cond)
+    {
+        for (size_t i = 0; i < spsc_detail::SPIN_ITERATIONS; i++) {
+            if (cond()) {
+                return true;
+            }
+        }
+
+        typedef std::chrono::steady_clock clock_type;
+        const clock_type::time_point exit_time =
+            clock_type::now()
+            + std::chrono::duration_cast<clock_type::duration>(
+                  std::chrono::duration<double>(timeout));
+        while (true) {
+            const uint32_t seq = event.prepare_wait();
+            if (cond()) {
+                event.cancel_wait();
+                return true;
+            }
+            const clock_type::duration remaining = exit_time - clock_type::now();
+            if (remaining <= clock_type::duration::zero()) {
+                event.cancel_wait();
+                return false;
+            }
+            event.wait(
+                seq, std::chrono::duration_cast<std::chrono::nanoseconds>(remaining));
+        }
+    }
+
+    std::vector<elem_type> _buffer;
+    const size_t _capacity;
+
+    // Producer side: written by the producer, cached read index.
+    // The padding keeps both sides on separate cache lines. Each event
+    // lives with the side that notifies it, so the check for waiters on
+    // every push or pop stays on the local cache line. Only a side that
+    // goes to sleep touches the other side's line.
+    char _pad0[spsc_detail::CACHE_LINE_SIZE];
+    std::atomic<size_t> _write_index;
+    size_t _cached_read_index;
+    spsc_detail::event _not_empty;
+
+    // Consumer side: written by the consumer, cached write index
+    char _pad1[spsc_detail::CACHE_LINE_SIZE];
+    std::atomic<size_t> _read_index;
+    size_t _cached_write_index;
+    spsc_detail::event _not_full;
+    char _pad2[spsc_detail::CACHE_LINE_SIZE];
+};
+
+}} // namespace uhd::transport
+
+#endif /* INCLUDED_UHDLIB_TRANSPORT_SPSC_QUEUE_HPP */
@@ -0,0 +1,137 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_TRANSPORT_STREAM_COUNTERS_HPP
+#define INCLUDED_UHDLIB_TRANSPORT_STREAM_COUNTERS_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/metadata.hpp>
+#include <boost/shared_ptr.hpp>
+#include <atomic>
+#include <chrono>
+
+namespace uhd { namespace transport {
+
+/*!
+ * The counters behind stream_stats_t.
+ *
+ * Every counter has a single writer: the streaming thread, or for the
+ * async message counters the thread which handles async messages. So the
+ * writers get away with a relaxed load and store instead of an atomic
+ * read-modify-write, and get_stats() can be called from any thread.
+ */
+class stream_counters
+{
+public:
+    typedef boost::shared_ptr<stream_counters> sptr;
+    typedef std::chrono::steady_clock clock_type;
+
+    stream_counters(void)
+        : _num_packets(0)
+        , _num_bytes(0)
+        , _num_seq_errors(0)
+        , _num_overflows(0)
+        , _num_late_packets(0)
+        , _num_underflows(0)
+        , _num_fc_stalls(0)
+        , _convert_ns(0)
+        , _get_buff_ns(0)
+    { /* NOP */
+    }
+
+    UHD_INLINE void add_packets(const size_t num_packets, const size_t num_bytes)
+    {
+        add(_num_packets, num_packets);
+        add(_num_bytes, num_bytes);
+    }
+
+    UHD_INLINE void add_seq_error(void)
+    {
+        add(_num_seq_errors, 1);
+    }
+
+    UHD_INLINE void add_overflow(void)
+    {
+        add(_num_overflows, 1);
+    }
+
+    UHD_INLINE void add_fc_stall(void)
+    {
+        add(_num_fc_stalls, 1);
+    }
+
+    //! Add the time since start to the conversion time
+    UHD_INLINE void add_convert_time(const clock_type::time_point& start)
+    {
+        add(_convert_ns, elapsed_ns(start));
+    }
+
+    //! Add the time since start to the time spent waiting for buffers
+    UHD_INLINE void add_get_buff_time(const clock_type::time_point& start)
+    {
+        add(_get_buff_ns, elapsed_ns(start));
+    }
+
+    //! Count the errors reported in a TX async message
+    void add_async_msg(const async_metadata_t& metadata)
+    {
+        switch (metadata.event_code) {
+            case async_metadata_t::EVENT_CODE_UNDERFLOW:
+            case async_metadata_t::EVENT_CODE_UNDERFLOW_IN_PACKET:
+                add(_num_underflows, 1);
+                break;
+            case async_metadata_t::EVENT_CODE_TIME_ERROR:
+                add(_num_late_packets, 1);
+                break;
+            default:
+                break;
+        }
+    }
+
+    stream_stats_t get_stats(void) const
+    {
+        stream_stats_t stats;
+        stats.num_packets      = _num_packets.load(std::memory_order_relaxed);
+        stats.num_bytes        = _num_bytes.load(std::memory_order_relaxed);
+        stats.num_seq_errors   = _num_seq_errors.load(std::memory_order_relaxed);
+        stats.num_overflows    = _num_overflows.load(std::memory_order_relaxed);
+        stats.num_late_packets = _num_late_packets.load(std::memory_order_relaxed);
+        stats.num_underflows   = _num_underflows.load(std::memory_order_relaxed);
+        stats.num_fc_stalls    = _num_fc_stalls.load(std::memory_order_relaxed);
+        stats.convert_time     = _convert_ns.load(std::memory_order_relaxed) / 1e9;
+        stats.get_buff_time    = _get_buff_ns.load(std::memory_order_relaxed) / 1e9;
+        return stats;
+    }
+
+private:
+    static UHD_INLINE void add(std::atomic<uint64_t>& counter, const uint64_t value)
+    {
+        counter.store(
+            counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    static UHD_INLINE uint64_t elapsed_ns(const clock_type::time_point& start)
+    {
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            clock_type::now() - start)
+                            .count());
+    }
+
+    std::atomic<uint64_t> _num_packets;
+    std::atomic<uint64_t> _num_bytes;
+    std::atomic<uint64_t> _num_seq_errors;
+    std::atomic<uint64_t> _num_overflows;
+    std::atomic<uint64_t> _num_late_packets;
+    std::atomic<uint64_t> _num_underflows;
+    std::atomic<uint64_t> _num_fc_stalls;
+    std::atomic<uint64_t> _convert_ns;
+    std::atomic<uint64_t> _get_buff_ns;
+};
+
+}} // namespace uhd::transport
+
+#endif /* INCLUDED_UHDLIB_TRANSPORT_STREAM_COUNTERS_HPP */
@@ -14,6 +14,9 @@ extern "C" {
 #include <stdint.h>
 #include <rte_mbuf.h>
 
+/* Maximum number of RX/TX queue pairs (and I/O threads) per port */
+#define UHD_DPDK_MAX_QUEUES_PER_PORT 8
+
 /* For MAC address */
 struct eth_addr {
     uint8_t addr[6];
@@ -48,8 +51,11 @@ int uhd_dpdk_init(int argc, const char **argv);
  * Offload capabilities will be used if available
  *
  * @param num_ports number of network interfaces to map
- * @param port_thread_mapping array of num_ports entries specifying which thread
- *     will drive the I/O for a given port (determined by array index)
+ * @param port_thread_mapping array of num_ports*UHD_DPDK_MAX_QUEUES_PER_PORT
+ *     entries specifying which thread will drive the I/O for a given queue of
+ *     a given port (entry port*UHD_DPDK_MAX_QUEUES_PER_PORT + queue). Unused
+ *     entries are -1. A port uses one queue per entry, up to the first unused
+ *     entry, so a port with queue 0 unused is not brought up.
  * @param num_mbufs number of packets in each packet buffer pool (multiplied by num_ports)
  *     There is one RX and one TX buffer pool per CPU socket
  * @param mbuf_cache_size Number of packet buffers to put in core-local cache
@@ -112,6 +118,11 @@ int uhd_dpdk_set_ipv4_addr(unsigned int portid, uint32_t ipv4_addr, uint32_t net
  * Copies needed info from sockarg
  * Do NOT share struct uhd_dpdk_socket between threads!
  *
+ * On a port with multiple queues, a UDP socket is served by the queue given by
+ * its local port number (modulo the number of queues), so an RX socket and a
+ * TX socket with the same local port share an I/O thread. An RX socket with
+ * an auto-assigned port goes to the queue with the fewest RX sockets.
+ *
  * @param portid ID number of network interface
  * @param t Type of socket to create (only UDP supported currently)
  * @param sockarg Pointer to arguments for corresponding socket type
@@ -0,0 +1,71 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_TRANSPORT_XDP_ZERO_COPY_HPP
+#define INCLUDED_UHDLIB_TRANSPORT_XDP_ZERO_COPY_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/transport/udp_zero_copy.hpp>
+#include <uhd/types/device_addr.hpp>
+
+namespace uhd { namespace transport {
+
+/*!
+ * A UDP transport on top of an AF_XDP socket.
+ *
+ * The socket owns one receive queue of the network interface. Frames live
+ * in a UMEM area that is shared with the kernel (or the NIC, in zero-copy
+ * mode), and the managed buffers point straight into it. The transport
+ * builds and parses the Ethernet/IPv4/UDP headers itself.
+ *
+ * Unlike DPDK, the interface stays with the kernel: only UDP packets to the
+ * transport's local port are redirected to the socket, everything else on
+ * the queue (ARP, management traffic) goes to the regular network stack.
+ * The NIC needs to steer the device's packets to the queue of the socket,
+ * e.g. `ethtool -N <iface> flow-type udp4 dst-port <port> action <queue>`.
+ *
+ * The UMEM frames are sized for the MTU of the interface. Frames larger
+ * than a page (MTU above about 3800 bytes) are backed by huge pages, which
+ * needs Linux 6.6 or later. The socket and XDP program are set up through
+ * the kernel's uAPI, Linux 5.9 or later is required.
+ */
+class xdp_zero_copy : public udp_zero_copy
+{
+public:
+    typedef boost::shared_ptr<xdp_zero_copy> sptr;
+
+    /*!
+     * Make a new AF_XDP transport to a single UDP endpoint.
+     *
+     * The following hints are used:
+     * - xdp_iface: the network interface (default: the one on the
+     *   subnet of \p addr)
+     * - xdp_queues: colon-separated list of interface queues to use. Every
+     *   transport takes the first free queue of the list. Required.
+     * - xdp_port_base: when set, the transport on queue N uses the local
+     *   UDP port xdp_port_base + N, so flows can be steered by port
+     * - xdp_mode: "zero_copy", "copy" or "auto" (default: "auto")
+     * - xdp_busy_poll: spin on the socket instead of sleeping in poll()
+     * - recv_frame_size, num_recv_frames, send_frame_size, num_send_frames.
+     *   The frame sizes are limited to what the MTU of the interface allows.
+     *
+     * \param addr the destination IPv4 address
+     * \param port the destination UDP port
+     * \param default_buff_args default values for frame sizes and num frames
+     * \param[out] buff_params_out returns the actual buffer sizes
+     * \param hints optional parameters, see above
+     * \return a new transport
+     */
+    static sptr make(const std::string& addr,
+        const std::string& port,
+        const zero_copy_xport_params& default_buff_args,
+        udp_zero_copy::buff_params& buff_params_out,
+        const device_addr_t& hints = device_addr_t());
+};
+
+}} // namespace uhd::transport
+
+#endif /* INCLUDED_UHDLIB_TRANSPORT_XDP_ZERO_COPY_HPP */
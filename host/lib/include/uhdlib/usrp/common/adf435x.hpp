@@ -12,9 +12,11 @@
 #include <uhd/types/dict.hpp>
 #include <uhd/types/ranges.hpp>
 #include <uhd/utils/log.hpp>
+#include <uhdlib/utils/lru_cache.hpp>
 #include <boost/function.hpp>
 #include <boost/thread.hpp>
 #include <boost/math/special_functions/round.hpp>
+#include <tuple>
 #include <vector>
 #include "adf4350_regs.hpp"
 #include "adf4351_regs.hpp"
@@ -97,7 +99,8 @@ public:
         _regs(),
         _fb_after_divider(false),
         _reference_freq(0.0),
-        _N_min(-1)
+        _N_min(-1),
+        _dividers_cache(DIVIDERS_CACHE_SIZE)
     {}
 
     virtual ~adf435x_impl() {};
@@ -205,12 +208,127 @@ public:
     }
 
     double set_frequency(double target_freq, bool int_n_mode, bool flush = false)
+    {
+        static const double VCO_FREQ_MIN            = 2.2e9;
+        static const double VCO_FREQ_MAX            = 4.4e9;
+
+        uhd::range_t rf_divider_range = _get_rfdiv_range();
+        uhd::range_t int_range = get_int_range();
+
+        const dividers_t dividers = _get_dividers(target_freq, int_n_mode);
+        const uint16_t R = dividers.R, BS = dividers.BS, N = dividers.N;
+        const uint16_t FRAC = dividers.FRAC, MOD = dividers.MOD, RFdiv = dividers.RFdiv;
+        const bool D = dividers.D, T = dividers.T;
+        const double pfd_freq = dividers.pfd_freq;
+        const double vco_freq = dividers.vco_freq;
+        const double feedback_freq = dividers.feedback_freq;
+        const double actual_freq = dividers.actual_freq;
+
+        //Typical phase resync time documented in data sheet pg.24
+        static const double PHASE_RESYNC_TIME = 400e-6;
+
+        _regs.frac_12_bit            = FRAC;
+        _regs.int_16_bit             = N;
+        _regs.mod_12_bit             = MOD;
+        _regs.clock_divider_12_bit   = std::max<uint16_t>(1, uint16_t(std::ceil(PHASE_RESYNC_TIME*pfd_freq/MOD)));
+        _regs.feedback_select        = _fb_after_divider ?
+                                        adf435x_regs_t::FEEDBACK_SELECT_DIVIDED :
+                                        adf435x_regs_t::FEEDBACK_SELECT_FUNDAMENTAL;
+        _regs.clock_div_mode         = _fb_after_divider ?
+                                        adf435x_regs_t::CLOCK_DIV_MODE_RESYNC_ENABLE :
+                                        adf435x_regs_t::CLOCK_DIV_MODE_FAST_LOCK;
+        _regs.r_counter_10_bit       = R;
+        _regs.reference_divide_by_2  = T ?
+                                        adf435x_regs_t::REFERENCE_DIVIDE_BY_2_ENABLED :
+                                        adf435x_regs_t::REFERENCE_DIVIDE_BY_2_DISABLED;
+        _regs.reference_doubler      = D ?
+                                        adf435x_regs_t::REFERENCE_DOUBLER_ENABLED :
+                                        adf435x_regs_t::REFERENCE_DOUBLER_DISABLED;
+        _regs.band_select_clock_div  = uint8_t(BS);
+        _regs.rf_divider_select      = static_cast<typename adf435x_regs_t::rf_divider_select_t>(_get_rfdiv_setting(RFdiv));
+        _regs.ldf                    = int_n_mode ?
+                                        adf435x_regs_t::LDF_INT_N :
+                                        adf435x_regs_t::LDF_FRAC_N;
+
+        std::string tuning_str = (int_n_mode) ? "Integer-N" : "Fractional";
+        UHD_LOGGER_TRACE("ADF435X")
+            << boost::format("ADF 435X Frequencies (MHz): REQUESTED=%0.9f, ACTUAL=%0.9f")
+                % (target_freq/1e6) % (actual_freq/1e6)
+            << boost::format("ADF 435X Intermediates (MHz): Feedback=%0.2f, VCO=%0.2f, PFD=%0.2f, BAND=%0.2f, REF=%0.2f")
+                % (feedback_freq/1e6) % (vco_freq/1e6) % (pfd_freq/1e6) % (pfd_freq/BS/1e6) % (_reference_freq/1e6)
+            << boost::format("ADF 435X Tuning: %s") % tuning_str.c_str()
+            << boost::format("ADF 435X Settings: R=%d, BS=%d, N=%d, FRAC=%d, MOD=%d, T=%d, D=%d, RFdiv=%d")
+                % R % BS % N % FRAC % MOD % T % D % RFdiv
+        ;
+
+        UHD_ASSERT_THROW((_regs.frac_12_bit          & ((uint16_t)~0xFFF)) == 0);
+        UHD_ASSERT_THROW((_regs.mod_12_bit           & ((uint16_t)~0xFFF)) == 0);
+        UHD_ASSERT_THROW((_regs.clock_divider_12_bit & ((uint16_t)~0xFFF)) == 0);
+        UHD_ASSERT_THROW((_regs.r_counter_10_bit     & ((uint16_t)~0x3FF)) == 0);
+
+        UHD_ASSERT_THROW(vco_freq >= VCO_FREQ_MIN and vco_freq <= VCO_FREQ_MAX);
+        UHD_ASSERT_THROW(RFdiv >= static_cast<uint16_t>(rf_divider_range.start()));
+        UHD_ASSERT_THROW(RFdiv <= static_cast<uint16_t>(rf_divider_range.stop()));
+        UHD_ASSERT_THROW(_regs.int_16_bit >= static_cast<uint16_t>(int_range.start()));
+        UHD_ASSERT_THROW(_regs.int_16_bit <= static_cast<uint16_t>(int_range.stop()));
+
+        if (flush) commit();
+        return actual_freq;
+    }
+
+    void commit()
+    {
+        //reset counters
+        _regs.counter_reset = adf435x_regs_t::COUNTER_RESET_ENABLED;
+        std::vector<uint32_t> regs;
+        regs.push_back(_regs.get_reg(uint32_t(2)));
+        _write_fn(regs);
+        _regs.counter_reset = adf435x_regs_t::COUNTER_RESET_DISABLED;
+
+        //write the registers
+        //correct power-up sequence to write registers (5, 4, 3, 2, 1, 0)
+        regs.clear();
+        for (int addr = 5; addr >= 0; addr--) {
+            regs.push_back(_regs.get_reg(uint32_t(addr)));
+        }
+        _write_fn(regs);
+    }
+
+protected:
+    uhd::range_t _get_rfdiv_range();
+    int _get_rfdiv_setting(uint16_t div);
+
+    //! Divider settings for a frequency, the result of _find_dividers()
+    struct dividers_t
+    {
+        uint16_t R, BS, N, FRAC, MOD, RFdiv;
+        bool D, T;
+        double pfd_freq, vco_freq, feedback_freq, actual_freq;
+    };
+
+    // target freq, integer-N, reference freq, divided feedback, minimum N
+    typedef std::tuple<double, bool, double, bool, int> dividers_key_t;
+    static const size_t DIVIDERS_CACHE_SIZE = 64;
+
+    dividers_t _get_dividers(double target_freq, bool int_n_mode)
+    {
+        // the divider search dominates the tuning time, so remember the results
+        const dividers_key_t key(
+            target_freq, int_n_mode, _reference_freq, _fb_after_divider, _N_min);
+        dividers_t dividers;
+        if (not _dividers_cache.get(key, dividers)) {
+            dividers = _find_dividers(target_freq, int_n_mode);
+            _dividers_cache.put(key, dividers);
+        }
+        return dividers;
+    }
+
+    dividers_t _find_dividers(double target_freq, bool int_n_mode)
     {
         static const double REF_DOUBLER_THRESH_FREQ = 12.5e6;
         static const double PFD_FREQ_MAX            = 25.0e6;
         static const double BAND_SEL_FREQ_MAX       = 100e3;
         static const double VCO_FREQ_MIN            = 2.2e9;
-        static const double VCO_FREQ_MAX            = 4.4e9;
 
         //Default invalid value for actual_freq
         double actual_freq = 0;
@@ -289,9 +407,6 @@ public:
             R /= 2;
         }
 
-        //Typical phase resync time documented in data sheet pg.24
-        static const double PHASE_RESYNC_TIME = 400e-6;
-
         //If feedback after divider, then compensation for the divider is pulled into the INT value
         int rf_div_compensation = _fb_after_divider ? 1 : RFdiv;
 
@@ -301,82 +416,28 @@ public:
             (_reference_freq*(D?2:1)/(R*(T?2:1))))
         ) / rf_div_compensation;
 
-        _regs.frac_12_bit            = FRAC;
-        _regs.int_16_bit             = N;
-        _regs.mod_12_bit             = MOD;
-        _regs.clock_divider_12_bit   = std::max<uint16_t>(1, uint16_t(std::ceil(PHASE_RESYNC_TIME*pfd_freq/MOD)));
-        _regs.feedback_select        = _fb_after_divider ?
-                                        adf435x_regs_t::FEEDBACK_SELECT_DIVIDED :
-                                        adf435x_regs_t::FEEDBACK_SELECT_FUNDAMENTAL;
-        _regs.clock_div_mode         = _fb_after_divider ?
-                                        adf435x_regs_t::CLOCK_DIV_MODE_RESYNC_ENABLE :
-                                        adf435x_regs_t::CLOCK_DIV_MODE_FAST_LOCK;
-        _regs.r_counter_10_bit       = R;
-        _regs.reference_divide_by_2  = T ?
-                                        adf435x_regs_t::REFERENCE_DIVIDE_BY_2_ENABLED :
-                                        adf435x_regs_t::REFERENCE_DIVIDE_BY_2_DISABLED;
-        _regs.reference_doubler      = D ?
-                                        adf435x_regs_t::REFERENCE_DOUBLER_ENABLED :
-                                        adf435x_regs_t::REFERENCE_DOUBLER_DISABLED;
-        _regs.band_select_clock_div  = uint8_t(BS);
-        _regs.rf_divider_select      = static_cast<typename adf435x_regs_t::rf_divider_select_t>(_get_rfdiv_setting(RFdiv));
-        _regs.ldf                    = int_n_mode ?
-                                        adf435x_regs_t::LDF_INT_N :
-                                        adf435x_regs_t::LDF_FRAC_N;
-
-        std::string tuning_str = (int_n_mode) ? "Integer-N" : "Fractional";
-        UHD_LOGGER_TRACE("ADF435X")
-            << boost::format("ADF 435X Frequencies (MHz): REQUESTED=%0.9f, ACTUAL=%0.9f")
-                % (target_freq/1e6) % (actual_freq/1e6)
-            << boost::format("ADF 435X Intermediates (MHz): Feedback=%0.2f, VCO=%0.2f, PFD=%0.2f, BAND=%0.2f, REF=%0.2f")
-                % (feedback_freq/1e6) % (vco_freq/1e6) % (pfd_freq/1e6) % (pfd_freq/BS/1e6) % (_reference_freq/1e6)
-            << boost::format("ADF 435X Tuning: %s") % tuning_str.c_str()
-            << boost::format("ADF 435X Settings: R=%d, BS=%d, N=%d, FRAC=%d, MOD=%d, T=%d, D=%d, RFdiv=%d")
-                % R % BS % N % FRAC % MOD % T % D % RFdiv
-        ;
-
-        UHD_ASSERT_THROW((_regs.frac_12_bit          & ((uint16_t)~0xFFF)) == 0);
-        UHD_ASSERT_THROW((_regs.mod_12_bit           & ((uint16_t)~0xFFF)) == 0);
-        UHD_ASSERT_THROW((_regs.clock_divider_12_bit & ((uint16_t)~0xFFF)) == 0);
-        UHD_ASSERT_THROW((_regs.r_counter_10_bit     & ((uint16_t)~0x3FF)) == 0);
-
-        UHD_ASSERT_THROW(vco_freq >= VCO_FREQ_MIN and vco_freq <= VCO_FREQ_MAX);
-        UHD_ASSERT_THROW(RFdiv >= static_cast<uint16_t>(rf_divider_range.start()));
-        UHD_ASSERT_THROW(RFdiv <= static_cast<uint16_t>(rf_divider_range.stop()));
-        UHD_ASSERT_THROW(_regs.int_16_bit >= static_cast<uint16_t>(int_range.start()));
-        UHD_ASSERT_THROW(_regs.int_16_bit <= static_cast<uint16_t>(int_range.stop()));
-
-        if (flush) commit();
-        return actual_freq;
-    }
-
-    void commit()
-    {
-        //reset counters
-        _regs.counter_reset = adf435x_regs_t::COUNTER_RESET_ENABLED;
-        std::vector<uint32_t> regs;
-        regs.push_back(_regs.get_reg(uint32_t(2)));
-        _write_fn(regs);
-        _regs.counter_reset = adf435x_regs_t::COUNTER_RESET_DISABLED;
-
-        //write the registers
-        //correct power-up sequence to write registers (5, 4, 3, 2, 1, 0)
-        regs.clear();
-        for (int addr = 5; addr >= 0; addr--) {
-            regs.push_back(_regs.get_reg(uint32_t(addr)));
-        }
-        _write_fn(regs);
+        dividers_t dividers;
+        dividers.R             = R;
+        dividers.BS            = BS;
+        dividers.N             = N;
+        dividers.FRAC          = FRAC;
+        dividers.MOD           = MOD;
+        dividers.RFdiv         = RFdiv;
+        dividers.D             = D;
+        dividers.T             = T;
+        dividers.pfd_freq      = pfd_freq;
+        dividers.vco_freq      = vco_freq;
+        dividers.feedback_freq = feedback_freq;
+        dividers.actual_freq   = actual_freq;
+        return dividers;
     }
 
-protected:
-    uhd::range_t _get_rfdiv_range();
-    int _get_rfdiv_setting(uint16_t div);
-
     write_fn_t      _write_fn;
     adf435x_regs_t  _regs;
     double          _fb_after_divider;
     double          _reference_freq;
     int             _N_min;
+    uhd::lru_cache<dividers_key_t, dividers_t> _dividers_cache;
 };
 
 template <>
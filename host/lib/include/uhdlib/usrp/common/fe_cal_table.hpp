@@ -0,0 +1,110 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_LIBUHD_USRP_COMMON_FE_CAL_TABLE_HPP
+#define INCLUDED_LIBUHD_USRP_COMMON_FE_CAL_TABLE_HPP
+
+#include <uhd/config.hpp>
+#include <stdint.h>
+#include <complex>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace uhd { namespace usrp {
+
+/*! A frontend calibration table: IQ balance or DC offset over LO frequency
+ *
+ * Tables are read from the CSV files written by the uhd_cal_* utilities, or
+ * from a binary copy of them, which is memory-mapped instead of parsed.
+ * The entries are sorted by frequency, so a lookup is a binary search.
+ * A table never changes once it's loaded, so it can be used from any number
+ * of threads without locking.
+ *
+ * The binary format is a header (the magic "UHDFECAL", a 32-bit version, a
+ * 32-bit byte order mark, a 64-bit entry count, and the 64-bit size and
+ * modification time of the CSV file it was made from), followed by the
+ * entries, each of which is three doubles (frequency, real and imaginary
+ * part), all in host byte order.
+ */
+class fe_cal_table
+{
+public:
+    typedef std::shared_ptr<const fe_cal_table> sptr;
+
+    struct entry_t
+    {
+        double lo_freq;
+        double corr_real;
+        double corr_imag;
+    };
+
+    /*! Return the correction at \p lo_freq
+     *
+     * Between two entries, the correction is interpolated linearly. Outside
+     * of the table, it's the correction of the first or last entry.
+     *
+     * \throws uhd::runtime_error if the table is empty
+     */
+    std::complex<double> get_correction(const double lo_freq) const;
+
+    //! Return the number of entries
+    size_t size(void) const
+    {
+        return _num_entries;
+    }
+
+    //! Return the entries, sorted by frequency
+    const entry_t* entries(void) const
+    {
+        return _entries;
+    }
+
+    /*! Write this table to a binary calibration file
+     *
+     * \param bin_path The file to write
+     * \param csv_size The size of the CSV file the table was read from
+     * \param csv_mtime The modification time of that CSV file
+     */
+    void save_binary(const std::string& bin_path,
+        const uint64_t csv_size     = 0,
+        const std::time_t csv_mtime = 0) const;
+
+    //! Make a table from \p entries, which don't need to be sorted
+    static sptr make(std::vector<entry_t> entries);
+
+    //! Parse a CSV calibration file, as written by the uhd_cal_* utilities
+    static sptr import_csv(const std::string& csv_path);
+
+    /*! Map a binary calibration file
+     *
+     * \throws uhd::runtime_error if it's not a valid binary calibration file
+     */
+    static sptr load_binary(const std::string& bin_path);
+
+    /*! Load a CSV calibration file, using its binary copy if possible
+     *
+     * If \p csv_path + ".bin" exists, and its header holds the current size
+     * and modification time of the CSV file, it's mapped. Otherwise, the CSV file is parsed, and the binary copy is
+     * (re-)written for the next time, if the directory is writable.
+     */
+    static sptr load(const std::string& csv_path);
+
+private:
+    fe_cal_table(std::shared_ptr<const void> storage,
+        const entry_t* entries,
+        const size_t num_entries);
+
+    //! Owns the memory of the entries (a vector, or a mapped file)
+    std::shared_ptr<const void> _storage;
+    const entry_t* _entries;
+    size_t _num_entries;
+};
+
+}} // namespace uhd::usrp
+
+#endif /* INCLUDED_LIBUHD_USRP_COMMON_FE_CAL_TABLE_HPP */
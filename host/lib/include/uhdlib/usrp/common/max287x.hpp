@@ -16,12 +16,14 @@
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/math.hpp>
 #include <uhd/utils/safe_call.hpp>
+#include <uhdlib/utils/lru_cache.hpp>
 #include <boost/assign.hpp>
 #include <boost/function.hpp>
 #include <boost/math/special_functions/round.hpp>
 #include <vector>
 #include <chrono>
 #include <thread>
+#include <tuple>
 #include <stdint.h>
 
 /**
@@ -249,14 +251,46 @@ public:
     virtual void config_for_sync(bool enable);
 
 protected:
+    //! Divider settings for a frequency, the result of find_dividers()
+    struct dividers_t
+    {
+        int R, T, D, BS, N, FRAC, MOD, RFdiv, fb_divisor;
+        double pfd_freq, vco_freq, actual_freq;
+    };
+
+    /**
+     * Check whether the feedback is taken after the output divider
+     * when tuning to a frequency
+     * @param target_freq target frequency
+     */
+    virtual bool is_feedback_divided(double target_freq);
+
     max287x_regs_t _regs;
     bool _can_sync;
     bool _config_for_sync;
     bool _write_all_regs;
 
 private:
+    // target freq, ref freq, target PFD freq, integer-N, divided feedback
+    typedef std::tuple<double, double, double, bool, bool> dividers_key_t;
+    static const size_t DIVIDERS_CACHE_SIZE = 64;
+
+    dividers_t get_dividers(
+        double target_freq,
+        double ref_freq,
+        double target_pfd_freq,
+        bool is_int_n,
+        bool feedback_divided);
+    static dividers_t find_dividers(
+        double target_freq,
+        double ref_freq,
+        double target_pfd_freq,
+        bool is_int_n,
+        bool feedback_divided);
+
     write_fn _write;
     bool _delay_after_write;
+    uhd::lru_cache<dividers_key_t, dividers_t> _dividers_cache;
 };
 
 /**
@@ -274,18 +308,25 @@ public:
         bool is_int_n)
     {
         _regs.cpoc = is_int_n ? max2870_regs_t::CPOC_ENABLED : max2870_regs_t::CPOC_DISABLED;
-        _regs.feedback_select = target_freq >= 3.0e9 ?
+        _regs.feedback_select = is_feedback_divided(target_freq) ?
             max2870_regs_t::FEEDBACK_SELECT_DIVIDED :
             max2870_regs_t::FEEDBACK_SELECT_FUNDAMENTAL;
 
         return max287x<max2870_regs_t>::set_frequency(target_freq, ref_freq, target_pfd_freq, is_int_n);
     }
+
     void commit(void)
     {
         // For MAX2870, we always need to write all registers.
         _write_all_regs = true;
         max287x<max2870_regs_t>::commit();
     }
+
+protected:
+    bool is_feedback_divided(double target_freq)
+    {
+        return target_freq >= 3.0e9;
+    }
 };
 
 /**
@@ -446,6 +487,12 @@ public:
             _can_sync = false;
         }
     }
+
+protected:
+    bool is_feedback_divided(double)
+    {
+        return true;
+    }
 };
 
 
@@ -461,7 +508,8 @@ max287x<max287x_regs_t>::max287x(write_fn func) :
         _config_for_sync(false),
         _write_all_regs(true),
         _write(func),
-        _delay_after_write(true)
+        _delay_after_write(true),
+        _dividers_cache(DIVIDERS_CACHE_SIZE)
 {
     power_up();
 }
@@ -529,12 +577,113 @@ double max287x<max287x_regs_t>::set_frequency(
         (64,  max287x_regs_t::RF_DIVIDER_SELECT_DIV64)
         (128, max287x_regs_t::RF_DIVIDER_SELECT_DIV128);
 
+    static const uhd::range_t clock_div_range(1,4095,1);
+
+    const bool feedback_divided = (_regs.feedback_select == max287x_regs_t::FEEDBACK_SELECT_DIVIDED);
+    const dividers_t dividers = get_dividers(
+        target_freq, ref_freq, target_pfd_freq, is_int_n, feedback_divided);
+    const int T = dividers.T;
+    const int D = dividers.D;
+    const int R = dividers.R;
+    const int BS = dividers.BS;
+    const int N = dividers.N;
+    const int FRAC = dividers.FRAC;
+    const int MOD = dividers.MOD;
+    const int RFdiv = dividers.RFdiv;
+    const double pfd_freq = dividers.pfd_freq;
+    const double vco_freq = dividers.vco_freq;
+    const double actual_freq = dividers.actual_freq;
+
+    UHD_LOGGER_TRACE("MAX287X")
+        << boost::format("MAX287x: Intermediates: ref=%0.2f, outdiv=%f, fbdiv=%f")
+            % ref_freq % double(RFdiv*2) % double(N + double(FRAC)/double(MOD))
+        << boost::format("MAX287x: tune: R=%d, BS=%d, N=%d, FRAC=%d, MOD=%d, T=%d, D=%d, RFdiv=%d, type=%s")
+            % R % BS % N % FRAC % MOD % T % D % RFdiv % ((is_int_n) ? "Integer-N" : "Fractional")
+        << boost::format("MAX287x: Frequencies (MHz): REQ=%0.2f, ACT=%0.2f, VCO=%0.2f, PFD=%0.2f, BAND=%0.2f")
+            % (target_freq/1e6) % (actual_freq/1e6) % (vco_freq/1e6) % (pfd_freq/1e6) % (pfd_freq/BS/1e6)
+    ;
+
+    //load the register values
+    _regs.rf_output_enable = max287x_regs_t::RF_OUTPUT_ENABLE_ENABLED;
+
+    if(is_int_n) {
+        _regs.cpl = max287x_regs_t::CPL_DISABLED;
+        _regs.ldf = max287x_regs_t::LDF_INT_N;
+        _regs.int_n_mode = max287x_regs_t::INT_N_MODE_INT_N;
+    } else {
+        _regs.cpl = max287x_regs_t::CPL_ENABLED;
+        _regs.ldf = max287x_regs_t::LDF_FRAC_N;
+        _regs.int_n_mode = max287x_regs_t::INT_N_MODE_FRAC_N;
+    }
+
+    _regs.lds = pfd_freq <= 32e6 ? max287x_regs_t::LDS_SLOW : max287x_regs_t::LDS_FAST;
+
+    _regs.frac_12_bit = FRAC;
+    _regs.int_16_bit = N;
+    _regs.mod_12_bit = MOD;
+    _regs.clock_divider_12_bit = std::max(int(clock_div_range.start()), int(std::ceil(400e-6*pfd_freq/MOD)));
+    UHD_ASSERT_THROW(_regs.clock_divider_12_bit <= clock_div_range.stop());
+    _regs.r_counter_10_bit = R;
+    _regs.reference_divide_by_2 = T ?
+        max287x_regs_t::REFERENCE_DIVIDE_BY_2_ENABLED :
+        max287x_regs_t::REFERENCE_DIVIDE_BY_2_DISABLED;
+    _regs.reference_doubler = D ?
+        max287x_regs_t::REFERENCE_DOUBLER_ENABLED :
+        max287x_regs_t::REFERENCE_DOUBLER_DISABLED;
+    _regs.band_select_clock_div = BS & 0xFF;
+    _regs.bs_msb = (BS & 0x300) >> 8;
+    UHD_ASSERT_THROW(rfdivsel_to_enum.has_key(RFdiv));
+    _regs.rf_divider_select = rfdivsel_to_enum[RFdiv];
+
+    if (_regs.clock_div_mode == max287x_regs_t::CLOCK_DIV_MODE_FAST_LOCK)
+    {
+        // Charge pump current needs to be set to lowest value in fast lock mode
+        _regs.charge_pump_current = max287x_regs_t::CHARGE_PUMP_CURRENT_0_32MA;
+        // Make sure the register containing the charge pump current is written
+        _write_all_regs = true;
+    }
+
+    return actual_freq;
+}
+
+template <typename max287x_regs_t>
+bool max287x<max287x_regs_t>::is_feedback_divided(double)
+{
+    return _regs.feedback_select == max287x_regs_t::FEEDBACK_SELECT_DIVIDED;
+}
+
+template <typename max287x_regs_t>
+typename max287x<max287x_regs_t>::dividers_t max287x<max287x_regs_t>::get_dividers(
+    double target_freq,
+    double ref_freq,
+    double target_pfd_freq,
+    bool is_int_n,
+    bool feedback_divided)
+{
+    // the divider search dominates the tuning time, so remember the results
+    const dividers_key_t key(target_freq, ref_freq, target_pfd_freq, is_int_n, feedback_divided);
+    dividers_t dividers;
+    if (not _dividers_cache.get(key, dividers))
+    {
+        dividers = find_dividers(target_freq, ref_freq, target_pfd_freq, is_int_n, feedback_divided);
+        _dividers_cache.put(key, dividers);
+    }
+    return dividers;
+}
+
+template <typename max287x_regs_t>
+typename max287x<max287x_regs_t>::dividers_t max287x<max287x_regs_t>::find_dividers(
+    double target_freq,
+    double ref_freq,
+    double target_pfd_freq,
+    bool is_int_n,
+    bool feedback_divided)
+{
     //map mode setting to valid integer divider (N) values
     static const uhd::range_t int_n_mode_div_range(16,65535,1);
     static const uhd::range_t frac_n_mode_div_range(19,4091,1);
 
     //other ranges and constants from MAX287X datasheets
-    static const uhd::range_t clock_div_range(1,4095,1);
     static const uhd::range_t r_range(1,1023,1);
     static const double MIN_VCO_FREQ = 3e9;
     static const double BS_FREQ = 50e3;
@@ -549,7 +698,6 @@ double max287x<max287x_regs_t>::set_frequency(
     int MOD = 4095;
     int RFdiv = 1;
     double pfd_freq = target_pfd_freq;
-    bool feedback_divided = (_regs.feedback_select == max287x_regs_t::FEEDBACK_SELECT_DIVIDED);
 
     //increase RF divider until acceptable VCO frequency (MIN freq for MAX287x VCO is 3GHz)
     UHD_ASSERT_THROW(target_freq > 0);
@@ -631,56 +779,20 @@ double max287x<max287x_regs_t>::set_frequency(
     //actual frequency calculation
     double actual_freq = double((N + (double(FRAC)/double(MOD)))*ref_freq*(1+int(D))/(R*(1+int(T)))) * fb_divisor / RFdiv;
 
-    UHD_LOGGER_TRACE("MAX287X")
-        << boost::format("MAX287x: Intermediates: ref=%0.2f, outdiv=%f, fbdiv=%f")
-            % ref_freq % double(RFdiv*2) % double(N + double(FRAC)/double(MOD))
-        << boost::format("MAX287x: tune: R=%d, BS=%d, N=%d, FRAC=%d, MOD=%d, T=%d, D=%d, RFdiv=%d, type=%s")
-            % R % BS % N % FRAC % MOD % T % D % RFdiv % ((is_int_n) ? "Integer-N" : "Fractional")
-        << boost::format("MAX287x: Frequencies (MHz): REQ=%0.2f, ACT=%0.2f, VCO=%0.2f, PFD=%0.2f, BAND=%0.2f")
-            % (target_freq/1e6) % (actual_freq/1e6) % (vco_freq/1e6) % (pfd_freq/1e6) % (pfd_freq/BS/1e6)
-    ;
-
-    //load the register values
-    _regs.rf_output_enable = max287x_regs_t::RF_OUTPUT_ENABLE_ENABLED;
-
-    if(is_int_n) {
-        _regs.cpl = max287x_regs_t::CPL_DISABLED;
-        _regs.ldf = max287x_regs_t::LDF_INT_N;
-        _regs.int_n_mode = max287x_regs_t::INT_N_MODE_INT_N;
-    } else {
-        _regs.cpl = max287x_regs_t::CPL_ENABLED;
-        _regs.ldf = max287x_regs_t::LDF_FRAC_N;
-        _regs.int_n_mode = max287x_regs_t::INT_N_MODE_FRAC_N;
-    }
-
-    _regs.lds = pfd_freq <= 32e6 ? max287x_regs_t::LDS_SLOW : max287x_regs_t::LDS_FAST;
-
-    _regs.frac_12_bit = FRAC;
-    _regs.int_16_bit = N;
-    _regs.mod_12_bit = MOD;
-    _regs.clock_divider_12_bit = std::max(int(clock_div_range.start()), int(std::ceil(400e-6*pfd_freq/MOD)));
-    UHD_ASSERT_THROW(_regs.clock_divider_12_bit <= clock_div_range.stop());
-    _regs.r_counter_10_bit = R;
-    _regs.reference_divide_by_2 = T ?
-        max287x_regs_t::REFERENCE_DIVIDE_BY_2_ENABLED :
-        max287x_regs_t::REFERENCE_DIVIDE_BY_2_DISABLED;
-    _regs.reference_doubler = D ?
-        max287x_regs_t::REFERENCE_DOUBLER_ENABLED :
-        max287x_regs_t::REFERENCE_DOUBLER_DISABLED;
-    _regs.band_select_clock_div = BS & 0xFF;
-    _regs.bs_msb = (BS & 0x300) >> 8;
-    UHD_ASSERT_THROW(rfdivsel_to_enum.has_key(RFdiv));
-    _regs.rf_divider_select = rfdivsel_to_enum[RFdiv];
-
-    if (_regs.clock_div_mode == max287x_regs_t::CLOCK_DIV_MODE_FAST_LOCK)
-    {
-        // Charge pump current needs to be set to lowest value in fast lock mode
-        _regs.charge_pump_current = max287x_regs_t::CHARGE_PUMP_CURRENT_0_32MA;
-        // Make sure the register containing the charge pump current is written
-        _write_all_regs = true;
-    }
-
-    return actual_freq;
+    dividers_t dividers;
+    dividers.R = R;
+    dividers.T = T;
+    dividers.D = D;
+    dividers.BS = BS;
+    dividers.N = N;
+    dividers.FRAC = FRAC;
+    dividers.MOD = MOD;
+    dividers.RFdiv = RFdiv;
+    dividers.fb_divisor = fb_divisor;
+    dividers.pfd_freq = pfd_freq;
+    dividers.vco_freq = vco_freq;
+    dividers.actual_freq = actual_freq;
+    return dividers;
 }
 
 template <typename max287x_regs_t>
@@ -57,6 +57,11 @@ namespace uhd{
             _locked = false;
         }
 
+        UHD_INLINE bool try_claim(void){
+            bool expected = false;
+            return _locked.compare_exchange_strong(expected, true);
+        }
+
         UHD_INLINE bool claim_with_wait(const double timeout){
             if (spin_wait_with_timeout(_locked, false, timeout)){
                 _locked = true;
@@ -0,0 +1,102 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_LRU_CACHE_HPP
+#define INCLUDED_UHDLIB_UTILS_LRU_CACHE_HPP
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <utility>
+
+namespace uhd {
+
+/*!
+ * A cache of the most recently used values, up to a fixed capacity.
+ *
+ * Looking up or inserting a key makes it the most recently used one; when
+ * the cache is full, inserting a new key evicts the least recently used
+ * one. Keys need an operator<, so std::tuple makes a good key type.
+ */
+template <typename key_type, typename value_type>
+class lru_cache
+{
+public:
+    lru_cache(const size_t capacity) : _capacity(capacity) {}
+
+    /*!
+     * Look up a value
+     * \param key the key of the value
+     * \param value set to the cached value, if there is one
+     * \return true if the value was cached
+     */
+    bool get(const key_type& key, value_type& value)
+    {
+        auto it = _index.find(key);
+        if (it == _index.end()) {
+            return false;
+        }
+        _entries.splice(_entries.begin(), _entries, it->second);
+        value = it->second->second;
+        return true;
+    }
+
+    //! Insert or replace a value, evicting the least recently used value if full
+    void put(const key_type& key, const value_type& value)
+    {
+        auto it = _index.find(key);
+        if (it != _index.end()) {
+            it->second->second = value;
+            _entries.splice(_entries.begin(), _entries, it->second);
+            return;
+        }
+        _entries.emplace_front(key, value);
+        _index[key] = _entries.begin();
+        this->evict();
+    }
+
+    //! Change the capacity, evicting the least recently used values if needed
+    void set_capacity(const size_t capacity)
+    {
+        _capacity = capacity;
+        this->evict();
+    }
+
+    size_t get_capacity(void) const
+    {
+        return _capacity;
+    }
+
+    size_t size(void) const
+    {
+        return _entries.size();
+    }
+
+    void clear(void)
+    {
+        _entries.clear();
+        _index.clear();
+    }
+
+private:
+    typedef std::list<std::pair<key_type, value_type>> entries_type;
+
+    void evict(void)
+    {
+        while (_entries.size() > _capacity) {
+            _index.erase(_entries.back().first);
+            _entries.pop_back();
+        }
+    }
+
+    size_t _capacity;
+    entries_type _entries; // most recently used first
+    std::map<key_type, typename entries_type::iterator> _index;
+};
+
+} // namespace uhd
+
+#endif /* INCLUDED_UHDLIB_UTILS_LRU_CACHE_HPP */
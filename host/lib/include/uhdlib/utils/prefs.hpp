@@ -74,7 +74,7 @@ namespace uhd { namespace prefs {
      *
      * [dpdk-mac=00:01:02:03:04:06]
      * dpdk-ipv4 = 192.168.40.1/24
-     * dpdk-io-cpu = 1
+     * dpdk-io-cpu = 2,3
      *
      * \param user_args After getting the device args from the config
      *                  files, all of these key/value pairs will be applied
@@ -0,0 +1,103 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_REACTOR_HPP
+#define INCLUDED_UHDLIB_UTILS_REACTOR_HPP
+
+#include <uhd/transport/zero_copy.hpp>
+#include <uhd/utils/tasks.hpp>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace uhd {
+
+/*! Runs the callbacks of many background tasks on a small, shared thread pool.
+ *
+ * Message handlers and housekeeping loops used to own a thread each (see
+ * uhd::task), which mostly slept in short timeouts. With many streamers, that
+ * adds up to a lot of threads waking up all the time. Instead, they can
+ * register a callback with the reactor, which runs it when a file descriptor
+ * becomes readable, or periodically.
+ *
+ * Callbacks must not block for long, because other callbacks might be
+ * waiting for the same thread. Work that can block on a device for long (like
+ * the claimer loops, which wait for RPC or peek/poke timeouts) keeps a
+ * uhd::task of its own. A callback never runs on two threads at once.
+ * If a callback throws, the error is logged and the callback is not called
+ * again (like a uhd::task loop).
+ *
+ * Registering returns a task::sptr. Once it's destroyed, the callback won't
+ * be called anymore; if it's running, the destructor waits for it to return
+ * (unless it's the callback itself that drops its task).
+ */
+class reactor
+{
+public:
+    typedef std::shared_ptr<reactor> sptr;
+
+    /*! Callback for readiness of a file descriptor
+     *
+     * Returns true if it should be called again right away, e.g. because it
+     * handled a message and there might be more.
+     */
+    typedef std::function<bool(void)> callback_type;
+
+    virtual ~reactor(void) {}
+
+    /*! Return the reactor shared by all devices in this process
+     *
+     * The number of threads is set by the UHD_REACTOR_THREADS environment
+     * variable, and defaults to 2.
+     */
+    static sptr get(void);
+
+    //! Create a reactor with its own \p num_threads threads
+    static sptr make(const size_t num_threads);
+
+    /*! Call \p callback whenever \p fd is readable
+     *
+     * The callback gets called again for as long as it returns true, and then
+     * again when the descriptor is readable. It should therefore read until
+     * there's nothing left.
+     *
+     * \returns The task that keeps the callback registered, or an empty pointer
+     *          if this platform can't wait on file descriptors.
+     */
+    virtual task::sptr add_fd(const int fd,
+        const callback_type& callback,
+        const std::string& name = "") = 0;
+
+    /*! Call \p callback every \p period
+     *
+     * The first call is right away. The period is counted from the end of
+     * a call to the start of the next one.
+     */
+    virtual task::sptr add_periodic(const std::chrono::milliseconds period,
+        const std::function<void(void)>& callback,
+        const std::string& name = "") = 0;
+};
+
+/*! Handle everything that's received on \p xport in the background
+ *
+ * If the transport has a file descriptor, the shared reactor calls
+ * handler(0.0) whenever it's readable, until the handler returns false.
+ * Otherwise, a dedicated task calls handler(0.1) in a loop.
+ *
+ * \param xport Transport to receive on
+ * \param handler Receives and handles at most one packet, waiting for up to
+ *                the given timeout. Returns true if there was a packet.
+ * \param name Task name, for debugging
+ * \returns The task, messages are handled until it's destroyed
+ */
+task::sptr make_recv_task(transport::zero_copy_if::sptr xport,
+    const std::function<bool(double)>& handler,
+    const std::string& name = "");
+
+} /* namespace uhd */
+
+#endif /* INCLUDED_UHDLIB_UTILS_REACTOR_HPP */
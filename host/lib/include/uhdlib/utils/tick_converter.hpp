@@ -0,0 +1,143 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_TICK_CONVERTER_HPP
+#define INCLUDED_UHDLIB_UTILS_TICK_CONVERTER_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/types/time_spec.hpp>
+#include <cmath>
+#include <cstdint>
+
+namespace uhd {
+
+/*! Converts between tick counts, sample counts and time_spec_t
+ *
+ * The streaming code keeps times as 64-bit tick counts, which is what goes
+ * into the packet headers. This class converts them to and from time_spec_t
+ * at the API boundary, and adds sample offsets to them.
+ *
+ * When the tick rate is a whole number, and a whole number of ticks per
+ * sample (i.e., the tick rate is a multiple of the sample rate), this is done
+ * in integer arithmetic, so it's cheaper and exact: A time that is N samples
+ * after another time is always exactly N * ticks-per-sample ticks later.
+ * Otherwise, it falls back to the floating point math of time_spec_t.
+ */
+class tick_converter
+{
+public:
+    tick_converter(const double tick_rate = 1.0, const double samp_rate = 1.0)
+        : _tick_rate(tick_rate), _samp_rate(samp_rate)
+    {
+        _update();
+    }
+
+    void set_tick_rate(const double tick_rate)
+    {
+        _tick_rate = tick_rate;
+        _update();
+    }
+
+    void set_samp_rate(const double samp_rate)
+    {
+        _samp_rate = samp_rate;
+        _update();
+    }
+
+    //! Return the number of ticks per sample, or 0 if it's not a whole number
+    int64_t get_ticks_per_samp(void) const
+    {
+        return _ticks_per_samp;
+    }
+
+    //! Return the number of ticks that \p nsamps samples take
+    UHD_INLINE int64_t samps_to_ticks(const int64_t nsamps) const
+    {
+        if (_ticks_per_samp) {
+            return nsamps * _ticks_per_samp;
+        }
+        return std::llround(nsamps * (_tick_rate / _samp_rate));
+    }
+
+    //! Return the time of tick count \p ticks
+    UHD_INLINE time_spec_t to_time_spec(const int64_t ticks) const
+    {
+        if (_int_tick_rate) {
+            int64_t full_secs = ticks / _int_tick_rate;
+            int64_t rem_ticks = ticks % _int_tick_rate;
+            if (rem_ticks < 0) {
+                full_secs -= 1;
+                rem_ticks += _int_tick_rate;
+            }
+            return time_spec_t(full_secs, double(rem_ticks) / _tick_rate);
+        }
+        return time_spec_t::from_ticks(ticks, _tick_rate);
+    }
+
+    //! Return the tick count of \p time_spec, rounded to the nearest tick
+    UHD_INLINE int64_t to_ticks(const time_spec_t& time_spec) const
+    {
+        if (_int_tick_rate) {
+            return time_spec.get_full_secs() * _int_tick_rate
+                   + std::llround(time_spec.get_frac_secs() * _tick_rate);
+        }
+        return time_spec.to_ticks(_tick_rate);
+    }
+
+    //! Return the tick count of \p time_spec plus \p nsamps samples
+    UHD_INLINE int64_t to_ticks(const time_spec_t& time_spec, const int64_t nsamps) const
+    {
+        if (_ticks_per_samp) {
+            return to_ticks(time_spec) + nsamps * _ticks_per_samp;
+        }
+        return (time_spec + time_spec_t::from_ticks(nsamps, _samp_rate))
+            .to_ticks(_tick_rate);
+    }
+
+    //! Return the time of tick count \p ticks plus \p nsamps samples
+    UHD_INLINE time_spec_t to_time_spec(const int64_t ticks, const int64_t nsamps) const
+    {
+        if (_ticks_per_samp) {
+            return to_time_spec(ticks + nsamps * _ticks_per_samp);
+        }
+        return to_time_spec(ticks) + time_spec_t::from_ticks(nsamps, _samp_rate);
+    }
+
+private:
+    //! Rates are considered whole numbers within this relative error
+    static constexpr double RATE_EPSILON = 1e-12;
+
+    void _update(void)
+    {
+        _int_tick_rate  = 0;
+        _ticks_per_samp = 0;
+        // Doubles represent integers exactly up to 2^53
+        if (_tick_rate < 1.0 or _tick_rate > 9007199254740992.0
+            or _tick_rate != std::floor(_tick_rate)) {
+            return;
+        }
+        _int_tick_rate = int64_t(_tick_rate);
+        if (_samp_rate <= 0.0) {
+            return;
+        }
+        const double ratio = std::round(_tick_rate / _samp_rate);
+        if (ratio >= 1.0
+            and std::abs(ratio * _samp_rate - _tick_rate) <= _tick_rate * RATE_EPSILON) {
+            _ticks_per_samp = int64_t(ratio);
+        }
+    }
+
+    double _tick_rate;
+    double _samp_rate;
+    //! The tick rate, or 0 if it's not a whole number
+    int64_t _int_tick_rate;
+    //! Ticks per sample, or 0 if it's not a whole number
+    int64_t _ticks_per_samp;
+};
+
+} /* namespace uhd */
+
+#endif /* INCLUDED_UHDLIB_UTILS_TICK_CONVERTER_HPP */
@@ -6,9 +6,11 @@
 //
 
 #include <uhd/property_tree.hpp>
-#include <uhd/types/dict.hpp>
-#include <boost/thread/mutex.hpp>
 #include <boost/make_shared.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/unordered_map.hpp>
+#include <algorithm>
 #include <iostream>
 
 using namespace uhd;
@@ -62,6 +64,11 @@ fs_path uhd::operator/(const fs_path &lhs, size_t rhs)
 
 /***********************************************************************
  * Property tree implementation
+ *
+ * All nodes of a tree live in one hash map, keyed by their full path
+ * ("/a/b/c", the root is ""). Looking up a path is a single hash lookup
+ * instead of a walk from the root, and lookups only take a shared lock,
+ * so readers on different threads don't serialize.
  **********************************************************************/
 class property_tree_impl : public uhd::property_tree{
 public:
@@ -70,11 +77,11 @@ public:
         _root(root)
     {
         _guts = boost::make_shared<tree_guts_type>();
+        _guts->nodes[""] = node_type();
     }
 
     sptr subtree(const fs_path &path_) const{
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
 
         property_tree_impl *subtree = new property_tree_impl(path);
         subtree->_guts = this->_guts; //copy the guts sptr
@@ -83,68 +90,74 @@ public:
 
     void remove(const fs_path &path_){
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
-
-        node_type *parent = NULL;
-        node_type *node = &_guts->root;
-        for(const std::string &name:  path_tokenizer(path)){
-            if (not node->has_key(name)) throw_path_not_found(path);
-            parent = node;
-            node = &(*node)[name];
+        const std::string key = make_key(path);
+        boost::unique_lock<boost::shared_mutex> lock(_guts->mutex);
+
+        if (key.empty()) throw uhd::runtime_error("Cannot uproot");
+        if (_guts->nodes.count(key) == 0) throw_path_not_found(path);
+
+        //unlink the node from its parent
+        const size_t sep = key.rfind('/');
+        std::vector<std::string> &siblings = _guts->nodes[key.substr(0, sep)].children;
+        siblings.erase(std::find(siblings.begin(), siblings.end(), key.substr(sep+1)));
+
+        //drop the node and everything below it
+        const std::string prefix = key + "/";
+        for (node_map_type::iterator it = _guts->nodes.begin(); it != _guts->nodes.end();){
+            if (it->first == key or it->first.compare(0, prefix.size(), prefix) == 0){
+                it = _guts->nodes.erase(it);
+            } else {
+                ++it;
+            }
         }
-        if (parent == NULL) throw uhd::runtime_error("Cannot uproot");
-        parent->pop(fs_path(path.leaf()));
     }
 
     bool exists(const fs_path &path_) const{
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
+        const std::string key = make_key(path);
+        boost::shared_lock<boost::shared_mutex> lock(_guts->mutex);
 
-        node_type *node = &_guts->root;
-        for(const std::string &name:  path_tokenizer(path)){
-            if (not node->has_key(name)) return false;
-            node = &(*node)[name];
-        }
-        return true;
+        return _guts->nodes.count(key) != 0;
     }
 
     std::vector<std::string> list(const fs_path &path_) const{
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
-
-        node_type *node = &_guts->root;
-        for(const std::string &name:  path_tokenizer(path)){
-            if (not node->has_key(name)) throw_path_not_found(path);
-            node = &(*node)[name];
-        }
+        const std::string key = make_key(path);
+        boost::shared_lock<boost::shared_mutex> lock(_guts->mutex);
 
-        return node->keys();
+        return get_node(key, path).children;
     }
 
     void _create(const fs_path &path_, const boost::shared_ptr<void> &prop){
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
-
-        node_type *node = &_guts->root;
-        for(const std::string &name:  path_tokenizer(path)){
-            if (not node->has_key(name)) (*node)[name] = node_type();
-            node = &(*node)[name];
+        const std::string key = make_key(path);
+        boost::unique_lock<boost::shared_mutex> lock(_guts->mutex);
+
+        //create the missing nodes along the way, parents first
+        size_t sep = 0;
+        while (sep != std::string::npos){
+            sep = key.find('/', sep+1);
+            const std::string node_key = key.substr(0, sep);
+            if (_guts->nodes.count(node_key) != 0) continue;
+            const size_t parent_sep = node_key.rfind('/');
+            _guts->nodes[node_key.substr(0, parent_sep)].children.push_back(
+                node_key.substr(parent_sep+1));
+            _guts->nodes[node_key] = node_type();
         }
-        if (node->prop.get() != NULL) throw uhd::runtime_error("Cannot create! Property already exists at: " + path);
-        node->prop = prop;
+        node_type &node = _guts->nodes[key];
+        if (node.prop.get() != NULL) throw uhd::runtime_error("Cannot create! Property already exists at: " + path);
+        node.prop = prop;
     }
 
-    boost::shared_ptr<void> &_access(const fs_path &path_) const{
-        const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
+    boost::shared_ptr<void> &_access(const fs_path &path) const{
+        boost::shared_lock<boost::shared_mutex> lock(_guts->mutex);
+        return _access_unlocked(path);
+    }
 
-        node_type *node = &_guts->root;
-        for(const std::string &name:  path_tokenizer(path)){
-            if (not node->has_key(name)) throw_path_not_found(path);
-            node = &(*node)[name];
-        }
-        if (node->prop.get() == NULL) throw uhd::runtime_error("Cannot access! Property uninitialized at: " + path);
-        return node->prop;
+    boost::shared_ptr<void> _get_handle(const fs_path &path) const{
+        //copy the pointer while the tree can't change underneath it
+        boost::shared_lock<boost::shared_mutex> lock(_guts->mutex);
+        return _access_unlocked(path);
     }
 
 private:
@@ -153,16 +166,45 @@ private:
     }
 
     //basic structural node element
-    struct node_type : uhd::dict<std::string, node_type>{
+    struct node_type{
         boost::shared_ptr<void> prop;
+        std::vector<std::string> children; //names, in order of creation
     };
+    typedef boost::unordered_map<std::string, node_type> node_map_type;
 
     //tree guts which may be referenced in a subtree
     struct tree_guts_type{
-        node_type root;
-        boost::mutex mutex;
+        node_map_type nodes;
+        boost::shared_mutex mutex;
     };
 
+    //! Turn a path into the key of its node: "/a/b/c", or "" for the root
+    static std::string make_key(const fs_path &path){
+        //paths built with operator/ are already in shape
+        if (path.empty() or (path[0] == '/' and *path.rbegin() != '/'
+            and path.find("//") == std::string::npos)){
+            return path;
+        }
+        std::string key;
+        for(const std::string &name:  path_tokenizer(path)){
+            key += "/" + name;
+        }
+        return key;
+    }
+
+    node_type &get_node(const std::string &key, const fs_path &path) const{
+        node_map_type::iterator it = _guts->nodes.find(key);
+        if (it == _guts->nodes.end()) throw_path_not_found(path);
+        return it->second;
+    }
+
+    boost::shared_ptr<void> &_access_unlocked(const fs_path &path_) const{
+        const fs_path path = _root / path_;
+        node_type &node = get_node(make_key(path), path);
+        if (node.prop.get() == NULL) throw uhd::runtime_error("Cannot access! Property uninitialized at: " + path);
+        return node.prop;
+    }
+
     //members, the tree and root prefix
     boost::shared_ptr<tree_guts_type> _guts;
     const fs_path _root;
@@ -12,6 +12,7 @@
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/tasks.hpp>
 #include <uhdlib/rfnoc/async_msg_handler.hpp>
+#include <uhdlib/utils/reactor.hpp>
 #include <boost/make_shared.hpp>
 #include <mutex>
 
@@ -35,8 +36,9 @@ public:
         uhd::sid_t sid)
         : _rx_xport(recv), _tx_xport(send), _sid(sid)
     {
-        // Launch receive thread
-        _recv_msg_task = task::make([=]() { this->handle_async_msgs(); });
+        // Handle messages in the background
+        _recv_msg_task = make_recv_task(
+            recv, [this](const double timeout) { return this->handle_async_msgs(timeout); });
     }
 
     ~async_msg_handler_impl() {}
@@ -84,14 +86,17 @@ private: // methods
     /************************************************************************
      * Internals
      ***********************************************************************/
-    /*! Packet receiver thread call.
+    /*! Packet receiver task call.
+     *
+     * \param timeout Time to wait for a packet
+     * \returns true if a packet was received
      */
-    void handle_async_msgs()
+    bool handle_async_msgs(const double timeout)
     {
         using namespace uhd::transport;
-        managed_recv_buffer::sptr buff = _rx_xport->get_recv_buff();
+        managed_recv_buffer::sptr buff = _rx_xport->get_recv_buff(timeout);
         if (not buff)
-            return;
+            return false;
 
         // Get packet info
         vrt::if_packet_info_t if_packet_info;
@@ -112,13 +117,13 @@ private: // methods
             UHD_LOGGER_ERROR("RFNOC")
                 << "[async message handler] Error parsing async message packet: "
                 << ex.what() << std::endl;
-            return;
+            return true;
         }
 
         // We discard anything that's not actually a command or response packet.
         if (not(if_packet_info.packet_type & vrt::if_packet_info_t::PACKET_TYPE_CMD)
             or if_packet_info.num_packet_words32 == 0) {
-            return;
+            return true;
         }
 
         const uint32_t* payload = packet_buff + if_packet_info.num_header_words32;
@@ -135,6 +140,7 @@ private: // methods
         }
 
         this->post_async_msg(metadata);
+        return true;
     }
 
     uint32_t get_local_addr() const
@@ -309,6 +309,22 @@ void block_ctrl_base::sr_write(
     return sr_write(reg_addr, data, port);
 }
 
+void block_ctrl_base::sr_write_burst(
+    const std::vector<std::pair<uint32_t, uint32_t>>& writes, const size_t port)
+{
+    if (not _ctrl_ifaces.count(port)) {
+        throw uhd::key_error(str(boost::format("[%s] sr_write_burst(): No such port: %d")
+                                 % get_block_id().get() % port));
+    }
+    try {
+        _ctrl_ifaces[port]->send_cmd_burst(
+            writes, _cmd_timespecs[port].to_ticks(_cmd_tickrates[port]));
+    } catch (const std::exception& ex) {
+        throw uhd::io_error(str(boost::format("[%s] sr_write_burst() failed: %s")
+                                % get_block_id().get() % ex.what()));
+    }
+}
+
 uint64_t block_ctrl_base::sr_read64(const settingsbus_reg_t reg, const size_t port)
 {
     if (not _ctrl_ifaces.count(port)) {
@@ -17,6 +17,10 @@
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
 #include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <mutex>
 
 using namespace uhd;
 using namespace uhd::rfnoc;
@@ -194,23 +198,23 @@ public:
         return (rhs.find(lhs) == 0);
     }
 
-    //! Open the file at filename and see if it's a block definition for the given NoC ID
-    static bool has_noc_id(uint64_t noc_id, const fs::path& filename)
+    //! Open the file at filename and return the NoC IDs it's a block definition for
+    static std::vector<std::string> get_noc_ids(const fs::path& filename)
     {
+        std::vector<std::string> noc_ids;
         pt::ptree propt;
         try {
             read_xml(filename.string(), propt);
             for (pt::ptree::value_type& v : propt.get_child("nocblock.ids")) {
-                if (v.first == "id" and match_noc_id(v.second.data(), noc_id)) {
-                    return true;
+                if (v.first == "id") {
+                    noc_ids.push_back(v.second.data());
                 }
             }
         } catch (std::exception& e) {
-            UHD_LOGGER_WARNING("RFNOC") << "has_noc_id(): caught exception " << e.what()
+            UHD_LOGGER_WARNING("RFNOC") << "get_noc_ids(): caught exception " << e.what()
                                         << " while parsing file: " << filename.string();
-            return false;
         }
-        return false;
+        return noc_ids;
     }
 
     blockdef_xml_impl(
@@ -397,6 +401,213 @@ private:
     pt::ptree _pt;
 };
 
+/****************************************************************************
+ * NoC ID index
+ ****************************************************************************/
+/*! Maps NoC IDs to block definition files.
+ *
+ * Finding the definition for a NoC ID used to mean parsing every file in the
+ * blocks directories, for every block on the device. Instead, every file is
+ * read once per process and only its NoC IDs are kept. A directory is read
+ * again when its modification time changes (i.e., files were added, removed
+ * or renamed). Modification times only have a resolution of one second, so
+ * a directory that changed less than a second before it was read gets read
+ * again on the next lookup, too.
+ *
+ * If the environment variable XML_INDEX_ENV names a file, the index is also
+ * stored there, so later sessions don't need to read the files either. When
+ * loading it, every file's modification time is checked, so edited files are
+ * read again.
+ */
+class blockdef_index
+{
+public:
+    static blockdef_index& get()
+    {
+        static blockdef_index index;
+        return index;
+    }
+
+    /*! Return the first file in \p dir that defines the block \p noc_id
+     *
+     * \returns the path to the file, or an empty path if there's none
+     */
+    fs::path find(const fs::path& dir, const uint64_t noc_id)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const dir_index_t& dir_index = _get_dir_index(dir);
+        for (const file_index_t& file : dir_index.files) {
+            for (const std::string& id : file.noc_ids) {
+                try {
+                    if (blockdef_xml_impl::match_noc_id(id, noc_id)) {
+                        return dir / file.filename;
+                    }
+                } catch (const std::exception& e) {
+                    UHD_LOGGER_WARNING("RFNOC")
+                        << "Invalid NoC ID in file " << (dir / file.filename).string()
+                        << ": " << e.what();
+                    break;
+                }
+            }
+        }
+        return fs::path();
+    }
+
+private:
+    struct file_index_t
+    {
+        std::string filename;
+        std::time_t mtime;
+        std::vector<std::string> noc_ids;
+    };
+
+    struct dir_index_t
+    {
+        std::time_t mtime;
+        //! True if the directory or a file in it was changed too recently to
+        // tell later changes apart by their modification time
+        bool racy;
+        //! All block definition files, in the order we found them
+        std::vector<file_index_t> files;
+    };
+
+    blockdef_index()
+    {
+        if (std::getenv(XML_INDEX_ENV.c_str()) != NULL) {
+            _index_file = fs::path(std::getenv(XML_INDEX_ENV.c_str()));
+            _load();
+        }
+    }
+
+    const dir_index_t& _get_dir_index(const fs::path& dir)
+    {
+        const std::time_t mtime = fs::last_write_time(dir);
+        auto it                 = _dirs.find(dir.string());
+        if (it != _dirs.end() and it->second.mtime == mtime and not it->second.racy) {
+            return it->second;
+        }
+
+        UHD_LOGGER_DEBUG("RFNOC") << "Indexing block definitions in " << dir.string();
+        dir_index_t& dir_index = _dirs[dir.string()];
+        dir_index.mtime        = mtime;
+        dir_index.files.clear();
+        const std::time_t racy_time = std::time(NULL) - 1;
+        dir_index.racy              = mtime >= racy_time;
+        fs::directory_iterator end_itr;
+        for (fs::directory_iterator i(dir); i != end_itr; ++i) {
+            if (not fs::exists(*i) or fs::is_directory(*i) or fs::is_empty(*i)) {
+                continue;
+            }
+            if (i->path().filename().extension() != XML_EXTENSION) {
+                continue;
+            }
+            file_index_t file;
+            file.filename = i->path().filename().string();
+            file.mtime    = fs::last_write_time(i->path());
+            file.noc_ids  = blockdef_xml_impl::get_noc_ids(i->path());
+            dir_index.files.push_back(file);
+            dir_index.racy = dir_index.racy or file.mtime >= racy_time;
+        }
+        _save();
+        return dir_index;
+    }
+
+    /*! Read the index file
+     *
+     * It's a text file, with one line per directory and one line per file.
+     * Fields are separated by tabs:
+     *
+     *     dir <mtime> <path>
+     *     file <mtime> <filename> <NoC ID>,<NoC ID>,...
+     *
+     * Directories where anything changed since the file was written are
+     * skipped, they'll be indexed again when they're used.
+     */
+    void _load()
+    {
+        std::ifstream in(_index_file.string().c_str());
+        std::string line;
+        std::string dir;
+        dir_index_t dir_index;
+        bool valid = false;
+        auto store = [this, &dir, &dir_index, &valid]() {
+            if (valid) {
+                _dirs[dir] = dir_index;
+            }
+        };
+        while (std::getline(in, line)) {
+            std::vector<std::string> fields;
+            boost::split(fields, line, boost::is_any_of("\t"));
+            try {
+                if (fields.size() == 3 and fields[0] == "dir") {
+                    store();
+                    dir             = fields[2];
+                    dir_index.mtime = std::time_t(std::stoll(fields[1]));
+                    dir_index.racy  = false;
+                    dir_index.files.clear();
+                    valid = fs::is_directory(dir)
+                            and fs::last_write_time(dir) == dir_index.mtime;
+                } else if (fields.size() == 4 and fields[0] == "file" and valid) {
+                    file_index_t file;
+                    file.filename = fields[2];
+                    file.mtime    = std::time_t(std::stoll(fields[1]));
+                    if (not fields[3].empty()) {
+                        boost::split(file.noc_ids, fields[3], boost::is_any_of(","));
+                    }
+                    valid = fs::last_write_time(fs::path(dir) / file.filename)
+                            == file.mtime;
+                    dir_index.files.push_back(file);
+                }
+            } catch (const std::exception&) {
+                valid = false;
+            }
+        }
+        store();
+    }
+
+    //! Write the index file, if there is one
+    void _save()
+    {
+        if (_index_file.empty()) {
+            return;
+        }
+        // Write to a temporary file first, so other processes never see a
+        // partial index. Its name is unique, so processes saving at the same
+        // time don't write to the same file.
+        const fs::path tmp_file =
+            fs::unique_path(_index_file.string() + ".%%%%-%%%%-%%%%.tmp");
+        try {
+            {
+                std::ofstream out(tmp_file.string().c_str());
+                for (const auto& dir : _dirs) {
+                    if (dir.second.racy) {
+                        continue;
+                    }
+                    out << "dir\t" << dir.second.mtime << "\t" << dir.first << "\n";
+                    for (const file_index_t& file : dir.second.files) {
+                        out << "file\t" << file.mtime << "\t" << file.filename << "\t"
+                            << boost::algorithm::join(file.noc_ids, ",") << "\n";
+                    }
+                }
+                if (not out) {
+                    throw uhd::io_error("Error writing " + tmp_file.string());
+                }
+            }
+            fs::rename(tmp_file, _index_file);
+        } catch (const std::exception& e) {
+            UHD_LOGGER_WARNING("RFNOC")
+                << "Could not store the block definition index: " << e.what();
+            boost::system::error_code ec;
+            fs::remove(tmp_file, ec);
+        }
+    }
+
+    std::mutex _mutex;
+    //! Index of each directory, by path
+    std::map<std::string, dir_index_t> _dirs;
+    fs::path _index_file;
+};
+
 blockdef::sptr blockdef::make_from_noc_id(uint64_t noc_id)
 {
     std::vector<fs::path> paths = blockdef_xml_impl::get_xml_paths();
@@ -416,20 +627,11 @@ blockdef::sptr blockdef::make_from_noc_id(uint64_t noc_id)
                                    "to the correct location");
     }
 
-    // Iterate over all paths
+    // Iterate over all paths, only the matching file gets parsed
     for (const auto& path : valid) {
-        // Iterate over all .xml files
-        fs::directory_iterator end_itr;
-        for (fs::directory_iterator i(path); i != end_itr; ++i) {
-            if (not fs::exists(*i) or fs::is_directory(*i) or fs::is_empty(*i)) {
-                continue;
-            }
-            if (i->path().filename().extension() != XML_EXTENSION) {
-                continue;
-            }
-            if (blockdef_xml_impl::has_noc_id(noc_id, i->path())) {
-                return blockdef::sptr(new blockdef_xml_impl(i->path(), noc_id));
-            }
+        const fs::path filename = blockdef_index::get().find(path, noc_id);
+        if (not filename.empty()) {
+            return blockdef::sptr(new blockdef_xml_impl(filename, noc_id));
         }
     }
 
@@ -20,6 +20,7 @@
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
 #include <queue>
+#include <vector>
 
 using namespace uhd;
 using namespace uhd::rfnoc;
@@ -35,6 +36,7 @@ public:
         : _xports(xports)
         , _name(name)
         , _seq_out(0)
+        , _seq_in(0)
         , _max_outstanding_acks(xports.recv->get_num_recv_frames())
     {
 
@@ -66,6 +68,37 @@ public:
             readback, bool(timestamp != 0) ? MASSIVE_TIMEOUT : ACK_TIMEOUT);
     }
 
+    void send_cmd_burst(const std::vector<reg_write_t>& writes, const uint64_t timestamp)
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        const double timeout = bool(timestamp != 0) ? MASSIVE_TIMEOUT : ACK_TIMEOUT;
+        // ACK everything that earlier writes left in flight first, so their
+        // errors don't get reported as errors of this burst
+        this->wait_for_acks(0, timeout);
+
+        const size_t first_seq = _seq_out;
+        try {
+            for (const reg_write_t& write : writes) {
+                // When the window is full, wait until half of it is ACKed
+                // rather than for a single ACK, so we go back and forth
+                // between sending and receiving less often
+                if (_outstanding_seqs.size() >= _max_outstanding_acks) {
+                    this->wait_for_acks(_max_outstanding_acks / 2, timeout);
+                }
+                this->send_pkt(write.first, write.second, timestamp);
+            }
+            this->wait_for_acks(0, timeout);
+        } catch (const uhd::io_error& ex) {
+            throw uhd::io_error(str(boost::format("%s (write %d of %d in burst)")
+                                    % ex.what() % (_seq_in - first_seq + 1)
+                                    % writes.size()));
+        } catch (const uhd::runtime_error& ex) {
+            throw uhd::runtime_error(str(boost::format("%s (write %d of %d in burst)")
+                                         % ex.what() % (_seq_out - first_seq + 1)
+                                         % writes.size()));
+        }
+    }
+
 private:
     // This is the buffer type for response messages
     struct resp_buff_type
@@ -126,95 +159,105 @@ private:
     inline uint64_t wait_for_ack(const bool readback, const double timeout)
     {
         while (readback or (_outstanding_seqs.size() >= _max_outstanding_acks)) {
-            // get seq to ack from outstanding packets list
-            UHD_ASSERT_THROW(not _outstanding_seqs.empty());
-            const size_t seq_to_ack = _outstanding_seqs.front();
-
-            // parse the packet
-            vrt::if_packet_info_t packet_info;
-            resp_buff_type resp_buff;
-            memset(&resp_buff, 0x00, sizeof(resp_buff));
-            uint32_t const* pkt = NULL;
-            managed_recv_buffer::sptr buff;
-
-            buff = _xports.recv->get_recv_buff(timeout);
-            try {
-                UHD_ASSERT_THROW(bool(buff));
-                UHD_ASSERT_THROW(buff->size() > 0);
-                _outstanding_seqs.pop();
-            } catch (const std::exception& ex) {
-                throw uhd::io_error(
-                    str(boost::format("Block ctrl (%s) no response packet - %s") % _name
-                        % ex.what()));
-            }
-            pkt                            = buff->cast<const uint32_t*>();
-            packet_info.num_packet_words32 = buff->size() / sizeof(uint32_t);
-
-            // parse the buffer
-            try {
-                if (_endianness == uhd::ENDIANNESS_BIG) {
-                    vrt::chdr::if_hdr_unpack_be(pkt, packet_info);
-                } else {
-                    vrt::chdr::if_hdr_unpack_le(pkt, packet_info);
-                }
-            } catch (const std::exception& ex) {
-                UHD_LOGGER_ERROR("RFNOC")
-                    << "[" << _name << "] Block ctrl bad VITA packet: " << ex.what();
-                if (buff) {
-                    UHD_LOGGER_INFO("RFNOC") << boost::format("%08X") % pkt[0];
-                    UHD_LOGGER_INFO("RFNOC") << boost::format("%08X") % pkt[1];
-                    UHD_LOGGER_INFO("RFNOC") << boost::format("%08X") % pkt[2];
-                    UHD_LOGGER_INFO("RFNOC") << boost::format("%08X") % pkt[3];
-                } else {
-                    UHD_LOGGER_INFO("RFNOC") << "buff is NULL";
-                }
+            const uint64_t payload = this->recv_ack(timeout);
+            // return the readback value
+            if (readback and _outstanding_seqs.empty()) {
+                return payload;
             }
+        }
 
-            // check the buffer
-            try {
-                UHD_ASSERT_THROW(packet_info.has_sid);
-                if (packet_info.sid != _xports.recv_sid.get()) {
-                    throw uhd::io_error(
-                        str(boost::format("Expected SID: %s  Received SID: %s")
-                            % _xports.recv_sid.to_pp_string_hex()
-                            % uhd::sid_t(packet_info.sid).to_pp_string_hex()));
-                }
+        return 0;
+    }
 
-                if (packet_info.packet_count != (seq_to_ack & 0xfff)) {
-                    throw uhd::io_error(
-                        str(boost::format("Expected packet index: %d "
-                                          "Received index: %d")
-                            % (seq_to_ack & 0xfff) % packet_info.packet_count));
-                }
+    //! Receive ACKs until no more than \p max_outstanding packets are in flight
+    inline void wait_for_acks(const size_t max_outstanding, const double timeout)
+    {
+        while (_outstanding_seqs.size() > max_outstanding) {
+            this->recv_ack(timeout);
+        }
+    }
+
+    //! Receive and check the ACK for the oldest outstanding packet, return its payload
+    inline uint64_t recv_ack(const double timeout)
+    {
+        // get seq to ack from outstanding packets list
+        UHD_ASSERT_THROW(not _outstanding_seqs.empty());
+        const size_t seq_to_ack = _outstanding_seqs.front();
+        _seq_in                 = seq_to_ack;
+
+        // parse the packet
+        vrt::if_packet_info_t packet_info;
+        uint32_t const* pkt = NULL;
+        managed_recv_buffer::sptr buff;
+
+        buff = _xports.recv->get_recv_buff(timeout);
+        try {
+            UHD_ASSERT_THROW(bool(buff));
+            UHD_ASSERT_THROW(buff->size() > 0);
+            _outstanding_seqs.pop();
+        } catch (const std::exception& ex) {
+            throw uhd::io_error(
+                str(boost::format("Block ctrl (%s) no response packet - %s") % _name
+                    % ex.what()));
+        }
+        pkt                            = buff->cast<const uint32_t*>();
+        packet_info.num_packet_words32 = buff->size() / sizeof(uint32_t);
 
-                UHD_ASSERT_THROW(packet_info.num_payload_words32 == 2);
-            } catch (const std::exception& ex) {
+        // parse the buffer
+        try {
+            if (_endianness == uhd::ENDIANNESS_BIG) {
+                vrt::chdr::if_hdr_unpack_be(pkt, packet_info);
+            } else {
+                vrt::chdr::if_hdr_unpack_le(pkt, packet_info);
+            }
+        } catch (const std::exception& ex) {
+            UHD_LOGGER_ERROR("RFNOC")
+                << "[" << _name << "] Block ctrl bad VITA packet: " << ex.what();
+            UHD_LOGGER_INFO("RFNOC") << boost::format("%08X") % pkt[0];
+            UHD_LOGGER_INFO("RFNOC") << boost::format("%08X") % pkt[1];
+            UHD_LOGGER_INFO("RFNOC") << boost::format("%08X") % pkt[2];
+            UHD_LOGGER_INFO("RFNOC") << boost::format("%08X") % pkt[3];
+        }
+
+        // check the buffer
+        try {
+            UHD_ASSERT_THROW(packet_info.has_sid);
+            if (packet_info.sid != _xports.recv_sid.get()) {
                 throw uhd::io_error(
-                    str(boost::format("Block ctrl (%s) packet parse error - %s") % _name
-                        % ex.what()));
+                    str(boost::format("Expected SID: %s  Received SID: %s")
+                        % _xports.recv_sid.to_pp_string_hex()
+                        % uhd::sid_t(packet_info.sid).to_pp_string_hex()));
             }
 
-            // return the readback value
-            if (readback and _outstanding_seqs.empty()) {
-                const uint64_t hi =
-                    (_endianness == uhd::ENDIANNESS_BIG)
-                        ? uhd::ntohx(pkt[packet_info.num_header_words32 + 0])
-                        : uhd::wtohx(pkt[packet_info.num_header_words32 + 0]);
-                const uint64_t lo =
-                    (_endianness == uhd::ENDIANNESS_BIG)
-                        ? uhd::ntohx(pkt[packet_info.num_header_words32 + 1])
-                        : uhd::wtohx(pkt[packet_info.num_header_words32 + 1]);
-                return ((hi << 32) | lo);
+            if (packet_info.packet_count != (seq_to_ack & 0xfff)) {
+                throw uhd::io_error(
+                    str(boost::format("Expected packet index: %d "
+                                      "Received index: %d")
+                        % (seq_to_ack & 0xfff) % packet_info.packet_count));
             }
+
+            UHD_ASSERT_THROW(packet_info.num_payload_words32 == 2);
+        } catch (const std::exception& ex) {
+            throw uhd::io_error(
+                str(boost::format("Block ctrl (%s) packet parse error - %s") % _name
+                    % ex.what()));
         }
 
-        return 0;
+        const uint64_t hi = (_endianness == uhd::ENDIANNESS_BIG)
+                                ? uhd::ntohx(pkt[packet_info.num_header_words32 + 0])
+                                : uhd::wtohx(pkt[packet_info.num_header_words32 + 0]);
+        const uint64_t lo = (_endianness == uhd::ENDIANNESS_BIG)
+                                ? uhd::ntohx(pkt[packet_info.num_header_words32 + 1])
+                                : uhd::wtohx(pkt[packet_info.num_header_words32 + 1]);
+        return ((hi << 32) | lo);
     }
 
 
     const uhd::both_xports_t _xports;
     const std::string _name;
     size_t _seq_out;
+    //! Sequence number of the last ACK we waited for
+    size_t _seq_in;
     std::queue<size_t> _outstanding_seqs;
     const size_t _max_outstanding_acks;
 
@@ -53,15 +53,18 @@ public:
             taps.resize(_n_taps, 0);
         }
 
-        // Write taps via the reload bus
+        // Write taps via the reload bus, as one burst
+        std::vector<std::pair<uint32_t, uint32_t>> writes;
+        writes.reserve(taps.size() + 1);
         for (size_t i = 0; i < taps.size() - 1; i++) {
-            sr_write(SR_RELOAD, uint32_t(taps[i]));
+            writes.push_back(std::make_pair(uint32_t(SR_RELOAD), uint32_t(taps[i])));
         }
         // Assert tlast when sending the spinal tap (haha, it's actually the final tap).
-        sr_write(SR_RELOAD_TLAST, uint32_t(taps.back()));
+        writes.push_back(std::make_pair(uint32_t(SR_RELOAD_TLAST), uint32_t(taps.back())));
         // Send the configuration word to replace the existing coefficients with the new
         // ones. Note: This configuration bus does not require tlast
-        sr_write(SR_CONFIG, 0);
+        writes.push_back(std::make_pair(uint32_t(SR_CONFIG), uint32_t(0)));
+        sr_write_burst(writes);
     }
 
     //! Returns the number of filter taps in this block.
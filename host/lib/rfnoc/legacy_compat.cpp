@@ -1167,6 +1167,13 @@ legacy_compat::sptr legacy_compat::make(
         return legacy_compat_copy;
     }
 
+    // Without radios, there are no channels to map (e.g., the simulator only
+    // has null blocks). Such devices can only be used through the RFNoC API.
+    if (device->find_blocks(RADIO_BLOCK_NAME).empty()) {
+        throw uhd::runtime_error("[legacy_compat] The device has no radio blocks, so "
+                                 "it can't be used through multi_usrp.");
+    }
+
     legacy_compat::sptr new_legacy_compat =
         boost::make_shared<legacy_compat_impl>(device, args);
     legacy_cache[device.get()] = new_legacy_compat;
@@ -84,7 +84,18 @@ void block_iface::run_and_check(const std::string& code, const std::string& erro
     boost::mutex::scoped_lock local_interpreter_lock(_lil_mutex);
 
     UHD_NOCSCRIPT_LOG() << "[NocScript] Executing and asserting code: " << code;
-    expression::sptr e        = _parser->create_expr_tree(code);
+    // The same checks run on every argument write, so only parse each of them
+    // once. Trees don't hold any state between evaluations, and the types of
+    // block args (which the parser uses) don't change.
+    expression::sptr& e = _expr_cache[code];
+    if (not e) {
+        try {
+            e = _parser->create_expr_tree(code);
+        } catch (...) {
+            _expr_cache.erase(code);
+            throw;
+        }
+    }
     expression_literal result = e->eval();
     if (not result.to_bool()) {
         if (error_message.empty()) {
@@ -80,6 +80,9 @@ private:
 
     //! Container for scoped variables
     std::map<std::string, expression_literal> _vars;
+
+    //! Expression trees of the code run so far, by source code
+    std::map<std::string, expression::sptr> _expr_cache;
 };
 
 }}} /* namespace uhd::rfnoc::nocscript */
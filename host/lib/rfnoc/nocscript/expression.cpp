@@ -288,6 +288,26 @@ expression_literal expression_container::eval()
     return ret_val;
 }
 
+bool expression_container::is_constant() const
+{
+    for (const expression::sptr& sub_expr : _sub_exprs) {
+        if (not sub_expr->is_constant()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+expression::sptr expression_container::get_unwrapped() const
+{
+    // AND and OR containers are always boolean, whatever the sub-expression
+    if (_sub_exprs.size() != 1
+        or (_combiner != COMBINE_ALL and _combiner != COMBINE_NOTSET)) {
+        return expression::sptr();
+    }
+    return _sub_exprs.front();
+}
+
 /********************************************************************
  * Functions
  *******************************************************************/
@@ -324,6 +344,8 @@ void expression_function::add(expression::sptr new_expr)
 {
     expression_container::add(new_expr);
     _arg_types.push_back(new_expr->infer_type());
+    // The signature changed, so look the function up again
+    _function.clear();
 }
 
 expression::type_t expression_function::infer_type() const
@@ -333,7 +355,16 @@ expression::type_t expression_function::infer_type() const
 
 expression_literal expression_function::eval()
 {
-    return _func_table->eval(_name, _arg_types, _sub_exprs);
+    if (not _function) {
+        _function = _func_table->get_function(_name, _arg_types);
+    }
+    return _function(_sub_exprs);
+}
+
+bool expression_function::is_constant() const
+{
+    return _func_table->is_pure(_name, _arg_types)
+           and expression_container::is_constant();
 }
 
 
@@ -38,6 +38,14 @@ public:
 
     //! Evaluate current expression and return its return value
     virtual expression_literal eval() = 0;
+
+    /*! Returns true if this expression always evaluates to the same value,
+     * without side effects. Such expressions can be evaluated at parse time.
+     */
+    virtual bool is_constant() const
+    {
+        return false;
+    }
 };
 
 /*! Literal (constant) expression class
@@ -86,6 +94,11 @@ public:
         return *this; // TODO make sure this is copy
     }
 
+    bool is_constant() const
+    {
+        return true;
+    }
+
     /*! A 'type cast' to bool. Cast rules are similar to most
      * scripting languages:
      * - Integers and doubles are false if zero, true otherwise
@@ -239,6 +252,18 @@ public:
      */
     virtual expression_literal eval();
 
+    //! A container is constant if all its sub-expressions are
+    virtual bool is_constant() const;
+
+    /*! Returns the only sub-expression, if this container holds exactly one
+     * and evaluating it directly gives the same value and type as evaluating
+     * the container. Otherwise, returns an empty pointer.
+     *
+     * The parser wraps every argument into a container, this allows it to
+     * drop those wrappers again.
+     */
+    virtual expression::sptr get_unwrapped() const;
+
 protected:
     //! Store all the sub-expressions, in order
     expr_list_type _sub_exprs;
@@ -295,9 +320,22 @@ public:
     expression::type_t infer_type() const;
 
     /*! Evaluate all arguments, then the function itself.
+     *
+     * The function is looked up in the function table on the first call
+     * only, later calls go straight to the function object.
      */
     expression_literal eval();
 
+    //! A function call is constant if the function is pure and all arguments
+    // are constant
+    bool is_constant() const;
+
+    //! A function is never unwrapped
+    expression::sptr get_unwrapped() const
+    {
+        return expression::sptr();
+    }
+
     //! String representation
     std::string repr() const;
 
@@ -305,6 +343,8 @@ private:
     std::string _name;
     const boost::shared_ptr<function_table> _func_table;
     std::vector<expression::type_t> _arg_types;
+    //! The function object, once it's been looked up
+    boost::function<expression_literal(expr_list_type&)> _function;
 };
 
 
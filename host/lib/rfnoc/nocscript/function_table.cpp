@@ -20,11 +20,13 @@ public:
     {
         expression::type_t return_type;
         function_ptr function;
+        bool pure;
 
-        function_info() : return_type(expression::TYPE_INT){};
-        function_info(
-            const expression::type_t return_type_, const function_ptr& function_)
-            : return_type(return_type_), function(function_){};
+        function_info() : return_type(expression::TYPE_INT), pure(false){};
+        function_info(const expression::type_t return_type_,
+            const function_ptr& function_,
+            const bool pure_)
+            : return_type(return_type_), function(function_), pure(pure_){};
     };
     // Should be an unordered_map... sigh, we'll get to C++11 someday.
     typedef std::map<std::string,
@@ -82,12 +84,35 @@ public:
         return _table[name][arg_types].function(arguments);
     }
 
+    function_ptr get_function(const std::string& name,
+        const expression_function::argtype_list_type& arg_types) const
+    {
+        table_type::const_iterator it = _table.find(name);
+        if (it == _table.end() or (it->second.find(arg_types) == it->second.end())) {
+            throw uhd::syntax_error(
+                str(boost::format("Cannot eval() function %s, not a known signature")
+                    % expression_function::to_string(name, arg_types)));
+        }
+        return it->second.find(arg_types)->second.function;
+    }
+
+    bool is_pure(const std::string& name,
+        const expression_function::argtype_list_type& arg_types) const
+    {
+        table_type::const_iterator it = _table.find(name);
+        if (it == _table.end() or (it->second.find(arg_types) == it->second.end())) {
+            return false;
+        }
+        return it->second.find(arg_types)->second.pure;
+    }
+
     void register_function(const std::string& name,
         const function_table::function_ptr& ptr,
         const expression::type_t return_type,
-        const expression_function::argtype_list_type& sig)
+        const expression_function::argtype_list_type& sig,
+        const bool pure)
     {
-        _table[name][sig] = function_info(return_type, ptr);
+        _table[name][sig] = function_info(return_type, ptr, pure);
     }
 
 private:
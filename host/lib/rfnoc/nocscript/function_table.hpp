@@ -57,17 +57,40 @@ public:
         const expression_function::argtype_list_type& arg_types,
         expression_container::expr_list_type& arguments) = 0;
 
+    /*! Look up the function \p name with the given argument types
+     *
+     * Lets callers resolve a function once and then call it directly,
+     * rather than going through eval() every time.
+     *
+     * \returns The function object
+     * \throws uhd::syntax_error if no such function is found
+     */
+    virtual function_ptr get_function(const std::string& name,
+        const expression_function::argtype_list_type& arg_types) const = 0;
+
+    /*! Check if a function only depends on its arguments
+     *
+     * \returns True, if such a function is registered and was registered as
+     *          pure. Calls to it with constant arguments can be evaluated
+     *          when parsing.
+     */
+    virtual bool is_pure(const std::string& name,
+        const expression_function::argtype_list_type& arg_types) const = 0;
+
     /*! Register a new function
      *
      * \param name Name of the function (e.g. 'ADD')
      * \param ptr Function object
      * \param return_type The function's return value
      * \param sig The function signature (list of argument types)
+     * \param pure Set to true if the function has no side effects and its
+     *             return value only depends on its arguments
      */
     virtual void register_function(const std::string& name,
         const function_ptr& ptr,
         const expression::type_t return_type,
-        const expression_function::argtype_list_type& sig) = 0;
+        const expression_function::argtype_list_type& sig,
+        const bool pure = false) = 0;
 };
 
 }}} /* namespace uhd::rfnoc::nocscript */
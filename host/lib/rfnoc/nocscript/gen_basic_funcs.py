@@ -256,6 +256,9 @@ BOOL SLEEP(DOUBLE)
     ${RETURN}(true);
 }
 """
+# Functions with side effects. All others only depend on their arguments, so
+# the parser may evaluate calls to them with constant arguments right away.
+IMPURE_FUNCS = ['SLEEP']
 # End of interesting part. The rest will take this and turn into a C++
 # header file.
 #############################################################################
@@ -318,7 +321,8 @@ REGISTER_COMMANDS_TEMPLATE = """
             "${name}",
             boost::bind(&${func_name}, _1),
             expression::TYPE_${retval},
-            ${func_name}_args
+            ${func_name}_args,
+            ${'true' if pure else 'false'}
     );"""
 
 DOXY_TEMPLATE = """/*! \page page_nocscript_funcs NocScript Function Reference
@@ -421,6 +425,7 @@ def write_function_header(output_filename):
         )
         registry_commands += parse_tmpl(
                 REGISTER_COMMANDS_TEMPLATE,
+                pure=func['name'] not in IMPURE_FUNCS,
                 **func
         )
     # Step 2: Write the registry process
@@ -95,7 +95,7 @@ private:
             expr_stack.push(expression_container::make());
         }
 
-        expression::sptr get_result()
+        expression_container::sptr get_result()
         {
             UHD_ASSERT_THROW(expr_stack.size() == 1);
             return expr_stack.top();
@@ -225,13 +225,13 @@ private:
                     expression_container::sptr c = P.expr_stack.top();
                     P.expr_stack.pop();
                     if (not c->empty()) {
-                        P.expr_stack.top()->add(c);
+                        P.expr_stack.top()->add(fold(c));
                     }
                     // At the end of (), either a function or container is complete,
                     // so pop that and add it to its top container:
                     expression_container::sptr c2 = P.expr_stack.top();
                     P.expr_stack.pop();
-                    P.expr_stack.top()->add(c2);
+                    P.expr_stack.top()->add(fold(c2));
                     next_valid_state = VALID_OPERATOR | VALID_COMMA | VALID_PARENS_CLOSE;
                 } break;
 
@@ -250,7 +250,7 @@ private:
                     // the current container:
                     expression_container::sptr c = P.expr_stack.top();
                     P.expr_stack.pop();
-                    P.expr_stack.top()->add(c);
+                    P.expr_stack.top()->add(fold(c));
                     // It also means another expression is following, so create another
                     // empty container for that:
                     P.expr_stack.push(expression_container::make());
@@ -309,6 +309,27 @@ private:
         }
     };
 
+    /*! Simplify a complete container before it gets added to its parent.
+     *
+     * Constant sub-trees (literals, and pure functions of literals) are
+     * replaced by their value, and single-expression containers are replaced
+     * by that expression. This way, evaluating the tree only does work that
+     * actually depends on variables or has side effects.
+     */
+    static expression::sptr fold(expression_container::sptr c)
+    {
+        if (c->is_constant()) {
+            try {
+                return expression_literal::make(c->eval());
+            } catch (const std::exception&) {
+                // Leave it as it is, so the error is raised when the code is
+                // actually run
+            }
+        }
+        expression::sptr unwrapped = c->get_unwrapped();
+        return unwrapped ? unwrapped : c;
+    }
+
 public:
     expression::sptr create_expr_tree(const std::string& code)
     {
@@ -316,15 +337,12 @@ public:
         grammar_props P(_ftable, _var_type_getter, _var_value_getter);
         int next_valid_state = grammar::VALID_EXPRESSION;
 
-        // Create a lexer instance
-        ns_lexer<lex::lexertl::lexer<>> lexer_functor;
-
         // Tokenize the string
         char const* first = code.c_str();
         char const* last  = &first[code.size()];
         bool r            = lex::tokenize(first,
             last, // Iterators
-            lexer_functor, // Lexer
+            _lexer, // Lexer
             boost::bind(grammar(),
                 _1,
                 boost::ref(P),
@@ -340,10 +358,14 @@ public:
         }
 
         // Clear stack and return result
-        return P.get_result();
+        return fold(P.get_result());
     }
 
 private:
+    //! The lexer is built from the token definitions once, building it is
+    // more expensive than tokenizing a typical line of NocScript.
+    const ns_lexer<lex::lexertl::lexer<>> _lexer;
+
     function_table::sptr _ftable;
     expression_variable::type_getter_type _var_type_getter;
     expression_variable::value_getter_type _var_value_getter;
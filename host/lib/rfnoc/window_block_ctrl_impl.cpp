@@ -54,14 +54,17 @@ public:
             coeffs_.push_back(coeffs[i]);
         }
 
-        // Write coefficients via the load bus
+        // Write coefficients via the load bus, as one burst
+        std::vector<std::pair<uint32_t, uint32_t>> writes;
+        writes.reserve(window_len + 1);
         for (size_t i = 0; i < window_len - 1; i++) {
-            sr_write(AXIS_WINDOW_LOAD, coeffs_[i]);
+            writes.push_back(std::make_pair(uint32_t(AXIS_WINDOW_LOAD), coeffs_[i]));
         }
         // Assert tlast when sending the final coefficient (sorry, no joke here)
-        sr_write(AXIS_WINDOW_LOAD_TLAST, coeffs_.back());
+        writes.push_back(std::make_pair(uint32_t(AXIS_WINDOW_LOAD_TLAST), coeffs_.back()));
         // Set the window length
-        sr_write(SR_WINDOW_LEN, window_len);
+        writes.push_back(std::make_pair(uint32_t(SR_WINDOW_LEN), uint32_t(window_len)));
+        sr_write_burst(writes);
 
         // This block requires spp to match the window length:
         set_arg<int>("spp", int(window_len));
@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include <uhd/exception.hpp>
 #include <uhd/stream.hpp>
 
 using namespace uhd;
@@ -14,7 +15,39 @@ rx_streamer::~rx_streamer(void)
     //empty
 }
 
+stream_stats_t rx_streamer::get_stats(void) const
+{
+    return stream_stats_t();
+}
+
+size_t rx_streamer::recv_views(rx_view_batch_t&, const size_t, const double)
+{
+    throw uhd::not_implemented_error("This streamer does not support recv_views()");
+}
+
+void rx_streamer::release_views(rx_view_batch_t& batch)
+{
+    batch.frames.clear();
+}
+
+void rx_streamer::set_iq_dc_correction(const size_t, const convert::iq_dc_correction_t&)
+{
+    throw uhd::not_implemented_error(
+        "This streamer does not support set_iq_dc_correction()");
+}
+
 tx_streamer::~tx_streamer(void)
 {
     //empty
 }
+
+stream_stats_t tx_streamer::get_stats(void) const
+{
+    return stream_stats_t();
+}
+
+void tx_streamer::set_iq_dc_correction(const size_t, const convert::iq_dc_correction_t&)
+{
+    throw uhd::not_implemented_error(
+        "This streamer does not support set_iq_dc_correction()");
+}
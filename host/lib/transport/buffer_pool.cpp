@@ -7,8 +7,17 @@
 
 #include <uhd/transport/buffer_pool.hpp>
 #include <uhd/transport/zero_copy.hpp>
+#include <uhd/utils/log.hpp>
 #include <boost/shared_array.hpp>
+#include <cstring>
 #include <vector>
+#ifdef UHD_PLATFORM_LINUX
+#    include <linux/mempolicy.h>
+#    include <sys/mman.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#    include <cerrno>
+#endif
 
 using namespace uhd::transport;
 
@@ -27,11 +36,95 @@ static size_t pad_to_boundary(const size_t bytes, const size_t alignment)
     return bytes + (alignment - bytes) % alignment;
 }
 
+const int buffer_pool::NUMA_NODE_ANY   = -1;
+const int buffer_pool::NUMA_NODE_LOCAL = -2;
+
 buffer_pool::~buffer_pool(void)
 {
     /* NOP */
 }
 
+/***********************************************************************
+ * Memory allocation with huge pages and NUMA placement
+ **********************************************************************/
+#ifdef UHD_PLATFORM_LINUX
+static const size_t HUGE_PAGE_SIZE = 2 << 20;
+
+//! Unmaps the memory of a pool when the last reference goes away
+struct munmap_deleter
+{
+    size_t size;
+    void operator()(char* mem) const
+    {
+        ::munmap(mem, size);
+    }
+};
+
+//! Set the memory policy of a mapping before its pages are touched
+static void place_on_numa_node(void* mem, const size_t size, int node)
+{
+    if (node == buffer_pool::NUMA_NODE_LOCAL) {
+        unsigned cpu = 0, local_node = 0;
+        if (::syscall(SYS_getcpu, &cpu, &local_node, nullptr) != 0) {
+            UHD_LOG_WARNING("BUFFER_POOL",
+                "Cannot find the NUMA node of the calling thread: " << strerror(errno));
+            return;
+        }
+        node = int(local_node);
+    }
+    const size_t bits_per_word = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> node_mask(size_t(node) / bits_per_word + 1, 0);
+    node_mask.back() = 1UL << (size_t(node) % bits_per_word);
+    // Preferred rather than bound: when the node runs out of (huge) pages,
+    // the kernel takes them from another node instead of failing the fault
+    if (::syscall(SYS_mbind,
+            mem,
+            size,
+            MPOL_PREFERRED,
+            node_mask.data(),
+            node_mask.size() * bits_per_word + 1,
+            0)
+        != 0) {
+        UHD_LOG_WARNING("BUFFER_POOL",
+            "Cannot place the buffers on NUMA node " << node << ": " << strerror(errno));
+    }
+}
+
+static boost::shared_array<char> map_pool_mem(
+    const size_t size, const buffer_pool::alloc_params& params)
+{
+    size_t map_size = size;
+    void* mem       = MAP_FAILED;
+    if (params.use_huge_pages) {
+        map_size = pad_to_boundary(size, HUGE_PAGE_SIZE);
+        mem      = ::mmap(nullptr,
+            map_size,
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+            -1,
+            0);
+        if (mem == MAP_FAILED) {
+            UHD_LOG_DEBUG("BUFFER_POOL",
+                "Cannot map " << map_size << " bytes of huge pages ("
+                              << strerror(errno) << "), using normal pages");
+        }
+    }
+    if (mem == MAP_FAILED) {
+        map_size = size;
+        mem      = ::mmap(
+            nullptr, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    if (mem == MAP_FAILED) {
+        return boost::shared_array<char>();
+    }
+    if (params.numa_node != buffer_pool::NUMA_NODE_ANY) {
+        place_on_numa_node(mem, map_size, params.numa_node);
+    }
+    std::memset(mem, 0, map_size);
+    return boost::shared_array<char>(static_cast<char*>(mem), munmap_deleter{map_size});
+}
+#endif /* UHD_PLATFORM_LINUX */
+
 /***********************************************************************
  * Buffer pool implementation
  **********************************************************************/
@@ -64,12 +157,30 @@ private:
  **********************************************************************/
 buffer_pool::sptr buffer_pool::make(
     const size_t num_buffs, const size_t buff_size, const size_t alignment)
+{
+    alloc_params params;
+    params.alignment = alignment;
+    return make(num_buffs, buff_size, params);
+}
+
+buffer_pool::sptr buffer_pool::make(
+    const size_t num_buffs, const size_t buff_size, const alloc_params& params)
 {
     // 1) pad the buffer size to be a multiple of alignment
     // 2) pad the overall memory size for room after alignment
     // 3) allocate the memory in one block of sufficient size
+    const size_t alignment        = params.alignment;
     const size_t padded_buff_size = pad_to_boundary(buff_size, alignment);
-    boost::shared_array<char> mem(new char[padded_buff_size * num_buffs + alignment - 1]);
+    const size_t mem_size         = padded_buff_size * num_buffs + alignment - 1;
+    boost::shared_array<char> mem;
+#ifdef UHD_PLATFORM_LINUX
+    if (params.use_huge_pages or params.numa_node != NUMA_NODE_ANY) {
+        mem = map_pool_mem(mem_size, params);
+    }
+#endif
+    if (not mem) {
+        mem.reset(new char[mem_size]);
+    }
 
     // Fill a vector with boundary-aligned points in the memory
     const size_t mem_start = pad_to_boundary(size_t(mem.get()), alignment);
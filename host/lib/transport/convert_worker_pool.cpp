@@ -0,0 +1,236 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/safe_call.hpp>
+#include <uhd/utils/thread.hpp>
+#include <uhdlib/transport/convert_worker_pool.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread/thread.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#    include <emmintrin.h>
+#    define HAVE_MM_PAUSE
+#endif
+
+using namespace uhd;
+using namespace uhd::transport;
+
+constexpr size_t convert_worker_pool::DEFAULT_SPIN_ITERATIONS;
+
+convert_worker_pool::~convert_worker_pool(void)
+{
+    /* NOP */
+}
+
+//! Tell the CPU we are busy-waiting, so the sibling hyperthread gets to run
+static UHD_INLINE void spin_pause(void)
+{
+#ifdef HAVE_MM_PAUSE
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+/***********************************************************************
+ * Worker pool implementation:
+ * The work for one call to run() is described by a single atomic word
+ * holding the generation (upper 32 bits), the number of channels and
+ * the next channel to claim (16 bits each). Workers claim channels with
+ * a compare-and-swap, so a worker still finishing up a previous
+ * generation can never claim a channel of the current one by accident.
+ **********************************************************************/
+class convert_worker_pool_impl : public convert_worker_pool
+{
+public:
+    convert_worker_pool_impl(const size_t num_threads,
+        const std::vector<size_t>& cpu_affinity,
+        const size_t spin_iterations)
+        : _spin_iterations(spin_iterations)
+        , _state(0)
+        , _tasks_done(0)
+        , _num_sleeping(0)
+        , _task(nullptr)
+        , _done(false)
+    {
+        for (size_t i = 1; i < num_threads; i++) {
+            std::vector<size_t> cpus;
+            if (not cpu_affinity.empty()) {
+                cpus.push_back(cpu_affinity[(i - 1) % cpu_affinity.size()]);
+            }
+            boost::thread* thread = _threads.create_thread(
+                boost::bind(&convert_worker_pool_impl::worker_loop, this, i, cpus));
+            set_thread_name(thread, "uhd_convert_" + std::to_string(i));
+        }
+        UHD_LOGGER_DEBUG("XPORT")
+            << "Created conversion worker pool with " << num_threads << " threads";
+    }
+
+    ~convert_worker_pool_impl(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _done = true;
+        }
+        _cond.notify_all();
+        UHD_SAFE_CALL(_threads.join_all();)
+    }
+
+    size_t size(void) const
+    {
+        return _threads.size() + 1;
+    }
+
+    void run(const size_t num_chans, const task_type& task)
+    {
+        if (_threads.size() == 0 or num_chans < 2) {
+            for (size_t i = 0; i < num_chans; i++) {
+                task(i, 0);
+            }
+            return;
+        }
+        UHD_ASSERT_THROW(num_chans <= 0xffff);
+
+        // publish the new generation of work
+        _task = &task;
+        _tasks_done.store(0, std::memory_order_relaxed);
+        const uint64_t gen = (_state.load(std::memory_order_relaxed) >> 32) + 1;
+        _state.store((gen << 32) | (uint64_t(num_chans) << 16));
+        if (_num_sleeping.load() != 0) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _cond.notify_all();
+        }
+
+        // take part in the work, then wait for the other workers
+        do_work(uint32_t(gen), 0);
+        while (_tasks_done.load(std::memory_order_acquire) != num_chans) {
+            std::this_thread::yield();
+        }
+        _task = nullptr;
+
+        if (_exception) {
+            std::exception_ptr e = _exception;
+            _exception           = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+private:
+    //! Claim and run channels until there are none left in this generation
+    void do_work(const uint32_t gen, const size_t worker_idx)
+    {
+        uint64_t state = _state.load(std::memory_order_acquire);
+        while (true) {
+            const size_t num_chans = size_t(state >> 16) & 0xffff;
+            const size_t chan      = size_t(state) & 0xffff;
+            if (uint32_t(state >> 32) != gen or chan >= num_chans) {
+                return;
+            }
+            if (not _state.compare_exchange_weak(state, state + 1)) {
+                continue;
+            }
+            try {
+                (*_task)(chan, worker_idx);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (not _exception) {
+                    _exception = std::current_exception();
+                }
+            }
+            _tasks_done.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    void worker_loop(const size_t worker_idx, const std::vector<size_t> cpus)
+    {
+        set_thread_affinity(cpus);
+
+        uint32_t last_gen = 0;
+        size_t spins      = 0;
+        while (true) {
+            const uint32_t gen = uint32_t(_state.load(std::memory_order_acquire) >> 32);
+            if (gen != last_gen) {
+                last_gen = gen;
+                spins    = 0;
+                do_work(gen, worker_idx);
+                continue;
+            }
+            if (++spins < _spin_iterations) {
+                spin_pause();
+                continue;
+            }
+
+            // nothing to do for a while: go to sleep
+            std::unique_lock<std::mutex> lock(_mutex);
+            _num_sleeping++;
+            _cond.wait(lock, [this, last_gen]() {
+                return _done or uint32_t(_state.load() >> 32) != last_gen;
+            });
+            _num_sleeping--;
+            if (_done) {
+                return;
+            }
+            spins = 0;
+        }
+    }
+
+    const size_t _spin_iterations;
+    std::atomic<uint64_t> _state;
+    std::atomic<size_t> _tasks_done;
+    std::atomic<size_t> _num_sleeping;
+    const task_type* _task;
+    std::exception_ptr _exception;
+    bool _done;
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    boost::thread_group _threads;
+};
+
+/***********************************************************************
+ * Worker pool factories
+ **********************************************************************/
+convert_worker_pool::sptr convert_worker_pool::make(const size_t num_threads,
+    const std::vector<size_t>& cpu_affinity,
+    const size_t spin_iterations)
+{
+    if (num_threads == 0) {
+        throw uhd::value_error("convert_worker_pool needs at least one thread");
+    }
+    return sptr(new convert_worker_pool_impl(num_threads, cpu_affinity, spin_iterations));
+}
+
+convert_worker_pool::sptr convert_worker_pool::make(const uhd::device_addr_t& args)
+{
+    const size_t num_threads = args.cast<size_t>("convert_threads", 1);
+    if (num_threads <= 1) {
+        return nullptr;
+    }
+
+    std::vector<size_t> cpu_affinity;
+    if (args.has_key("convert_cpus")) {
+        std::vector<std::string> cpus;
+        boost::split(cpus, args["convert_cpus"], boost::is_any_of(":"));
+        for (const std::string& cpu : cpus) {
+            try {
+                cpu_affinity.push_back(boost::lexical_cast<size_t>(boost::trim_copy(cpu)));
+            } catch (const boost::bad_lexical_cast&) {
+                throw uhd::value_error("Invalid CPU number in convert_cpus: " + cpu);
+            }
+        }
+    }
+
+    return make(num_threads,
+        cpu_affinity,
+        args.cast<size_t>("convert_spin", DEFAULT_SPIN_ITERATIONS));
+}
@@ -12,6 +12,8 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
 #include <boost/make_shared.hpp>
+#include <algorithm>
+#include <array>
 #include <stack>
 #include <sys/syslog.h>
 #include <arpa/inet.h>
@@ -24,6 +26,8 @@ constexpr size_t DEFAULT_FRAME_SIZE = 8000;
 constexpr int DEFAULT_NUM_MBUFS = 4095;
 constexpr int DEFAULT_MBUF_CACHE_SIZE = 315;
 constexpr size_t UHD_DPDK_HEADERS_SIZE = 14 + 20 + 8; // Ethernet + IPv4 + UDP
+//! Maximum number of buffers to get from a socket at once
+constexpr unsigned int BUFF_BURST_SIZE = 32;
 
 inline char * eal_add_opt(std::vector<const char*> &argv, size_t n,
     char *dst, const char *opt, const char *arg)
@@ -140,7 +144,7 @@ void uhd_dpdk_ctx::init(const device_addr_t &user_args)
         /* Get configuration for all the NIC ports */
         device_addrs_t args = separate_device_addr(user_args);
         int num_ports = uhd_dpdk_port_count();
-        std::vector<int> io_cpu_map(num_ports);
+        std::vector<int> io_cpu_map(num_ports * UHD_DPDK_MAX_QUEUES_PER_PORT, -1);
         device_addrs_t nics(num_ports);
         for (ssize_t i = 0; i < num_ports; i++) {
             struct eth_addr mac_addr = uhd_dpdk_get_eth_addr(i);
@@ -158,13 +162,25 @@ void uhd_dpdk_ctx::init(const device_addr_t &user_args)
             if (nics[i].has_key("dpdk-ipv4")
                 && nics[i].has_key("dpdk-io-cpu")) {
                 uint32_t ipv4_addr, netmask;
-                io_cpu_map[i] = std::atoi(nics[i]["dpdk-io-cpu"].c_str());
+                /* NOTE: This arg may have commas (one CPU per queue), so
+                 * multiple queues are limited to config file
+                 */
+                std::vector<std::string> io_cpus;
+                boost::algorithm::split(io_cpus, nics[i]["dpdk-io-cpu"],
+                    [](const char &in) {return in == ',';}, boost::token_compress_on);
+                if (io_cpus.size() > UHD_DPDK_MAX_QUEUES_PER_PORT) {
+                    UHD_LOG_WARNING("DPDK", "NIC(" << i << "): Only using the first "
+                        << UHD_DPDK_MAX_QUEUES_PER_PORT << " I/O CPUs");
+                    io_cpus.resize(UHD_DPDK_MAX_QUEUES_PER_PORT);
+                }
+                for (size_t q = 0; q < io_cpus.size(); q++) {
+                    io_cpu_map[i * UHD_DPDK_MAX_QUEUES_PER_PORT + q] =
+                        std::atoi(io_cpus[q].c_str());
+                }
                 separate_ipv4_addr(nics[i]["dpdk-ipv4"], ipv4_addr, netmask);
                 uhd_dpdk_set_ipv4_addr((unsigned int) i, ipv4_addr, netmask);
-            } else {
-                /* Not enough configuration to use NIC */
-                io_cpu_map[i] = -1;
             }
+            /* Otherwise, not enough configuration to use NIC */
             UHD_LOG_TRACE("DPDK", "Found NIC(" << i << "):" << std::endl
                 << nics[i].to_pp_string());
         }
@@ -255,12 +271,9 @@ public:
         }
     }
 
-    sptr get_new(double timeout)
+    sptr get_new(struct rte_mbuf *buf)
     {
-        int bufs = uhd_dpdk_request_tx_bufs(_sock, &_buf, 1, timeout);
-        if (bufs != 1 || !_buf)
-            return sptr();
-
+        _buf = buf;
         return make(this, uhd_dpdk_buf_to_data(_sock, _buf),
                     _frame_size);
     }
@@ -287,15 +300,9 @@ public:
         }
     }
 
-    sptr get_new(double timeout)
+    sptr get_new(struct rte_mbuf *buf)
     {
-        int bufs = uhd_dpdk_recv(_sock, &_buf, 1, (int) (timeout*USEC));
-        if (bufs != 1 || _buf == nullptr) {
-            // Push back into pool if we didn't get a real buffer
-            _free_bufs.push(this);
-            return sptr();
-        }
-
+        _buf = buf;
         return make(this, uhd_dpdk_buf_to_data(_sock, _buf),
                     uhd_dpdk_get_len(_sock, _buf));
     }
@@ -321,7 +328,11 @@ public:
                             _recv_frame_size(xport_params.recv_frame_size),
                             _port_id(dpdk_port_id),
                             _rx_empty_count(0),
-                            _tx_empty_count(0)
+                            _tx_empty_count(0),
+                            _rx_cache_head(0),
+                            _rx_cache_tail(0),
+                            _tx_cache_head(0),
+                            _tx_cache_tail(0)
     {
         UHD_ASSERT_THROW(xport_params.recv_frame_size > 0);
         UHD_ASSERT_THROW(xport_params.send_frame_size > 0);
@@ -395,6 +406,13 @@ public:
                               << "RX empty count is " << _rx_empty_count);
         UHD_LOG_TRACE("DPDK", "(" << ntohs(sockarg.remote_port) << "," << ntohs(sockarg.local_port) << ") "
                               << "TX empty count is " << _tx_empty_count);
+        // Return the buffers that were fetched, but never handed out
+        for (; _rx_cache_head < _rx_cache_tail; _rx_cache_head++) {
+            uhd_dpdk_free_buf(_rx_cache[_rx_cache_head]);
+        }
+        for (; _tx_cache_head < _tx_cache_tail; _tx_cache_head++) {
+            uhd_dpdk_free_buf(_tx_cache[_tx_cache_head]);
+        }
         uhd_dpdk_sock_close(_rx_sock);
         uhd_dpdk_sock_close(_tx_sock);
     }
@@ -406,12 +424,23 @@ public:
             return managed_recv_buffer::sptr();
         }
 
+        // Get as many packets as there are buffers for, but only wait for one
+        if (_rx_cache_head == _rx_cache_tail) {
+            const unsigned int num_bufs =
+                std::min<size_t>(_mrb_pool.size(), _rx_cache.size());
+            int bufs = uhd_dpdk_recv(_rx_sock, _rx_cache.data(), num_bufs,
+                                     (int) (timeout*USEC));
+            if (bufs <= 0) {
+                _rx_empty_count++;
+                return managed_recv_buffer::sptr();
+            }
+            _rx_cache_head = 0;
+            _rx_cache_tail = bufs;
+        }
+
         dpdk_zero_copy_mrb *mrb = _mrb_pool.top();
         _mrb_pool.pop();
-        managed_recv_buffer::sptr buff = mrb->get_new(timeout);
-        if (!buff)
-            _rx_empty_count++;
-        return buff;
+        return mrb->get_new(_rx_cache[_rx_cache_head++]);
     }
 
     size_t get_num_recv_frames(void) const
@@ -431,12 +460,22 @@ public:
             return managed_send_buffer::sptr();
         }
 
+        if (_tx_cache_head == _tx_cache_tail) {
+            const unsigned int num_bufs =
+                std::min<size_t>(_msb_pool.size(), _tx_cache.size());
+            int bufs = uhd_dpdk_request_tx_bufs(_tx_sock, _tx_cache.data(),
+                                                num_bufs, timeout);
+            if (bufs <= 0) {
+                _tx_empty_count++;
+                return managed_send_buffer::sptr();
+            }
+            _tx_cache_head = 0;
+            _tx_cache_tail = bufs;
+        }
+
         dpdk_zero_copy_msb *msb = _msb_pool.top();
         _msb_pool.pop();
-        managed_send_buffer::sptr buff = msb->get_new(timeout);
-        if (!buff)
-            _tx_empty_count++;
-        return buff;
+        return msb->get_new(_tx_cache[_tx_cache_head++]);
     }
 
     size_t get_num_send_frames(void) const
@@ -484,6 +523,15 @@ private:
     unsigned int _rx_empty_count;
     unsigned int _tx_empty_count;
 
+    // Packets received in the last burst, but not handed out yet
+    std::array<struct rte_mbuf *, BUFF_BURST_SIZE> _rx_cache;
+    unsigned int _rx_cache_head;
+    unsigned int _rx_cache_tail;
+    // Free TX buffers from the last burst, not handed out yet
+    std::array<struct rte_mbuf *, BUFF_BURST_SIZE> _tx_cache;
+    unsigned int _tx_cache_head;
+    unsigned int _tx_cache_tail;
+
     std::stack<dpdk_zero_copy_mrb *, std::vector<dpdk_zero_copy_mrb *>> _mrb_pool;
     std::stack<dpdk_zero_copy_msb *, std::vector<dpdk_zero_copy_msb *>> _msb_pool;
 };
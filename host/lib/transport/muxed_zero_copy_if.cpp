@@ -6,18 +6,28 @@
 //
 
 #include <uhd/exception.hpp>
-#include <uhd/transport/bounded_buffer.hpp>
 #include <uhd/transport/muxed_zero_copy_if.hpp>
+#include <uhd/utils/log.hpp>
 #include <uhd/utils/safe_call.hpp>
+#include <uhdlib/transport/spsc_queue.hpp>
+#include <uhdlib/utils/atomic.hpp>
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/thread.hpp>
 #include <boost/thread/locks.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
 #include <map>
+#include <vector>
 
 using namespace uhd;
 using namespace uhd::transport;
 
+//! Dropped frames are reported at most this often
+static const std::chrono::seconds DROP_LOG_INTERVAL(1);
+
 class muxed_zero_copy_if_impl
     : public muxed_zero_copy_if,
       public boost::enable_shared_from_this<muxed_zero_copy_if_impl>
@@ -32,6 +42,8 @@ public:
         , _classify(classify_fn)
         , _max_num_streams(max_streams)
         , _num_dropped_frames(0)
+        , _num_unlogged_full(0)
+        , _num_unlogged_unknown(0)
     {
         // Create the receive thread to poll the underlying transport
         // and classify packets into queues
@@ -65,19 +77,21 @@ public:
             throw uhd::runtime_error("muxed_zero_copy_if: stream capacity exceeded. "
                                      "cannot create more streams.");
         }
-        // Only allocate a portion of the base transport's frames to each stream
-        // to prevent all streams from attempting to use all the frames.
+        // The stream still advertises all the base transport's frames. How
+        // many of them it may hold on to is decided per frame, see
+        // _process_next_buffer().
         stream_impl::sptr stream =
             boost::make_shared<stream_impl>(this->shared_from_this(),
                 stream_num,
                 _base_xport->get_num_send_frames(),
                 _base_xport->get_num_recv_frames());
-        _streams[stream_num] = stream;
+        _streams[stream_num] = stream.get();
         return stream;
     }
 
     virtual size_t get_num_dropped_frames() const
     {
+        boost::lock_guard<boost::mutex> lock(_mutex);
         return _num_dropped_frames;
     }
 
@@ -89,36 +103,60 @@ public:
 
 private:
     /*
-     * @class stream_mrb is used to copy the data and release the original
-     * managed receive buffer back to the base transport.
+     * @class stream_mrb hands a managed receive buffer of the base transport
+     * to a stream without copying it. The base buffer is only released back
+     * to the base transport when the stream's consumer releases this buffer.
+     * Once the stream holds its quota of base buffers, the frame is copied
+     * into this buffer's own memory instead.
      */
     class stream_mrb : public managed_recv_buffer
     {
     public:
-        stream_mrb(size_t size) : _buff(new char[size]) {}
+        stream_mrb(std::atomic<size_t>& num_held, const size_t size)
+            : _num_held(num_held), _buff(size)
+        {
+        }
 
-        ~stream_mrb()
+        void release()
         {
-            delete[] _buff;
+            if (_base_buff) {
+                _base_buff.reset();
+                _num_held--;
+            }
+            _claimer.release();
         }
 
-        void release() {}
+        UHD_INLINE bool try_claim(void)
+        {
+            return _claimer.try_claim();
+        }
 
-        UHD_INLINE sptr get_new(char* buff, size_t len)
+        UHD_INLINE sptr get_new(managed_recv_buffer::sptr&& base_buff)
         {
-            memcpy(_buff, buff, len);
-            return make(this, _buff, len);
+            _num_held++;
+            _base_buff = std::move(base_buff);
+            return make(this, _base_buff->cast<void*>(), _base_buff->size());
+        }
+
+        UHD_INLINE sptr get_copy(managed_recv_buffer::sptr&& base_buff)
+        {
+            const size_t len = std::min(base_buff->size(), _buff.size());
+            std::memcpy(_buff.data(), base_buff->cast<const void*>(), len);
+            base_buff.reset();
+            return make(this, _buff.data(), len);
         }
 
     private:
-        char* _buff;
+        std::atomic<size_t>& _num_held;
+        managed_recv_buffer::sptr _base_buff;
+        std::vector<char> _buff;
+        simple_claimer _claimer;
     };
 
     class stream_impl : public zero_copy_if
     {
     public:
         typedef boost::shared_ptr<stream_impl> sptr;
-        typedef boost::weak_ptr<stream_impl> wptr;
 
         stream_impl(muxed_zero_copy_if_impl::sptr muxed_xport,
             const uint32_t stream_num,
@@ -130,12 +168,13 @@ private:
             , _send_frame_size(_muxed_xport->base_xport()->get_send_frame_size())
             , _num_recv_frames(num_recv_frames)
             , _recv_frame_size(_muxed_xport->base_xport()->get_recv_frame_size())
+            , _num_held(0)
             , _buff_queue(num_recv_frames)
             , _buffers(num_recv_frames)
             , _buffer_index(0)
         {
             for (size_t i = 0; i < num_recv_frames; i++) {
-                _buffers[i] = boost::make_shared<stream_mrb>(_recv_frame_size);
+                _buffers[i] = boost::make_shared<stream_mrb>(_num_held, _recv_frame_size);
             }
         }
 
@@ -171,11 +210,36 @@ private:
             }
         }
 
-        void push_recv_buff(managed_recv_buffer::sptr buff)
+        /*!
+         * Hand a frame of the base transport to the consumer. Never blocks,
+         * so a stream that is not drained can't stall the other streams.
+         * \param buff the frame of the base transport
+         * \param zero_copy_quota how many base frames the stream may hold,
+         *        beyond that the frame is copied
+         * \return false if all the stream's buffers are in use and the frame
+         *         was dropped
+         */
+        bool push_recv_buff(
+            managed_recv_buffer::sptr&& buff, const size_t zero_copy_quota)
         {
-            _buff_queue.push_with_wait(
-                _buffers.at(_buffer_index++)->get_new(buff->cast<char*>(), buff->size()));
-            _buffer_index %= _buffers.size();
+            stream_mrb* mrb = nullptr;
+            for (size_t i = 0; i < _buffers.size() and not mrb; i++) {
+                stream_mrb* candidate = _buffers[_buffer_index].get();
+                _buffer_index         = (_buffer_index + 1) % _buffers.size();
+                if (candidate->try_claim()) {
+                    mrb = candidate;
+                }
+            }
+            if (not mrb) {
+                buff.reset();
+                return false;
+            }
+            // Every claimed buffer has a free slot in the queue. Move the
+            // buffer in, so the consumer holds the only reference to it.
+            _buff_queue.push_with_haste(_num_held < zero_copy_quota
+                                            ? mrb->get_new(std::move(buff))
+                                            : mrb->get_copy(std::move(buff)));
+            return true;
         }
 
         size_t get_num_send_frames(void) const
@@ -200,7 +264,10 @@ private:
         const size_t _send_frame_size;
         const size_t _num_recv_frames;
         const size_t _recv_frame_size;
-        bounded_buffer<managed_recv_buffer::sptr> _buff_queue;
+        // Number of base transport frames held by the stream's buffers
+        std::atomic<size_t> _num_held;
+        // Filled by the muxer's receive thread, drained by the stream owner
+        spsc_queue<managed_recv_buffer::sptr> _buff_queue;
         std::vector<boost::shared_ptr<stream_mrb>> _buffers;
         size_t _buffer_index;
     };
@@ -250,29 +317,33 @@ private:
     {
         managed_recv_buffer::sptr buff = _base_xport->get_recv_buff(0.0);
         if (buff) {
-            stream_impl::sptr stream;
+            bool pushed = false, known_stream = false;
             try {
                 const uint32_t stream_num =
                     _classify(buff->cast<void*>(), _base_xport->get_recv_frame_size());
-                {
-                    // Hold the stream mutex long enough to pull a bounded buffer
-                    // and lock it (increment its ref count).
-                    boost::lock_guard<boost::mutex> lock(_mutex);
-                    stream_map_t::iterator str_iter = _streams.find(stream_num);
-                    if (str_iter != _streams.end()) {
-                        stream = (*str_iter).second.lock();
-                    }
+                // Push while holding the mutex: the stream can't be removed
+                // (and destroyed) in the meantime, and this thread never ends
+                // up owning a stream, or through it the muxer itself.
+                // Pushing never blocks.
+                boost::lock_guard<boost::mutex> lock(_mutex);
+                stream_map_t::iterator str_iter = _streams.find(stream_num);
+                if (str_iter != _streams.end()) {
+                    known_stream = true;
+                    // Received frames are handed to the streams without a
+                    // copy. Splitting the base transport's frames evenly
+                    // means that stalled streams can never hold all of
+                    // them, and the other streams keep receiving.
+                    const size_t zero_copy_quota =
+                        _base_xport->get_num_recv_frames() / _streams.size();
+                    pushed = str_iter->second->push_recv_buff(
+                        std::move(buff), zero_copy_quota);
                 }
             } catch (std::exception&) {
                 // If _classify throws we simply drop the frame
             }
-            // Once a bounded buffer is acquired, we can rely on its
-            // thread safety to serialize with the consumer.
-            if (stream.get()) {
-                stream->push_recv_buff(buff);
-            } else {
-                boost::lock_guard<boost::mutex> lock(_mutex);
-                _num_dropped_frames++;
+            if (not pushed) {
+                buff.reset();
+                _count_dropped_frame(known_stream);
             }
             // We processed a packet, and there could be more coming
             // Don't yield in the next iteration.
@@ -284,15 +355,46 @@ private:
         }
     }
 
-    typedef std::map<uint32_t, stream_impl::wptr> stream_map_t;
+    //! Count a dropped frame, and report the drops once in a while
+    void _count_dropped_frame(const bool full_stream)
+    {
+        size_t num_full = 0, num_unknown = 0;
+        {
+            boost::lock_guard<boost::mutex> lock(_mutex);
+            _num_dropped_frames++;
+            (full_stream ? _num_unlogged_full : _num_unlogged_unknown)++;
+            const auto now = std::chrono::steady_clock::now();
+            if (now - _last_drop_log < DROP_LOG_INTERVAL) {
+                return;
+            }
+            _last_drop_log = now;
+            std::swap(num_full, _num_unlogged_full);
+            std::swap(num_unknown, _num_unlogged_unknown);
+        }
+        if (num_full) {
+            UHD_LOG_WARNING("MUXED_XPORT",
+                "Dropped " << num_full
+                           << " frame(s) for streams that are not drained fast enough");
+        }
+        if (num_unknown) {
+            UHD_LOG_DEBUG("MUXED_XPORT",
+                "Dropped " << num_unknown
+                           << " frame(s) for unknown or removed streams");
+        }
+    }
+
+    typedef std::map<uint32_t, stream_impl*> stream_map_t;
 
     zero_copy_if::sptr _base_xport;
     stream_classifier_fn _classify;
     stream_map_t _streams;
     const size_t _max_num_streams;
     size_t _num_dropped_frames;
+    // Drops since the last report
+    size_t _num_unlogged_full, _num_unlogged_unknown;
+    std::chrono::steady_clock::time_point _last_drop_log;
     boost::thread _recv_thread;
-    boost::mutex _mutex;
+    mutable boost::mutex _mutex;
 };
 
 muxed_zero_copy_if::sptr muxed_zero_copy_if::make(zero_copy_if::sptr base_xport,
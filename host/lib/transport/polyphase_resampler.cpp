@@ -0,0 +1,249 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhdlib/transport/polyphase_resampler.hpp>
+#include <boost/format.hpp>
+#include <boost/math/constants/constants.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#ifdef __SSE2__
+#    include <emmintrin.h>
+#endif
+
+using namespace uhd;
+using namespace uhd::transport;
+
+polyphase_resampler::~polyphase_resampler(void)
+{
+    /* NOP */
+}
+
+/***********************************************************************
+ * Helpers
+ **********************************************************************/
+static size_t gcd(size_t a, size_t b)
+{
+    while (b != 0) {
+        const size_t r = a % b;
+        a              = b;
+        b              = r;
+    }
+    return a;
+}
+
+/*!
+ * Get the number of taps per polyphase branch: The filter spans
+ * taps_per_phase samples at the lower of the two rates, so when decimating,
+ * it needs more input samples to reach the same stopband.
+ */
+static size_t get_num_taps(const size_t interp, const size_t decim, const size_t taps_per_phase)
+{
+    const size_t num_taps = taps_per_phase * ((decim + interp - 1) / interp);
+    return std::max<size_t>(4, num_taps + (num_taps % 2));
+}
+
+/*!
+ * Multiply num complex samples with num real taps and sum up. The taps are
+ * stored twice each, so they line up with the interleaved I and Q values.
+ */
+static UHD_INLINE std::complex<float> dot_product(
+    const std::complex<float>* samps, const float* taps, const size_t num)
+{
+    const float* x = reinterpret_cast<const float*>(samps);
+#ifdef __SSE2__
+    // num is even, so this is two samples at a time with nothing left over
+    __m128 acc = _mm_setzero_ps();
+    for (size_t i = 0; i < 2 * num; i += 4) {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(taps + i)));
+    }
+    // acc is (I0, Q0, I1, Q1)
+    acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+    float sum[4];
+    _mm_storeu_ps(sum, acc);
+    return std::complex<float>(sum[0], sum[1]);
+#else
+    float sum_i = 0, sum_q = 0;
+    for (size_t i = 0; i < 2 * num; i += 2) {
+        sum_i += x[i] * taps[i];
+        sum_q += x[i + 1] * taps[i + 1];
+    }
+    return std::complex<float>(sum_i, sum_q);
+#endif
+}
+
+/***********************************************************************
+ * Resampler implementation:
+ * The prototype filter runs at interp times the input rate, and has
+ * interp times the taps per branch, minus one, taps, so its delay is a
+ * whole number of samples at that rate. Polyphase branch p holds taps p, p + interp, ...,
+ * reversed, so they line up with the input samples in memory.
+ *
+ * The position of the next output is kept as the index of the newest
+ * input sample it needs (_next_index, relative to the next input to be
+ * consumed), plus the branch (_phase). Each output moves the position on
+ * by decim branches.
+ **********************************************************************/
+class polyphase_resampler_impl : public polyphase_resampler
+{
+public:
+    polyphase_resampler_impl(const size_t num_chans,
+        const size_t interp,
+        const size_t decim,
+        const size_t taps_per_phase)
+        : _interp(interp / gcd(interp, decim))
+        , _decim(decim / gcd(interp, decim))
+        , _num_taps(get_num_taps(_interp, _decim, taps_per_phase))
+        , _delay(_interp * _num_taps / 2 - 1)
+        , _work(num_chans, std::vector<sample_type>(2 * (_num_taps - 1)))
+    {
+        _design_taps();
+        this->reset();
+        UHD_LOGGER_DEBUG("XPORT")
+            << boost::format("Created %d/%d resampler with %d taps per phase")
+                   % _interp % _decim % _num_taps;
+    }
+
+    size_t get_interp(void) const
+    {
+        return _interp;
+    }
+
+    size_t get_decim(void) const
+    {
+        return _decim;
+    }
+
+    size_t process(const sample_type* const* in,
+        const size_t num_in,
+        sample_type* const* out,
+        const size_t max_out,
+        size_t& num_consumed)
+    {
+        const size_t num_chans = _work.size();
+        const size_t hist_len  = _num_taps - 1;
+
+        // Outputs that reach back into the history read from the work
+        // buffer, which holds the history followed by the first inputs
+        const size_t num_head = std::min(hist_len, num_in);
+        for (size_t ch = 0; ch < num_chans; ch++) {
+            std::copy(in[ch], in[ch] + num_head, _work[ch].begin() + hist_len);
+        }
+
+        size_t num_out = 0;
+        while (num_out < max_out and _next_index < num_in) {
+            const float* taps = &_taps[_phase * 2 * _num_taps];
+            for (size_t ch = 0; ch < num_chans; ch++) {
+                const sample_type* x = (_next_index >= hist_len)
+                                           ? in[ch] + (_next_index - hist_len)
+                                           : &_work[ch][_next_index];
+                out[ch][num_out] = dot_product(x, taps, _num_taps);
+            }
+            num_out++;
+            _phase += _decim;
+            _next_index += _phase / _interp;
+            _phase %= _interp;
+        }
+        num_consumed = std::min(_next_index, num_in);
+
+        // Keep the newest consumed inputs as the history. Position k of the
+        // new history is position num_consumed + k of (history, inputs), so
+        // the old history can be moved down in place.
+        for (size_t ch = 0; ch < num_chans; ch++) {
+            for (size_t k = 0; k < hist_len; k++) {
+                const size_t pos = num_consumed + k;
+                _work[ch][k] = (pos < hist_len) ? _work[ch][pos] : in[ch][pos - hist_len];
+            }
+        }
+        _next_index -= num_consumed;
+        return num_out;
+    }
+
+    double get_next_output_offset(void) const
+    {
+        return double(_next_index) + (double(_phase) - double(_delay)) / _interp;
+    }
+
+    void reset(void)
+    {
+        for (auto& work : _work) {
+            std::fill(work.begin(), work.end(), sample_type(0));
+        }
+        // Start at the output that lines up with the first input
+        _next_index = _delay / _interp;
+        _phase      = _delay % _interp;
+    }
+
+private:
+    void _design_taps(void)
+    {
+        const double pi     = boost::math::constants::pi<double>();
+        const size_t len    = _interp * _num_taps - 1;
+        const double cutoff = 0.5 / std::max(_interp, _decim);
+
+        // Blackman windowed sinc, normalized to a gain of interp, because
+        // only one out of interp samples at the filter rate is non-zero
+        std::vector<double> proto(len);
+        double sum = 0;
+        for (size_t n = 0; n < len; n++) {
+            const double t = double(n) - double(_delay);
+            const double sinc =
+                (t == 0) ? 1.0 : std::sin(2 * pi * cutoff * t) / (2 * pi * cutoff * t);
+            const double window = 0.42 - 0.5 * std::cos(2 * pi * n / (len - 1))
+                                  + 0.08 * std::cos(4 * pi * n / (len - 1));
+            proto[n] = sinc * window;
+            sum += proto[n];
+        }
+
+        _taps.assign(2 * _interp * _num_taps, 0.0f);
+        for (size_t p = 0; p < _interp; p++) {
+            for (size_t m = 0; m < _num_taps; m++) {
+                const size_t n = p + (_num_taps - 1 - m) * _interp;
+                const float tap = (n < len) ? float(proto[n] * _interp / sum) : 0.0f;
+                _taps[(p * _num_taps + m) * 2 + 0] = tap;
+                _taps[(p * _num_taps + m) * 2 + 1] = tap;
+            }
+        }
+    }
+
+    const size_t _interp;
+    const size_t _decim;
+    const size_t _num_taps; // per phase, always even
+    const size_t _delay; // of the prototype filter, at interp times the input rate
+    std::vector<float> _taps;
+    std::vector<std::vector<sample_type>> _work; // one per channel
+    size_t _next_index;
+    size_t _phase;
+};
+
+/***********************************************************************
+ * Factory functions
+ **********************************************************************/
+polyphase_resampler::sptr polyphase_resampler::make(const size_t num_chans,
+    const size_t interp,
+    const size_t decim,
+    const size_t taps_per_phase)
+{
+    if (num_chans == 0 or interp == 0 or decim == 0) {
+        throw uhd::value_error(str(
+            boost::format("Invalid resampler: %d channels, interp %d, decim %d")
+            % num_chans % interp % decim));
+    }
+    return sptr(new polyphase_resampler_impl(num_chans, interp, decim, taps_per_phase));
+}
+
+polyphase_resampler::sptr polyphase_resampler::make(
+    const size_t num_chans, const uhd::device_addr_t& args)
+{
+    const size_t interp = args.cast<size_t>("resamp_interp", 1);
+    const size_t decim  = args.cast<size_t>("resamp_decim", 1);
+    if (interp == decim) {
+        return nullptr;
+    }
+    return make(num_chans, interp, decim, args.cast<size_t>("resamp_taps", 16));
+}
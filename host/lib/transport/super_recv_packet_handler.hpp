@@ -19,10 +19,15 @@
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/tasks.hpp>
 #include <uhdlib/rfnoc/rx_stream_terminator.hpp>
+#include <uhdlib/transport/convert_worker_pool.hpp>
+#include <uhdlib/transport/polyphase_resampler.hpp>
+#include <uhdlib/transport/stream_counters.hpp>
+#include <uhdlib/utils/tick_converter.hpp>
 #include <boost/dynamic_bitset.hpp>
 #include <boost/format.hpp>
 #include <boost/function.hpp>
 #include <boost/make_shared.hpp>
+#include <chrono>
 #include <iostream>
 #include <vector>
 
@@ -70,8 +75,16 @@ public:
      * \param size the number of transport channels
      */
     recv_packet_handler(const size_t size = 1)
-        : _queue_error_for_next_call(false), _buffers_infos_index(0)
+        : _queue_error_for_next_call(false)
+        , _scale_factor(1 / 32767.)
+        , _resamp_num_samps(0)
+        , _resamp_offset(0)
+        , _buffers_infos_index(0)
+        , _counters(boost::make_shared<stream_counters>())
     {
+        _convert_task = [this](const size_t index, const size_t worker) {
+            this->convert_to_out_buff(index, worker);
+        };
 #ifdef ERROR_INJECT_DROPPED_PACKETS
         recvd_packets = 0;
 #endif
@@ -123,12 +136,14 @@ public:
     void set_tick_rate(const double rate)
     {
         _tick_rate = rate;
+        _ticks.set_tick_rate(rate);
     }
 
     //! Set the rate of samples per second
     void set_samp_rate(const double rate)
     {
         _samp_rate = rate;
+        _ticks.set_samp_rate(rate);
     }
 
     /*!
@@ -182,13 +197,61 @@ public:
     //! Set the conversion routine for all channels
     void set_converter(const uhd::convert::id_type& id)
     {
-        _num_outputs = id.num_outputs;
-        _converter   = uhd::convert::get_converter(id)();
+        _num_outputs  = id.num_outputs;
+        _converter_id = id;
+        _converters.clear();
+        for (size_t i = 0; i < get_num_converters(); i++) {
+            _converters.push_back(uhd::convert::get_converter(id)());
+        }
+        _converter = _converters.front();
+        this->check_resampler_format();
+        _iq_dc_converters.clear();
+        if (not _iq_dc_corrections.empty()) {
+            this->make_iq_dc_converters();
+        }
         this->set_scale_factor(1 / 32767.); // update after setting converter
         _bytes_per_otw_item = uhd::convert::get_bytes_per_item(id.input_format);
         _bytes_per_cpu_item = uhd::convert::get_bytes_per_item(id.output_format);
     }
 
+    /*!
+     * Convert the channels in parallel on a pool of worker threads.
+     * Each worker gets its own converter. A null pool, or a pool with a
+     * single thread, converts all channels on the calling thread.
+     * \param pool the worker pool (see convert_worker_pool::make())
+     */
+    void set_convert_worker_pool(convert_worker_pool::sptr pool)
+    {
+        _convert_pool = (pool and pool->size() > 1 and this->size() > 1)
+                            ? pool
+                            : convert_worker_pool::sptr();
+        if (_converter) {
+            const double scale_factor = _scale_factor;
+            this->set_converter(_converter_id);
+            this->set_scale_factor(scale_factor);
+        }
+    }
+
+    /*!
+     * Resample the converted samples on the host. The packets of all
+     * channels are converted into a scratch buffer of one packet, and then
+     * resampled from there, so the samples are still in cache. A null
+     * resampler turns resampling off.
+     * \param resampler the resampler (see polyphase_resampler::make())
+     */
+    void set_resampler(polyphase_resampler::sptr resampler)
+    {
+        _resampler = resampler;
+        _resamp_num_samps = 0;
+        _resamp_offset    = 0;
+        _resamp_buffs.clear();
+        if (_resampler) {
+            this->check_resampler_format();
+            _resamp_buffs.resize(this->size(),
+                std::vector<polyphase_resampler::sample_type>(RESAMP_BUFF_SIZE));
+        }
+    }
+
     //! Set the transport channel's overflow handler
     void set_overflow_handler(
         const size_t xport_chan, const handle_overflow_type& handle_overflow)
@@ -199,7 +262,41 @@ public:
     //! Set the scale factor used in float conversion
     void set_scale_factor(const double scale_factor)
     {
-        _converter->set_scalar(scale_factor);
+        _scale_factor = scale_factor;
+        for (auto& converter : _converters) {
+            converter->set_scalar(scale_factor);
+        }
+        for (auto& converter : _iq_dc_converters) {
+            converter->set_scalar(scale_factor);
+        }
+    }
+
+    /*!
+     * Correct IQ imbalance and DC offset of a channel while converting.
+     * The first correction switches all channels over to a correcting
+     * converter (see uhd::convert::IQ_DC_FORMAT_SUFFIX), with no correction
+     * on the other channels. Throws a uhd::key_error if there's none for
+     * this conversion.
+     */
+    void set_iq_dc_correction(
+        const size_t chan, const uhd::convert::iq_dc_correction_t& correction)
+    {
+        if (chan >= this->size()) {
+            throw uhd::index_error(
+                str(boost::format("set_iq_dc_correction(): invalid channel %d") % chan));
+        }
+        if (_iq_dc_corrections.empty()) {
+            _iq_dc_corrections.resize(this->size());
+            try {
+                this->make_iq_dc_converters();
+            } catch (const uhd::key_error&) {
+                _iq_dc_corrections.clear();
+                throw uhd::key_error("Cannot correct IQ/DC offset for conversion "
+                                     + _converter_id.to_string());
+            }
+        }
+        _iq_dc_corrections[chan] = correction;
+        _iq_dc_converters[chan]->set_iq_dc_correction(correction);
     }
 
     //! Set the callback to issue stream commands
@@ -209,6 +306,12 @@ public:
         _props.at(xport_chan).issue_stream_cmd = issue_stream_cmd;
     }
 
+    //! Get the counters of this handler, see rx_streamer::get_stats()
+    stream_counters::sptr get_stream_counters(void) const
+    {
+        return _counters;
+    }
+
     //! Overload call to issue stream commands
     void issue_stream_cmd(const stream_cmd_t& stream_cmd)
     {
@@ -235,6 +338,155 @@ public:
         uhd::rx_metadata_t& metadata,
         const double timeout,
         const bool one_packet)
+    {
+        if (_resampler) {
+            return recv_resampled(buffs, nsamps_per_buff, metadata, timeout, one_packet);
+        }
+        return recv_converted(buffs, nsamps_per_buff, metadata, timeout, one_packet);
+    }
+
+    /*******************************************************************
+     * Receive views:
+     * Hand out the aligned transport buffers instead of converting
+     * them, see rx_streamer::recv_views().
+     ******************************************************************/
+    size_t recv_views(
+        rx_view_batch_t& batch, const size_t max_packets, const double timeout)
+    {
+        batch.frames.clear();
+        size_t num_views = 0;
+        while (num_views < max_packets) {
+            if (batch.views.size() == num_views) {
+                batch.views.push_back(rx_view_t());
+            }
+            rx_view_t& view = batch.views[num_views];
+            view.nsamps     = 0;
+
+            // handle metadata queued from a previous receive
+            if (_queue_error_for_next_call) {
+                _queue_error_for_next_call = false;
+                view.metadata              = _queue_metadata;
+                if (_queue_metadata.error_code != rx_metadata_t::ERROR_CODE_TIMEOUT) {
+                    num_views++;
+                    break;
+                }
+            }
+
+            // only wait for the first packet of the batch
+            if (get_curr_buffer_info().data_bytes_to_copy == 0) {
+                get_aligned_buffs(num_views == 0 ? timeout : 0.0);
+            }
+            buffers_info_type& info = get_curr_buffer_info();
+            view.metadata           = info.metadata;
+            if (info.metadata.error_code != rx_metadata_t::ERROR_CODE_NONE) {
+                // a timeout ends a batch which already has packets
+                if (num_views == 0
+                    or info.metadata.error_code != rx_metadata_t::ERROR_CODE_TIMEOUT) {
+                    num_views++;
+                }
+                break;
+            }
+
+            // hand over the rest of the packet, which may be a fragment
+            view.metadata.time_spec = get_fragment_time(info);
+            view.metadata.more_fragments  = false;
+            view.metadata.fragment_offset = info.fragment_offset_in_samps;
+            view.nsamps = info.data_bytes_to_copy / _bytes_per_otw_item;
+            view.buffs.resize(this->size());
+            for (size_t i = 0; i < this->size(); i++) {
+                view.buffs[i] = info[i].copy_buff;
+                batch.frames.push_back(info[i].buff);
+                info[i].buff.reset();
+            }
+            info.data_bytes_to_copy = 0;
+            info.fragment_offset_in_samps += view.nsamps;
+            num_views++;
+
+            if (view.metadata.end_of_burst) {
+                break;
+            }
+        }
+        batch.views.resize(num_views);
+        return num_views;
+    }
+
+private:
+    vrt_unpacker_type _vrt_unpacker;
+    size_t _header_offset_words32;
+    double _tick_rate, _samp_rate;
+    uhd::tick_converter _ticks;
+    bool _queue_error_for_next_call;
+    size_t _alignment_failure_threshold;
+    rx_metadata_t _queue_metadata;
+    struct xport_chan_props_type
+    {
+        xport_chan_props_type(void)
+            : packet_count(0), handle_overflow(&handle_overflow_nop), fc_update_window(0)
+        {
+        }
+        get_buff_type get_buff;
+        issue_stream_cmd_type issue_stream_cmd;
+        size_t packet_count;
+        handle_overflow_type handle_overflow;
+        handle_flowctrl_type handle_flowctrl;
+        handle_flowctrl_ack_type handle_flowctrl_ack;
+        size_t fc_update_window;
+    };
+    std::vector<xport_chan_props_type> _props;
+    size_t _num_outputs;
+    size_t _bytes_per_otw_item; // used in conversion
+    size_t _bytes_per_cpu_item; // used in conversion
+    uhd::convert::converter::sptr _converter; // used in conversion
+    uhd::convert::id_type _converter_id;
+    std::vector<uhd::convert::converter::sptr> _converters; // one per worker
+    std::vector<uhd::convert::iq_dc_correction_t> _iq_dc_corrections; // one per channel
+    std::vector<uhd::convert::converter::sptr> _iq_dc_converters; // one per channel
+    double _scale_factor;
+    convert_worker_pool::sptr _convert_pool;
+    convert_worker_pool::task_type _convert_task;
+    static const size_t RESAMP_BUFF_SIZE = 4096; // samples per channel
+    polyphase_resampler::sptr _resampler;
+    std::vector<std::vector<polyphase_resampler::sample_type>> _resamp_buffs;
+    size_t _resamp_num_samps; // samples in the scratch buffers
+    size_t _resamp_offset; // samples of the scratch buffers already resampled
+    rx_metadata_t _resamp_metadata; // metadata of the scratch buffers
+
+    size_t get_num_converters(void) const
+    {
+        return _convert_pool ? _convert_pool->size() : 1;
+    }
+
+    //! Make a correcting converter for each channel, see set_iq_dc_correction()
+    void make_iq_dc_converters(void)
+    {
+        uhd::convert::id_type id = _converter_id;
+        id.output_format += uhd::convert::IQ_DC_FORMAT_SUFFIX;
+        const uhd::convert::function_type make_converter = uhd::convert::get_converter(id);
+        _iq_dc_converters.clear();
+        for (const auto& correction : _iq_dc_corrections) {
+            _iq_dc_converters.push_back(make_converter());
+            _iq_dc_converters.back()->set_scalar(_scale_factor);
+            _iq_dc_converters.back()->set_iq_dc_correction(correction);
+        }
+    }
+
+    //! The resampler works on single buffers of fc32 samples
+    void check_resampler_format(void) const
+    {
+        if (_resampler and _converter
+            and (_converter_id.output_format != "fc32" or _num_outputs != 1)) {
+            throw uhd::value_error(
+                "Resampling on the host requires the fc32 CPU format, not "
+                + _converter_id.output_format);
+        }
+    }
+
+    //! Receive into the user buffers, without resampling
+    UHD_INLINE size_t recv_converted(const uhd::rx_streamer::buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        uhd::rx_metadata_t& metadata,
+        const double timeout,
+        const bool one_packet)
     {
         // handle metadata queued from a previous receive
         if (_queue_error_for_next_call) {
@@ -291,32 +543,102 @@ public:
         return accum_num_samps;
     }
 
-private:
-    vrt_unpacker_type _vrt_unpacker;
-    size_t _header_offset_words32;
-    double _tick_rate, _samp_rate;
-    bool _queue_error_for_next_call;
-    size_t _alignment_failure_threshold;
-    rx_metadata_t _queue_metadata;
-    struct xport_chan_props_type
+    /*!
+     * Receive one packet at a time into the scratch buffers, and resample
+     * from there into the user buffers. The time spec of the first output
+     * is derived from the time spec of the packet it is resampled from.
+     */
+    UHD_INLINE size_t recv_resampled(const uhd::rx_streamer::buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        uhd::rx_metadata_t& metadata,
+        const double timeout,
+        const bool one_packet)
     {
-        xport_chan_props_type(void)
-            : packet_count(0), handle_overflow(&handle_overflow_nop), fc_update_window(0)
-        {
+        // handle metadata queued from a previous receive
+        if (_queue_error_for_next_call) {
+            _queue_error_for_next_call = false;
+            metadata                   = _queue_metadata;
+            return 0;
         }
-        get_buff_type get_buff;
-        issue_stream_cmd_type issue_stream_cmd;
-        size_t packet_count;
-        handle_overflow_type handle_overflow;
-        handle_flowctrl_type handle_flowctrl;
-        handle_flowctrl_ack_type handle_flowctrl_ack;
-        size_t fc_update_window;
-    };
-    std::vector<xport_chan_props_type> _props;
-    size_t _num_outputs;
-    size_t _bytes_per_otw_item; // used in conversion
-    size_t _bytes_per_cpu_item; // used in conversion
-    uhd::convert::converter::sptr _converter; // used in conversion
+        metadata.reset();
+
+        const size_t num_chans = _resamp_buffs.size();
+        std::vector<const polyphase_resampler::sample_type*> in(num_chans);
+        std::vector<polyphase_resampler::sample_type*> out(num_chans);
+        size_t num_out = 0;
+        while (num_out < nsamps_per_buff) {
+            // refill the scratch buffers with the next packet
+            if (_resamp_offset == _resamp_num_samps) {
+                std::vector<void*> scratch_ptrs(num_chans);
+                for (size_t i = 0; i < num_chans; i++) {
+                    scratch_ptrs[i] = _resamp_buffs[i].data();
+                }
+                _resamp_offset    = 0;
+                _resamp_num_samps = recv_converted(
+                    uhd::rx_streamer::buffs_type(scratch_ptrs.data(), num_chans),
+                    RESAMP_BUFF_SIZE,
+                    _resamp_metadata,
+                    timeout,
+                    true);
+                if (_resamp_metadata.error_code != rx_metadata_t::ERROR_CODE_NONE) {
+                    _resamp_num_samps = 0;
+                    if (_resamp_metadata.error_code != rx_metadata_t::ERROR_CODE_TIMEOUT) {
+                        // samples were lost, start over
+                        _resampler->reset();
+                    }
+                    if (num_out == 0) {
+                        metadata = _resamp_metadata;
+                    } else if (_resamp_metadata.error_code
+                               != rx_metadata_t::ERROR_CODE_TIMEOUT) {
+                        _queue_metadata            = _resamp_metadata;
+                        _queue_error_for_next_call = true;
+                    }
+                    break;
+                }
+                if (_resamp_metadata.start_of_burst) {
+                    _resampler->reset();
+                }
+            }
+
+            if (num_out == 0) {
+                metadata.has_time_spec = _resamp_metadata.has_time_spec;
+                metadata.time_spec =
+                    _resamp_metadata.time_spec
+                    + time_spec_t((_resamp_offset + _resampler->get_next_output_offset())
+                                  / _samp_rate);
+                metadata.start_of_burst = _resamp_metadata.start_of_burst;
+            }
+            for (size_t i = 0; i < num_chans; i++) {
+                in[i]  = _resamp_buffs[i].data() + _resamp_offset;
+                out[i] = reinterpret_cast<polyphase_resampler::sample_type*>(buffs[i])
+                         + num_out;
+            }
+            size_t num_consumed = 0;
+            const size_t num_produced = _resampler->process(in.data(),
+                _resamp_num_samps - _resamp_offset,
+                out.data(),
+                nsamps_per_buff - num_out,
+                num_consumed);
+            _resamp_offset += num_consumed;
+            num_out += num_produced;
+            if (num_produced > 0) {
+                _resamp_metadata.start_of_burst = false;
+            }
+
+            if (_resamp_offset == _resamp_num_samps) {
+                if (_resamp_metadata.end_of_burst) {
+                    // the tail of the filter is dropped with the burst
+                    metadata.end_of_burst = true;
+                    _resampler->reset();
+                    break;
+                }
+                if (one_packet and num_out > 0) {
+                    break;
+                }
+            }
+        }
+        return num_out;
+    }
 
     //! information stored for a received buffer
     struct per_buffer_info_type
@@ -369,6 +691,8 @@ private:
     //! a circular queue of buffer infos
     std::vector<buffers_info_type> _buffers_infos;
     size_t _buffers_infos_index;
+
+    stream_counters::sptr _counters;
     buffers_info_type& get_curr_buffer_info(void)
     {
         return _buffers_infos[_buffers_infos_index];
@@ -414,7 +738,9 @@ private:
         per_buffer_info_type& info      = curr_buffer_info;
         while (1) {
             // get a single packet from the transport layer
-            buff = _props[index].get_buff(timeout);
+            const auto get_buff_start = stream_counters::clock_type::now();
+            buff                      = _props[index].get_buff(timeout);
+            _counters->add_get_buff_time(get_buff_start);
             if (buff.get() == nullptr)
                 return PACKET_TIMEOUT_ERROR;
 
@@ -474,6 +800,7 @@ private:
         if (info.ifpi.packet_type != vrt::if_packet_info_t::PACKET_TYPE_DATA) {
             return PACKET_INLINE_MESSAGE;
         }
+        _counters->add_packets(1, info.ifpi.num_payload_bytes);
 
 // 2) check for sequence errors
 #ifndef SRPH_DONT_CHECK_SEQUENCE
@@ -490,6 +817,7 @@ private:
                 // flow control is in.
                 _props[index].handle_flowctrl(info.ifpi.packet_count);
             }
+            _counters->add_seq_error();
             return PACKET_SEQUENCE_ERROR;
         }
 #endif
@@ -647,12 +975,13 @@ private:
                     std::swap(curr_info, next_info); // save progress from curr -> next
                     curr_info.metadata.has_time_spec = next_info[index].ifpi.has_tsf;
                     curr_info.metadata.time_spec =
-                        time_spec_t::from_ticks(next_info[index].time, _tick_rate);
+                        _ticks.to_time_spec(int64_t(next_info[index].time));
                     curr_info.metadata.error_code =
                         rx_metadata_t::error_code_t(get_context_code(
                             next_info[index].vrt_hdr, next_info[index].ifpi));
                     if (curr_info.metadata.error_code
                         == rx_metadata_t::ERROR_CODE_OVERFLOW) {
+                        _counters->add_overflow();
                         // Not sending flow control would cause timeouts due to source
                         // flow control locking up. Send first as the overrun handler may
                         // flush the receive buffers which could contain packets with
@@ -695,13 +1024,12 @@ private:
 
             // too many iterations: detect alignment failure
             if (iterations++ > _alignment_failure_threshold) {
-                UHD_LOGGER_ERROR("STREAMER")
-                    << boost::format(
-                           "The receive packet handler failed to time-align packets.\n"
-                           "%u received packets were processed by the handler.\n"
-                           "However, a timestamp match could not be determined.\n")
-                           % iterations
-                    << std::endl;
+                UHD_LOG_FAST(uhd::log::error,
+                    "STREAMER",
+                    "The receive packet handler failed to time-align packets.\n"
+                    "%u received packets were processed by the handler.\n"
+                    "However, a timestamp match could not be determined.\n",
+                    iterations);
                 std::swap(curr_info, next_info); // save progress from curr -> next
                 curr_info.metadata.error_code = rx_metadata_t::ERROR_CODE_ALIGNMENT;
                 _props[index].handle_overflow();
@@ -711,13 +1039,30 @@ private:
 
         // set the metadata from the buffer information at index zero
         curr_info.metadata.has_time_spec = curr_info[0].ifpi.has_tsf;
-        curr_info.metadata.time_spec =
-            time_spec_t::from_ticks(curr_info[0].time, _tick_rate);
+        curr_info.metadata.time_spec = _ticks.to_time_spec(int64_t(curr_info[0].time));
         curr_info.metadata.more_fragments  = false;
         curr_info.metadata.fragment_offset = 0;
         curr_info.metadata.error_code      = rx_metadata_t::ERROR_CODE_NONE;
     }
 
+    /*!
+     * Return the time of the first sample that hasn't been handed out yet.
+     * For a packet without errors, its time spec is the time of its tick
+     * count, so the time of the fragment can be counted in ticks as well.
+     */
+    UHD_INLINE time_spec_t get_fragment_time(const buffers_info_type& info) const
+    {
+        if (info.fragment_offset_in_samps == 0) {
+            return info.metadata.time_spec;
+        }
+        if (info.metadata.error_code == rx_metadata_t::ERROR_CODE_NONE) {
+            return _ticks.to_time_spec(
+                int64_t(info[0].time), int64_t(info.fragment_offset_in_samps));
+        }
+        return info.metadata.time_spec
+               + time_spec_t::from_ticks(info.fragment_offset_in_samps, _samp_rate);
+    }
+
     /*******************************************************************
      * Receive a single packet on all channels
      * Handles fragmentation, messages, errors, and copy-conversion.
@@ -740,8 +1085,7 @@ private:
         metadata                = info.metadata;
 
         // interpolate the time spec (useful when this is a fragment)
-        metadata.time_spec +=
-            time_spec_t::from_ticks(info.fragment_offset_in_samps, _samp_rate);
+        metadata.time_spec = get_fragment_time(info);
 
         // extract the number of samples available to copy
         const size_t nsamps_available = info.data_bytes_to_copy / _bytes_per_otw_item;
@@ -757,8 +1101,17 @@ private:
         _convert_bytes_to_copy       = bytes_to_copy;
 
         // perform N channels of conversion
+        const auto convert_start = stream_counters::clock_type::now();
+        if (_convert_pool) {
+            _convert_pool->run(this->size(), _convert_task);
+        } else {
+            for (size_t i = 0; i < this->size(); i++) {
+                convert_to_out_buff(i);
+            }
+        }
+        _counters->add_convert_time(convert_start);
         for (size_t i = 0; i < this->size(); i++) {
-            convert_to_out_buff(i);
+            release_out_buff(i);
         }
 
         // update the copy buffer's availability
@@ -775,15 +1128,12 @@ private:
     /*! Run the conversion from the internal buffers to the user's output
      *  buffer.
      *
-     * - Calls the converter
-     * - Releases internal data buffers
-     * - Updates read/write pointers
+     * - Calls the converter of the given worker
      */
-    inline void convert_to_out_buff(const size_t index)
+    inline void convert_to_out_buff(const size_t index, const size_t worker = 0)
     {
         // shortcut references to local data structures
-        buffers_info_type& buff_info         = get_curr_buffer_info();
-        per_buffer_info_type& info           = buff_info[index];
+        per_buffer_info_type& info           = get_curr_buffer_info()[index];
         const rx_streamer::buffs_type& buffs = *_convert_buffs;
 
         // fill IO buffs with pointers into the output buffer
@@ -794,8 +1144,22 @@ private:
         }
         const ref_vector<void*> out_buffs(io_buffs, _num_outputs);
 
-        // perform the conversion operation
-        _converter->conv(info.copy_buff, out_buffs, _convert_nsamps);
+        // perform the conversion operation, corrected channels have their own converter
+        const uhd::convert::converter::sptr& converter =
+            _iq_dc_converters.empty() ? _converters[worker] : _iq_dc_converters[index];
+        converter->conv(info.copy_buff, out_buffs, _convert_nsamps);
+    }
+
+    /*! Finish up after the conversion of a channel. Always runs on the
+     *  calling thread, so transports never see a release from a worker.
+     *
+     * - Releases internal data buffers
+     * - Updates read/write pointers
+     */
+    inline void release_out_buff(const size_t index)
+    {
+        buffers_info_type& buff_info = get_curr_buffer_info();
+        per_buffer_info_type& info   = buff_info[index];
 
         // advance the pointer for the source buffer
         info.copy_buff += _convert_bytes_to_copy;
@@ -925,6 +1289,23 @@ public:
         return recv_packet_handler::issue_stream_cmd(stream_cmd);
     }
 
+    size_t recv_views(
+        rx_view_batch_t& batch, const size_t max_packets, const double timeout)
+    {
+        return recv_packet_handler::recv_views(batch, max_packets, timeout);
+    }
+
+    stream_stats_t get_stats(void) const
+    {
+        return get_stream_counters()->get_stats();
+    }
+
+    void set_iq_dc_correction(
+        const size_t chan, const uhd::convert::iq_dc_correction_t& correction)
+    {
+        recv_packet_handler::set_iq_dc_correction(chan, correction);
+    }
+
 private:
     size_t _max_num_samps;
 };
@@ -19,7 +19,13 @@
 #include <uhd/utils/tasks.hpp>
 #include <uhd/utils/thread.hpp>
 #include <uhdlib/rfnoc/tx_stream_terminator.hpp>
+#include <uhdlib/transport/convert_worker_pool.hpp>
+#include <uhdlib/transport/polyphase_resampler.hpp>
+#include <uhdlib/transport/stream_counters.hpp>
+#include <uhdlib/utils/tick_converter.hpp>
+#include <boost/format.hpp>
 #include <boost/function.hpp>
+#include <boost/make_shared.hpp>
 #include <chrono>
 #include <iostream>
 #include <thread>
@@ -57,8 +63,16 @@ public:
      * \param size the number of transport channels
      */
     send_packet_handler(const size_t size = 1)
-        : _next_packet_seq(0), _cached_metadata(false)
+        : _scale_factor(32767.)
+        , _resamp_fill(0)
+        , _resamp_num_zeros(0)
+        , _next_packet_seq(0)
+        , _cached_metadata(false)
+        , _counters(boost::make_shared<stream_counters>())
     {
+        _convert_task = [this](const size_t index, const size_t worker) {
+            this->convert_to_in_buff(index, worker);
+        };
         this->set_enable_trailer(true);
         this->resize(size);
     }
@@ -109,12 +123,14 @@ public:
     void set_tick_rate(const double rate)
     {
         _tick_rate = rate;
+        _ticks.set_tick_rate(rate);
     }
 
     //! Set the rate of samples per second
     void set_samp_rate(const double rate)
     {
         _samp_rate = rate;
+        _ticks.set_samp_rate(rate);
     }
 
     /*!
@@ -140,13 +156,63 @@ public:
     //! Set the conversion routine for all channels
     void set_converter(const uhd::convert::id_type& id)
     {
-        _num_inputs = id.num_inputs;
-        _converter  = uhd::convert::get_converter(id)();
+        _num_inputs   = id.num_inputs;
+        _converter_id = id;
+        _converters.clear();
+        for (size_t i = 0; i < get_num_converters(); i++) {
+            _converters.push_back(uhd::convert::get_converter(id)());
+        }
+        _converter = _converters.front();
+        this->check_resampler_format();
+        _iq_dc_converters.clear();
+        if (not _iq_dc_corrections.empty()) {
+            this->make_iq_dc_converters();
+        }
         this->set_scale_factor(32767.); // update after setting converter
         _bytes_per_otw_item = uhd::convert::get_bytes_per_item(id.output_format);
         _bytes_per_cpu_item = uhd::convert::get_bytes_per_item(id.input_format);
     }
 
+    /*!
+     * Convert the channels in parallel on a pool of worker threads.
+     * Each worker gets its own converter. A null pool, or a pool with a
+     * single thread, converts all channels on the calling thread.
+     * \param pool the worker pool (see convert_worker_pool::make())
+     */
+    void set_convert_worker_pool(convert_worker_pool::sptr pool)
+    {
+        _convert_pool = (pool and pool->size() > 1 and this->size() > 1)
+                            ? pool
+                            : convert_worker_pool::sptr();
+        if (_converter) {
+            const double scale_factor = _scale_factor;
+            this->set_converter(_converter_id);
+            this->set_scale_factor(scale_factor);
+        }
+    }
+
+    /*!
+     * Resample the samples on the host before converting them. The samples
+     * of all channels are resampled into a scratch buffer of one packet,
+     * and converted from there, so they are still in cache. A null
+     * resampler turns resampling off.
+     * \param resampler the resampler (see polyphase_resampler::make())
+     */
+    void set_resampler(polyphase_resampler::sptr resampler)
+    {
+        _resampler = resampler;
+        _resamp_metadata  = uhd::tx_metadata_t();
+        _resamp_fill      = 0;
+        _resamp_num_zeros = 0;
+        _resamp_buffs.clear();
+        if (_resampler) {
+            this->check_resampler_format();
+            _resamp_buffs.resize(this->size(),
+                std::vector<polyphase_resampler::sample_type>(RESAMP_BUFF_SIZE));
+            _resamp_zeros.resize(RESAMP_BUFF_SIZE);
+        }
+    }
+
     /*!
      * Set the maximum number of samples per host packet.
      * Ex: A USRP1 in dual channel mode would be half.
@@ -160,7 +226,38 @@ public:
     //! Set the scale factor used in float conversion
     void set_scale_factor(const double scale_factor)
     {
-        _converter->set_scalar(scale_factor);
+        _scale_factor = scale_factor;
+        for (auto& converter : _converters) {
+            converter->set_scalar(scale_factor);
+        }
+        for (auto& converter : _iq_dc_converters) {
+            converter->set_scalar(scale_factor);
+        }
+    }
+
+    /*!
+     * Correct IQ imbalance and DC offset of a channel while converting.
+     * Works like recv_packet_handler::set_iq_dc_correction().
+     */
+    void set_iq_dc_correction(
+        const size_t chan, const uhd::convert::iq_dc_correction_t& correction)
+    {
+        if (chan >= this->size()) {
+            throw uhd::index_error(
+                str(boost::format("set_iq_dc_correction(): invalid channel %d") % chan));
+        }
+        if (_iq_dc_corrections.empty()) {
+            _iq_dc_corrections.resize(this->size());
+            try {
+                this->make_iq_dc_converters();
+            } catch (const uhd::key_error&) {
+                _iq_dc_corrections.clear();
+                throw uhd::key_error("Cannot correct IQ/DC offset for conversion "
+                                     + _converter_id.to_string());
+            }
+        }
+        _iq_dc_corrections[chan] = correction;
+        _iq_dc_converters[chan]->set_iq_dc_correction(correction);
     }
 
     //! Set the callback to get async messages
@@ -178,6 +275,12 @@ public:
         return false;
     }
 
+    //! Get the counters of this handler, see tx_streamer::get_stats()
+    stream_counters::sptr get_stream_counters(void) const
+    {
+        return _counters;
+    }
+
     /*******************************************************************
      * Send:
      * The entry point for the fast-path send calls.
@@ -187,6 +290,19 @@ public:
         const size_t nsamps_per_buff,
         const uhd::tx_metadata_t& metadata,
         const double timeout)
+    {
+        if (_resampler) {
+            return send_resampled(buffs, nsamps_per_buff, metadata, timeout);
+        }
+        return send_converted(buffs, nsamps_per_buff, metadata, timeout);
+    }
+
+private:
+    //! Send from the user buffers, without resampling
+    UHD_INLINE size_t send_converted(const uhd::tx_streamer::buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        const uhd::tx_metadata_t& metadata,
+        const double timeout)
     {
         // translate the metadata to vrt if packet info
         vrt::if_packet_info_t if_packet_info;
@@ -196,7 +312,7 @@ public:
         if_packet_info.has_tlr = _has_tlr;
         if_packet_info.has_tsi = false;
         if_packet_info.has_tsf = metadata.has_time_spec;
-        if_packet_info.tsf     = metadata.time_spec.to_ticks(_tick_rate);
+        if_packet_info.tsf     = _ticks.to_ticks(metadata.time_spec);
         if_packet_info.sob     = metadata.start_of_burst;
         if_packet_info.eob     = metadata.end_of_burst;
         if_packet_info.fc_ack  = false; // This is a data packet
@@ -210,7 +326,7 @@ public:
             // If the new metada has a time_spec, do not use the cached time_spec.
             if (!metadata.has_time_spec) {
                 if_packet_info.has_tsf = _metadata_cache.has_time_spec;
-                if_packet_info.tsf     = _metadata_cache.time_spec.to_ticks(_tick_rate);
+                if_packet_info.tsf     = _ticks.to_ticks(_metadata_cache.time_spec);
             }
             if_packet_info.sob = _metadata_cache.start_of_burst;
             if_packet_info.eob = _metadata_cache.end_of_burst;
@@ -266,10 +382,8 @@ public:
                 return total_num_samps_sent;
 
             // setup metadata for the next fragment
-            const time_spec_t time_spec =
-                metadata.time_spec
-                + time_spec_t::from_ticks(total_num_samps_sent, _samp_rate);
-            if_packet_info.tsf = time_spec.to_ticks(_tick_rate);
+            if_packet_info.tsf =
+                _ticks.to_ticks(metadata.time_spec, int64_t(total_num_samps_sent));
             if_packet_info.sob = false;
         }
 
@@ -288,24 +402,179 @@ public:
         return nsamps_sent;
     }
 
-private:
+    /*!
+     * Resample the user buffers into the scratch buffers, and send whole
+     * packets from the scratch buffers (or all of them when they are full).
+     * Outputs short of a packet stay there for the next call. The time spec
+     * of a burst is moved to the first output sample. At the end of a
+     * burst, the filter is flushed with zeros up to the position of the
+     * last input sample.
+     *
+     * On a timeout, the return value counts all inputs taken by the filter.
+     * The outputs which were not sent, and the start of burst and time spec
+     * if they did not go out yet, are kept for the next call.
+     */
+    UHD_INLINE size_t send_resampled(const uhd::tx_streamer::buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        const uhd::tx_metadata_t& metadata,
+        const double timeout)
+    {
+        // outputs still pending go out before a new burst or time spec
+        if ((metadata.start_of_burst or metadata.has_time_spec)
+            and not send_resampled_buffs(_resamp_fill, false, timeout)) {
+            return 0;
+        }
+        if (metadata.start_of_burst) {
+            _resampler->reset();
+            _resamp_num_zeros               = 0;
+            _resamp_metadata.start_of_burst = true;
+        }
+        // keep the time spec until the first output is sent
+        if (metadata.has_time_spec) {
+            const double host_rate =
+                _samp_rate * _resampler->get_decim() / _resampler->get_interp();
+            _resamp_metadata.has_time_spec = true;
+            _resamp_metadata.time_spec =
+                metadata.time_spec
+                + time_spec_t(_resampler->get_next_output_offset() / host_rate);
+        }
+
+        const size_t num_chans = _resamp_buffs.size();
+        std::vector<const polyphase_resampler::sample_type*> in(num_chans);
+        std::vector<polyphase_resampler::sample_type*> out(num_chans);
+        size_t num_in = 0;
+        while (true) {
+            if (not send_full_resampled_buffs(timeout)) {
+                return num_in;
+            }
+            if (num_in == nsamps_per_buff) {
+                break;
+            }
+            for (size_t i = 0; i < num_chans; i++) {
+                in[i] = reinterpret_cast<const polyphase_resampler::sample_type*>(
+                            buffs[i])
+                        + num_in;
+                out[i] = _resamp_buffs[i].data() + _resamp_fill;
+            }
+            size_t num_consumed = 0;
+            _resamp_fill += _resampler->process(in.data(),
+                nsamps_per_buff - num_in,
+                out.data(),
+                RESAMP_BUFF_SIZE - _resamp_fill,
+                num_consumed);
+            if (num_consumed) {
+                _resamp_num_zeros = 0;
+            }
+            num_in += num_consumed;
+        }
+
+        if (metadata.end_of_burst) {
+            // flush the outputs which are still pending in the filter
+            std::fill(in.begin(), in.end(), _resamp_zeros.data());
+            while (_resamp_num_zeros + _resampler->get_next_output_offset() < 0) {
+                if (not send_full_resampled_buffs(timeout)) {
+                    return num_in;
+                }
+                for (size_t i = 0; i < num_chans; i++) {
+                    out[i] = _resamp_buffs[i].data() + _resamp_fill;
+                }
+                size_t num_consumed = 0;
+                _resamp_fill += _resampler->process(
+                    in.data(), RESAMP_BUFF_SIZE, out.data(), 1, num_consumed);
+                _resamp_num_zeros += num_consumed;
+            }
+            if (not send_resampled_buffs(_resamp_fill, true, timeout)) {
+                return num_in;
+            }
+            _resampler->reset();
+            _resamp_num_zeros = 0;
+        }
+        return num_in;
+    }
+
+    //! Send the whole packets in the scratch buffers, or all of them if full
+    bool send_full_resampled_buffs(const double timeout)
+    {
+        if (_resamp_fill >= _max_samples_per_packet) {
+            return send_resampled_buffs(
+                _resamp_fill - _resamp_fill % _max_samples_per_packet, false, timeout);
+        }
+        if (_resamp_fill == RESAMP_BUFF_SIZE) {
+            return send_resampled_buffs(_resamp_fill, false, timeout);
+        }
+        return true;
+    }
+
+    /*!
+     * Send the first samples of the scratch buffers with the pending
+     * metadata, and move the ones which were not sent to the front.
+     * \return true if all samples were sent
+     */
+    bool send_resampled_buffs(const size_t nsamps, const bool eob, const double timeout)
+    {
+        if (nsamps == 0 and not eob) {
+            return true;
+        }
+        if (nsamps == 0 and _resamp_metadata.start_of_burst) {
+            // the burst ends before it ever started
+            _resamp_metadata = uhd::tx_metadata_t();
+            return true;
+        }
+        std::vector<const void*> buffs(_resamp_buffs.size());
+        for (size_t i = 0; i < buffs.size(); i++) {
+            buffs[i] = _resamp_buffs[i].data();
+        }
+        uhd::tx_metadata_t metadata = _resamp_metadata;
+        metadata.end_of_burst       = eob;
+        const size_t num_sent =
+            send_converted(uhd::tx_streamer::buffs_type(buffs.data(), buffs.size()),
+                nsamps,
+                metadata,
+                timeout);
+        if (num_sent > 0 or nsamps == 0) {
+            // the start of burst and time spec went out with the first packet
+            _resamp_metadata = uhd::tx_metadata_t();
+        }
+        for (auto& buff : _resamp_buffs) {
+            std::copy(buff.begin() + num_sent, buff.begin() + _resamp_fill, buff.begin());
+        }
+        _resamp_fill -= num_sent;
+        return num_sent == nsamps;
+    }
+
     vrt_packer_type _vrt_packer;
     size_t _header_offset_words32;
     double _tick_rate, _samp_rate;
+    uhd::tick_converter _ticks;
     struct xport_chan_props_type
     {
-        xport_chan_props_type(void) : has_sid(false), sid(0) {}
+        xport_chan_props_type(void) : has_sid(false), sid(0), num_commit_bytes(0) {}
         get_buff_type get_buff;
         post_send_cb_type go_postal;
         bool has_sid;
         uint32_t sid;
         managed_send_buffer::sptr buff;
+        size_t num_commit_bytes;
     };
     std::vector<xport_chan_props_type> _props;
     size_t _num_inputs;
     size_t _bytes_per_otw_item; // used in conversion
     size_t _bytes_per_cpu_item; // used in conversion
     uhd::convert::converter::sptr _converter; // used in conversion
+    uhd::convert::id_type _converter_id;
+    std::vector<uhd::convert::converter::sptr> _converters; // one per worker
+    std::vector<uhd::convert::iq_dc_correction_t> _iq_dc_corrections; // one per channel
+    std::vector<uhd::convert::converter::sptr> _iq_dc_converters; // one per channel
+    double _scale_factor;
+    convert_worker_pool::sptr _convert_pool;
+    convert_worker_pool::task_type _convert_task;
+    static const size_t RESAMP_BUFF_SIZE = 4096; // samples per channel
+    polyphase_resampler::sptr _resampler;
+    std::vector<std::vector<polyphase_resampler::sample_type>> _resamp_buffs;
+    std::vector<polyphase_resampler::sample_type> _resamp_zeros;
+    size_t _resamp_fill; // samples per channel waiting in the scratch buffers
+    size_t _resamp_num_zeros; // zeros fed to the filter since the last input
+    uhd::tx_metadata_t _resamp_metadata; // pending until the next packet is sent
     size_t _max_samples_per_packet;
     std::vector<const void*> _zero_buffs;
     size_t _next_packet_seq;
@@ -313,6 +582,7 @@ private:
     async_receiver_type _async_receiver;
     bool _cached_metadata;
     uhd::tx_metadata_t _metadata_cache;
+    stream_counters::sptr _counters;
 
 #ifdef UHD_TXRX_DEBUG_PRINTS
     struct dbg_send_stat_t
@@ -394,8 +664,11 @@ private:
 
         // get a buffer for each channel or timeout
         BOOST_FOREACH (xport_chan_props_type& props, _props) {
-            if (not props.buff)
-                props.buff = props.get_buff(timeout);
+            if (not props.buff) {
+                const auto get_buff_start = stream_counters::clock_type::now();
+                props.buff                = props.get_buff(timeout);
+                _counters->add_get_buff_time(get_buff_start);
+            }
             if (not props.buff)
                 return 0; // timeout
         }
@@ -407,22 +680,62 @@ private:
         _convert_if_packet_info      = &if_packet_info;
 
         // perform N channels of conversion
+        const auto convert_start = stream_counters::clock_type::now();
+        if (_convert_pool) {
+            _convert_pool->run(this->size(), _convert_task);
+        } else {
+            for (size_t i = 0; i < this->size(); i++) {
+                convert_to_in_buff(i);
+            }
+        }
+        _counters->add_convert_time(convert_start);
         for (size_t i = 0; i < this->size(); i++) {
-            convert_to_in_buff(i);
+            commit_in_buff(i);
         }
+        _counters->add_packets(
+            this->size(), this->size() * if_packet_info.num_payload_bytes);
 
         _next_packet_seq++; // increment sequence after commits
         return nsamps_per_buff;
     }
 
-    /*! Run the conversion from the internal buffers to the user's input
-     *  buffer.
+    size_t get_num_converters(void) const
+    {
+        return _convert_pool ? _convert_pool->size() : 1;
+    }
+
+    //! The resampler works on single buffers of fc32 samples
+    void check_resampler_format(void) const
+    {
+        if (_resampler and _converter
+            and (_converter_id.input_format != "fc32" or _num_inputs != 1)) {
+            throw uhd::value_error(
+                "Resampling on the host requires the fc32 CPU format, not "
+                + _converter_id.input_format);
+        }
+    }
+
+    //! Make a correcting converter for each channel, see set_iq_dc_correction()
+    void make_iq_dc_converters(void)
+    {
+        uhd::convert::id_type id = _converter_id;
+        id.input_format += uhd::convert::IQ_DC_FORMAT_SUFFIX;
+        const uhd::convert::function_type make_converter = uhd::convert::get_converter(id);
+        _iq_dc_converters.clear();
+        for (const auto& correction : _iq_dc_corrections) {
+            _iq_dc_converters.push_back(make_converter());
+            _iq_dc_converters.back()->set_scalar(_scale_factor);
+            _iq_dc_converters.back()->set_iq_dc_correction(correction);
+        }
+    }
+
+    /*! Run the conversion from the user's input buffer to the internal
+     *  buffers.
      *
-     * - Calls the converter
-     * - Releases internal data buffers
-     * - Updates read/write pointers
+     * - Packs the VRT header
+     * - Calls the converter of the given worker
      */
-    UHD_INLINE void convert_to_in_buff(const size_t index)
+    UHD_INLINE void convert_to_in_buff(const size_t index, const size_t worker = 0)
     {
         // shortcut references to local data structures
         managed_send_buffer::sptr& buff      = _props[index].buff;
@@ -444,13 +757,27 @@ private:
         _vrt_packer(otw_mem, if_packet_info);
         otw_mem += if_packet_info.num_header_words32;
 
-        // perform the conversion operation
-        _converter->conv(in_buffs, otw_mem, _convert_nsamps);
+        // perform the conversion operation, corrected channels have their own converter
+        const uhd::convert::converter::sptr& converter =
+            _iq_dc_converters.empty() ? _converters[worker] : _iq_dc_converters[index];
+        converter->conv(in_buffs, otw_mem, _convert_nsamps);
 
-        // commit the samples to the zero-copy interface
         const size_t num_vita_words32 =
             _header_offset_words32 + if_packet_info.num_packet_words32;
-        buff->commit(num_vita_words32 * sizeof(uint32_t));
+        _props[index].num_commit_bytes = num_vita_words32 * sizeof(uint32_t);
+    }
+
+    /*! Hand a converted packet to the transport. Always runs on the
+     *  calling thread, in channel order.
+     *
+     * - Commits and releases internal data buffers
+     */
+    UHD_INLINE void commit_in_buff(const size_t index)
+    {
+        managed_send_buffer::sptr& buff = _props[index].buff;
+
+        // commit the samples to the zero-copy interface
+        buff->commit(_props[index].num_commit_bytes);
         buff.reset(); // effectively a release
 
         if (_props[index].go_postal) {
@@ -497,6 +824,17 @@ public:
         return send_packet_handler::recv_async_msg(async_metadata, timeout);
     }
 
+    stream_stats_t get_stats(void) const
+    {
+        return get_stream_counters()->get_stats();
+    }
+
+    void set_iq_dc_correction(
+        const size_t chan, const uhd::convert::iq_dc_correction_t& correction)
+    {
+        send_packet_handler::set_iq_dc_correction(chan, correction);
+    }
+
 private:
     size_t _max_num_samps;
 };
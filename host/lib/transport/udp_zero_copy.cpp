@@ -10,12 +10,24 @@
 #include <uhd/transport/udp_simple.hpp> //mtu
 #include <uhd/transport/udp_zero_copy.hpp>
 #include <uhd/utils/log.hpp>
+#include <uhd/utils/safe_call.hpp>
 #include <uhdlib/utils/atomic.hpp>
 #include <boost/format.hpp>
 #include <boost/make_shared.hpp>
 #include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
+#if defined(HAVE_RECVMMSG) || defined(HAVE_SENDMMSG)
+#    include <sys/socket.h>
+#endif
+#ifdef UHD_PLATFORM_LINUX
+#    include <ifaddrs.h>
+#endif
 
 using namespace uhd;
 using namespace uhd::transport;
@@ -25,6 +37,9 @@ constexpr size_t UDP_ZERO_COPY_DEFAULT_FRAME_SIZE =
     1472; // Based on common 1500 byte MTU for 1GbE.
 constexpr size_t UDP_ZERO_COPY_DEFAULT_BUFF_SIZE =
     2500000; // 20ms of data for 1GbE link (in bytes)
+constexpr size_t UDP_ZERO_COPY_DEFAULT_RECV_BATCH_SIZE   = 1;
+constexpr size_t UDP_ZERO_COPY_DEFAULT_SEND_BATCH_SIZE   = 1;
+constexpr double UDP_ZERO_COPY_DEFAULT_SEND_BATCH_TIMEOUT = 100e-6; // seconds
 /***********************************************************************
  * Check registry for correct fast-path setting (windows only)
  **********************************************************************/
@@ -58,6 +73,69 @@ static void check_registry_for_fast_send_threshold(const size_t mtu)
 }
 #endif /*HAVE_ATLBASE_H*/
 
+/***********************************************************************
+ * Frame memory placement
+ **********************************************************************/
+static buffer_pool::alloc_params get_pool_params(const zero_copy_xport_params& params)
+{
+    buffer_pool::alloc_params pool_params;
+    pool_params.use_huge_pages = params.use_huge_pages;
+    pool_params.numa_node      = params.numa_node;
+    return pool_params;
+}
+
+#ifdef UHD_PLATFORM_LINUX
+/*!
+ * Find the NUMA node of the network interface which the route to the
+ * given endpoint goes through.
+ * \return the node, or buffer_pool::NUMA_NODE_ANY when it is unknown
+ */
+static int get_nic_numa_node(const std::string& addr, const std::string& port)
+{
+    std::string iface;
+    try {
+        // Connecting a UDP socket only looks up the route
+        asio::io_service io_service;
+        asio::ip::udp::resolver resolver(io_service);
+        asio::ip::udp::resolver::query query(asio::ip::udp::v4(), addr, port);
+        asio::ip::udp::socket socket(io_service);
+        socket.open(asio::ip::udp::v4());
+        socket.connect(*resolver.resolve(query));
+        const asio::ip::address_v4 local_addr =
+            socket.local_endpoint().address().to_v4();
+
+        ifaddrs* ifas = nullptr;
+        if (::getifaddrs(&ifas) == 0) {
+            for (ifaddrs* ifa = ifas; ifa != nullptr; ifa = ifa->ifa_next) {
+                if (ifa->ifa_addr != nullptr and ifa->ifa_addr->sa_family == AF_INET
+                    and ntohl(reinterpret_cast<sockaddr_in*>(ifa->ifa_addr)
+                                  ->sin_addr.s_addr)
+                            == local_addr.to_ulong()) {
+                    iface = ifa->ifa_name;
+                    break;
+                }
+            }
+            ::freeifaddrs(ifas);
+        }
+    } catch (const boost::system::system_error& e) {
+        UHD_LOGGER_WARNING("UDP") << "Cannot find the interface to " << addr << ": "
+                                  << e.what();
+    }
+
+    // Virtual interfaces have no device, and single-node hosts report -1
+    int node = buffer_pool::NUMA_NODE_ANY;
+    if (not iface.empty()) {
+        std::ifstream numa_file("/sys/class/net/" + iface + "/device/numa_node");
+        if (not(numa_file >> node) or node < 0) {
+            node = buffer_pool::NUMA_NODE_ANY;
+        }
+    }
+    UHD_LOGGER_TRACE("UDP") << boost::format("NUMA node of interface '%s': %d") % iface
+                                   % node;
+    return node;
+}
+#endif /* UHD_PLATFORM_LINUX */
+
 /***********************************************************************
  * Reusable managed receiver buffer:
  *  - get_new performs the recv operation
@@ -103,6 +181,32 @@ public:
         return sptr(); // null for timeout
     }
 
+    /*******************************************************************
+     * Batched receive support:
+     * The transport claims a run of buffers, fills them with a single
+     * recvmmsg() and then hands them out one by one with get_filled().
+     ******************************************************************/
+    UHD_INLINE bool claim_with_wait(const double timeout)
+    {
+        return _claimer.claim_with_wait(timeout);
+    }
+
+    UHD_INLINE bool try_claim(void)
+    {
+        return _claimer.try_claim();
+    }
+
+    UHD_INLINE void unclaim(void)
+    {
+        _claimer.release();
+    }
+
+    UHD_INLINE sptr get_filled(const size_t len, size_t& index)
+    {
+        index++; // advances the caller's buffer
+        return make(this, _mem, len);
+    }
+
 private:
     void* _mem;
     int _sock_fd;
@@ -111,6 +215,143 @@ private:
     simple_claimer _claimer;
 };
 
+#ifdef HAVE_SENDMMSG
+/***********************************************************************
+ * Send batcher:
+ *  - collects committed send buffers and sends them with one sendmmsg()
+ *  - flushes when the batch is full, when the transport runs out of
+ *    free send buffers, or when the oldest buffer has waited too long
+ **********************************************************************/
+class udp_zero_copy_send_batcher
+{
+public:
+    udp_zero_copy_send_batcher(
+        int sock_fd, const size_t batch_size, const double batch_timeout)
+        : _sock_fd(sock_fd)
+        , _batch_size(batch_size)
+        , _batch_timeout(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+              std::chrono::duration<double>(batch_timeout)))
+        , _done(false)
+    {
+        _pending.reserve(_batch_size);
+        _msgs.resize(_batch_size);
+        _iovs.resize(_batch_size);
+        _flush_thread = std::thread([this]() { this->flush_loop(); });
+    }
+
+    ~udp_zero_copy_send_batcher(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _done = true;
+        }
+        _cond.notify_one();
+        _flush_thread.join();
+        UHD_SAFE_CALL(this->flush();)
+    }
+
+    //! Queue a committed buffer; the claimer is released once it was sent
+    void push(const void* mem, const size_t len, simple_claimer* claimer)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending.push_back(pending_type{mem, len, claimer});
+        if (_pending.size() >= _batch_size) {
+            flush_locked();
+        } else if (_pending.size() == 1) {
+            _deadline = std::chrono::steady_clock::now() + _batch_timeout;
+            _cond.notify_one();
+        }
+    }
+
+    //! Send everything that is queued
+    void flush(void)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        flush_locked();
+    }
+
+private:
+    struct pending_type
+    {
+        const void* mem;
+        size_t len;
+        simple_claimer* claimer;
+    };
+
+    void flush_locked(void)
+    {
+        const size_t num_msgs = _pending.size();
+        for (size_t i = 0; i < num_msgs; i++) {
+            _iovs[i].iov_base = const_cast<void*>(_pending[i].mem);
+            _iovs[i].iov_len  = _pending[i].len;
+            std::memset(&_msgs[i], 0, sizeof(mmsghdr));
+            _msgs[i].msg_hdr.msg_iov    = &_iovs[i];
+            _msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        // Retry logic because send may fail with ENOBUFS (see
+        // udp_zero_copy_asio_msb::release()). sendmmsg() may also return
+        // after sending only part of the batch.
+        size_t num_sent = 0;
+        while (num_sent < num_msgs) {
+            const int ret =
+                ::sendmmsg(_sock_fd, &_msgs[num_sent], unsigned(num_msgs - num_sent), 0);
+            if (ret == -1 and errno == ENOBUFS) {
+                std::this_thread::sleep_for(std::chrono::microseconds(1));
+                continue; // try to send again
+            }
+            if (ret == -1) {
+                release_pending();
+                throw uhd::io_error(
+                    str(boost::format("send error on socket: %s") % strerror(errno)));
+            }
+            num_sent += size_t(ret);
+        }
+        release_pending();
+    }
+
+    void release_pending(void)
+    {
+        for (const pending_type& pending : _pending) {
+            pending.claimer->release();
+        }
+        _pending.clear();
+    }
+
+    void flush_loop(void)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (not _done) {
+            if (_pending.empty()) {
+                _cond.wait(lock);
+                continue;
+            }
+            if (_cond.wait_until(lock, _deadline) == std::cv_status::timeout
+                and not _pending.empty()
+                and std::chrono::steady_clock::now() >= _deadline) {
+                try {
+                    flush_locked();
+                } catch (const uhd::exception& e) {
+                    UHD_LOGGER_ERROR("UDP") << "Error flushing send batch: " << e.what();
+                }
+            }
+        }
+    }
+
+    const int _sock_fd;
+    const size_t _batch_size;
+    const std::chrono::steady_clock::duration _batch_timeout;
+    std::vector<pending_type> _pending;
+    std::vector<mmsghdr> _msgs;
+    std::vector<iovec> _iovs;
+    std::chrono::steady_clock::time_point _deadline;
+    bool _done;
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    std::thread _flush_thread;
+};
+#endif /* HAVE_SENDMMSG */
+
 /***********************************************************************
  * Reusable managed send buffer:
  *  - commit performs the send operation
@@ -123,8 +364,24 @@ public:
     { /*NOP*/
     }
 
+#ifdef HAVE_SENDMMSG
+    udp_zero_copy_asio_msb(void* mem,
+        int sock_fd,
+        const size_t frame_size,
+        udp_zero_copy_send_batcher* batcher)
+        : _mem(mem), _sock_fd(sock_fd), _frame_size(frame_size), _batcher(batcher)
+    { /*NOP*/
+    }
+#endif
+
     void release(void)
     {
+#ifdef HAVE_SENDMMSG
+        if (_batcher) {
+            _batcher->push(_mem, size(), &_claimer);
+            return;
+        }
+#endif
         // Retry logic because send may fail with ENOBUFS.
         // This is known to occur at least on some OSX systems.
         // But it should be safe to always check for the error.
@@ -147,7 +404,16 @@ public:
 
     UHD_INLINE sptr get_new(const double timeout, size_t& index)
     {
-        if (not _claimer.claim_with_wait(timeout))
+        bool claimed = false;
+#ifdef HAVE_SENDMMSG
+        if (_batcher) {
+            // this buffer may still be waiting in an unsent batch
+            claimed = _claimer.try_claim();
+            if (not claimed)
+                _batcher->flush();
+        }
+#endif
+        if (not claimed and not _claimer.claim_with_wait(timeout))
             return sptr();
         index++; // advances the caller's buffer
         return make(this, _mem, _frame_size);
@@ -158,6 +424,9 @@ private:
     int _sock_fd;
     size_t _frame_size;
     simple_claimer _claimer;
+#ifdef HAVE_SENDMMSG
+    udp_zero_copy_send_batcher* _batcher = nullptr;
+#endif
 };
 
 /***********************************************************************
@@ -174,17 +443,26 @@ public:
 
     udp_zero_copy_asio_impl(const std::string& addr,
         const std::string& port,
-        const zero_copy_xport_params& xport_params)
+        const zero_copy_xport_params& xport_params,
+        const size_t recv_batch_size,
+        const size_t send_batch_size,
+        const double send_batch_timeout)
         : _recv_frame_size(xport_params.recv_frame_size)
         , _num_recv_frames(xport_params.num_recv_frames)
         , _send_frame_size(xport_params.send_frame_size)
         , _num_send_frames(xport_params.num_send_frames)
-        , _recv_buffer_pool(buffer_pool::make(
-              xport_params.num_recv_frames, xport_params.recv_frame_size))
-        , _send_buffer_pool(buffer_pool::make(
-              xport_params.num_send_frames, xport_params.send_frame_size))
+        , _recv_buffer_pool(buffer_pool::make(xport_params.num_recv_frames,
+              xport_params.recv_frame_size,
+              get_pool_params(xport_params)))
+        , _send_buffer_pool(buffer_pool::make(xport_params.num_send_frames,
+              xport_params.send_frame_size,
+              get_pool_params(xport_params)))
         , _next_recv_buff_index(0)
         , _next_send_buff_index(0)
+#ifdef HAVE_RECVMMSG
+        , _recv_batch_size(std::min(recv_batch_size, xport_params.num_recv_frames))
+        , _num_recv_ready(0)
+#endif
     {
         UHD_LOGGER_TRACE("UDP")
             << boost::format("Creating UDP transport to %s:%s") % addr % port;
@@ -213,13 +491,63 @@ public:
                 _recv_buffer_pool->at(i), _sock_fd, get_recv_frame_size()));
         }
 
+#ifdef HAVE_RECVMMSG
+        // one message header per receive buffer, so any run of buffers can
+        // be filled with one call to recvmmsg()
+        if (_recv_batch_size > 1) {
+            _recv_msgs.resize(get_num_recv_frames());
+            _recv_iovs.resize(get_num_recv_frames());
+            for (size_t i = 0; i < get_num_recv_frames(); i++) {
+                _recv_iovs[i].iov_base = _recv_buffer_pool->at(i);
+                _recv_iovs[i].iov_len  = get_recv_frame_size();
+                std::memset(&_recv_msgs[i], 0, sizeof(mmsghdr));
+                _recv_msgs[i].msg_hdr.msg_iov    = &_recv_iovs[i];
+                _recv_msgs[i].msg_hdr.msg_iovlen = 1;
+            }
+        }
+#else
+        if (recv_batch_size > 1) {
+            UHD_LOGGER_DEBUG("UDP") << "Batched receive is not supported on this platform";
+        }
+#endif /* HAVE_RECVMMSG */
+
+#ifdef HAVE_SENDMMSG
+        // batches can never be larger than the number of send buffers
+        const size_t batch_size = std::min(send_batch_size, get_num_send_frames());
+        if (batch_size > 1) {
+            _send_batcher.reset(
+                new udp_zero_copy_send_batcher(_sock_fd, batch_size, send_batch_timeout));
+        }
+#else
+        (void)send_batch_timeout;
+        if (send_batch_size > 1) {
+            UHD_LOGGER_DEBUG("UDP") << "Batched send is not supported on this platform";
+        }
+#endif /* HAVE_SENDMMSG */
+
         // allocate re-usable managed send buffers
         for (size_t i = 0; i < get_num_send_frames(); i++) {
+#ifdef HAVE_SENDMMSG
+            _msb_pool.push_back(
+                boost::make_shared<udp_zero_copy_asio_msb>(_send_buffer_pool->at(i),
+                    _sock_fd,
+                    get_send_frame_size(),
+                    _send_batcher.get()));
+#else
             _msb_pool.push_back(boost::make_shared<udp_zero_copy_asio_msb>(
                 _send_buffer_pool->at(i), _sock_fd, get_send_frame_size()));
+#endif
         }
     }
 
+#ifdef HAVE_SENDMMSG
+    ~udp_zero_copy_asio_impl(void)
+    {
+        // flush pending sends while the socket is still open
+        _send_batcher.reset();
+    }
+#endif
+
     // get size for internal socket buffer
     template <typename Opt> size_t get_buff_size(void) const
     {
@@ -243,9 +571,21 @@ public:
     /*******************************************************************
      * Receive implementation:
      * Block on the managed buffer's get call and advance the index.
+     * With batching, one recvmmsg() fills a run of buffers, which are
+     * then handed out without any further system calls.
      ******************************************************************/
     managed_recv_buffer::sptr get_recv_buff(double timeout)
     {
+#ifdef HAVE_RECVMMSG
+        if (_recv_batch_size > 1) {
+            if (_num_recv_ready == 0 and not recv_batch(timeout))
+                return managed_recv_buffer::sptr(); // null for timeout
+            _num_recv_ready--;
+            const size_t index = _next_recv_buff_index;
+            return _mrb_pool[index]->get_filled(
+                _recv_msgs[index].msg_len, _next_recv_buff_index);
+        }
+#endif /* HAVE_RECVMMSG */
         if (_next_recv_buff_index == _num_recv_frames)
             _next_recv_buff_index = 0;
         return _mrb_pool[_next_recv_buff_index]->get_new(timeout, _next_recv_buff_index);
@@ -260,6 +600,15 @@ public:
         return _recv_frame_size;
     }
 
+    int get_recv_fd(void) const
+    {
+#ifdef UHD_PLATFORM_WIN32
+        return -1; // Sockets aren't file descriptors
+#else
+        return _sock_fd;
+#endif /* UHD_PLATFORM_WIN32 */
+    }
+
     /*******************************************************************
      * Send implementation:
      * Block on the managed buffer's get call and advance the index.
@@ -291,14 +640,76 @@ public:
     }
 
 private:
+#ifdef HAVE_RECVMMSG
+    /*!
+     * Claim the free buffers following the next buffer (up to the end of
+     * the pool) and fill as many of them as possible with one recvmmsg().
+     * \return true when at least one buffer was filled
+     */
+    bool recv_batch(const double timeout)
+    {
+        if (_next_recv_buff_index == _num_recv_frames)
+            _next_recv_buff_index = 0;
+        const size_t first = _next_recv_buff_index;
+        if (not _mrb_pool[first]->claim_with_wait(timeout))
+            return false;
+
+        const size_t max_claims = std::min(_recv_batch_size, _num_recv_frames - first);
+        size_t num_claimed      = 1;
+        while (num_claimed < max_claims
+               and _mrb_pool[first + num_claimed]->try_claim()) {
+            num_claimed++;
+        }
+
+        int ret = ::recvmmsg(
+            _sock_fd, &_recv_msgs[first], unsigned(num_claimed), MSG_DONTWAIT, NULL);
+        if (ret == -1 and (errno == EAGAIN or errno == EWOULDBLOCK)) {
+            ret = 0;
+            if (wait_for_recv_ready(_sock_fd, timeout)) {
+                ret = ::recvmmsg(_sock_fd,
+                    &_recv_msgs[first],
+                    unsigned(num_claimed),
+                    MSG_DONTWAIT,
+                    NULL);
+            }
+        }
+        const int recv_errno = errno;
+
+        // undo the claims on buffers that did not get filled
+        const size_t num_filled = (ret > 0) ? size_t(ret) : 0;
+        for (size_t i = num_filled; i < num_claimed; i++) {
+            _mrb_pool[first + i]->unclaim();
+        }
+        if (ret == -1 and recv_errno != EAGAIN and recv_errno != EWOULDBLOCK) {
+            throw uhd::io_error(
+                str(boost::format("recv error on socket: %s") % strerror(recv_errno)));
+        }
+
+        _num_recv_ready = num_filled;
+        return num_filled > 0;
+    }
+#endif /* HAVE_RECVMMSG */
+
     // memory management -> buffers and fifos
     const size_t _recv_frame_size, _num_recv_frames;
     const size_t _send_frame_size, _num_send_frames;
     buffer_pool::sptr _recv_buffer_pool, _send_buffer_pool;
+#ifdef HAVE_SENDMMSG
+    // send buffers push into it on release, see ~udp_zero_copy_asio_impl()
+    std::unique_ptr<udp_zero_copy_send_batcher> _send_batcher;
+#endif
     std::vector<boost::shared_ptr<udp_zero_copy_asio_msb>> _msb_pool;
     std::vector<boost::shared_ptr<udp_zero_copy_asio_mrb>> _mrb_pool;
     size_t _next_recv_buff_index, _next_send_buff_index;
 
+#ifdef HAVE_RECVMMSG
+    // batched receive -> one message header per receive buffer
+    const size_t _recv_batch_size;
+    size_t _num_recv_ready;
+    std::vector<mmsghdr> _recv_msgs;
+    std::vector<iovec> _recv_iovs;
+#endif
+
     // asio guts -> socket and service
     asio::io_service _io_service;
     socket_sptr _socket;
@@ -360,6 +771,19 @@ udp_zero_copy::sptr udp_zero_copy::make(const std::string& addr,
         size_t(hints.cast<double>("recv_buff_size", default_buff_args.recv_buff_size));
     xport_params.send_buff_size =
         size_t(hints.cast<double>("send_buff_size", default_buff_args.send_buff_size));
+    xport_params.use_huge_pages =
+        hints.cast<bool>("use_huge_pages", default_buff_args.use_huge_pages);
+
+    const std::string numa_node = hints.get("numa_node", "");
+    if (numa_node == "local") {
+        xport_params.numa_node = buffer_pool::NUMA_NODE_LOCAL;
+    } else if (numa_node == "nic") {
+#ifdef UHD_PLATFORM_LINUX
+        xport_params.numa_node = get_nic_numa_node(addr, port);
+#endif
+    } else if (not numa_node.empty()) {
+        xport_params.numa_node = hints.cast<int>("numa_node", xport_params.numa_node);
+    }
 
     if (xport_params.num_recv_frames == 0) {
         UHD_LOG_TRACE("UDP",
@@ -410,8 +834,15 @@ udp_zero_copy::sptr udp_zero_copy::make(const std::string& addr,
     }
 #endif
 
-    udp_zero_copy_asio_impl::sptr udp_trans(
-        new udp_zero_copy_asio_impl(addr, port, xport_params));
+    const size_t recv_batch_size =
+        size_t(hints.cast<double>("recv_batch_size", UDP_ZERO_COPY_DEFAULT_RECV_BATCH_SIZE));
+    const size_t send_batch_size =
+        size_t(hints.cast<double>("send_batch_size", UDP_ZERO_COPY_DEFAULT_SEND_BATCH_SIZE));
+    const double send_batch_timeout =
+        hints.cast<double>("send_batch_timeout", UDP_ZERO_COPY_DEFAULT_SEND_BATCH_TIMEOUT);
+
+    udp_zero_copy_asio_impl::sptr udp_trans(new udp_zero_copy_asio_impl(
+        addr, port, xport_params, recv_batch_size, send_batch_size, send_batch_timeout));
 
     // call the helper to resize send and recv buffers
     buff_params_out.recv_buff_size =
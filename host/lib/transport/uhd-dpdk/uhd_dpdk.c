@@ -82,18 +82,79 @@ int uhd_dpdk_set_ipv4_addr(unsigned int portid, uint32_t ipv4_addr, uint32_t net
     if (p) {
         p->ipv4_addr = ipv4_addr;
         p->netmask = netmask;
+        for (unsigned int q = 1; q < p->num_queues; q++) {
+            p->queues[q]->ipv4_addr = ipv4_addr;
+            p->queues[q]->netmask = netmask;
+        }
         return 0;
     }
     return -ENODEV;
 }
 
 /*
- * Initialize a given port using default settings and with the RX buffers
- * coming from the mbuf_pool passed as a parameter.
- * FIXME: Starting with assumption of one thread/core per port
+ * Create the tables (and ARP ring, for queues other than 0) of one of a
+ * port's queues
+ */
+static int uhd_dpdk_queue_init(struct uhd_dpdk_port *port)
+{
+    /* Create the hash table for the RX sockets */
+    char name[32];
+    snprintf(name, sizeof(name), "rx_table_%u.%u", port->id, port->queue_id);
+    struct rte_hash_parameters hash_params = {
+        .name = name,
+        .entries = UHD_DPDK_MAX_SOCKET_CNT,
+        .key_len = sizeof(struct uhd_dpdk_ipv4_5tuple),
+        .hash_func = NULL,
+        .hash_func_init_val = 0,
+    };
+    port->rx_table = rte_hash_create(&hash_params);
+    if (port->rx_table == NULL)
+        return rte_errno;
+
+    /* Create ARP table */
+    snprintf(name, sizeof(name), "arp_table_%u.%u", port->id, port->queue_id);
+    hash_params.name = name;
+    hash_params.entries = UHD_DPDK_MAX_SOCKET_CNT;
+    hash_params.key_len = sizeof(uint32_t);
+    hash_params.hash_func = NULL;
+    hash_params.hash_func_init_val = 0;
+    port->arp_table = rte_hash_create(&hash_params);
+    if (port->arp_table == NULL)
+        goto free_rx_table;
+
+    /* Only queue 0 gets ARP replies from the NIC, and it passes them on */
+    if (port->queue_id > 0) {
+        snprintf(name, sizeof(name), "arp_ring_%u.%u", port->id, port->queue_id);
+        port->arp_ring = rte_ring_create(
+                            name,
+                            UHD_DPDK_ARPQ_SIZE,
+                            rte_lcore_to_socket_id(port->parent->lcore),
+                            RING_F_SC_DEQ | RING_F_SP_ENQ
+                        );
+        if (port->arp_ring == NULL)
+            goto free_arp_table;
+    }
+
+    /* Set up list for TX queues */
+    LIST_INIT(&port->txq_list);
+    return 0;
+
+free_arp_table:
+    rte_hash_free(port->arp_table);
+free_rx_table:
+    rte_hash_free(port->rx_table);
+    return rte_errno;
+}
+
+/*
+ * Initialize a given port using default settings, with one RX/TX queue pair
+ * per entry of port->queues. The RX buffers of each queue come from the
+ * mbuf_pool of the thread servicing it.
+ *
+ * Packets are steered to queues other than 0 by flow rules (one per RX
+ * socket). If the NIC can't do that, only queue 0 is used.
  */
 static inline int uhd_dpdk_port_init(struct uhd_dpdk_port *port,
-                                     struct rte_mempool *rx_mbuf_pool,
                                      unsigned int mtu)
 {
     int retval;
@@ -102,7 +163,7 @@ static inline int uhd_dpdk_port_init(struct uhd_dpdk_port *port,
     if (port->id >= rte_eth_dev_count())
         return -ENODEV;
 
-    /* Set up Ethernet device with defaults (1 RX ring, 1 TX ring) */
+    /* Set up Ethernet device with defaults */
     retval = rte_eth_dev_set_mtu(port->id, mtu);
     if (retval) {
         uint16_t actual_mtu;
@@ -138,7 +199,15 @@ static inline int uhd_dpdk_port_init(struct uhd_dpdk_port *port,
             .offloads = tx_offloads,
         }
     };
-    retval = rte_eth_dev_configure(port->id, 1, 1, &port_conf);
+    unsigned int num_queues = port->num_queues;
+    if (num_queues > dev_info.max_rx_queues)
+        num_queues = dev_info.max_rx_queues;
+    if (num_queues > dev_info.max_tx_queues)
+        num_queues = dev_info.max_tx_queues;
+    if (num_queues != port->num_queues) {
+        RTE_LOG(WARNING, EAL, "Port %u: Only supports %u queues\n", port->id, num_queues);
+    }
+    retval = rte_eth_dev_configure(port->id, num_queues, num_queues, &port_conf);
     if (retval != 0)
         return retval;
 
@@ -153,57 +222,50 @@ static inline int uhd_dpdk_port_init(struct uhd_dpdk_port *port,
     if (tx_desc != DEFAULT_RING_SIZE)
         RTE_LOG(WARNING, EAL, "TX descriptors changed to %d\n", tx_desc);
 
-    retval = rte_eth_rx_queue_setup(port->id, 0, rx_desc,
-                 rte_eth_dev_socket_id(port->id), NULL, rx_mbuf_pool);
-    if (retval < 0)
-        return retval;
-
     struct rte_eth_txconf txconf = {
         .offloads = DEV_TX_OFFLOAD_IPV4_CKSUM
     };
-    retval = rte_eth_tx_queue_setup(port->id, 0, tx_desc,
-                 rte_eth_dev_socket_id(port->id), &txconf);
-    if (retval < 0)
-        goto port_init_fail;
-
-    /* Create the hash table for the RX sockets */
-    char name[32];
-    snprintf(name, sizeof(name), "rx_table_%u", port->id);
-    struct rte_hash_parameters hash_params = {
-        .name = name,
-        .entries = UHD_DPDK_MAX_SOCKET_CNT,
-        .key_len = sizeof(struct uhd_dpdk_ipv4_5tuple),
-        .hash_func = NULL,
-        .hash_func_init_val = 0,
-    };
-    port->rx_table = rte_hash_create(&hash_params);
-    if (port->rx_table == NULL) {
-        retval = rte_errno;
-        goto port_init_fail;
+    for (unsigned int q = 0; q < num_queues; q++) {
+        retval = rte_eth_rx_queue_setup(port->id, q, rx_desc,
+                     rte_eth_dev_socket_id(port->id), NULL,
+                     port->queues[q]->parent->rx_pktbuf_pool);
+        if (retval < 0)
+            return retval;
+
+        retval = rte_eth_tx_queue_setup(port->id, q, tx_desc,
+                     rte_eth_dev_socket_id(port->id), &txconf);
+        if (retval < 0)
+            goto port_init_fail;
     }
 
-    /* Create ARP table */
-    snprintf(name, sizeof(name), "arp_table_%u", port->id);
-    hash_params.name = name;
-    hash_params.entries = UHD_DPDK_MAX_SOCKET_CNT;
-    hash_params.key_len = sizeof(uint32_t);
-    hash_params.hash_func = NULL;
-    hash_params.hash_func_init_val = 0;
-    port->arp_table = rte_hash_create(&hash_params);
-    if (port->arp_table == NULL) {
-        retval = rte_errno;
-        goto free_rx_table;
-    }
-
-    /* Set up list for TX queues */
-    LIST_INIT(&port->txq_list);
+    retval = uhd_dpdk_queue_init(port);
+    if (retval)
+        goto port_init_fail;
 
     /* Start the Ethernet port. */
     retval = rte_eth_dev_start(port->id);
     if (retval < 0) {
-        goto free_arp_table;
+        goto free_tables;
     }
 
+    /* Check that the other queues can get their packets */
+    if (num_queues > 1 && _uhd_dpdk_udp_flow_create(port->queues[1], rte_cpu_to_be_16(1), NULL)) {
+        RTE_LOG(WARNING, EAL, "Port %u: No flow rule support, using 1 queue\n", port->id);
+        num_queues = 1;
+    }
+    for (unsigned int q = 1; q < num_queues; q++) {
+        if (uhd_dpdk_queue_init(port->queues[q]))
+            rte_exit(EXIT_FAILURE, "Cannot init queue %u of port %u\n", q, port->id);
+    }
+    for (unsigned int q = num_queues; q < port->num_queues; q++) {
+        rte_free(port->queues[q]);
+        port->queues[q] = NULL;
+    }
+    for (unsigned int q = 0; q < num_queues; q++) {
+        port->queues[q]->num_queues = num_queues;
+    }
+    rte_atomic32_set(&port->num_active, num_queues);
+
     /* Display the port MAC address. */
     rte_eth_macaddr_get(port->id, &port->mac_addr);
     RTE_LOG(INFO, EAL, "Port %u MAC: %02x %02x %02x %02x %02x %02x\n",
@@ -218,9 +280,8 @@ static inline int uhd_dpdk_port_init(struct uhd_dpdk_port *port,
 
     return 0;
 
-free_arp_table:
+free_tables:
     rte_hash_free(port->arp_table);
-free_rx_table:
     rte_hash_free(port->rx_table);
 port_init_fail:
     return rte_errno;
@@ -294,8 +355,12 @@ int uhd_dpdk_init(int argc, const char **argv)
     for (size_t i = 0; i < ctx->num_ports; i++) {
         struct uhd_dpdk_port *port = &ctx->ports[i];
         port->id = i;
+        port->queue_id = 0;
+        port->num_queues = 1;
+        port->queues[0] = port;
         rte_eth_macaddr_get(port->id, &port->mac_addr);
     }
+    rte_spinlock_init(&ctx->flow_lock);
 
     return 0;
 }
@@ -313,6 +378,15 @@ int uhd_dpdk_start(unsigned int num_ports, int *port_thread_mapping,
     if (ctx->num_ports < num_ports)
         rte_exit(EXIT_FAILURE, "Error: User requested more ports than available\n");
 
+    /* Every queue holds on to RX buffers, so size the pools by queues */
+    unsigned int num_queues = 0;
+    for (unsigned int i = 0; i < num_ports*UHD_DPDK_MAX_QUEUES_PER_PORT; i++) {
+        if (port_thread_mapping[i] >= 0)
+            num_queues++;
+    }
+    if (num_queues < ctx->num_ports)
+        num_queues = ctx->num_ports;
+
     /* Initialize the thread data structures */
     for (int i = rte_get_next_lcore(-1, 1, 0);
         (i < RTE_MAX_LCORE);
@@ -330,7 +404,7 @@ int uhd_dpdk_start(unsigned int num_ports, int *port_thread_mapping,
             snprintf(name, sizeof(name), "rx_mbuf_pool_%u", socket_id);
             ctx->rx_pktbuf_pools[socket_id] = rte_pktmbuf_pool_create(
                                                name,
-                                               ctx->num_ports*num_mbufs,
+                                               num_queues*num_mbufs,
                                                mbuf_cache_size,
                                                0,
                                                mbuf_size,
@@ -339,7 +413,7 @@ int uhd_dpdk_start(unsigned int num_ports, int *port_thread_mapping,
             snprintf(name, sizeof(name), "tx_mbuf_pool_%u", socket_id);
             ctx->tx_pktbuf_pools[socket_id] = rte_pktmbuf_pool_create(
                                                name,
-                                               ctx->num_ports*num_mbufs,
+                                               num_queues*num_mbufs,
                                                mbuf_cache_size,
                                                0,
                                                mbuf_size,
@@ -356,25 +430,51 @@ int uhd_dpdk_start(unsigned int num_ports, int *port_thread_mapping,
 
     unsigned master_lcore = rte_get_master_lcore();
 
-    /* Assign ports to threads and initialize the port data structures */
+    /* Assign ports' queues to threads and initialize the port data structures */
     for (unsigned int i = 0; i < num_ports; i++) {
-        int thread_id = port_thread_mapping[i];
-        if (thread_id < 0)
+        int *queue_thread_mapping = &port_thread_mapping[i*UHD_DPDK_MAX_QUEUES_PER_PORT];
+        if (queue_thread_mapping[0] < 0)
             continue;
-        if (((unsigned int) thread_id) == master_lcore)
-            RTE_LOG(WARNING, EAL, "User requested master lcore for port %u\n", i);
-        if (ctx->threads[thread_id].lcore != (unsigned int) thread_id)
-            rte_exit(EXIT_FAILURE, "Requested inactive lcore %u for port %u\n", (unsigned int) thread_id, i);
 
         struct uhd_dpdk_port *port = &ctx->ports[i];
-        port->parent = &ctx->threads[thread_id];
-        ctx->threads[thread_id].num_ports++;
-        LIST_INSERT_HEAD(&ctx->threads[thread_id].port_list, port, port_entry);
+        port->num_queues = 0;
+        for (unsigned int q = 0; q < UHD_DPDK_MAX_QUEUES_PER_PORT; q++) {
+            int thread_id = queue_thread_mapping[q];
+            if (thread_id < 0)
+                break;
+            if (((unsigned int) thread_id) == master_lcore)
+                RTE_LOG(WARNING, EAL, "User requested master lcore for port %u\n", i);
+            if (ctx->threads[thread_id].lcore != (unsigned int) thread_id)
+                rte_exit(EXIT_FAILURE, "Requested inactive lcore %u for port %u\n", (unsigned int) thread_id, i);
+
+            struct uhd_dpdk_port *queue = port;
+            if (q > 0) {
+                queue = rte_zmalloc("uhd_dpdk_port", sizeof(*queue), 0);
+                if (!queue)
+                    rte_exit(EXIT_FAILURE, "Error: Could not allocate memory for port data\n");
+                queue->id = port->id;
+                queue->queue_id = q;
+                ether_addr_copy(&port->mac_addr, &queue->mac_addr);
+                queue->ipv4_addr = port->ipv4_addr;
+                queue->netmask = port->netmask;
+            }
+            queue->parent = &ctx->threads[thread_id];
+            port->queues[q] = queue;
+            port->num_queues++;
+        }
 
-        /* Initialize port. */
-        if (uhd_dpdk_port_init(port, port->parent->rx_pktbuf_pool, mtu) != 0)
+        /* Initialize port. This may cut down the number of queues. */
+        if (uhd_dpdk_port_init(port, mtu) != 0)
             rte_exit(EXIT_FAILURE, "Cannot init port %"PRIu8 "\n",
                     i);
+
+        for (unsigned int q = 0; q < port->num_queues; q++) {
+            struct uhd_dpdk_port *queue = port->queues[q];
+            if (q > 0)
+                memcpy(queue->queues, port->queues, sizeof(port->queues));
+            queue->parent->num_ports++;
+            LIST_INSERT_HEAD(&queue->parent->port_list, queue, port_entry);
+        }
     }
 
     RTE_LOG(INFO, EAL, "Init DONE!\n");
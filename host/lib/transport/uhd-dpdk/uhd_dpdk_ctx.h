@@ -14,6 +14,7 @@
 #include <rte_hash.h>
 #include <rte_eal.h>
 #include <rte_atomic.h>
+#include <rte_spinlock.h>
 #include <uhdlib/transport/uhd-dpdk.h>
 //#include <pthread.h>
 
@@ -26,6 +27,7 @@
 #define UHD_DPDK_TX_BURST_SIZE (UHD_DPDK_TXQ_SIZE - 1)
 #define UHD_DPDK_RXQ_SIZE 128
 #define UHD_DPDK_RX_BURST_SIZE (UHD_DPDK_RXQ_SIZE - 1)
+#define UHD_DPDK_ARPQ_SIZE 64
 
 struct uhd_dpdk_port;
 struct uhd_dpdk_tx_queue;
@@ -160,7 +162,17 @@ LIST_HEAD(uhd_dpdk_txq_head, uhd_dpdk_tx_queue);
  *
  * All memory allocation owned by I/O thread
  *
+ * There is one of these per RX/TX queue pair of a port, each serviced by its
+ * own I/O thread, and each with its own tables. The one for queue 0 is the
+ * one in the global context, and it is the only one answering ARP requests.
+ *
  * id: hardware port id (for DPDK)
+ * queue_id: RX/TX queue serviced by this structure
+ * num_queues: Number of queues in use on this port
+ * queues: Structures for all queues of this port (queues[0] for queue 0)
+ * num_socks: Number of RX sockets on this queue (for balancing new sockets)
+ * num_active: Number of queues not yet shut down (in queue 0 only)
+ * arp_ring: ARP packets handed over from queue 0 (NULL for queue 0)
  * parent: I/O thread servicing this port
  * mac_addr: MAC address of this port
  * ipv4_addr: IPv4 address of this port
@@ -172,6 +184,12 @@ LIST_HEAD(uhd_dpdk_txq_head, uhd_dpdk_tx_queue);
  ************************************************/
 struct uhd_dpdk_port {
     unsigned int id;
+    unsigned int queue_id;
+    unsigned int num_queues;
+    struct uhd_dpdk_port *queues[UHD_DPDK_MAX_QUEUES_PER_PORT];
+    rte_atomic32_t num_socks;
+    rte_atomic32_t num_active;
+    struct rte_ring *arp_ring;
     struct uhd_dpdk_thread *parent;
     struct ether_addr mac_addr;
     uint32_t ipv4_addr; /* FIXME: Check this before allowing a socket!!! */
@@ -235,6 +253,7 @@ struct uhd_dpdk_thread {
  * ports: Array of all DPDK/NIC ports
  * rx_pktbuf_pools: Array of all packet buffer pools for RX
  * tx_pktbuf_pools: Array of all packet buffer pools for TX
+ * flow_lock: Serializes flow rule changes, which I/O threads make
  *
  * The packet buffer pools are memory pools that are associated with a CPU
  * socket. They will provide storage close to the socket to accommodate NUMA
@@ -247,6 +266,7 @@ struct uhd_dpdk_ctx {
     struct uhd_dpdk_port *ports;
     struct rte_mempool *rx_pktbuf_pools[RTE_MAX_NUMA_NODES];
     struct rte_mempool *tx_pktbuf_pools[RTE_MAX_NUMA_NODES];
+    rte_spinlock_t flow_lock;
 };
 
 extern struct uhd_dpdk_ctx *ctx;
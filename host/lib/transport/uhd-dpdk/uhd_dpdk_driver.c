@@ -7,8 +7,10 @@
 #include "uhd_dpdk_fops.h"
 #include "uhd_dpdk_udp.h"
 #include "uhd_dpdk_wait.h"
+#include <rte_errno.h>
 #include <rte_malloc.h>
 #include <rte_mempool.h>
+#include <rte_prefetch.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 
@@ -44,7 +46,7 @@ int _uhd_dpdk_arp_reply(struct uhd_dpdk_port *port, struct arp_hdr *arp_req)
     mbuf->pkt_len = 42;
     mbuf->data_len = 42;
 
-    if (rte_eth_tx_burst(port->id, 0, &mbuf, 1) != 1) {
+    if (rte_eth_tx_burst(port->id, port->queue_id, &mbuf, 1) != 1) {
         RTE_LOG(WARNING, RING, "%s: TX descriptor ring is full\n", __func__);
         rte_pktmbuf_free(mbuf);
         return -EAGAIN;
@@ -83,8 +85,9 @@ int _uhd_dpdk_process_arp(struct uhd_dpdk_port *port, struct arp_hdr *arp_frame)
         }
     }
 
-    /* Respond if this was an ARP request */
-    if (arp_frame->arp_op == rte_cpu_to_be_16(ARP_OP_REQUEST) &&
+    /* Respond if this was an ARP request (once per port, from queue 0) */
+    if (port->queue_id == 0 &&
+        arp_frame->arp_op == rte_cpu_to_be_16(ARP_OP_REQUEST) &&
         arp_frame->arp_data.arp_tip == port->ipv4_addr) {
         _uhd_dpdk_arp_reply(port, arp_frame);
     }
@@ -125,7 +128,7 @@ int _uhd_dpdk_arp_request(struct uhd_dpdk_port *port, uint32_t ip)
     mbuf->pkt_len = 42;
     mbuf->data_len = 42;
 
-    if (rte_eth_tx_burst(port->id, 0, &mbuf, 1) != 1) {
+    if (rte_eth_tx_burst(port->id, port->queue_id, &mbuf, 1) != 1) {
         RTE_LOG(WARNING, RING, "%s: TX descriptor ring is full\n", __func__);
         rte_pktmbuf_free(mbuf);
         return -EAGAIN;
@@ -133,10 +136,11 @@ int _uhd_dpdk_arp_request(struct uhd_dpdk_port *port, uint32_t ip)
     return 0;
 }
 
-int _uhd_dpdk_process_udp(struct uhd_dpdk_port *port, struct rte_mbuf *mbuf,
-                          struct udp_hdr *pkt, bool bcast)
+/* Find the socket for a UDP packet. If there is none, drop the packet. */
+struct uhd_dpdk_rx_entry *_uhd_dpdk_process_udp(struct uhd_dpdk_port *port,
+                                                struct rte_mbuf *mbuf,
+                                                struct udp_hdr *pkt, bool bcast)
 {
-    int status = 0;
     struct uhd_dpdk_ipv4_5tuple ht_key = {
         .sock_type = UHD_DPDK_SOCK_UDP,
         .src_ip = 0,
@@ -148,7 +152,6 @@ int _uhd_dpdk_process_udp(struct uhd_dpdk_port *port, struct rte_mbuf *mbuf,
     struct uhd_dpdk_rx_entry *entry = NULL;
     rte_hash_lookup_data(port->rx_table, &ht_key, (void **) &entry);
     if (!entry) {
-        status = -ENODEV;
         //RTE_LOG(WARNING, USER1, "%s: Dropping packet to UDP port %d\n", __func__, ntohs(pkt->dst_port));
         goto udp_rx_drop;
     }
@@ -158,36 +161,69 @@ int _uhd_dpdk_process_udp(struct uhd_dpdk_port *port, struct rte_mbuf *mbuf,
         // Filter broadcast packets if not listening
         goto udp_rx_drop;
     }
-    status = rte_ring_enqueue(entry->sock->rx_ring, mbuf);
-    if (entry->waiter) {
-        _uhd_dpdk_waiter_wake(entry->waiter, port->parent);
-        entry->waiter = NULL;
-    }
-    if (status) {
-        pdata->dropped_pkts++;
-        goto udp_rx_drop;
-    }
-    pdata->xferd_pkts++;
-    return 0;
+    return entry;
 
 udp_rx_drop:
     rte_pktmbuf_free(mbuf);
-    return status;
+    return NULL;
 }
 
-int _uhd_dpdk_process_ipv4(struct uhd_dpdk_port *port, struct rte_mbuf *mbuf,
-                           struct ipv4_hdr *pkt)
+struct uhd_dpdk_rx_entry *_uhd_dpdk_process_ipv4(struct uhd_dpdk_port *port,
+                                                 struct rte_mbuf *mbuf,
+                                                 struct ipv4_hdr *pkt)
 {
     bool bcast = is_broadcast(port, pkt->dst_addr);
     if (pkt->dst_addr != port->ipv4_addr && !bcast) {
         rte_pktmbuf_free(mbuf);
-        return -ENODEV;
+        return NULL;
     }
     if (pkt->next_proto_id == 0x11) {
         return _uhd_dpdk_process_udp(port, mbuf, (struct udp_hdr *) &pkt[1], bcast);
     }
     rte_pktmbuf_free(mbuf);
-    return -EINVAL;
+    return NULL;
+}
+
+/* Hand a run of received packets to the socket they are all for */
+static inline void _uhd_dpdk_rx_deliver(struct uhd_dpdk_port *port,
+                                        struct uhd_dpdk_rx_entry *entry,
+                                        struct rte_mbuf **bufs,
+                                        unsigned int num_bufs)
+{
+    if (num_bufs == 0)
+        return;
+
+    struct uhd_dpdk_udp_priv *pdata = (struct uhd_dpdk_udp_priv *) entry->sock->priv;
+    unsigned int enqd = rte_ring_enqueue_burst(entry->sock->rx_ring,
+                                               (void **) bufs, num_bufs, NULL);
+    if (entry->waiter) {
+        _uhd_dpdk_waiter_wake(entry->waiter, port->parent);
+        entry->waiter = NULL;
+    }
+    pdata->xferd_pkts += enqd;
+    if (enqd != num_bufs) {
+        pdata->dropped_pkts += num_bufs - enqd;
+        for (unsigned int i = enqd; i < num_bufs; i++) {
+            rte_pktmbuf_free(bufs[i]);
+        }
+    }
+}
+
+/* Pass an ARP packet from queue 0 on to the port's other queues */
+static inline void _uhd_dpdk_fwd_arp(struct uhd_dpdk_port *port,
+                                     struct rte_mbuf *mbuf)
+{
+    if (port->queue_id != 0)
+        return;
+
+    for (unsigned int q = 1; q < port->num_queues; q++) {
+        /* The queues only read it, and each drops its own reference */
+        rte_mbuf_refcnt_update(mbuf, 1);
+        if (rte_ring_enqueue(port->queues[q]->arp_ring, mbuf)) {
+            RTE_LOG(WARNING, RING, "%s: ARP ring of queue %u is full\n", __func__, q);
+            rte_pktmbuf_free(mbuf);
+        }
+    }
 }
 
 static int _uhd_dpdk_fill_ipv4_addr(struct uhd_dpdk_port *port,
@@ -211,52 +247,64 @@ static int _uhd_dpdk_fill_ipv4_addr(struct uhd_dpdk_port *port,
     return 0;
 }
 
+/* Send a burst of packets from q
+ *
+ * Returns the number of packets that are done, i.e. sent or dropped, which is
+ * the number of buffers to restore. Packets that couldn't be sent go on the
+ * retry queue.
+ */
 static int _uhd_dpdk_send(struct uhd_dpdk_port *port,
                           struct uhd_dpdk_tx_queue *txq,
                           struct rte_ring *q)
 {
-    struct rte_mbuf *buf;
-
-    unsigned int num_tx = rte_ring_count(q);
-    num_tx = (num_tx < UHD_DPDK_TX_BURST_SIZE) ? num_tx : UHD_DPDK_TX_BURST_SIZE;
-    for (unsigned int i = 0; i < num_tx; i++) {
-        int status = rte_ring_dequeue(q, (void **) &buf);
-        if (status) {
-            RTE_LOG(ERR, USER1, "%s: Q Count doesn't match actual\n", __func__);
-            break;
-        }
-        struct ether_hdr *eth_hdr = rte_pktmbuf_mtod(buf, struct ether_hdr *);
-        if (eth_hdr->ether_type == rte_cpu_to_be_16(ETHER_TYPE_IPv4)) {
-            status = _uhd_dpdk_fill_ipv4_addr(port, buf);
-            if (status) {
-                return status;
-            }
-        }
+    struct rte_mbuf *bufs[UHD_DPDK_TX_BURST_SIZE];
+    unsigned int num_deq = rte_ring_dequeue_burst(q, (void **) bufs,
+                                                  UHD_DPDK_TX_BURST_SIZE, NULL);
+    if (num_deq == 0)
+        return 0;
 
-        status = rte_eth_tx_prepare(port->id, 0, &buf, 1);
-        if (status != 1) {
-            status = rte_ring_enqueue(txq->retry_queue, buf);
-            if (status) {
-                RTE_LOG(WARNING, USER1, "%s: Could not re-enqueue pkt %d\n", __func__, i);
-                rte_pktmbuf_free(buf);
-            }
-            num_tx = i;
-            break;
+    /* Fill in destination addresses. Drop packets that have none. */
+    unsigned int num_ready = 0;
+    for (unsigned int i = 0; i < num_deq; i++) {
+        struct ether_hdr *eth_hdr = rte_pktmbuf_mtod(bufs[i], struct ether_hdr *);
+        if (eth_hdr->ether_type == rte_cpu_to_be_16(ETHER_TYPE_IPv4) &&
+            _uhd_dpdk_fill_ipv4_addr(port, bufs[i])) {
+            rte_pktmbuf_free(bufs[i]);
+            continue;
         }
-
-        status = rte_eth_tx_burst(port->id, 0, &buf, 1); /* Automatically frees mbuf */
-        if (status != 1) {
-            status = rte_ring_enqueue(txq->retry_queue, buf);
-            if (status) {
-                RTE_LOG(WARNING, USER1, "%s: Could not re-enqueue pkt %d\n", __func__, i);
-                rte_pktmbuf_free(buf);
+        bufs[num_ready++] = bufs[i];
+    }
+    unsigned int num_done = num_deq - num_ready;
+
+    uint16_t num_prep = rte_eth_tx_prepare(port->id, port->queue_id, bufs, num_ready);
+    /* Automatically frees sent mbufs */
+    uint16_t num_sent = rte_eth_tx_burst(port->id, port->queue_id, bufs, num_prep);
+    num_done += num_sent;
+
+    /* tx_prepare() stops at the first packet the NIC can't send, ever */
+    unsigned int first_unsent = num_sent;
+    if (unlikely(num_prep != num_ready) && num_sent == num_prep) {
+        RTE_LOG(WARNING, USER1, "%s: Dropping invalid pkt: %d\n", __func__, rte_errno);
+        rte_pktmbuf_free(bufs[num_prep]);
+        first_unsent++;
+        num_done++;
+    }
+
+    unsigned int num_unsent = num_ready - first_unsent;
+    if (num_unsent) {
+        unsigned int enqd = rte_ring_enqueue_burst(txq->retry_queue,
+                                (void **) &bufs[first_unsent], num_unsent, NULL);
+        if (enqd != num_unsent) {
+            RTE_LOG(WARNING, USER1, "%s: Could not re-enqueue %u pkts\n", __func__,
+                    num_unsent - enqd);
+            for (unsigned int i = first_unsent + enqd; i < num_ready; i++) {
+                rte_pktmbuf_free(bufs[i]);
             }
-            num_tx = i;
-            break;
+            num_done += num_unsent - enqd;
         }
     }
 
-    return num_tx;
+    return num_done;
 }
 
 static inline int _uhd_dpdk_restore_bufs(struct uhd_dpdk_port *port,
@@ -288,7 +336,9 @@ static inline void _uhd_dpdk_disable_ports(struct uhd_dpdk_thread *t)
 {
     struct uhd_dpdk_port *port = NULL;
     LIST_FOREACH(port, &t->port_list, port_entry) {
-        rte_eth_dev_stop(port->id);
+        /* The last of the port's queues to go takes the port down */
+        if (rte_atomic32_dec_and_test(&port->queues[0]->num_active))
+            rte_eth_dev_stop(port->id);
     }
 }
 
@@ -377,6 +427,14 @@ static inline int _uhd_dpdk_driver_cleanup(struct uhd_dpdk_thread *t)
             rte_free(arp_entry);
         }
         rte_hash_free(port->arp_table);
+
+        if (port->arp_ring) {
+            struct rte_mbuf *buf = NULL;
+            while (rte_ring_dequeue(port->arp_ring, (void **) &buf) == 0) {
+                rte_pktmbuf_free(buf);
+            }
+            rte_ring_free(port->arp_ring);
+        }
     }
 
     return 0;
@@ -412,34 +470,74 @@ static inline int _uhd_dpdk_service_config_req(struct rte_ring *sock_req_ring)
     return status;
 }
 
-/* Do a burst of RX on port */
+/* Process the ARP packets that queue 0 passed on */
+static inline void _uhd_dpdk_arp_burst(struct uhd_dpdk_port *port)
+{
+    struct rte_mbuf *bufs[UHD_DPDK_ARPQ_SIZE];
+    const unsigned int num_arp = rte_ring_dequeue_burst(port->arp_ring,
+                                     (void **) bufs, UHD_DPDK_ARPQ_SIZE, NULL);
+    for (unsigned int i = 0; i < num_arp; i++) {
+        struct ether_hdr *hdr = rte_pktmbuf_mtod(bufs[i], struct ether_hdr *);
+        _uhd_dpdk_process_arp(port, (struct arp_hdr *) &hdr[1]);
+        rte_pktmbuf_free(bufs[i]);
+    }
+}
+
+/* Do a burst of RX on port
+ *
+ * Consecutive packets for the same socket are handed over together
+ */
 static inline void _uhd_dpdk_rx_burst(struct uhd_dpdk_port *port)
 {
     struct ether_hdr *hdr;
     char *l2_data;
     struct rte_mbuf *bufs[UHD_DPDK_RX_BURST_SIZE];
-    const uint16_t num_rx = rte_eth_rx_burst(port->id, 0,
+    struct rte_mbuf *run[UHD_DPDK_RX_BURST_SIZE];
+    struct uhd_dpdk_rx_entry *run_entry = NULL;
+    unsigned int run_len = 0;
+
+    if (port->arp_ring && !rte_ring_empty(port->arp_ring)) {
+        _uhd_dpdk_arp_burst(port);
+    }
+
+    const uint16_t num_rx = rte_eth_rx_burst(port->id, port->queue_id,
                                bufs, UHD_DPDK_RX_BURST_SIZE);
     if (unlikely(num_rx == 0)) {
          return;
     }
- 
+
     for (int buf = 0; buf < num_rx; buf++) {
+        if (buf + 1 < num_rx) {
+            rte_prefetch0(rte_pktmbuf_mtod(bufs[buf + 1], void *));
+        }
         uint64_t ol_flags = bufs[buf]->ol_flags;
         hdr = rte_pktmbuf_mtod(bufs[buf], struct ether_hdr *);
         l2_data = (char *) &hdr[1];
         switch (rte_be_to_cpu_16(hdr->ether_type)) {
         case ETHER_TYPE_ARP:
+            _uhd_dpdk_fwd_arp(port, bufs[buf]);
             _uhd_dpdk_process_arp(port, (struct arp_hdr *) l2_data);
             rte_pktmbuf_free(bufs[buf]);
             break;
         case ETHER_TYPE_IPv4:
             if ((ol_flags & PKT_RX_IP_CKSUM_MASK) == PKT_RX_IP_CKSUM_BAD) {
                 RTE_LOG(WARNING, RING, "Buf %d: Bad IP cksum\n", buf);
+                rte_pktmbuf_free(bufs[buf]);
             } else if ((ol_flags & PKT_RX_IP_CKSUM_MASK) == PKT_RX_IP_CKSUM_NONE) {
                 RTE_LOG(WARNING, RING, "Buf %d: Missing IP cksum\n", buf);
+                rte_pktmbuf_free(bufs[buf]);
             } else {
-                _uhd_dpdk_process_ipv4(port, bufs[buf], (struct ipv4_hdr *) l2_data);
+                struct uhd_dpdk_rx_entry *entry = _uhd_dpdk_process_ipv4(
+                    port, bufs[buf], (struct ipv4_hdr *) l2_data);
+                if (!entry)
+                    break;
+                if (entry != run_entry) {
+                    if (run_entry)
+                        _uhd_dpdk_rx_deliver(port, run_entry, run, run_len);
+                    run_entry = entry;
+                    run_len = 0;
+                }
+                run[run_len++] = bufs[buf];
             }
             break;
         default:
@@ -447,6 +545,8 @@ static inline void _uhd_dpdk_rx_burst(struct uhd_dpdk_port *port)
             break;
         }
     }
+    if (run_entry)
+        _uhd_dpdk_rx_deliver(port, run_entry, run, run_len);
 }
 
 /* Do a burst of TX on port's tx q */
@@ -455,7 +555,8 @@ static inline int _uhd_dpdk_tx_burst(struct uhd_dpdk_port *port,
 {
     if (!rte_ring_empty(q->retry_queue)) {
         int num_retry = _uhd_dpdk_send(port, q, q->retry_queue);
-        _uhd_dpdk_restore_bufs(port, q, num_retry);
+        if (num_retry > 0)
+            _uhd_dpdk_restore_bufs(port, q, num_retry);
         if (!rte_ring_empty(q->retry_queue)) {
             return -EAGAIN;
         }
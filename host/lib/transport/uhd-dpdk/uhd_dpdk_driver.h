@@ -20,9 +20,12 @@ static inline bool is_broadcast(struct uhd_dpdk_port *port, uint32_t dst_ipv4_ad
 
 
 int _uhd_dpdk_process_arp(struct uhd_dpdk_port *port, struct arp_hdr *arp_frame);
-int _uhd_dpdk_process_udp(struct uhd_dpdk_port *port, struct rte_mbuf *mbuf,
-                          struct udp_hdr *pkt, bool bcast);
-int _uhd_dpdk_process_ipv4(struct uhd_dpdk_port *port, struct rte_mbuf *mbuf, struct ipv4_hdr *pkt);
+struct uhd_dpdk_rx_entry *_uhd_dpdk_process_udp(struct uhd_dpdk_port *port,
+                                                struct rte_mbuf *mbuf,
+                                                struct udp_hdr *pkt, bool bcast);
+struct uhd_dpdk_rx_entry *_uhd_dpdk_process_ipv4(struct uhd_dpdk_port *port,
+                                                 struct rte_mbuf *mbuf,
+                                                 struct ipv4_hdr *pkt);
 int _uhd_dpdk_send_udp(struct uhd_dpdk_port *port,
                        struct uhd_dpdk_socket *sock,
                        struct rte_mbuf *mbuf);
@@ -7,6 +7,7 @@
 #include "uhd_dpdk_udp.h"
 #include "uhd_dpdk_driver.h"
 #include "uhd_dpdk_wait.h"
+#include <rte_errno.h>
 #include <rte_ring.h>
 #include <rte_malloc.h>
 #include <unistd.h>
@@ -101,6 +102,66 @@ unwind_txq:
     return -ENOENT;
 }
 
+int _uhd_dpdk_udp_flow_create(struct uhd_dpdk_port *port, uint16_t dst_port,
+                              struct rte_flow **flow)
+{
+    struct rte_flow_attr attr = {
+        .ingress = 1
+    };
+    struct rte_flow_item_udp udp_spec = {
+        .hdr = { .dst_port = dst_port }
+    };
+    struct rte_flow_item_udp udp_mask = {
+        .hdr = { .dst_port = 0xffff }
+    };
+    struct rte_flow_item pattern[] = {
+        { .type = RTE_FLOW_ITEM_TYPE_ETH },
+        { .type = RTE_FLOW_ITEM_TYPE_IPV4 },
+        { .type = RTE_FLOW_ITEM_TYPE_UDP, .spec = &udp_spec, .mask = &udp_mask },
+        { .type = RTE_FLOW_ITEM_TYPE_END }
+    };
+    struct rte_flow_action_queue queue = {
+        .index = port->queue_id
+    };
+    struct rte_flow_action actions[] = {
+        { .type = RTE_FLOW_ACTION_TYPE_QUEUE, .conf = &queue },
+        { .type = RTE_FLOW_ACTION_TYPE_END }
+    };
+    struct rte_flow_error error;
+    memset(&error, 0, sizeof(error));
+
+    /* Every queue's I/O thread makes flow rules for its own sockets */
+    int retval = 0;
+    rte_spinlock_lock(&ctx->flow_lock);
+    if (flow) {
+        *flow = rte_flow_create(port->id, &attr, pattern, actions, &error);
+        if (!*flow)
+            retval = -rte_errno;
+    } else {
+        retval = rte_flow_validate(port->id, &attr, pattern, actions, &error);
+    }
+    rte_spinlock_unlock(&ctx->flow_lock);
+
+    if (retval) {
+        RTE_LOG(WARNING, USER1, "%s: Cannot steer UDP port %u to queue %u of port %u: %s\n",
+                __func__, ntohs(dst_port), port->queue_id, port->id,
+                error.message ? error.message : "(no reason given)");
+    }
+    return retval;
+}
+
+static void _uhd_dpdk_udp_flow_destroy(struct uhd_dpdk_port *port,
+                                       struct rte_flow *flow)
+{
+    struct rte_flow_error error;
+    rte_spinlock_lock(&ctx->flow_lock);
+    if (rte_flow_destroy(port->id, flow, &error)) {
+        RTE_LOG(WARNING, USER1, "%s: Cannot destroy flow rule on port %u\n",
+                __func__, port->id);
+    }
+    rte_spinlock_unlock(&ctx->flow_lock);
+}
+
 /* Finish setting up UDP socket (unless ARP needs to be done)
  * Not multi-thread safe!
  * This call should only be used by the thread servicing the port
@@ -126,8 +187,13 @@ int _uhd_dpdk_udp_setup(struct uhd_dpdk_config_req *req)
     if (sock->rx_ring) {
         /* Add to rx table */
         if (pdata->dst_port == 0) {
-            /* Assign unused one in a very slow fashion */
+            /* Assign unused one in a very slow fashion
+             * It has to be one that maps to this queue, so it stays unique
+             * across the port's queues
+             */
             for (uint16_t i = MAX_UDP_PORT; i > 0; i--) {
+                if (i % port->num_queues != port->queue_id)
+                    continue;
                 ht_key.dst_port = htons(i);
                 if (rte_hash_lookup(port->rx_table, &ht_key) == -ENOENT) {
                     pdata->dst_port = htons(i);
@@ -186,6 +252,18 @@ int _uhd_dpdk_udp_setup(struct uhd_dpdk_config_req *req)
             _uhd_dpdk_config_req_compl(req, retval);
             return retval;
         }
+
+        /* Packets only go to queues other than 0 when told to */
+        if (port->queue_id > 0) {
+            retval = _uhd_dpdk_udp_flow_create(port, pdata->dst_port, &pdata->flow);
+            if (retval) {
+                rte_hash_del_key(port->rx_table, &ht_key);
+                rte_free(entry);
+                rte_ring_free(sock->rx_ring);
+                _uhd_dpdk_config_req_compl(req, retval);
+                return retval;
+            }
+        }
         _uhd_dpdk_config_req_compl(req, 0);
     }
 
@@ -353,6 +431,10 @@ int _uhd_dpdk_udp_release(struct uhd_dpdk_config_req *req)
             rte_free(entry);
         }
         rte_hash_del_key(port->rx_table, &ht_key);
+        if (pdata->flow) {
+            _uhd_dpdk_udp_flow_destroy(port, pdata->flow);
+            pdata->flow = NULL;
+        }
         struct rte_mbuf *mbuf = NULL;
         while (rte_ring_dequeue(sock->rx_ring, (void **) &mbuf) == 0) {
             rte_pktmbuf_free(mbuf);
@@ -378,6 +460,28 @@ int _uhd_dpdk_udp_rx_key(struct uhd_dpdk_socket *sock,
     return 0;
 }
 
+/* Pick the queue (and so, the I/O thread) of port that serves a socket
+ */
+static struct uhd_dpdk_port *_uhd_dpdk_udp_select_queue(
+    struct uhd_dpdk_port *port, struct uhd_dpdk_sockarg_udp *arg)
+{
+    if (port->num_queues <= 1)
+        return port;
+
+    if (arg->local_port)
+        return port->queues[ntohs(arg->local_port) % port->num_queues];
+
+    /* Port will be auto-assigned, so go with the least busy queue */
+    struct uhd_dpdk_port *queue = port;
+    for (unsigned int q = 1; q < port->num_queues; q++) {
+        if (rte_atomic32_read(&port->queues[q]->num_socks) <
+            rte_atomic32_read(&queue->num_socks)) {
+            queue = port->queues[q];
+        }
+    }
+    return queue;
+}
+
 /* Configure a socket for UDP
  */
 void uhd_dpdk_udp_open(struct uhd_dpdk_config_req *req,
@@ -393,6 +497,7 @@ void uhd_dpdk_udp_open(struct uhd_dpdk_config_req *req,
 
     struct uhd_dpdk_socket *sock = req->sock;
     sock->tid = pthread_self();
+    sock->port = _uhd_dpdk_udp_select_queue(sock->port, arg);
 
     /* Create private data */
     struct uhd_dpdk_udp_priv *data = (struct uhd_dpdk_udp_priv *) rte_zmalloc(NULL, sizeof(*data), 0);
@@ -424,6 +529,8 @@ void uhd_dpdk_udp_open(struct uhd_dpdk_config_req *req,
     
     if (req->retval)
         rte_free(data);
+    else if (!arg->is_tx)
+        rte_atomic32_inc(&sock->port->num_socks);
 }
 
 void uhd_dpdk_udp_close(struct uhd_dpdk_config_req *req)
@@ -432,6 +539,8 @@ void uhd_dpdk_udp_close(struct uhd_dpdk_config_req *req)
         return;
 
     uhd_dpdk_config_req_submit(req, -1, req->sock->port->parent);
+    if (!req->sock->tx_queue)
+        rte_atomic32_dec(&req->sock->port->num_socks);
     rte_free(req->sock->priv);
 }
 
@@ -7,6 +7,7 @@
 #define _UHD_DPDK_UDP_H_
 
 #include "uhd_dpdk_ctx.h"
+#include <rte_flow.h>
 #include <rte_udp.h>
 
 struct uhd_dpdk_udp_priv {
@@ -16,6 +17,8 @@ struct uhd_dpdk_udp_priv {
     size_t dropped_pkts;
     size_t xferd_pkts;
     bool filter_bcast;
+    /* Steers this RX socket's packets to its queue (NULL on queue 0) */
+    struct rte_flow *flow;
     /* TODO: Cache destination address ptr to avoid ARP table lookup cost? */
     //struct uhd_dpdk_arp_entry *arp_entry;
 };
@@ -30,6 +33,14 @@ void uhd_dpdk_udp_close(struct uhd_dpdk_config_req *req);
 int uhd_dpdk_udp_prep(struct uhd_dpdk_socket *sock,
                       struct rte_mbuf *mbuf);
 
+/*
+ * Steer packets for UDP port dst_port (in network format) to port's queue
+ *
+ * If flow is NULL, this only checks that the NIC can do it.
+ */
+int _uhd_dpdk_udp_flow_create(struct uhd_dpdk_port *port, uint16_t dst_port,
+                              struct rte_flow **flow);
+
 /*
  * Get key for RX table corresponding to this socket
  *
@@ -0,0 +1,1271 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhdlib/transport/xdp_zero_copy.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/format.hpp>
+#include <boost/make_shared.hpp>
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <linux/bpf.h>
+#include <linux/if_ether.h>
+#include <linux/if_link.h>
+#include <linux/if_xdp.h>
+#include <net/if.h>
+#include <net/if_arp.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace uhd;
+using namespace uhd::transport;
+
+#ifndef AF_XDP
+#    define AF_XDP 44
+#endif
+#ifndef SOL_XDP
+#    define SOL_XDP 283
+#endif
+#ifndef SO_PREFER_BUSY_POLL
+#    define SO_PREFER_BUSY_POLL 69
+#endif
+#ifndef XDP_PACKET_HEADROOM
+#    define XDP_PACKET_HEADROOM 256 // reserved by the kernel in every frame
+#endif
+#ifndef SO_BUSY_POLL_BUDGET
+#    define SO_BUSY_POLL_BUDGET 70
+#endif
+
+namespace {
+
+constexpr size_t XDP_MIN_FRAME_SIZE     = 2048;
+constexpr size_t XDP_DEFAULT_NUM_FRAMES = 1024;
+constexpr size_t XDP_MAX_QUEUES         = 256;
+constexpr size_t ETH_HDR_SIZE           = 14;
+constexpr size_t IPV4_HDR_SIZE          = 20;
+constexpr size_t UDP_HDR_SIZE           = 8;
+constexpr size_t HDR_SIZE = ETH_HDR_SIZE + IPV4_HDR_SIZE + UDP_HDR_SIZE;
+constexpr int XDP_BUSY_POLL_USECS       = 20;
+constexpr int XDP_BUSY_POLL_BUDGET      = 64;
+constexpr double XDP_ARP_TIMEOUT        = 1.0; // seconds
+constexpr double XDP_BIND_TIMEOUT       = 1.0; // seconds
+constexpr int DISCARD_PORT              = 9;
+
+/***********************************************************************
+ * Interface helpers
+ **********************************************************************/
+struct iface_info_t
+{
+    std::string name;
+    unsigned int index;
+    size_t mtu;
+    in_addr_t ipv4; // network byte order
+    uint8_t mac[ETH_ALEN];
+};
+
+//! Find the interface on the subnet of the destination (or the named one)
+iface_info_t find_iface(const in_addr_t dst_addr, const std::string& name)
+{
+    ifaddrs* ifas = nullptr;
+    if (::getifaddrs(&ifas) != 0) {
+        throw uhd::os_error(
+            str(boost::format("getifaddrs failed: %s") % strerror(errno)));
+    }
+    iface_info_t info;
+    for (ifaddrs* ifa = ifas; ifa; ifa = ifa->ifa_next) {
+        if (not ifa->ifa_addr or ifa->ifa_addr->sa_family != AF_INET
+            or not ifa->ifa_netmask) {
+            continue;
+        }
+        const in_addr_t ifa_addr =
+            reinterpret_cast<sockaddr_in*>(ifa->ifa_addr)->sin_addr.s_addr;
+        const in_addr_t ifa_mask =
+            reinterpret_cast<sockaddr_in*>(ifa->ifa_netmask)->sin_addr.s_addr;
+        const bool match = name.empty() ? ((ifa_addr ^ dst_addr) & ifa_mask) == 0
+                                        : name == ifa->ifa_name;
+        if (match) {
+            info.name = ifa->ifa_name;
+            info.ipv4 = ifa_addr;
+            break;
+        }
+    }
+    ::freeifaddrs(ifas);
+    if (info.name.empty()) {
+        throw uhd::runtime_error(name.empty()
+                                     ? "AF_XDP: No interface on the subnet of the device"
+                                     : "AF_XDP: No IPv4 address on interface " + name);
+    }
+    info.index = ::if_nametoindex(info.name.c_str());
+
+    const int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    ifreq ifr;
+    std::memset(&ifr, 0, sizeof(ifr));
+    std::strncpy(ifr.ifr_name, info.name.c_str(), IFNAMSIZ - 1);
+    if (::ioctl(fd, SIOCGIFHWADDR, &ifr) != 0) {
+        ::close(fd);
+        throw uhd::os_error("AF_XDP: Cannot get the MAC address of " + info.name);
+    }
+    std::memcpy(info.mac, ifr.ifr_hwaddr.sa_data, ETH_ALEN);
+    const int ret = ::ioctl(fd, SIOCGIFMTU, &ifr);
+    ::close(fd);
+    if (ret != 0) {
+        throw uhd::os_error("AF_XDP: Cannot get the MTU of " + info.name);
+    }
+    info.mtu = size_t(ifr.ifr_mtu);
+    return info;
+}
+
+//! Look up the MAC address of the destination in the kernel's ARP table
+bool lookup_arp(const iface_info_t& iface, const in_addr_t dst_addr, uint8_t* mac)
+{
+    arpreq req;
+    std::memset(&req, 0, sizeof(req));
+    sockaddr_in* pa     = reinterpret_cast<sockaddr_in*>(&req.arp_pa);
+    pa->sin_family      = AF_INET;
+    pa->sin_addr.s_addr = dst_addr;
+    std::strncpy(req.arp_dev, iface.name.c_str(), sizeof(req.arp_dev) - 1);
+
+    const int fd  = ::socket(AF_INET, SOCK_DGRAM, 0);
+    const int ret = ::ioctl(fd, SIOCGARP, &req);
+    ::close(fd);
+    if (ret != 0 or not(req.arp_flags & ATF_COM)) {
+        return false;
+    }
+    std::memcpy(mac, req.arp_ha.sa_data, ETH_ALEN);
+    return true;
+}
+
+uint16_t ipv4_checksum(const uint8_t* hdr)
+{
+    uint32_t sum = 0;
+    for (size_t i = 0; i < IPV4_HDR_SIZE; i += 2) {
+        sum += (uint32_t(hdr[i]) << 8) | hdr[i + 1];
+    }
+    while (sum >> 16) {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    return htons(uint16_t(~sum));
+}
+
+//! A frame holds the kernel's headroom and a full Ethernet frame
+size_t frame_size_for_mtu(const size_t mtu)
+{
+    size_t frame_size = XDP_MIN_FRAME_SIZE;
+    while (frame_size < XDP_PACKET_HEADROOM + ETH_HDR_SIZE + mtu) {
+        frame_size <<= 1;
+    }
+    return frame_size;
+}
+
+//! The default huge page size, frames larger than a page need huge pages
+size_t get_huge_page_size(void)
+{
+    std::ifstream meminfo("/proc/meminfo");
+    std::string key;
+    size_t value_kb = 0;
+    while (meminfo >> key) {
+        if (key == "Hugepagesize:" and meminfo >> value_kb) {
+            return value_kb * 1024;
+        }
+        meminfo.ignore(256, '\n');
+    }
+    return 2 * 1024 * 1024;
+}
+
+/***********************************************************************
+ * BPF helpers:
+ * The XDP program and its maps are set up with the bpf() system call, so
+ * no BPF library is needed.
+ **********************************************************************/
+int sys_bpf(const int cmd, bpf_attr& attr)
+{
+    return int(::syscall(__NR_bpf, cmd, &attr, sizeof(attr)));
+}
+
+int create_map(const uint32_t type,
+    const uint32_t value_size,
+    const uint32_t max_entries,
+    const char* name)
+{
+    bpf_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.map_type    = type;
+    attr.key_size    = sizeof(uint32_t);
+    attr.value_size  = value_size;
+    attr.max_entries = max_entries;
+    std::strncpy(attr.map_name, name, BPF_OBJ_NAME_LEN - 1);
+    const int fd = sys_bpf(BPF_MAP_CREATE, attr);
+    if (fd < 0) {
+        throw uhd::os_error(str(
+            boost::format("AF_XDP: Cannot create the BPF map %s: %s (CAP_BPF and "
+                          "CAP_NET_ADMIN are required)")
+            % name % strerror(errno)));
+    }
+    return fd;
+}
+
+int update_map(const int map_fd, const uint32_t key, const uint32_t value)
+{
+    bpf_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.map_fd = uint32_t(map_fd);
+    attr.key    = reinterpret_cast<uint64_t>(&key);
+    attr.value  = reinterpret_cast<uint64_t>(&value);
+    attr.flags  = BPF_ANY;
+    return sys_bpf(BPF_MAP_UPDATE_ELEM, attr);
+}
+
+int delete_from_map(const int map_fd, const uint32_t key)
+{
+    bpf_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.map_fd = uint32_t(map_fd);
+    attr.key    = reinterpret_cast<uint64_t>(&key);
+    return sys_bpf(BPF_MAP_DELETE_ELEM, attr);
+}
+
+bpf_insn make_insn(const uint8_t code,
+    const uint8_t dst_reg,
+    const uint8_t src_reg,
+    const int16_t off,
+    const int32_t imm)
+{
+    bpf_insn insn;
+    insn.code    = code;
+    insn.dst_reg = dst_reg & 0xf;
+    insn.src_reg = src_reg & 0xf;
+    insn.off     = off;
+    insn.imm     = imm;
+    return insn;
+}
+
+/*!
+ * The XDP program redirects a packet to the AF_XDP socket of its queue if
+ * it is IPv4/UDP to the port in ports[queue]. Everything else, including
+ * ARP and the host's other traffic on the queue, goes to the kernel.
+ *
+ *     if (data + HDR_SIZE > data_end) return XDP_PASS;
+ *     if (ethertype != IPv4 or ip[0] != 0x45 or ip.proto != UDP)
+ *         return XDP_PASS;
+ *     port = ports[ctx->rx_queue_index];
+ *     if (not port or udp.dst_port != *port) return XDP_PASS;
+ *     return bpf_redirect_map(xsks, ctx->rx_queue_index, XDP_PASS);
+ */
+std::vector<bpf_insn> make_redirect_program(const int ports_fd, const int xsks_fd)
+{
+    std::vector<bpf_insn> prog;
+    std::vector<size_t> pass_jumps;
+    auto jump_to_pass = [&](const uint8_t op, const uint8_t dst, const uint8_t src, const int32_t imm) {
+        pass_jumps.push_back(prog.size());
+        prog.push_back(make_insn(BPF_JMP | op, dst, src, 0, imm));
+    };
+    auto load_map_fd = [&](const uint8_t dst, const int fd) {
+        prog.push_back(make_insn(BPF_LD | BPF_DW | BPF_IMM, dst, BPF_PSEUDO_MAP_FD, 0, fd));
+        prog.push_back(make_insn(0, 0, 0, 0, 0));
+    };
+    // Packet loads see the raw bytes in host order, compare them likewise
+    const int32_t eth_p_ip = htons(ETH_P_IP);
+    const int16_t queue_off = offsetof(xdp_md, rx_queue_index);
+
+    prog.push_back(make_insn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_6, BPF_REG_1, 0, 0));
+    prog.push_back(make_insn(BPF_LDX | BPF_W | BPF_MEM, BPF_REG_2, BPF_REG_6, offsetof(xdp_md, data), 0));
+    prog.push_back(make_insn(BPF_LDX | BPF_W | BPF_MEM, BPF_REG_3, BPF_REG_6, offsetof(xdp_md, data_end), 0));
+    prog.push_back(make_insn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_4, BPF_REG_2, 0, 0));
+    prog.push_back(make_insn(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_4, 0, 0, HDR_SIZE));
+    jump_to_pass(BPF_JGT | BPF_X, BPF_REG_4, BPF_REG_3, 0);
+    prog.push_back(make_insn(BPF_LDX | BPF_H | BPF_MEM, BPF_REG_4, BPF_REG_2, 12, 0));
+    jump_to_pass(BPF_JNE | BPF_K, BPF_REG_4, 0, eth_p_ip);
+    prog.push_back(make_insn(BPF_LDX | BPF_B | BPF_MEM, BPF_REG_4, BPF_REG_2, ETH_HDR_SIZE, 0));
+    jump_to_pass(BPF_JNE | BPF_K, BPF_REG_4, 0, 0x45);
+    prog.push_back(make_insn(BPF_LDX | BPF_B | BPF_MEM, BPF_REG_4, BPF_REG_2, ETH_HDR_SIZE + 9, 0));
+    jump_to_pass(BPF_JNE | BPF_K, BPF_REG_4, 0, IPPROTO_UDP);
+    // r7 survives the helper calls
+    prog.push_back(make_insn(BPF_LDX | BPF_H | BPF_MEM, BPF_REG_7, BPF_REG_2, ETH_HDR_SIZE + IPV4_HDR_SIZE + 2, 0));
+
+    prog.push_back(make_insn(BPF_LDX | BPF_W | BPF_MEM, BPF_REG_4, BPF_REG_6, queue_off, 0));
+    prog.push_back(make_insn(BPF_STX | BPF_W | BPF_MEM, BPF_REG_10, BPF_REG_4, -4, 0));
+    prog.push_back(make_insn(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_2, BPF_REG_10, 0, 0));
+    prog.push_back(make_insn(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_2, 0, 0, -4));
+    load_map_fd(BPF_REG_1, ports_fd);
+    prog.push_back(make_insn(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_map_lookup_elem));
+    jump_to_pass(BPF_JEQ | BPF_K, BPF_REG_0, 0, 0);
+    prog.push_back(make_insn(BPF_LDX | BPF_W | BPF_MEM, BPF_REG_4, BPF_REG_0, 0, 0));
+    jump_to_pass(BPF_JNE | BPF_X, BPF_REG_4, BPF_REG_7, 0);
+
+    prog.push_back(make_insn(BPF_LDX | BPF_W | BPF_MEM, BPF_REG_2, BPF_REG_6, queue_off, 0));
+    load_map_fd(BPF_REG_1, xsks_fd);
+    // The lower bits of the flags are the action when the queue has no socket
+    prog.push_back(make_insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_3, 0, 0, XDP_PASS));
+    prog.push_back(make_insn(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_redirect_map));
+    prog.push_back(make_insn(BPF_JMP | BPF_EXIT, 0, 0, 0, 0));
+
+    const size_t pass = prog.size();
+    prog.push_back(make_insn(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, XDP_PASS));
+    prog.push_back(make_insn(BPF_JMP | BPF_EXIT, 0, 0, 0, 0));
+    for (const size_t jump : pass_jumps) {
+        prog[jump].off = int16_t(pass - jump - 1);
+    }
+    return prog;
+}
+
+/***********************************************************************
+ * XDP program of an interface:
+ * Only one XDP program can be attached to an interface, so all transports
+ * on an interface share it. A transport registers its socket and local
+ * port for its queue. Only one AF_XDP socket can own an interface queue.
+ **********************************************************************/
+class xdp_iface_program
+{
+public:
+    typedef std::shared_ptr<xdp_iface_program> sptr;
+
+    //! Get the program of the interface, attach it if this is the first user
+    static sptr get(const iface_info_t& iface, const uint32_t attach_flags)
+    {
+        std::lock_guard<std::mutex> lock(_registry_mutex);
+        sptr program = _registry[iface.name].lock();
+        if (not program) {
+            program                = sptr(new xdp_iface_program(iface, attach_flags));
+            _registry[iface.name] = program;
+        } else if (program->_attach_flags != attach_flags) {
+            throw uhd::value_error("AF_XDP: All transports on " + iface.name
+                                   + " need the same xdp_mode");
+        }
+        return program;
+    }
+
+    ~xdp_iface_program(void)
+    {
+        // Closing the link detaches the program from the interface
+        for (const int fd : {_link_fd, _prog_fd, _xsks_fd, _ports_fd}) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+    }
+
+    //! Take the first free queue of the list
+    size_t claim_queue(const std::vector<size_t>& queues)
+    {
+        std::lock_guard<std::mutex> lock(_registry_mutex);
+        for (const size_t queue : queues) {
+            if (queue >= XDP_MAX_QUEUES) {
+                throw uhd::value_error(
+                    str(boost::format("AF_XDP: Queue %d is out of range") % queue));
+            }
+            if (_queues.count(queue) == 0) {
+                _queues.insert(queue);
+                return queue;
+            }
+        }
+        throw uhd::runtime_error(
+            str(boost::format("AF_XDP: All queues of %s in xdp_queues are in use. "
+                              "Every AF_XDP transport needs a queue of its own.")
+                % _iface_name));
+    }
+
+    //! Redirect the packets to the local port to the socket
+    void add_socket(const size_t queue, const int xsk_fd, const uint16_t port)
+    {
+        if (update_map(_xsks_fd, uint32_t(queue), uint32_t(xsk_fd)) != 0
+            or update_map(_ports_fd, uint32_t(queue), port) != 0) {
+            throw uhd::os_error(
+                str(boost::format("AF_XDP: Cannot register the socket for queue %d: %s")
+                    % queue % strerror(errno)));
+        }
+    }
+
+    void release_queue(const size_t queue)
+    {
+        update_map(_ports_fd, uint32_t(queue), 0);
+        delete_from_map(_xsks_fd, uint32_t(queue));
+        std::lock_guard<std::mutex> lock(_registry_mutex);
+        _queues.erase(queue);
+    }
+
+private:
+    xdp_iface_program(const iface_info_t& iface, const uint32_t attach_flags)
+        : _iface_name(iface.name), _attach_flags(attach_flags)
+    {
+        try {
+            _xsks_fd  = create_map(BPF_MAP_TYPE_XSKMAP, sizeof(uint32_t), XDP_MAX_QUEUES, "uhd_xsks");
+            _ports_fd = create_map(BPF_MAP_TYPE_ARRAY, sizeof(uint32_t), XDP_MAX_QUEUES, "uhd_ports");
+            load_program();
+            attach(iface.index);
+        } catch (...) {
+            for (const int fd : {_prog_fd, _xsks_fd, _ports_fd}) {
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+            }
+            throw;
+        }
+    }
+
+    void load_program(void)
+    {
+        const std::vector<bpf_insn> prog = make_redirect_program(_ports_fd, _xsks_fd);
+        std::vector<char> log(4096);
+        bpf_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.prog_type = BPF_PROG_TYPE_XDP;
+        attr.insns     = reinterpret_cast<uint64_t>(prog.data());
+        attr.insn_cnt  = uint32_t(prog.size());
+        attr.license   = reinterpret_cast<uint64_t>("GPL");
+        attr.log_buf   = reinterpret_cast<uint64_t>(log.data());
+        attr.log_size  = uint32_t(log.size());
+        attr.log_level = 1;
+        std::strncpy(attr.prog_name, "uhd_xdp", BPF_OBJ_NAME_LEN - 1);
+        _prog_fd = sys_bpf(BPF_PROG_LOAD, attr);
+        if (_prog_fd < 0) {
+            throw uhd::os_error(
+                str(boost::format("AF_XDP: Cannot load the XDP program: %s\n%s")
+                    % strerror(errno) % log.data()));
+        }
+    }
+
+    void attach(const unsigned int ifindex)
+    {
+        bpf_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.link_create.prog_fd     = uint32_t(_prog_fd);
+        attr.link_create.target_fd   = ifindex;
+        attr.link_create.attach_type = BPF_XDP;
+        attr.link_create.flags       = _attach_flags;
+        _link_fd                     = sys_bpf(BPF_LINK_CREATE, attr);
+        if (_link_fd < 0) {
+            throw uhd::os_error(str(
+                boost::format("AF_XDP: Cannot attach the XDP program to %s: %s. "
+                              "Is another XDP program attached already?")
+                % _iface_name % strerror(errno)));
+        }
+    }
+
+    static std::mutex _registry_mutex;
+    static std::map<std::string, std::weak_ptr<xdp_iface_program>> _registry;
+
+    const std::string _iface_name;
+    const uint32_t _attach_flags;
+    std::set<size_t> _queues;
+    int _xsks_fd  = -1;
+    int _ports_fd = -1;
+    int _prog_fd  = -1;
+    int _link_fd  = -1;
+};
+
+std::mutex xdp_iface_program::_registry_mutex;
+std::map<std::string, std::weak_ptr<xdp_iface_program>> xdp_iface_program::_registry;
+
+/***********************************************************************
+ * Rings shared with the kernel:
+ * The producer and consumer indexes are free-running, the kernel reads
+ * what we produce and the other way around.
+ **********************************************************************/
+struct xdp_ring
+{
+    uint32_t* producer = nullptr;
+    uint32_t* consumer = nullptr;
+    uint32_t* flags    = nullptr;
+    void* descs        = nullptr;
+    uint32_t size = 0, mask = 0;
+    uint32_t cached_prod = 0, cached_cons = 0;
+    void* map     = nullptr;
+    size_t map_len = 0;
+
+    //! Producer side: reserve the next n entries, starting at idx
+    UHD_INLINE bool reserve(const uint32_t n, uint32_t& idx)
+    {
+        if (size - (cached_prod - cached_cons) < n) {
+            cached_cons = __atomic_load_n(consumer, __ATOMIC_ACQUIRE);
+            if (size - (cached_prod - cached_cons) < n) {
+                return false;
+            }
+        }
+        idx = cached_prod;
+        cached_prod += n;
+        return true;
+    }
+
+    //! Producer side: hand the reserved entries to the kernel
+    UHD_INLINE void submit(void)
+    {
+        __atomic_store_n(producer, cached_prod, __ATOMIC_RELEASE);
+    }
+
+    //! Consumer side: take up to n entries, starting at idx
+    UHD_INLINE uint32_t peek(const uint32_t n, uint32_t& idx)
+    {
+        uint32_t avail = cached_prod - cached_cons;
+        if (avail == 0) {
+            cached_prod = __atomic_load_n(producer, __ATOMIC_ACQUIRE);
+            avail       = cached_prod - cached_cons;
+        }
+        const uint32_t taken = std::min(n, avail);
+        idx                  = cached_cons;
+        cached_cons += taken;
+        return taken;
+    }
+
+    //! Consumer side: hand the taken entries back to the kernel
+    UHD_INLINE void release(void)
+    {
+        __atomic_store_n(consumer, cached_cons, __ATOMIC_RELEASE);
+    }
+
+    UHD_INLINE bool needs_wakeup(void) const
+    {
+        return __atomic_load_n(flags, __ATOMIC_RELAXED) & XDP_RING_NEED_WAKEUP;
+    }
+
+    UHD_INLINE uint64_t& addr(const uint32_t idx)
+    {
+        return static_cast<uint64_t*>(descs)[idx & mask];
+    }
+
+    UHD_INLINE xdp_desc& desc(const uint32_t idx)
+    {
+        return static_cast<xdp_desc*>(descs)[idx & mask];
+    }
+};
+
+} // namespace
+
+/***********************************************************************
+ * Managed buffers:
+ *  - recv buffers hand their UMEM frame back to the fill ring on release
+ *  - send buffers put their UMEM frame on the TX ring on release
+ **********************************************************************/
+class xdp_zero_copy_impl;
+
+class xdp_zero_copy_mrb : public managed_recv_buffer
+{
+public:
+    xdp_zero_copy_mrb(xdp_zero_copy_impl* xport) : _xport(xport), _addr(0) {}
+
+    void release(void);
+
+    UHD_INLINE sptr get_new(const uint64_t addr, void* mem, const size_t len)
+    {
+        _addr = addr;
+        return make(this, mem, len);
+    }
+
+private:
+    xdp_zero_copy_impl* _xport;
+    uint64_t _addr;
+};
+
+class xdp_zero_copy_msb : public managed_send_buffer
+{
+public:
+    xdp_zero_copy_msb(xdp_zero_copy_impl* xport) : _xport(xport), _addr(0) {}
+
+    void release(void);
+
+    UHD_INLINE sptr get_new(const uint64_t addr, void* mem, const size_t len)
+    {
+        _addr = addr;
+        return make(this, mem, len);
+    }
+
+private:
+    xdp_zero_copy_impl* _xport;
+    uint64_t _addr;
+};
+
+/***********************************************************************
+ * AF_XDP transport implementation
+ **********************************************************************/
+class xdp_zero_copy_impl : public xdp_zero_copy
+{
+public:
+    xdp_zero_copy_impl(const std::string& addr,
+        const std::string& port,
+        const zero_copy_xport_params& xport_params,
+        const device_addr_t& hints)
+        : _recv_frame_size(xport_params.recv_frame_size)
+        , _num_recv_frames(xport_params.num_recv_frames)
+        , _send_frame_size(xport_params.send_frame_size)
+        , _num_send_frames(xport_params.num_send_frames)
+        , _busy_poll(hints.has_key("xdp_busy_poll"))
+    {
+        // Taking a queue that carries other traffic by default would be a
+        // surprise, so the queues must be given
+        if (not hints.has_key("xdp_queues")) {
+            throw uhd::value_error(
+                "AF_XDP: xdp_queues must list the interface queues to use");
+        }
+        std::vector<size_t> queues;
+        std::vector<std::string> queue_strs;
+        boost::split(queue_strs, hints["xdp_queues"], boost::is_any_of(":"));
+        for (const std::string& queue_str : queue_strs) {
+            try {
+                queues.push_back(std::stoul(queue_str));
+            } catch (const std::exception&) {
+                throw uhd::value_error("AF_XDP: Invalid queue in xdp_queues: " + queue_str);
+            }
+        }
+
+        // Resolve the addresses
+        in_addr dst_addr;
+        if (::inet_pton(AF_INET, addr.c_str(), &dst_addr) != 1) {
+            throw uhd::value_error("AF_XDP: Not an IPv4 address: " + addr);
+        }
+        _dst_addr = dst_addr.s_addr;
+        _dst_port = htons(uint16_t(std::stoul(port)));
+        _iface    = find_iface(_dst_addr, hints.get("xdp_iface", ""));
+
+        // Frames are sized for the link, and payloads limited to what fits
+        _frame_size = frame_size_for_mtu(_iface.mtu);
+        _recv_frame_size = std::min(_recv_frame_size, get_max_payload_size(_iface.mtu));
+        _send_frame_size = std::min(_send_frame_size, get_max_payload_size(_iface.mtu));
+
+        const std::string mode = hints.get("xdp_mode", "auto");
+        uint32_t attach_flags  = 0;
+        if (mode == "copy") {
+            attach_flags = XDP_FLAGS_SKB_MODE;
+            _bind_flags  = XDP_COPY;
+        } else if (mode == "zero_copy") {
+            attach_flags = XDP_FLAGS_DRV_MODE;
+            _bind_flags  = XDP_ZEROCOPY;
+        } else if (mode != "auto") {
+            throw uhd::value_error("AF_XDP: Invalid xdp_mode: " + mode);
+        }
+        _program = xdp_iface_program::get(_iface, attach_flags);
+        _queue   = _program->claim_queue(queues);
+
+        try {
+            reserve_local_port(hints);
+            resolve_dst_mac();
+            create_socket();
+            _program->add_socket(_queue, _xsk_fd, _src_port);
+        } catch (...) {
+            cleanup();
+            throw;
+        }
+        init_header_template();
+
+        UHD_LOGGER_DEBUG("XDP") << boost::format(
+                                       "Created AF_XDP transport on %s queue %d "
+                                       "(%d byte frames): %s:%d -> %s:%s")
+                                       % _iface.name % _queue % _frame_size
+                                       % get_local_addr() % get_local_port() % addr
+                                       % port;
+    }
+
+    ~xdp_zero_copy_impl(void)
+    {
+        cleanup();
+    }
+
+    //! The largest UDP payload for the MTU, in multiples of 8 bytes
+    static size_t get_max_payload_size(const size_t mtu)
+    {
+        const size_t frame_payload =
+            frame_size_for_mtu(mtu) - XDP_PACKET_HEADROOM - HDR_SIZE;
+        return std::min(mtu - IPV4_HDR_SIZE - UDP_HDR_SIZE, frame_payload) & ~size_t(7);
+    }
+
+    /*******************************************************************
+     * Receive implementation:
+     * Take the next descriptor off the RX ring. Packets which are not
+     * from our peer go straight back to the fill ring.
+     ******************************************************************/
+    managed_recv_buffer::sptr get_recv_buff(double timeout)
+    {
+        const auto exit_time = std::chrono::steady_clock::now()
+                               + std::chrono::microseconds(int64_t(timeout * 1e6));
+        while (true) {
+            uint32_t idx = 0;
+            if (_rx_ring.peek(1, idx) == 1) {
+                const uint64_t addr = _rx_ring.desc(idx).addr;
+                const uint32_t len  = _rx_ring.desc(idx).len;
+                _rx_ring.release();
+
+                uint8_t* pkt       = umem_data(addr);
+                size_t payload_len = 0;
+                if (parse_headers(pkt, len, payload_len)) {
+                    xdp_zero_copy_mrb& mrb = *_mrb_pool[frame_index(addr)];
+                    return mrb.get_new(addr, pkt + HDR_SIZE, payload_len);
+                }
+                recycle_recv_frame(addr);
+                continue;
+            }
+            if (std::chrono::steady_clock::now() >= exit_time) {
+                return managed_recv_buffer::sptr();
+            }
+            wait_for_rx(exit_time);
+        }
+    }
+
+    size_t get_num_recv_frames(void) const
+    {
+        return _num_recv_frames;
+    }
+
+    size_t get_recv_frame_size(void) const
+    {
+        return _recv_frame_size;
+    }
+
+    //! Called by the managed receive buffers on release
+    void recycle_recv_frame(const uint64_t addr)
+    {
+        std::lock_guard<std::mutex> lock(_fill_mutex);
+        uint32_t idx = 0;
+        // The fill ring is as large as the number of receive frames
+        UHD_ASSERT_THROW(_fill_ring.reserve(1, idx));
+        _fill_ring.addr(idx) = frame_base(addr);
+        _fill_ring.submit();
+    }
+
+    /*******************************************************************
+     * Send implementation:
+     * Reclaim completed frames, then hand out a free one. The headers
+     * are filled in when the buffer is committed.
+     ******************************************************************/
+    managed_send_buffer::sptr get_send_buff(double timeout)
+    {
+        const auto exit_time = std::chrono::steady_clock::now()
+                               + std::chrono::microseconds(int64_t(timeout * 1e6));
+        while (true) {
+            reclaim_send_frames();
+            if (not _free_send_frames.empty()) {
+                const uint64_t addr = _free_send_frames.back();
+                _free_send_frames.pop_back();
+                xdp_zero_copy_msb& msb =
+                    *_msb_pool[frame_index(addr) - _num_recv_frames];
+                return msb.get_new(addr, umem_data(addr) + HDR_SIZE, _send_frame_size);
+            }
+            if (std::chrono::steady_clock::now() >= exit_time) {
+                return managed_send_buffer::sptr();
+            }
+            // Frames are only completed after the kernel processed them
+            kick_tx();
+            if (not _busy_poll) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    size_t get_num_send_frames(void) const
+    {
+        return _num_send_frames;
+    }
+
+    size_t get_send_frame_size(void) const
+    {
+        return _send_frame_size;
+    }
+
+    //! Called by the managed send buffers on release
+    void send_frame(const uint64_t addr, const size_t payload_len)
+    {
+        write_headers(umem_data(addr), payload_len);
+
+        uint32_t idx = 0;
+        // The TX ring is as large as the number of send frames
+        UHD_ASSERT_THROW(_tx_ring.reserve(1, idx));
+        _tx_ring.desc(idx).addr    = addr;
+        _tx_ring.desc(idx).len     = uint32_t(HDR_SIZE + payload_len);
+        _tx_ring.desc(idx).options = 0;
+        _tx_ring.submit();
+        if (_tx_ring.needs_wakeup()) {
+            kick_tx();
+        }
+    }
+
+    uint16_t get_local_port(void) const
+    {
+        return ntohs(_src_port);
+    }
+
+    std::string get_local_addr(void) const
+    {
+        char buf[INET_ADDRSTRLEN];
+        in_addr src_addr;
+        src_addr.s_addr = _iface.ipv4;
+        return ::inet_ntop(AF_INET, &src_addr, buf, sizeof(buf));
+    }
+
+private:
+    /*******************************************************************
+     * Setup helpers
+     ******************************************************************/
+    //! Bind a kernel socket to the local port, so nobody else takes it
+    void reserve_local_port(const device_addr_t& hints)
+    {
+        _port_fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+        if (_port_fd < 0) {
+            throw uhd::os_error("AF_XDP: Cannot create the port reservation socket");
+        }
+        sockaddr_in local;
+        std::memset(&local, 0, sizeof(local));
+        local.sin_family      = AF_INET;
+        local.sin_addr.s_addr = _iface.ipv4;
+        if (hints.has_key("xdp_port_base")) {
+            local.sin_port =
+                htons(uint16_t(hints.cast<size_t>("xdp_port_base", 0) + _queue));
+        }
+        socklen_t local_len = sizeof(local);
+        if (::bind(_port_fd, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0
+            or ::getsockname(_port_fd, reinterpret_cast<sockaddr*>(&local), &local_len)
+                   != 0) {
+            throw uhd::os_error(
+                str(boost::format("AF_XDP: Cannot bind a local UDP port: %s")
+                    % strerror(errno)));
+        }
+        _src_port = local.sin_port;
+    }
+
+    //! Get the peer's MAC address from the kernel, prompting an ARP request
+    void resolve_dst_mac(void)
+    {
+        if (lookup_arp(_iface, _dst_addr, _dst_mac)) {
+            return;
+        }
+        // The kernel resolves the address when we send something to the
+        // peer's discard port
+        sockaddr_in discard;
+        std::memset(&discard, 0, sizeof(discard));
+        discard.sin_family      = AF_INET;
+        discard.sin_addr.s_addr = _dst_addr;
+        discard.sin_port        = htons(DISCARD_PORT);
+        ::sendto(_port_fd,
+            "",
+            0,
+            0,
+            reinterpret_cast<sockaddr*>(&discard),
+            sizeof(discard));
+
+        const auto exit_time =
+            std::chrono::steady_clock::now()
+            + std::chrono::milliseconds(int(XDP_ARP_TIMEOUT * 1000));
+        while (std::chrono::steady_clock::now() < exit_time) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            if (lookup_arp(_iface, _dst_addr, _dst_mac)) {
+                return;
+            }
+        }
+        throw uhd::runtime_error("AF_XDP: Cannot resolve the MAC address of the device");
+    }
+
+    void create_socket(void)
+    {
+        // Receive frames first, then send frames. Frames larger than a page
+        // have to be backed by huge pages.
+        const size_t num_frames = _num_recv_frames + _num_send_frames;
+        _umem_size              = num_frames * _frame_size;
+        _umem_map_len           = _umem_size;
+        int map_flags           = MAP_PRIVATE | MAP_ANONYMOUS;
+        if (_frame_size > size_t(::sysconf(_SC_PAGESIZE))) {
+            const size_t huge_page_size = get_huge_page_size();
+            map_flags |= MAP_HUGETLB;
+            _umem_map_len =
+                (_umem_size + huge_page_size - 1) / huge_page_size * huge_page_size;
+        }
+        _umem_area =
+            ::mmap(nullptr, _umem_map_len, PROT_READ | PROT_WRITE, map_flags, -1, 0);
+        if (_umem_area == MAP_FAILED) {
+            _umem_area = nullptr;
+            throw uhd::os_error(str(
+                boost::format("AF_XDP: Cannot allocate the UMEM area (%d frames of %d "
+                              "bytes): %s%s")
+                % num_frames % _frame_size % strerror(errno)
+                % ((map_flags & MAP_HUGETLB)
+                          ? ". The MTU of the interface needs huge pages, see "
+                            "vm.nr_hugepages"
+                          : "")));
+        }
+
+        _xsk_fd = ::socket(AF_XDP, SOCK_RAW | SOCK_CLOEXEC, 0);
+        if (_xsk_fd < 0) {
+            throw uhd::os_error(str(
+                boost::format("AF_XDP: Cannot create the socket: %s") % strerror(errno)));
+        }
+        xdp_umem_reg umem_reg;
+        std::memset(&umem_reg, 0, sizeof(umem_reg));
+        umem_reg.addr       = reinterpret_cast<uint64_t>(_umem_area);
+        umem_reg.len        = _umem_size;
+        umem_reg.chunk_size = uint32_t(_frame_size);
+        set_xdp_opt(XDP_UMEM_REG, &umem_reg, sizeof(umem_reg), "register the UMEM");
+
+        const uint32_t recv_ring_size = ring_size(_num_recv_frames);
+        const uint32_t send_ring_size = ring_size(_num_send_frames);
+        set_xdp_opt(XDP_UMEM_FILL_RING,
+            &recv_ring_size,
+            sizeof(recv_ring_size),
+            "size the fill ring");
+        set_xdp_opt(XDP_UMEM_COMPLETION_RING,
+            &send_ring_size,
+            sizeof(send_ring_size),
+            "size the completion ring");
+        set_xdp_opt(
+            XDP_RX_RING, &recv_ring_size, sizeof(recv_ring_size), "size the RX ring");
+        set_xdp_opt(
+            XDP_TX_RING, &send_ring_size, sizeof(send_ring_size), "size the TX ring");
+
+        xdp_mmap_offsets offsets;
+        socklen_t offsets_len = sizeof(offsets);
+        if (::getsockopt(_xsk_fd, SOL_XDP, XDP_MMAP_OFFSETS, &offsets, &offsets_len)
+            != 0) {
+            throw uhd::os_error(
+                str(boost::format("AF_XDP: Cannot get the ring offsets: %s")
+                    % strerror(errno)));
+        }
+        map_ring(_fill_ring,
+            offsets.fr,
+            sizeof(uint64_t),
+            recv_ring_size,
+            XDP_UMEM_PGOFF_FILL_RING);
+        map_ring(_comp_ring,
+            offsets.cr,
+            sizeof(uint64_t),
+            send_ring_size,
+            XDP_UMEM_PGOFF_COMPLETION_RING);
+        map_ring(_rx_ring, offsets.rx, sizeof(xdp_desc), recv_ring_size, XDP_PGOFF_RX_RING);
+        map_ring(_tx_ring, offsets.tx, sizeof(xdp_desc), send_ring_size, XDP_PGOFF_TX_RING);
+
+        sockaddr_xdp sxdp;
+        std::memset(&sxdp, 0, sizeof(sxdp));
+        sxdp.sxdp_family   = AF_XDP;
+        sxdp.sxdp_flags    = _bind_flags | XDP_USE_NEED_WAKEUP;
+        sxdp.sxdp_ifindex  = _iface.index;
+        sxdp.sxdp_queue_id = uint32_t(_queue);
+        // The kernel frees the buffers of a closed socket asynchronously, so
+        // the queue may still be busy for a moment after the last user
+        const auto bind_exit_time =
+            std::chrono::steady_clock::now()
+            + std::chrono::milliseconds(int(XDP_BIND_TIMEOUT * 1000));
+        int ret;
+        while ((ret = ::bind(_xsk_fd, reinterpret_cast<sockaddr*>(&sxdp), sizeof(sxdp)))
+                   != 0
+               and errno == EBUSY and std::chrono::steady_clock::now() < bind_exit_time) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        if (ret != 0) {
+            throw uhd::os_error(
+                str(boost::format("AF_XDP: Cannot bind the socket to %s queue %d: %s")
+                    % _iface.name % _queue % strerror(errno)));
+        }
+
+        if (_busy_poll) {
+            const int one = 1, usecs = XDP_BUSY_POLL_USECS, budget = XDP_BUSY_POLL_BUDGET;
+            if (::setsockopt(_xsk_fd, SOL_SOCKET, SO_PREFER_BUSY_POLL, &one, sizeof(one))
+                    != 0
+                or ::setsockopt(_xsk_fd, SOL_SOCKET, SO_BUSY_POLL, &usecs, sizeof(usecs))
+                       != 0
+                or ::setsockopt(
+                       _xsk_fd, SOL_SOCKET, SO_BUSY_POLL_BUDGET, &budget, sizeof(budget))
+                       != 0) {
+                UHD_LOGGER_WARNING("XDP")
+                    << "Could not enable busy polling on the AF_XDP socket: "
+                    << strerror(errno);
+            }
+        }
+
+        // Hand all receive frames to the kernel, keep the send frames
+        for (size_t i = 0; i < _num_recv_frames; i++) {
+            _mrb_pool.push_back(boost::make_shared<xdp_zero_copy_mrb>(this));
+            recycle_recv_frame(i * _frame_size);
+        }
+        for (size_t i = _num_recv_frames; i < num_frames; i++) {
+            _msb_pool.push_back(boost::make_shared<xdp_zero_copy_msb>(this));
+            _free_send_frames.push_back(i * _frame_size);
+        }
+    }
+
+    void set_xdp_opt(
+        const int opt, const void* val, const socklen_t len, const std::string& what)
+    {
+        if (::setsockopt(_xsk_fd, SOL_XDP, opt, val, len) != 0) {
+            throw uhd::os_error(
+                str(boost::format("AF_XDP: Cannot %s: %s") % what % strerror(errno)));
+        }
+    }
+
+    void map_ring(xdp_ring& ring,
+        const xdp_ring_offset& offset,
+        const size_t entry_size,
+        const uint32_t size,
+        const off_t pgoff)
+    {
+        ring.map_len = offset.desc + size * entry_size;
+        ring.map     = ::mmap(nullptr,
+            ring.map_len,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE,
+            _xsk_fd,
+            pgoff);
+        if (ring.map == MAP_FAILED) {
+            ring.map = nullptr;
+            throw uhd::os_error(
+                str(boost::format("AF_XDP: Cannot map a ring: %s") % strerror(errno)));
+        }
+        uint8_t* base    = static_cast<uint8_t*>(ring.map);
+        ring.producer    = reinterpret_cast<uint32_t*>(base + offset.producer);
+        ring.consumer    = reinterpret_cast<uint32_t*>(base + offset.consumer);
+        ring.flags       = reinterpret_cast<uint32_t*>(base + offset.flags);
+        ring.descs       = base + offset.desc;
+        ring.size        = size;
+        ring.mask        = size - 1;
+        ring.cached_prod = *ring.producer;
+        ring.cached_cons = *ring.consumer;
+    }
+
+    void cleanup(void)
+    {
+        if (_program) {
+            _program->release_queue(_queue);
+            _program.reset();
+        }
+        for (xdp_ring* ring : {&_fill_ring, &_comp_ring, &_rx_ring, &_tx_ring}) {
+            if (ring->map) {
+                ::munmap(ring->map, ring->map_len);
+                ring->map = nullptr;
+            }
+        }
+        if (_xsk_fd >= 0) {
+            ::close(_xsk_fd);
+            _xsk_fd = -1;
+        }
+        if (_umem_area) {
+            ::munmap(_umem_area, _umem_map_len);
+            _umem_area = nullptr;
+        }
+        if (_port_fd >= 0) {
+            ::close(_port_fd);
+            _port_fd = -1;
+        }
+    }
+
+    //! Everything but the lengths and checksum is the same for every packet
+    void init_header_template(void)
+    {
+        uint8_t* hdr = _hdr_template;
+        std::memset(hdr, 0, HDR_SIZE);
+        std::memcpy(hdr, _dst_mac, ETH_ALEN);
+        std::memcpy(hdr + ETH_ALEN, _iface.mac, ETH_ALEN);
+        hdr[12] = ETH_P_IP >> 8;
+        hdr[13] = ETH_P_IP & 0xff;
+
+        uint8_t* ip = hdr + ETH_HDR_SIZE;
+        ip[0]       = 0x45; // IPv4, 5 words of header
+        ip[6]       = 0x40; // don't fragment
+        ip[8]       = 64; // TTL
+        ip[9]       = IPPROTO_UDP;
+        std::memcpy(ip + 12, &_iface.ipv4, 4);
+        std::memcpy(ip + 16, &_dst_addr, 4);
+
+        uint8_t* udp = ip + IPV4_HDR_SIZE;
+        std::memcpy(udp, &_src_port, 2);
+        std::memcpy(udp + 2, &_dst_port, 2);
+        // The UDP checksum is optional for IPv4 and left at zero
+    }
+
+    /*******************************************************************
+     * Datapath helpers
+     ******************************************************************/
+    UHD_INLINE void write_headers(uint8_t* pkt, const size_t payload_len)
+    {
+        std::memcpy(pkt, _hdr_template, HDR_SIZE);
+        uint8_t* ip = pkt + ETH_HDR_SIZE;
+        const uint16_t ip_len =
+            htons(uint16_t(IPV4_HDR_SIZE + UDP_HDR_SIZE + payload_len));
+        std::memcpy(ip + 2, &ip_len, 2);
+        const uint16_t csum = ipv4_checksum(ip);
+        std::memcpy(ip + 10, &csum, 2);
+        const uint16_t udp_len = htons(uint16_t(UDP_HDR_SIZE + payload_len));
+        std::memcpy(ip + IPV4_HDR_SIZE + 4, &udp_len, 2);
+    }
+
+    //! Check that the packet is UDP from our peer to our port
+    UHD_INLINE bool parse_headers(
+        const uint8_t* pkt, const size_t len, size_t& payload_len) const
+    {
+        if (len < HDR_SIZE or pkt[12] != (ETH_P_IP >> 8)
+            or pkt[13] != (ETH_P_IP & 0xff)) {
+            return false;
+        }
+        const uint8_t* ip = pkt + ETH_HDR_SIZE;
+        // Only plain 20 byte IPv4 headers, so the payload offset is fixed
+        if (ip[0] != 0x45 or ip[9] != IPPROTO_UDP
+            or std::memcmp(ip + 12, &_dst_addr, 4) != 0) {
+            return false;
+        }
+        const uint8_t* udp = ip + IPV4_HDR_SIZE;
+        if (std::memcmp(udp, &_dst_port, 2) != 0
+            or std::memcmp(udp + 2, &_src_port, 2) != 0) {
+            return false;
+        }
+        const size_t udp_len = (size_t(udp[4]) << 8) | udp[5];
+        if (udp_len < UDP_HDR_SIZE or ETH_HDR_SIZE + IPV4_HDR_SIZE + udp_len > len) {
+            return false;
+        }
+        payload_len = udp_len - UDP_HDR_SIZE;
+        return true;
+    }
+
+    void reclaim_send_frames(void)
+    {
+        uint32_t idx             = 0;
+        const uint32_t completed = _comp_ring.peek(uint32_t(_num_send_frames), idx);
+        for (uint32_t i = 0; i < completed; i++) {
+            _free_send_frames.push_back(_comp_ring.addr(idx + i));
+        }
+        if (completed) {
+            _comp_ring.release();
+        }
+    }
+
+    UHD_INLINE void kick_tx(void)
+    {
+        ::sendto(_xsk_fd, nullptr, 0, MSG_DONTWAIT, nullptr, 0);
+    }
+
+    void wait_for_rx(const std::chrono::steady_clock::time_point exit_time)
+    {
+        if (_busy_poll) {
+            // Drive the NAPI loop of the queue from this thread
+            ::recvfrom(_xsk_fd, nullptr, 0, MSG_DONTWAIT, nullptr, nullptr);
+            return;
+        }
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            exit_time - std::chrono::steady_clock::now());
+        pollfd pfd;
+        pfd.fd     = _xsk_fd;
+        pfd.events = POLLIN;
+        ::poll(&pfd, 1, std::max<int>(1, int(remaining.count())));
+    }
+
+    UHD_INLINE uint8_t* umem_data(const uint64_t addr) const
+    {
+        return static_cast<uint8_t*>(_umem_area) + addr;
+    }
+
+    //! Received packets start after the kernel's headroom in the frame
+    UHD_INLINE uint64_t frame_base(const uint64_t addr) const
+    {
+        return addr & ~uint64_t(_frame_size - 1);
+    }
+
+    UHD_INLINE size_t frame_index(const uint64_t addr) const
+    {
+        return size_t(addr / _frame_size);
+    }
+
+    //! Ring sizes must be powers of two
+    static uint32_t ring_size(const size_t num_frames)
+    {
+        uint32_t size = 1;
+        while (size < num_frames) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    // Buffers
+    size_t _recv_frame_size;
+    const size_t _num_recv_frames;
+    size_t _send_frame_size;
+    const size_t _num_send_frames;
+    size_t _frame_size = XDP_MIN_FRAME_SIZE;
+    std::vector<boost::shared_ptr<xdp_zero_copy_mrb>> _mrb_pool;
+    std::vector<boost::shared_ptr<xdp_zero_copy_msb>> _msb_pool;
+    std::vector<uint64_t> _free_send_frames;
+    std::mutex _fill_mutex;
+
+    // Addressing, all in network byte order
+    iface_info_t _iface;
+    size_t _queue = 0;
+    in_addr_t _dst_addr;
+    uint16_t _dst_port;
+    uint16_t _src_port = 0;
+    uint8_t _dst_mac[ETH_ALEN];
+    uint8_t _hdr_template[HDR_SIZE];
+
+    // AF_XDP state
+    const bool _busy_poll;
+    uint16_t _bind_flags = 0;
+    xdp_iface_program::sptr _program;
+    int _port_fd         = -1;
+    int _xsk_fd          = -1;
+    void* _umem_area     = nullptr;
+    size_t _umem_size    = 0;
+    size_t _umem_map_len = 0;
+    xdp_ring _fill_ring;
+    xdp_ring _comp_ring;
+    xdp_ring _rx_ring;
+    xdp_ring _tx_ring;
+};
+
+void xdp_zero_copy_mrb::release(void)
+{
+    _xport->recycle_recv_frame(_addr);
+}
+
+void xdp_zero_copy_msb::release(void)
+{
+    _xport->send_frame(_addr, size());
+}
+
+/***********************************************************************
+ * AF_XDP zero copy make function
+ **********************************************************************/
+xdp_zero_copy::sptr xdp_zero_copy::make(const std::string& addr,
+    const std::string& port,
+    const zero_copy_xport_params& default_buff_args,
+    udp_zero_copy::buff_params& buff_params_out,
+    const device_addr_t& hints)
+{
+    zero_copy_xport_params xport_params = default_buff_args;
+
+    xport_params.recv_frame_size =
+        size_t(hints.cast<double>("recv_frame_size", default_buff_args.recv_frame_size));
+    xport_params.num_recv_frames =
+        size_t(hints.cast<double>("num_recv_frames", default_buff_args.num_recv_frames));
+    xport_params.send_frame_size =
+        size_t(hints.cast<double>("send_frame_size", default_buff_args.send_frame_size));
+    xport_params.num_send_frames =
+        size_t(hints.cast<double>("num_send_frames", default_buff_args.num_send_frames));
+
+    // The UMEM frames replace the socket buffers, so make sure there are
+    // plenty of them
+    if (not hints.has_key("num_recv_frames")) {
+        xport_params.num_recv_frames =
+            std::max(xport_params.num_recv_frames, XDP_DEFAULT_NUM_FRAMES);
+    }
+    if (not hints.has_key("num_send_frames")) {
+        xport_params.num_send_frames =
+            std::max(xport_params.num_send_frames, XDP_DEFAULT_NUM_FRAMES);
+    }
+
+    // The frame sizes are limited by the MTU of the interface
+    xdp_zero_copy::sptr xport =
+        boost::make_shared<xdp_zero_copy_impl>(addr, port, xport_params, hints);
+    buff_params_out.recv_buff_size =
+        xport->get_num_recv_frames() * xport->get_recv_frame_size();
+    buff_params_out.send_buff_size =
+        xport->get_num_send_frames() * xport->get_send_frame_size();
+    return xport;
+}
@@ -5,7 +5,6 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
-#include <uhd/transport/bounded_buffer.hpp>
 #include <uhd/transport/buffer_pool.hpp>
 #include <uhd/transport/zero_copy_flow_ctrl.hpp>
 #include <uhd/utils/log.hpp>
@@ -19,8 +18,6 @@
 using namespace uhd;
 using namespace uhd::transport;
 
-typedef bounded_buffer<managed_send_buffer::sptr> bounded_buffer_t;
-
 class zero_copy_flow_ctrl_msb : public managed_send_buffer
 {
 public:
@@ -5,12 +5,12 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
-#include <uhd/transport/bounded_buffer.hpp>
 #include <uhd/transport/buffer_pool.hpp>
 #include <uhd/transport/zero_copy_recv_offload.hpp>
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/safe_call.hpp>
 #include <uhd/utils/thread.hpp>
+#include <uhdlib/transport/spsc_queue.hpp>
 #include <boost/bind.hpp>
 #include <boost/format.hpp>
 #include <boost/make_shared.hpp>
@@ -20,7 +20,9 @@
 using namespace uhd;
 using namespace uhd::transport;
 
-typedef bounded_buffer<managed_recv_buffer::sptr> bounded_buffer_t;
+// The receive thread is the only producer and the caller of
+// get_recv_buff() is the only consumer
+typedef spsc_queue<managed_recv_buffer::sptr> spsc_queue_t;
 
 /***********************************************************************
  * Zero copy offload transport:
@@ -128,7 +130,7 @@ private:
     const double _timeout;
 
     // Shared buffers
-    bounded_buffer_t _inbox;
+    spsc_queue_t _inbox;
 
     // Threading
     bool _recv_done;
@@ -406,6 +406,7 @@ rx_streamer::sptr b200_impl::get_rx_stream(const uhd::stream_args_t& args_)
     check_streamer_args(args, this->get_tick_rate(), "RX");
 
     boost::shared_ptr<sph::recv_packet_streamer> my_streamer;
+    const convert_worker_pool::sptr convert_pool = convert_worker_pool::make(args.args);
     for (size_t stream_i = 0; stream_i < args.channels.size(); stream_i++) {
         const size_t radio_index =
             _tree->access<std::vector<size_t>>("/mboards/0/rx_chan_dsp_mapping")
@@ -449,7 +450,9 @@ rx_streamer::sptr b200_impl::get_rx_stream(const uhd::stream_args_t& args_)
         id.num_inputs    = 1;
         id.output_format = args.cpu_format;
         id.num_outputs   = 1;
+        my_streamer->set_convert_worker_pool(convert_pool);
         my_streamer->set_converter(id);
+        my_streamer->set_resampler(polyphase_resampler::make(args.channels.size(), args.args));
 
         perif.framer->clear();
         perif.framer->set_nsamps_per_packet(spp);
@@ -528,6 +531,7 @@ tx_streamer::sptr b200_impl::get_tx_stream(const uhd::stream_args_t& args_)
     check_streamer_args(args, this->get_tick_rate(), "TX");
 
     boost::shared_ptr<sph::send_packet_streamer> my_streamer;
+    const convert_worker_pool::sptr convert_pool = convert_worker_pool::make(args.args);
     for (size_t stream_i = 0; stream_i < args.channels.size(); stream_i++) {
         const size_t radio_index =
             _tree->access<std::vector<size_t>>("/mboards/0/tx_chan_dsp_mapping")
@@ -568,7 +572,9 @@ tx_streamer::sptr b200_impl::get_tx_stream(const uhd::stream_args_t& args_)
         id.num_inputs    = 1;
         id.output_format = args.otw_format + "_item32_le";
         id.num_outputs   = 1;
+        my_streamer->set_convert_worker_pool(convert_pool);
         my_streamer->set_converter(id);
+        my_streamer->set_resampler(polyphase_resampler::make(args.channels.size(), args.args));
 
         perif.deframer->clear();
         perif.deframer->setup(args);
@@ -9,77 +9,39 @@
 #include <uhd/usrp/dboard_eeprom.hpp>
 #include <uhd/utils/paths.hpp>
 #include <uhd/utils/log.hpp>
-#include <uhd/utils/csv.hpp>
-#include <uhd/types/dict.hpp>
+#include <uhdlib/usrp/common/fe_cal_table.hpp>
 #include <boost/filesystem.hpp>
-#include <boost/thread/mutex.hpp>
-#include <cstdio>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
 #include <complex>
-#include <fstream>
+#include <map>
 
 namespace fs = boost::filesystem;
-
-boost::mutex corrections_mutex;
-
-/***********************************************************************
- * Helper routines
- **********************************************************************/
-static double linear_interp(double x, double x0, double y0, double x1, double y1){
-    return y0 + (x - x0)*(y1 - y0)/(x1 - x0);
-}
+using uhd::usrp::fe_cal_table;
 
 /***********************************************************************
  * FE apply corrections implementation
  **********************************************************************/
-struct fe_cal_t{
-    double lo_freq;
-    double iq_corr_real;
-    double iq_corr_imag;
-};
+//! Tables by CSV file path. Tables are immutable, so only the map is locked.
+static std::map<std::string, fe_cal_table::sptr> fe_cal_cache;
+static boost::shared_mutex fe_cal_cache_mutex;
 
-static bool fe_cal_comp(fe_cal_t a, fe_cal_t b){
-    return (a.lo_freq < b.lo_freq);
-}
-
-static uhd::dict<std::string, std::vector<fe_cal_t> > fe_cal_cache;
-
-static bool is_same_freq(const double f1, const double f2)
+static fe_cal_table::sptr get_fe_cal_table(const std::string &cal_data_path)
 {
-    const double epsilon = 0.1;
-    return ((f1 - epsilon) < f2 and (f1 + epsilon) > f2);
-}
-
-static std::complex<double> get_fe_correction(
-    const std::string &key, const double lo_freq
-){
-    const std::vector<fe_cal_t> &datas = fe_cal_cache[key];
-    if (datas.empty()) throw uhd::runtime_error("empty calibration table " + key);
-
-    //search for lo freq
-    size_t lo_index = 0;
-    size_t hi_index = datas.size()-1;
-    for (size_t i = 0; i < datas.size(); i++){
-        if (is_same_freq(datas[i].lo_freq, lo_freq))
-        {
-            hi_index = i;
-            lo_index = i;
-            break;
-        }
-        if (datas[i].lo_freq > lo_freq){
-            hi_index = i;
-            break;
-        }
-        lo_index = i;
+    {
+        boost::shared_lock<boost::shared_mutex> lock(fe_cal_cache_mutex);
+        auto it = fe_cal_cache.find(cal_data_path);
+        if (it != fe_cal_cache.end()) return it->second;
     }
 
-    if (lo_index == 0) return std::complex<double>(datas[lo_index].iq_corr_real, datas[lo_index].iq_corr_imag);
-    if (hi_index == lo_index) return std::complex<double>(datas[hi_index].iq_corr_real, datas[hi_index].iq_corr_imag);
-
-    //interpolation time
-    return std::complex<double>(
-        linear_interp(lo_freq, datas[lo_index].lo_freq, datas[lo_index].iq_corr_real, datas[hi_index].lo_freq, datas[hi_index].iq_corr_real),
-        linear_interp(lo_freq, datas[lo_index].lo_freq, datas[lo_index].iq_corr_imag, datas[hi_index].lo_freq, datas[hi_index].iq_corr_imag)
-    );
+    //parse csv file (or map its binary copy) without holding the lock
+    fe_cal_table::sptr table = fe_cal_table::load(cal_data_path);
+    boost::unique_lock<boost::shared_mutex> lock(fe_cal_cache_mutex);
+    auto result = fe_cal_cache.insert(std::make_pair(cal_data_path, table));
+    if (result.second) {
+        UHD_LOGGER_INFO("CAL") << "Calibration data loaded: " << cal_data_path;
+    }
+    return result.first->second;
 }
 
 static void apply_fe_corrections(
@@ -96,38 +58,11 @@ static void apply_fe_corrections(
     const fs::path cal_data_path = fs::path(uhd::get_app_path()) / ".uhd" / "cal" / (file_prefix + db_eeprom.serial + ".csv");
     if (not fs::exists(cal_data_path)) return;
 
-    //parse csv file or get from cache
-    if (not fe_cal_cache.has_key(cal_data_path.string())){
-        std::ifstream cal_data(cal_data_path.string().c_str());
-        const uhd::csv::rows_type rows = uhd::csv::to_rows(cal_data);
-
-        bool read_data = false, skip_next = false;;
-        std::vector<fe_cal_t> datas;
-        for(const uhd::csv::row_type &row:  rows){
-            if (not read_data and not row.empty() and row[0] == "DATA STARTS HERE"){
-                read_data = true;
-                skip_next = true;
-                continue;
-            }
-            if (not read_data) continue;
-            if (skip_next){
-                skip_next = false;
-                continue;
-            }
-            fe_cal_t data;
-            std::sscanf(row[0].c_str(), "%lf" , &data.lo_freq);
-            std::sscanf(row[1].c_str(), "%lf" , &data.iq_corr_real);
-            std::sscanf(row[2].c_str(), "%lf" , &data.iq_corr_imag);
-            datas.push_back(data);
-        }
-        std::sort(datas.begin(), datas.end(), fe_cal_comp);
-        fe_cal_cache[cal_data_path.string()] = datas;
-        UHD_LOGGER_INFO("CAL") << "Calibration data loaded: " << cal_data_path.string();
-
-    }
+    const fe_cal_table::sptr table = get_fe_cal_table(cal_data_path.string());
+    if (table->size() == 0) throw uhd::runtime_error("empty calibration table " + cal_data_path.string());
 
     sub_tree->access<std::complex<double> >(fe_path)
-        .set(get_fe_correction(cal_data_path.string(), lo_freq));
+        .set(table->get_correction(lo_freq));
 }
 
 /***********************************************************************
@@ -139,7 +74,6 @@ void uhd::usrp::apply_tx_fe_corrections( //overloading to work according to rfno
     const uhd::fs_path tx_fe_corr_path,
     const double lo_freq //actual lo freq
 ){
-    boost::mutex::scoped_lock l(corrections_mutex);
     try{
         apply_fe_corrections(
             sub_tree,
@@ -166,7 +100,6 @@ void uhd::usrp::apply_tx_fe_corrections(
     const std::string &slot, //name of dboard slot
     const double lo_freq //actual lo freq
 ){
-    boost::mutex::scoped_lock l(corrections_mutex);
     try{
         apply_fe_corrections(
             sub_tree,
@@ -194,7 +127,6 @@ void uhd::usrp::apply_rx_fe_corrections( //overloading to work according to rfno
     const uhd::fs_path rx_fe_corr_path,
     const double lo_freq //actual lo freq
 ){
-    boost::mutex::scoped_lock l(corrections_mutex);
     try{
         apply_fe_corrections(
             sub_tree,
@@ -214,7 +146,6 @@ void uhd::usrp::apply_rx_fe_corrections(
     const std::string &slot, //name of dboard slot
     const double lo_freq //actual lo freq
 ){
-    boost::mutex::scoped_lock l(corrections_mutex);
     try{
         apply_fe_corrections(
             sub_tree,
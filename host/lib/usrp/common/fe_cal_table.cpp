@@ -0,0 +1,234 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/csv.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhdlib/usrp/common/fe_cal_table.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+using namespace uhd::usrp;
+namespace fs  = boost::filesystem;
+namespace bip = boost::interprocess;
+
+namespace {
+static const char BIN_MAGIC[8]        = {'U', 'H', 'D', 'F', 'E', 'C', 'A', 'L'};
+static const uint32_t BIN_VERSION     = 2;
+static const uint32_t BIN_BYTE_ORDER  = 0x01020304;
+static const char* const BIN_SUFFIX   = ".bin";
+
+struct bin_header_t
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t num_entries;
+    //! Size and modification time of the CSV file this was made from
+    uint64_t csv_size;
+    int64_t csv_mtime;
+};
+
+//! Entries within this distance (in Hz) of the LO frequency are used as-is
+static const double SAME_FREQ_EPSILON = 0.1;
+
+bool entry_comp(const fe_cal_table::entry_t& lhs, const fe_cal_table::entry_t& rhs)
+{
+    return lhs.lo_freq < rhs.lo_freq;
+}
+
+double linear_interp(double x, double x0, double y0, double x1, double y1)
+{
+    return y0 + (x - x0) * (y1 - y0) / (x1 - x0);
+}
+} // namespace
+
+fe_cal_table::fe_cal_table(std::shared_ptr<const void> storage,
+    const entry_t* entries,
+    const size_t num_entries)
+    : _storage(storage), _entries(entries), _num_entries(num_entries)
+{
+    /* NOP */
+}
+
+std::complex<double> fe_cal_table::get_correction(const double lo_freq) const
+{
+    if (_num_entries == 0) {
+        throw uhd::runtime_error("empty calibration table");
+    }
+    const entry_t* end = _entries + _num_entries;
+
+    // First entry that's not below lo_freq by the epsilon or more
+    const entry_t* hi = std::upper_bound(
+        _entries, end, lo_freq, [](const double freq, const entry_t& entry) {
+            return entry.lo_freq + SAME_FREQ_EPSILON > freq;
+        });
+    if (hi != end and hi->lo_freq - SAME_FREQ_EPSILON < lo_freq) {
+        return std::complex<double>(hi->corr_real, hi->corr_imag);
+    }
+    // Same as the previous linear search: At the ends of the table (and
+    // between its first two entries), there's no interpolation.
+    if (hi == end) {
+        return std::complex<double>((end - 1)->corr_real, (end - 1)->corr_imag);
+    }
+    if (hi <= _entries + 1) {
+        return std::complex<double>(_entries->corr_real, _entries->corr_imag);
+    }
+    const entry_t* lo = hi - 1;
+    return std::complex<double>(
+        linear_interp(lo_freq, lo->lo_freq, lo->corr_real, hi->lo_freq, hi->corr_real),
+        linear_interp(lo_freq, lo->lo_freq, lo->corr_imag, hi->lo_freq, hi->corr_imag));
+}
+
+void fe_cal_table::save_binary(const std::string& bin_path,
+    const uint64_t csv_size,
+    const std::time_t csv_mtime) const
+{
+    bin_header_t header;
+    std::memcpy(header.magic, BIN_MAGIC, sizeof(header.magic));
+    header.version     = BIN_VERSION;
+    header.byte_order  = BIN_BYTE_ORDER;
+    header.num_entries = _num_entries;
+    header.csv_size    = csv_size;
+    header.csv_mtime   = int64_t(csv_mtime);
+
+    // Write a temporary file first, so readers never see a partial one
+    const std::string tmp_path = bin_path + ".tmp";
+    {
+        std::ofstream file(tmp_path.c_str(), std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(
+            reinterpret_cast<const char*>(_entries), sizeof(entry_t) * _num_entries);
+        if (not file) {
+            std::remove(tmp_path.c_str());
+            throw uhd::runtime_error("Could not write calibration file " + bin_path);
+        }
+    }
+    boost::system::error_code ec;
+    fs::rename(tmp_path, bin_path, ec);
+    if (ec) {
+        std::remove(tmp_path.c_str());
+        throw uhd::runtime_error(
+            "Could not write calibration file " + bin_path + ": " + ec.message());
+    }
+}
+
+fe_cal_table::sptr fe_cal_table::make(std::vector<entry_t> entries)
+{
+    std::stable_sort(entries.begin(), entries.end(), entry_comp);
+    auto storage = std::make_shared<const std::vector<entry_t>>(std::move(entries));
+    return sptr(new fe_cal_table(storage, storage->data(), storage->size()));
+}
+
+fe_cal_table::sptr fe_cal_table::import_csv(const std::string& csv_path)
+{
+    std::ifstream cal_data(csv_path.c_str());
+    if (not cal_data) {
+        throw uhd::runtime_error("Could not open calibration file " + csv_path);
+    }
+    const uhd::csv::rows_type rows = uhd::csv::to_rows(cal_data);
+
+    bool read_data = false, skip_next = false;
+    std::vector<entry_t> entries;
+    for (const uhd::csv::row_type& row : rows) {
+        if (not read_data and not row.empty() and row[0] == "DATA STARTS HERE") {
+            read_data = true;
+            skip_next = true;
+            continue;
+        }
+        if (not read_data)
+            continue;
+        if (skip_next) {
+            skip_next = false;
+            continue;
+        }
+        if (row.size() < 3) {
+            continue;
+        }
+        entry_t entry;
+        std::sscanf(row[0].c_str(), "%lf", &entry.lo_freq);
+        std::sscanf(row[1].c_str(), "%lf", &entry.corr_real);
+        std::sscanf(row[2].c_str(), "%lf", &entry.corr_imag);
+        entries.push_back(entry);
+    }
+    return make(std::move(entries));
+}
+
+fe_cal_table::sptr fe_cal_table::load_binary(const std::string& bin_path)
+{
+    std::shared_ptr<bip::mapped_region> region;
+    try {
+        bip::file_mapping mapping(bin_path.c_str(), bip::read_only);
+        region = std::make_shared<bip::mapped_region>(mapping, bip::read_only);
+    } catch (const bip::interprocess_exception& ex) {
+        throw uhd::runtime_error(
+            "Could not map calibration file " + bin_path + ": " + ex.what());
+    }
+
+    const size_t size = region->get_size();
+    const char* data  = static_cast<const char*>(region->get_address());
+    bin_header_t header;
+    if (size < sizeof(header)) {
+        throw uhd::runtime_error("Calibration file too short: " + bin_path);
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, BIN_MAGIC, sizeof(header.magic)) != 0
+        or header.version != BIN_VERSION or header.byte_order != BIN_BYTE_ORDER) {
+        throw uhd::runtime_error("Not a calibration file for this host: " + bin_path);
+    }
+    if (header.num_entries != (size - sizeof(header)) / sizeof(entry_t)
+        or (size - sizeof(header)) % sizeof(entry_t) != 0) {
+        throw uhd::runtime_error("Calibration file has the wrong size: " + bin_path);
+    }
+
+    // The header is a multiple of 8 bytes, and mappings are page aligned, so
+    // the entries can be used in place
+    const entry_t* entries = reinterpret_cast<const entry_t*>(data + sizeof(header));
+    const size_t num_entries = size_t(header.num_entries);
+    if (not std::is_sorted(entries, entries + num_entries, entry_comp)) {
+        throw uhd::runtime_error("Calibration file is not sorted: " + bin_path);
+    }
+    return sptr(new fe_cal_table(region, entries, num_entries));
+}
+
+fe_cal_table::sptr fe_cal_table::load(const std::string& csv_path)
+{
+    const std::string bin_path = csv_path + BIN_SUFFIX;
+    boost::system::error_code ec;
+    const uint64_t csv_size    = uint64_t(fs::file_size(csv_path, ec));
+    const std::time_t csv_time = ec ? 0 : fs::last_write_time(csv_path, ec);
+    if (not ec) {
+        // The binary copy is only used if it was made from this very CSV file.
+        // Comparing the modification times alone would take a copy that was
+        // written in the same second as a changed CSV file.
+        bin_header_t header;
+        std::ifstream bin_file(bin_path.c_str(), std::ios::binary);
+        if (bin_file.read(reinterpret_cast<char*>(&header), sizeof(header))
+            and header.version == BIN_VERSION and header.csv_size == csv_size
+            and header.csv_mtime == int64_t(csv_time)) {
+            try {
+                return load_binary(bin_path);
+            } catch (const uhd::runtime_error& ex) {
+                UHD_LOG_DEBUG("CAL", ex.what() << ", reading the CSV file instead");
+            }
+        }
+    }
+
+    sptr table = import_csv(csv_path);
+    if (not ec) {
+        try {
+            table->save_binary(bin_path, csv_size, csv_time);
+        } catch (const uhd::runtime_error& ex) {
+            UHD_LOG_DEBUG("CAL", ex.what());
+        }
+    }
+    return table;
+}
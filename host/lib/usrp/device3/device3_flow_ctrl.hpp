@@ -12,6 +12,7 @@
 #include <uhd/transport/zero_copy.hpp>
 #include <uhd/types/sid.hpp>
 #include <uhd/utils/log.hpp>
+#include <uhdlib/transport/stream_counters.hpp>
 #include <boost/shared_ptr.hpp>
 
 namespace uhd { namespace usrp {
@@ -183,12 +184,15 @@ struct tx_fc_cache_t
         unpack;
     std::function<void(uint32_t* packet_buff, uhd::transport::vrt::if_packet_info_t&)>
         pack;
+    //! Counts the packets which wait for credit, may be null
+    uhd::transport::stream_counters::sptr counters;
 };
 
 inline bool tx_flow_ctrl(boost::shared_ptr<tx_fc_cache_t> fc_cache,
     uhd::transport::zero_copy_if::sptr xport,
     uhd::transport::managed_buffer::sptr buff)
 {
+    bool stalled = false;
     while (true) {
         // If there is space
         if (fc_cache->window_size - (fc_cache->byte_count - fc_cache->last_byte_ack)
@@ -204,6 +208,10 @@ inline bool tx_flow_ctrl(boost::shared_ptr<tx_fc_cache_t> fc_cache,
             fc_cache->pkt_count++;
             return true;
         }
+        if (not stalled and fc_cache->counters) {
+            fc_cache->counters->add_fc_stall();
+            stalled = true;
+        }
 
         // Look for a flow control message to update the space available in the buffer.
         uhd::transport::managed_recv_buffer::sptr buff = xport->get_recv_buff(0.1);
@@ -253,7 +261,8 @@ inline void tx_flow_ctrl_ack(boost::shared_ptr<tx_fc_cache_t> fc_cache,
     // Get a send buffer
     uhd::transport::managed_send_buffer::sptr fc_buff = send_xport->get_send_buff(0.0);
     if (not fc_buff) {
-        UHD_LOGGER_ERROR("tx_flow_ctrl_ack") << "timed out getting a send buffer";
+        UHD_LOG_FAST(
+            uhd::log::error, "tx_flow_ctrl_ack", "timed out getting a send buffer");
         return;
     }
     uint32_t* pkt = fc_buff->cast<uint32_t*>();
@@ -20,6 +20,7 @@
 #include <uhdlib/rfnoc/rx_stream_terminator.hpp>
 #include <uhdlib/rfnoc/tx_stream_terminator.hpp>
 #include <uhdlib/usrp/common/async_packet_handler.hpp>
+#include <uhdlib/utils/reactor.hpp>
 #include <boost/atomic.hpp>
 
 #define UHD_TX_STREAMER_LOG() UHD_LOGGER_TRACE("STREAMER")
@@ -191,22 +192,25 @@ struct async_tx_info_t
     size_t device_channel;
     boost::shared_ptr<device3_impl::async_md_type> async_queue;
     boost::shared_ptr<device3_impl::async_md_type> old_async_queue;
+    stream_counters::sptr counters;
 };
 
 /*! Handle incoming messages.
  *  Send them to the async message queue for the user to poll.
  *
- * This is run inside a uhd::task as long as this streamer lives.
+ * This is run by a receive task (see make_recv_task()) as long as this
+ * streamer lives. Returns true if a message was received.
  */
-static void handle_tx_async_msgs(boost::shared_ptr<async_tx_info_t> async_info,
+static bool handle_tx_async_msgs(boost::shared_ptr<async_tx_info_t> async_info,
     zero_copy_if::sptr xport,
     uint32_t (*to_host)(uint32_t),
     void (*unpack)(const uint32_t* packet_buff, vrt::if_packet_info_t&),
-    boost::function<double(void)> get_tick_rate)
+    boost::function<double(void)> get_tick_rate,
+    const double timeout)
 {
-    managed_recv_buffer::sptr buff = xport->get_recv_buff();
+    managed_recv_buffer::sptr buff = xport->get_recv_buff(timeout);
     if (not buff) {
-        return;
+        return false;
     }
 
     // extract packet info
@@ -220,7 +224,7 @@ static void handle_tx_async_msgs(boost::shared_ptr<async_tx_info_t> async_info,
     } catch (const std::exception& ex) {
         UHD_LOGGER_ERROR("STREAMER")
             << "Error parsing async message packet: " << ex.what();
-        return;
+        return true;
     }
 
     double tick_rate = get_tick_rate();
@@ -243,11 +247,13 @@ static void handle_tx_async_msgs(boost::shared_ptr<async_tx_info_t> async_info,
             << "Unexpected flow control message found in async message handling"
             << std::endl;
     } else {
+        async_info->counters->add_async_msg(metadata);
         async_info->async_queue->push_with_pop_on_full(metadata);
         metadata.channel = async_info->device_channel;
         async_info->old_async_queue->push_with_pop_on_full(metadata);
         standard_async_msg_prints(metadata);
     }
+    return true;
 }
 
 bool device3_impl::recv_async_msg(async_metadata_t& async_metadata, double timeout)
@@ -255,6 +261,35 @@ bool device3_impl::recv_async_msg(async_metadata_t& async_metadata, double timeo
     return _async_md->pop_with_timed_wait(async_metadata, timeout);
 }
 
+/***********************************************************************
+ * Streamer counters
+ **********************************************************************/
+/*! Mirror the counters of a new streamer into the property tree, at
+ *  /streamers/<rx|tx>/<terminator ID>/stats, and remove the nodes of
+ *  streamers which are gone.
+ */
+template <typename streamer_type>
+static void publish_stream_stats(property_tree::sptr tree,
+    const fs_path& base_path,
+    const uhd::dict<std::string, boost::weak_ptr<streamer_type>>& streamers,
+    const std::string& new_id)
+{
+    for (const std::string& id : streamers.keys()) {
+        const boost::weak_ptr<streamer_type> weak_streamer = streamers[id];
+        if (weak_streamer.expired()) {
+            if (tree->exists(base_path / id)) {
+                tree->remove(base_path / id);
+            }
+        } else if (id == new_id) {
+            tree->create<stream_stats_t>(base_path / id / "stats")
+                .set_publisher([weak_streamer]() {
+                    auto streamer = weak_streamer.lock();
+                    return streamer ? streamer->get_stats() : stream_stats_t();
+                });
+        }
+    }
+}
+
 /***********************************************************************
  * Receive streamer
  **********************************************************************/
@@ -427,6 +462,10 @@ rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t& args_)
             my_streamer = boost::make_shared<device3_recv_packet_streamer>(
                 spp, recv_terminator, xport);
             my_streamer->resize(chan_list.size());
+            my_streamer->set_convert_worker_pool(
+                convert_worker_pool::make(args.args));
+            my_streamer->set_resampler(
+                polyphase_resampler::make(chan_list.size(), args.args));
         }
 
         // init some streamer stuff
@@ -484,6 +523,8 @@ rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t& args_)
     // to do so.
     _rx_streamers[recv_terminator->unique_id()] =
         boost::weak_ptr<uhd::rx_streamer>(my_streamer);
+    publish_stream_stats(
+        _tree, "/streamers/rx", _rx_streamers, recv_terminator->unique_id());
 
     // Sets tick rate, samp rate and scaling on this streamer.
     // A registered terminator is required to do this.
@@ -685,6 +726,10 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t& args_)
             my_streamer = boost::make_shared<device3_send_packet_streamer>(
                 spp, send_terminator, xport, async_xport);
             my_streamer->resize(chan_list.size());
+            my_streamer->set_convert_worker_pool(
+                convert_worker_pool::make(args.args));
+            my_streamer->set_resampler(
+                polyphase_resampler::make(chan_list.size(), args.args));
         }
 
         // init some streamer stuff
@@ -710,16 +755,19 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t& args_)
         async_tx_info->device_channel  = mb_index;
         async_tx_info->async_queue     = async_md;
         async_tx_info->old_async_queue = _async_md;
+        async_tx_info->counters        = my_streamer->get_stream_counters();
+        fc_cache->counters             = my_streamer->get_stream_counters();
 
-        task::sptr async_task =
-            task::make([async_tx_info, async_xport, xport, send_terminator]() {
-                handle_tx_async_msgs(async_tx_info,
+        task::sptr async_task = make_recv_task(async_xport.recv,
+            [async_tx_info, async_xport, xport, send_terminator](const double timeout) {
+                return handle_tx_async_msgs(async_tx_info,
                     async_xport.recv,
                     xport.endianness == ENDIANNESS_BIG ? uhd::ntohx<uint32_t>
                                                        : uhd::wtohx<uint32_t>,
                     xport.endianness == ENDIANNESS_BIG ? vrt::chdr::if_hdr_unpack_be
                                                        : vrt::chdr::if_hdr_unpack_le,
-                    [send_terminator]() { return send_terminator->get_tick_rate(); });
+                    [send_terminator]() { return send_terminator->get_tick_rate(); },
+                    timeout);
             });
         my_streamer->add_async_msg_task(async_task);
 
@@ -753,6 +801,8 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t& args_)
     // to do so.
     _tx_streamers[send_terminator->unique_id()] =
         boost::weak_ptr<uhd::tx_streamer>(my_streamer);
+    publish_stream_stats(
+        _tree, "/streamers/tx", _tx_streamers, send_terminator->unique_id());
 
     // Sets tick rate, samp rate and scaling on this streamer
     // A registered terminator is required to do this.
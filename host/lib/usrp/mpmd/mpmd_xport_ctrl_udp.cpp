@@ -10,7 +10,9 @@
 #include <uhd/transport/udp_constants.hpp>
 #include <uhd/transport/udp_simple.hpp>
 #include <uhd/transport/udp_zero_copy.hpp>
-
+#ifdef HAVE_XDP
+#    include <uhdlib/transport/xdp_zero_copy.hpp>
+#endif
 
 using namespace uhd;
 using namespace uhd::mpmd::xport;
@@ -194,11 +196,35 @@ uhd::both_xports_t mpmd_xport_ctrl_udp::make_transport(
             xport_args.cast<size_t>("send_frame_size", get_mtu(uhd::TX_DIRECTION));
     }
     transport::udp_zero_copy::buff_params buff_params;
-    auto recv                     = transport::udp_zero_copy::make(xport_info["ipv4"],
-        xport_info["port"],
-        default_buff_args,
-        buff_params,
-        xport_args);
+    transport::udp_zero_copy::sptr recv;
+    const bool is_data_xport = xport_type == usrp::device3_impl::TX_DATA
+                               or xport_type == usrp::device3_impl::RX_DATA;
+    if (is_data_xport and _mb_args.has_key("use_xdp")) {
+#ifdef HAVE_XDP
+        // The xdp_* device args pick the interface and queues
+        for (const std::string& key : _mb_args.keys()) {
+            if (key.find("xdp_") == 0 and not xport_args.has_key(key)) {
+                xport_args[key] = _mb_args[key];
+            }
+        }
+        recv = transport::xdp_zero_copy::make(xport_info["ipv4"],
+            xport_info["port"],
+            default_buff_args,
+            buff_params,
+            xport_args);
+#else
+        UHD_LOG_WARNING("MPMD",
+            "use_xdp was given, but UHD was built without AF_XDP support. "
+            "Using regular UDP sockets.");
+#endif
+    }
+    if (not recv) {
+        recv = transport::udp_zero_copy::make(xport_info["ipv4"],
+            xport_info["port"],
+            default_buff_args,
+            buff_params,
+            xport_args);
+    }
     const uint16_t port           = recv->get_local_port();
     const std::string src_ip_addr = recv->get_local_addr();
     xport_info["src_port"]        = std::to_string(port);
@@ -27,6 +27,9 @@
 #include <cmath>
 #include <bitset>
 #include <chrono>
+#include <functional>
+#include <future>
+#include <map>
 #include <thread>
 
 using namespace uhd;
@@ -1074,26 +1077,7 @@ public:
     }
 
     tune_result_t set_rx_freq(const tune_request_t &tune_request, size_t chan){
-
-        // If any mixer is driven by an external LO the daughterboard assumes that no CORDIC correction is
-        // necessary. Since the LO might be sourced from another daughterboard which would normally apply a
-        // cordic correction a manual DSP tune policy should be used to ensure identical configurations across
-        // daughterboards.
-        if (tune_request.dsp_freq_policy == tune_request.POLICY_AUTO and
-            tune_request.rf_freq_policy  == tune_request.POLICY_AUTO)
-        {
-            for (size_t c = 0; c < get_rx_num_channels(); c++) {
-                const bool external_all_los = _tree->exists(rx_rf_fe_root(chan) / "los" / ALL_LOS)
-                                              && get_rx_lo_source(ALL_LOS, c) == "external";
-                if (external_all_los) {
-                    UHD_LOGGER_WARNING("MULTI_USRP")
-                            << "At least one channel is using an external LO."
-                            << "Using a manual DSP frequency policy is recommended to ensure "
-                            << "the same frequency shift on all channels.";
-                    break;
-                }
-            }
-        }
+        warn_on_external_rx_lo(tune_request);
 
         tune_result_t result = tune_xx_subdev_and_dsp(RX_SIGN,
                 _tree->subtree(rx_dsp_root(chan)),
@@ -1103,6 +1087,31 @@ public:
         return result;
     }
 
+    std::vector<tune_result_t> set_rx_freqs(
+        const std::vector<tune_request_t> &tune_requests,
+        const std::vector<size_t> &chans,
+        const time_spec_t &cmd_time
+    ){
+        check_batch_size(tune_requests.size(), chans.size());
+        const batch_mboards_t mboards = rx_batch_mboards(chans);
+        for (const tune_request_t &tune_request : tune_requests){
+            if (warn_on_external_rx_lo(tune_request)) break;
+        }
+        std::vector<property_tree::sptr> dsp_subtrees, rf_fe_subtrees;
+        for (const size_t chan : chans){
+            dsp_subtrees.push_back(_tree->subtree(rx_dsp_root(chan)));
+            rf_fe_subtrees.push_back(_tree->subtree(rx_rf_fe_root(chan)));
+        }
+        std::vector<tune_result_t> results(chans.size());
+        run_batch(mboards, cmd_time, [&](const size_t i){
+            results[i] = tune_xx_subdev_and_dsp(RX_SIGN,
+                dsp_subtrees[i],
+                rf_fe_subtrees[i],
+                tune_requests[tune_requests.size() == 1 ? 0 : i]);
+        });
+        return results;
+    }
+
     double get_rx_freq(size_t chan){
         return derive_freq_from_xx_subdev_and_dsp(RX_SIGN, _tree->subtree(rx_dsp_root(chan)), _tree->subtree(rx_rf_fe_root(chan)));
     }
@@ -1507,20 +1516,10 @@ public:
     void set_rx_gain(double gain, const std::string &name, size_t chan){
         /* Check if any AGC mode is enable and if so warn the user */
         if (chan != ALL_CHANS) {
-            if (_tree->exists(rx_rf_fe_root(chan) / "gain" / "agc")) {
-                bool agc = _tree->access<bool>(rx_rf_fe_root(chan) / "gain" / "agc" / "enable").get();
-                if(agc) {
-                    UHD_LOGGER_WARNING("MULTI_USRP") << "AGC enabled for this channel. Setting will be ignored." ;
-                }
-            }
+            warn_on_rx_agc(chan);
         } else {
             for (size_t c = 0; c < get_rx_num_channels(); c++){
-                if (_tree->exists(rx_rf_fe_root(c) / "gain" / "agc")) {
-                    bool agc = _tree->access<bool>(rx_rf_fe_root(chan) / "gain" / "agc" / "enable").get();
-                    if(agc) {
-                        UHD_LOGGER_WARNING("MULTI_USRP") << "AGC enabled for this channel. Setting will be ignored." ;
-                    }
-                }
+                warn_on_rx_agc(c);
             }
         }
         /* Apply gain setting.
@@ -1532,6 +1531,23 @@ public:
         }
     }
 
+    void set_rx_gains(
+        const std::vector<double> &gains,
+        const std::vector<size_t> &chans,
+        const time_spec_t &cmd_time
+    ){
+        check_batch_size(gains.size(), chans.size());
+        const batch_mboards_t mboards = rx_batch_mboards(chans);
+        std::vector<gain_group::sptr> gain_groups;
+        for (const size_t chan : chans){
+            warn_on_rx_agc(chan);
+            gain_groups.push_back(rx_gain_group(chan));
+        }
+        run_batch(mboards, cmd_time, [&](const size_t i){
+            gain_groups[i]->set_value(gains[gains.size() == 1 ? 0 : i], ALL_GAINS);
+        });
+    }
+
     void set_rx_gain_profile(const std::string& profile, const size_t chan){
         if (chan != ALL_CHANS) {
             if (_tree->exists(rx_rf_fe_root(chan) / "gains/all/profile/value")) {
@@ -1923,6 +1939,28 @@ public:
         return result;
     }
 
+    std::vector<tune_result_t> set_tx_freqs(
+        const std::vector<tune_request_t> &tune_requests,
+        const std::vector<size_t> &chans,
+        const time_spec_t &cmd_time
+    ){
+        check_batch_size(tune_requests.size(), chans.size());
+        const batch_mboards_t mboards = tx_batch_mboards(chans);
+        std::vector<property_tree::sptr> dsp_subtrees, rf_fe_subtrees;
+        for (const size_t chan : chans){
+            dsp_subtrees.push_back(_tree->subtree(tx_dsp_root(chan)));
+            rf_fe_subtrees.push_back(_tree->subtree(tx_rf_fe_root(chan)));
+        }
+        std::vector<tune_result_t> results(chans.size());
+        run_batch(mboards, cmd_time, [&](const size_t i){
+            results[i] = tune_xx_subdev_and_dsp(TX_SIGN,
+                dsp_subtrees[i],
+                rf_fe_subtrees[i],
+                tune_requests[tune_requests.size() == 1 ? 0 : i]);
+        });
+        return results;
+    }
+
     double get_tx_freq(size_t chan){
         return derive_freq_from_xx_subdev_and_dsp(TX_SIGN, _tree->subtree(tx_dsp_root(chan)), _tree->subtree(tx_rf_fe_root(chan)));
     }
@@ -1947,6 +1985,22 @@ public:
         }
     }
 
+    void set_tx_gains(
+        const std::vector<double> &gains,
+        const std::vector<size_t> &chans,
+        const time_spec_t &cmd_time
+    ){
+        check_batch_size(gains.size(), chans.size());
+        const batch_mboards_t mboards = tx_batch_mboards(chans);
+        std::vector<gain_group::sptr> gain_groups;
+        for (const size_t chan : chans){
+            gain_groups.push_back(tx_gain_group(chan));
+        }
+        run_batch(mboards, cmd_time, [&](const size_t i){
+            gain_groups[i]->set_value(gains[gains.size() == 1 ? 0 : i], ALL_GAINS);
+        });
+    }
+
     void set_tx_gain_profile(const std::string& profile, const size_t chan){
         if (chan != ALL_CHANS) {
             if (_tree->exists(tx_rf_fe_root(chan) / "gains/all/profile/value")) {
@@ -2518,6 +2572,131 @@ private:
         return mcp;
     }
 
+    /*!
+     * If any mixer is driven by an external LO the daughterboard assumes that no CORDIC correction is
+     * necessary. Since the LO might be sourced from another daughterboard which would normally apply a
+     * cordic correction a manual DSP tune policy should be used to ensure identical configurations across
+     * daughterboards.
+     * \return true if the warning was given
+     */
+    bool warn_on_external_rx_lo(const tune_request_t &tune_request){
+        if (tune_request.dsp_freq_policy != tune_request.POLICY_AUTO or
+            tune_request.rf_freq_policy  != tune_request.POLICY_AUTO)
+        {
+            return false;
+        }
+        for (size_t c = 0; c < get_rx_num_channels(); c++) {
+            const bool external_all_los = _tree->exists(rx_rf_fe_root(c) / "los" / ALL_LOS)
+                                          && get_rx_lo_source(ALL_LOS, c) == "external";
+            if (external_all_los) {
+                UHD_LOGGER_WARNING("MULTI_USRP")
+                        << "At least one channel is using an external LO."
+                        << "Using a manual DSP frequency policy is recommended to ensure "
+                        << "the same frequency shift on all channels.";
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //! Warn if AGC is enabled on a channel, it ignores gain settings then
+    void warn_on_rx_agc(const size_t chan){
+        if (_tree->exists(rx_rf_fe_root(chan) / "gain" / "agc")) {
+            bool agc = _tree->access<bool>(rx_rf_fe_root(chan) / "gain" / "agc" / "enable").get();
+            if(agc) {
+                UHD_LOGGER_WARNING("MULTI_USRP") << "AGC enabled for this channel. Setting will be ignored." ;
+            }
+        }
+    }
+
+    /***********************************************************************
+     * Batched channel settings:
+     * The channels are grouped by motherboard, and every motherboard gets a
+     * thread of its own, which handles its channels in order.
+     *
+     * Looking up a channel reads the subdev specs of all motherboards (and
+     * may set a default one), and the external LO check reads the LO
+     * sources of all channels. So all of that, and the command time, is done
+     * on the calling thread. The motherboard threads only get the subtrees
+     * or gain groups of their own channels, and never touch the properties
+     * of another motherboard.
+     **********************************************************************/
+    //! Indexes into chans, by motherboard
+    typedef std::map<size_t, std::vector<size_t> > batch_mboards_t;
+
+    batch_mboards_t rx_batch_mboards(const std::vector<size_t> &chans){
+        batch_mboards_t mboards;
+        for (size_t i = 0; i < chans.size(); i++){
+            mboards[rx_chan_to_mcp(chans[i]).mboard].push_back(i);
+        }
+        return mboards;
+    }
+
+    batch_mboards_t tx_batch_mboards(const std::vector<size_t> &chans){
+        batch_mboards_t mboards;
+        for (size_t i = 0; i < chans.size(); i++){
+            mboards[tx_chan_to_mcp(chans[i]).mboard].push_back(i);
+        }
+        return mboards;
+    }
+
+    void check_batch_size(const size_t num_settings, const size_t num_chans){
+        if (num_settings != 1 and num_settings != num_chans){
+            throw uhd::value_error(str(boost::format(
+                "multi_usrp: %u settings given for %u channels"
+            ) % num_settings % num_chans));
+        }
+    }
+
+    void run_batch(
+        const batch_mboards_t &mboards,
+        const time_spec_t &cmd_time,
+        const std::function<void(const size_t)> &task
+    ){
+        // the command time is cleared on every motherboard it was set on,
+        // also when a later motherboard or a setting fails
+        std::vector<size_t> timed_mboards;
+        std::exception_ptr error;
+        try {
+            if (cmd_time != time_spec_t(0.0)){
+                for (const auto &mboard : mboards){
+                    set_command_time(cmd_time, mboard.first);
+                    timed_mboards.push_back(mboard.first);
+                }
+            }
+
+            // a single motherboard is handled on the calling thread
+            const std::launch policy = (mboards.size() > 1)
+                ? std::launch::async : std::launch::deferred;
+            std::vector<std::future<void> > mboard_tasks;
+            for (const auto &mboard : mboards){
+                const std::vector<size_t> &indexes = mboard.second;
+                mboard_tasks.emplace_back(std::async(policy, [&task, &indexes](){
+                    for (const size_t i : indexes){
+                        task(i);
+                    }
+                }));
+            }
+
+            // wait for all motherboards before reporting the first error
+            for (auto &mboard_task : mboard_tasks){
+                try {
+                    mboard_task.get();
+                } catch (...) {
+                    if (not error) error = std::current_exception();
+                }
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+        for (const size_t mboard : timed_mboards){
+            clear_command_time(mboard);
+        }
+        if (error){
+            std::rethrow_exception(error);
+        }
+    }
+
     mboard_chan_pair tx_chan_to_mcp(size_t chan){
         mboard_chan_pair mcp;
         mcp.chan = chan;
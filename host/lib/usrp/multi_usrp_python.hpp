@@ -37,16 +37,20 @@ void export_multi_usrp(py::module& m)
         .def("get_rx_rate"             , &multi_usrp::get_rx_rate, py::arg("chan") = 0)
         .def("get_rx_stream"           , &multi_usrp::get_rx_stream)
         .def("set_rx_freq"             , &multi_usrp::set_rx_freq, py::arg("tune_request"), py::arg("chan") = 0)
+        .def("set_rx_freqs"            , &multi_usrp::set_rx_freqs, py::arg("tune_requests"), py::arg("chans"), py::arg("cmd_time") = uhd::time_spec_t(0.0))
         .def("set_rx_gain"             , (void (multi_usrp::*)(double, const std::string&, size_t)) &multi_usrp::set_rx_gain, py::arg("gain"), py::arg("name"), py::arg("chan") = 0)
         .def("set_rx_gain"             , (void (multi_usrp::*)(double, size_t)) &multi_usrp::set_rx_gain, py::arg("gain"), py::arg("chan") = 0)
+        .def("set_rx_gains"            , &multi_usrp::set_rx_gains, py::arg("gains"), py::arg("chans"), py::arg("cmd_time") = uhd::time_spec_t(0.0))
         .def("set_rx_rate"             , &multi_usrp::set_rx_rate, py::arg("rate"), py::arg("chan") = ALL_CHANS)
         .def("get_tx_freq"             , &multi_usrp::get_tx_freq, py::arg("chan") = 0)
         .def("get_tx_num_channels"     , &multi_usrp::get_tx_num_channels)
         .def("get_tx_rate"             , &multi_usrp::get_tx_rate, py::arg("chan") = 0)
         .def("get_tx_stream"           , &multi_usrp::get_tx_stream)
         .def("set_tx_freq"             , &multi_usrp::set_tx_freq, py::arg("tune_request"), py::arg("chan") = 0)
+        .def("set_tx_freqs"            , &multi_usrp::set_tx_freqs, py::arg("tune_requests"), py::arg("chans"), py::arg("cmd_time") = uhd::time_spec_t(0.0))
         .def("set_tx_gain"             , (void (multi_usrp::*)(double, const std::string&, size_t)) &multi_usrp::set_tx_gain, py::arg("gain"), py::arg("name"), py::arg("chan") = 0)
         .def("set_tx_gain"             , (void (multi_usrp::*)(double, size_t)) &multi_usrp::set_tx_gain, py::arg("gain"), py::arg("chan") = 0)
+        .def("set_tx_gains"            , &multi_usrp::set_tx_gains, py::arg("gains"), py::arg("chans"), py::arg("cmd_time") = uhd::time_spec_t(0.0))
         .def("set_tx_rate"             , &multi_usrp::set_tx_rate, py::arg("rate"), py::arg("chan") = ALL_CHANS)
         .def("get_usrp_rx_info"        , &multi_usrp::get_usrp_rx_info, py::arg("chan") = 0)
         .def("get_usrp_tx_info"        , &multi_usrp::get_usrp_tx_info, py::arg("chan") = 0)
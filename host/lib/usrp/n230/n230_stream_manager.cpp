@@ -61,6 +61,7 @@ rx_streamer::sptr n230_stream_manager::get_rx_stream(const uhd::stream_args_t &a
     args.channels = args.channels.empty()? std::vector<size_t>(1, 0) : args.channels;
 
     boost::shared_ptr<sph::recv_packet_streamer> my_streamer;
+    const convert_worker_pool::sptr convert_pool = convert_worker_pool::make(args.args);
     for (size_t stream_i = 0; stream_i < args.channels.size(); stream_i++)
     {
         const size_t chan = args.channels[stream_i];
@@ -109,7 +110,9 @@ rx_streamer::sptr n230_stream_manager::get_rx_stream(const uhd::stream_args_t &a
         id.num_inputs = 1;
         id.output_format = args.cpu_format;
         id.num_outputs = 1;
+        my_streamer->set_convert_worker_pool(convert_pool);
         my_streamer->set_converter(id);
+        my_streamer->set_resampler(polyphase_resampler::make(args.channels.size(), args.args));
 
         perif.framer->clear();
         perif.framer->set_nsamps_per_packet(spp);
@@ -188,6 +191,7 @@ tx_streamer::sptr n230_stream_manager::get_tx_stream(const uhd::stream_args_t &a
     boost::shared_ptr<async_md_queue_t> async_md(new async_md_queue_t(N230_TX_MAX_ASYNC_MESSAGES));
 
     boost::shared_ptr<sph::send_packet_streamer> my_streamer;
+    const convert_worker_pool::sptr convert_pool = convert_worker_pool::make(args.args);
     for (size_t stream_i = 0; stream_i < args.channels.size(); stream_i++)
     {
         const size_t chan = args.channels[stream_i];
@@ -234,7 +238,9 @@ tx_streamer::sptr n230_stream_manager::get_tx_stream(const uhd::stream_args_t &a
         id.num_inputs = 1;
         id.output_format = args.otw_format + "_item32_be";
         id.num_outputs = 1;
+        my_streamer->set_convert_worker_pool(convert_pool);
         my_streamer->set_converter(id);
+        my_streamer->set_resampler(polyphase_resampler::make(args.channels.size(), args.args));
 
         perif.deframer->clear();
         perif.deframer->setup(args);
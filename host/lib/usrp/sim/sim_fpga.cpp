@@ -0,0 +1,679 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "sim_fpga.hpp"
+#include "../../transport/udp_common.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/rfnoc/constants.hpp>
+#include <uhd/rfnoc/null_block_ctrl.hpp>
+#include <uhd/transport/chdr.hpp>
+#include <uhd/types/sid.hpp>
+#include <uhd/utils/byteswap.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/thread.hpp>
+#include <boost/asio.hpp>
+#include <boost/thread/thread.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
+
+using namespace uhd;
+using namespace uhd::rfnoc;
+using namespace uhd::transport;
+using namespace uhd::usrp::sim;
+namespace asio = boost::asio;
+
+namespace {
+
+typedef std::chrono::steady_clock clock_type;
+
+//! NoC ID of the null source/sink block
+constexpr uint64_t NULL_BLOCK_NOC_ID = 0;
+
+// Traffic counter registers (see uhd/rfnoc/traffic_counter.hpp)
+constexpr uint32_t SR_TRAFFIC_COUNTER_ENABLE = 192;
+constexpr uint32_t RB_TRAFFIC_COUNTER_ID     = 64;
+constexpr uint64_t TRAFFIC_COUNTER_ID        = 0x712AFF1C00000000ULL;
+enum traffic_count_t {
+    XBAR_TO_SHELL_XFER = 0,
+    XBAR_TO_SHELL_PKT,
+    SHELL_TO_XBAR_XFER,
+    SHELL_TO_XBAR_PKT,
+    SHELL_TO_CE_XFER,
+    SHELL_TO_CE_PKT,
+    CE_TO_SHELL_XFER,
+    CE_TO_SHELL_PKT,
+    NUM_TRAFFIC_COUNTS
+};
+
+//! Reset value of the null source's line rate register (i.e., slowest rate)
+constexpr uint32_t DEFAULT_LINE_RATE = 0xFFFF;
+//! A source that falls behind by more than this doesn't try to catch up
+constexpr std::chrono::milliseconds MAX_PACING_LAG(1);
+//! How often the threads check if the simulator is shutting down, in seconds
+constexpr double RECV_TIMEOUT = 0.1;
+constexpr size_t MAX_RECV_PKT_SIZE = 65536;
+
+inline size_t bytes_to_lines(const size_t num_bytes)
+{
+    return (num_bytes + BYTES_PER_LINE - 1) / BYTES_PER_LINE;
+}
+
+//! State of a block's output (the null source)
+struct source_t
+{
+    bool enabled           = false;
+    bool draining          = false;
+    uint32_t fc_config     = 0;
+    uint32_t window_size   = 0;
+    uint32_t pkt_limit     = 0;
+    bool has_dst           = false;
+    uint16_t dst           = 0;
+    uint32_t bytes_sent    = 0;
+    uint32_t pkts_sent     = 0;
+    uint32_t bytes_acked   = 0;
+    uint32_t pkts_acked    = 0;
+    size_t seq_num         = 0;
+    uint32_t lines_per_pkt = null_block_ctrl::DEFAULT_LINES_PER_PACKET;
+    uint32_t line_rate     = DEFAULT_LINE_RATE;
+    uint64_t tsf           = 0;
+    clock_type::time_point next_time;
+
+    //! Return true if flow control lets a packet of \p num_bytes go out
+    bool has_credit(const size_t num_bytes) const
+    {
+        if (not(fc_config & 0x1)) {
+            return true;
+        }
+        if ((fc_config & 0x2)
+            and uint32_t(bytes_sent - bytes_acked) + num_bytes > window_size) {
+            return false;
+        }
+        if ((fc_config & 0x4) and uint32_t(pkts_sent - pkts_acked) >= pkt_limit) {
+            return false;
+        }
+        return true;
+    }
+};
+
+//! State of a block's input (the null sink)
+struct sink_t
+{
+    //! Bytes between flow control responses, 0 if they're disabled
+    uint32_t bytes_per_ack  = 0;
+    uint32_t bytes_received = 0;
+    uint32_t pkts_received  = 0;
+    uint32_t last_ack_bytes = 0;
+    size_t seq_num          = 0;
+};
+
+struct traffic_counter_t
+{
+    bool enabled = false;
+    clock_type::time_point start_time;
+    uint64_t bus_clock_ticks = 0;
+    uint64_t counts[NUM_TRAFFIC_COUNTS] = {};
+
+    void count(const traffic_count_t xfer, const size_t num_bytes)
+    {
+        if (enabled) {
+            counts[xfer] += bytes_to_lines(num_bytes);
+            counts[xfer + 1]++;
+        }
+    }
+};
+
+//! A timed command that waits in a block's command FIFO
+struct cmd_t
+{
+    sid_t sid;
+    size_t seq_num;
+    uint32_t addr;
+    uint32_t data;
+    bool has_tsf;
+    uint64_t tsf;
+};
+
+struct block_t
+{
+    uint16_t address        = 0;
+    uint32_t readback_reg   = SR_READBACK_REG_ID;
+    uint32_t user_rb_addr   = 0;
+    //! Data packet counters, which noc_shell reports in SR_READBACK_REG_GLOBAL_PARAMS
+    uint16_t data_in_count  = 0;
+    uint16_t data_out_count = 0;
+    source_t source;
+    sink_t sink;
+    traffic_counter_t counter;
+    //! Commands that wait for their time, and everything queued behind them
+    std::deque<cmd_t> cmd_fifo;
+};
+
+} // namespace
+
+class sim_fpga_impl : public sim_fpga
+{
+public:
+    sim_fpga_impl(const config_t& config)
+        : _config(config)
+        , _blocks(config.num_blocks)
+        , _start_time(clock_type::now())
+        , _socket(_io_service)
+        , _running(true)
+    {
+        if (config.num_blocks == 0
+            or config.first_xbar_port + config.num_blocks > MAX_NUM_BLOCKS) {
+            throw uhd::value_error(
+                str(boost::format("Invalid number of simulated blocks: %d")
+                    % config.num_blocks));
+        }
+        for (size_t i = 0; i < _blocks.size(); i++) {
+            _blocks[i].address =
+                uint16_t((config.dst_addr << 8) | ((config.first_xbar_port + i) << 4));
+        }
+
+        _socket.open(asio::ip::udp::v4());
+        _socket.bind(asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0));
+        // The socket buffer must hold all data in flight towards the null
+        // sinks, because UDP drops anything that doesn't fit, and the flow
+        // control windows never recover from lost packets.
+        boost::system::error_code ec;
+        _socket.set_option(
+            asio::socket_base::receive_buffer_size(int(config.buff_size)), ec);
+        _socket.set_option(
+            asio::socket_base::send_buffer_size(int(config.buff_size)), ec);
+
+        _recv_thread = boost::thread([this]() { this->recv_loop(); });
+        set_thread_name(&_recv_thread, "sim_fpga_recv");
+        _source_thread = boost::thread([this]() { this->source_loop(); });
+        set_thread_name(&_source_thread, "sim_fpga_src");
+        UHD_LOG_DEBUG("SIM",
+            "Simulated FPGA with " << _blocks.size() << " blocks listening on port "
+                                   << get_udp_port());
+    }
+
+    ~sim_fpga_impl(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _running = false;
+        }
+        _source_cond.notify_all();
+        _recv_thread.join();
+        _source_thread.join();
+    }
+
+    std::string get_udp_port(void) const
+    {
+        return std::to_string(_socket.local_endpoint().port());
+    }
+
+private:
+    /***********************************************************************
+     * Packet handling
+     **********************************************************************/
+    void recv_loop(void)
+    {
+        std::vector<uint32_t> pkt(MAX_RECV_PKT_SIZE / sizeof(uint32_t));
+        asio::ip::udp::endpoint sender;
+        while (_running) {
+            if (not wait_for_recv_ready(_socket.native_handle(), RECV_TIMEOUT)) {
+                continue;
+            }
+            boost::system::error_code ec;
+            const size_t len = _socket.receive_from(
+                asio::buffer(pkt.data(), pkt.size() * sizeof(uint32_t)), sender, 0, ec);
+            if (ec) {
+                UHD_LOG_DEBUG("SIM", "Error receiving packet: " << ec.message());
+                continue;
+            }
+            handle_packet(pkt.data(), len, sender);
+        }
+    }
+
+    void handle_packet(
+        const uint32_t* pkt, const size_t len, const asio::ip::udp::endpoint& sender)
+    {
+        if (len < 2 * sizeof(uint32_t)) {
+            return;
+        }
+        // A packet with a zero word is how a new transport tells us its address
+        if (pkt[0] == 0) {
+            const sid_t sid(uhd::ntohx(pkt[1]));
+            std::lock_guard<std::mutex> lock(_mutex);
+            _routes[uint16_t(sid.get_src())] = sender;
+            return;
+        }
+
+        vrt::if_packet_info_t info;
+        info.num_packet_words32 = len / sizeof(uint32_t);
+        try {
+            vrt::chdr::if_hdr_unpack_be(pkt, info);
+        } catch (const uhd::exception& ex) {
+            UHD_LOG_DEBUG("SIM", "Dropping malformed packet: " << ex.what());
+            return;
+        }
+        const sid_t sid(info.sid);
+        block_t* block = get_block(sid);
+        if (not block) {
+            UHD_LOG_DEBUG("SIM", "Dropping packet for unknown block: " << sid);
+            return;
+        }
+        const uint32_t* payload = pkt + info.num_header_words32;
+        const size_t pkt_size   = info.num_packet_words32 * sizeof(uint32_t);
+
+        uint32_t resp[8];
+        vrt::if_packet_info_t resp_info;
+        resp_info.has_sid = true;
+        resp_info.sid     = sid.reversed().get();
+        resp_info.has_tsf = false;
+        resp_info.num_payload_words32 = 2;
+        resp_info.num_payload_bytes   = 2 * sizeof(uint32_t);
+        bool has_resp                 = false;
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        block->counter.count(XBAR_TO_SHELL_XFER, pkt_size);
+        switch (info.packet_type) {
+            case vrt::if_packet_info_t::PACKET_TYPE_CMD: {
+                if (info.num_payload_words32 < 2) {
+                    return;
+                }
+                cmd_t cmd;
+                cmd.sid     = sid;
+                cmd.seq_num = info.packet_count;
+                cmd.addr    = uhd::ntohx(payload[0]);
+                cmd.data    = uhd::ntohx(payload[1]);
+                cmd.has_tsf = info.has_tsf;
+                cmd.tsf     = info.tsf;
+                // Like noc_shell, a command waits until its time comes, and
+                // the commands behind it wait for it. The source thread runs
+                // them when they're due.
+                if (not block->cmd_fifo.empty()
+                    or (cmd.has_tsf and cmd.tsf > get_ticks(clock_type::now()))) {
+                    block->cmd_fifo.push_back(cmd);
+                    lock.unlock();
+                    _source_cond.notify_one();
+                    return;
+                }
+                run_cmd(*block, cmd, resp, resp_info);
+                has_resp = true;
+                break;
+            }
+            case vrt::if_packet_info_t::PACKET_TYPE_FC:
+                // Flow control packets are for the output, but the host's flow
+                // control ACKs go into the input, and count like data does
+                if (not info.fc_ack) {
+                    if (info.num_payload_words32 < 2) {
+                        return;
+                    }
+                    block->source.pkts_acked  = uhd::ntohx(payload[0]);
+                    block->source.bytes_acked = uhd::ntohx(payload[1]);
+                    lock.unlock();
+                    _source_cond.notify_one();
+                    return;
+                }
+                has_resp = consume(*block, sid, pkt_size, resp, resp_info);
+                break;
+            case vrt::if_packet_info_t::PACKET_TYPE_DATA:
+                block->data_in_count++;
+                block->counter.count(SHELL_TO_CE_XFER, pkt_size);
+                has_resp = consume(*block, sid, pkt_size, resp, resp_info);
+                break;
+            default:
+                return;
+        }
+        if (not has_resp) {
+            return;
+        }
+        auto route = _routes.find(uint16_t(sid.get_src()));
+        if (route == _routes.end()) {
+            return;
+        }
+        const asio::ip::udp::endpoint dest = route->second;
+        const size_t resp_size = resp_info.num_packet_words32 * sizeof(uint32_t);
+        block->counter.count(SHELL_TO_XBAR_XFER, resp_size);
+        lock.unlock();
+        send(resp, resp_size, dest);
+    }
+
+    //! Run a command, and pack its ACK (with the readback value) into \p resp
+    void run_cmd(
+        block_t& block, const cmd_t& cmd, uint32_t* resp, vrt::if_packet_info_t& resp_info)
+    {
+        write_reg(block, cmd.addr, cmd.data);
+        const uint64_t value   = read_reg(block);
+        resp_info.packet_type  = vrt::if_packet_info_t::PACKET_TYPE_RESP;
+        resp_info.packet_count = cmd.seq_num;
+        vrt::chdr::if_hdr_pack_be(resp, resp_info);
+        uint32_t* resp_payload = resp + resp_info.num_header_words32;
+        resp_payload[0]        = uhd::htonx(uint32_t(value >> 32));
+        resp_payload[1]        = uhd::htonx(uint32_t(value));
+    }
+
+    /*! Count a packet that goes into a block's input, and pack a flow control
+     * response into \p resp if one is due.
+     */
+    bool consume(block_t& block,
+        const sid_t& sid,
+        const size_t pkt_size,
+        uint32_t* resp,
+        vrt::if_packet_info_t& resp_info)
+    {
+        sink_t& sink = block.sink;
+        sink.bytes_received += uint32_t(bytes_to_lines(pkt_size) * BYTES_PER_LINE);
+        sink.pkts_received++;
+        if (sink.bytes_per_ack == 0
+            or uint32_t(sink.bytes_received - sink.last_ack_bytes) < sink.bytes_per_ack) {
+            return false;
+        }
+        sink.last_ack_bytes = sink.bytes_received;
+
+        resp_info.packet_type  = vrt::if_packet_info_t::PACKET_TYPE_FC;
+        resp_info.packet_count = sink.seq_num++;
+        resp_info.sid          = sid.reversed().get();
+        vrt::chdr::if_hdr_pack_be(resp, resp_info);
+        resp[resp_info.num_header_words32 + 0] = uhd::htonx(sink.pkts_received);
+        resp[resp_info.num_header_words32 + 1] = uhd::htonx(sink.bytes_received);
+        return true;
+    }
+
+    block_t* get_block(const sid_t& sid)
+    {
+        if (sid.get_dst_addr() != _config.dst_addr
+            or sid.get_dst_xbarport() < _config.first_xbar_port
+            or sid.get_dst_xbarport() >= _config.first_xbar_port + _blocks.size()) {
+            return nullptr;
+        }
+        return &_blocks[sid.get_dst_xbarport() - _config.first_xbar_port];
+    }
+
+    /***********************************************************************
+     * Registers (must be called with _mutex held)
+     **********************************************************************/
+    void write_reg(block_t& block, const uint32_t addr, const uint32_t data)
+    {
+        source_t& source = block.source;
+        switch (addr) {
+            case SR_FLOW_CTRL_BYTES_PER_ACK:
+                // Bit 31 enables flow control responses
+                block.sink.bytes_per_ack = (data & (1u << 31)) ? (data & 0x7FFFFFFF) : 0;
+                break;
+            case SR_FLOW_CTRL_WINDOW_SIZE:
+                source.window_size = data;
+                break;
+            case SR_FLOW_CTRL_EN:
+                source.fc_config = data;
+                break;
+            case SR_FLOW_CTRL_PKT_LIMIT:
+                source.pkt_limit = data;
+                break;
+            case SR_NEXT_DST_SID:
+                source.dst     = uint16_t(data & 0xFFFF);
+                source.has_dst = true;
+                break;
+            case SR_CLEAR_TX_FC:
+                if (data & 0x1) {
+                    source.has_dst     = false;
+                    source.bytes_sent  = 0;
+                    source.pkts_sent   = 0;
+                    source.bytes_acked = 0;
+                    source.pkts_acked  = 0;
+                    source.seq_num     = 0;
+                }
+                source.draining = (data & 0x2) != 0;
+                break;
+            case SR_CLEAR_RX_FC:
+                if (data & 0x1) {
+                    block.sink = sink_t();
+                }
+                break;
+            case SR_READBACK:
+                block.readback_reg = data;
+                break;
+            case SR_READBACK_ADDR:
+                block.user_rb_addr = data;
+                break;
+            case null_block_ctrl::SR_LINES_PER_PACKET:
+                source.lines_per_pkt = std::max<uint32_t>(data, 1);
+                break;
+            case null_block_ctrl::SR_LINE_RATE:
+                source.line_rate = data & 0xFFFF;
+                break;
+            case null_block_ctrl::SR_ENABLE_STREAM:
+                if (data and not source.enabled) {
+                    const clock_type::time_point now = clock_type::now();
+                    source.next_time = now;
+                    source.tsf       = get_ticks(now);
+                }
+                source.enabled = (data != 0);
+                break;
+            case SR_TRAFFIC_COUNTER_ENABLE:
+                if ((data & 0x1) and not block.counter.enabled) {
+                    block.counter            = traffic_counter_t();
+                    block.counter.enabled    = true;
+                    block.counter.start_time = clock_type::now();
+                } else if (not(data & 0x1) and block.counter.enabled) {
+                    block.counter.bus_clock_ticks = get_counter_ticks(block.counter);
+                    block.counter.enabled         = false;
+                }
+                break;
+            default:
+                break;
+        }
+        _source_cond.notify_one();
+    }
+
+    uint64_t read_reg(const block_t& block) const
+    {
+        switch (block.readback_reg) {
+            case SR_READBACK_REG_ID:
+                return NULL_BLOCK_NOC_ID;
+            case SR_READBACK_REG_GLOBAL_PARAMS:
+                return (uint64_t(block.data_in_count) << 48)
+                       | (uint64_t(block.data_out_count) << 32);
+            case SR_READBACK_REG_FIFOSIZE:
+                return _config.fifo_size;
+            case SR_READBACK_REG_USER:
+                return read_user_reg(block);
+            case SR_READBACK_COMPAT:
+                return (uint64_t(NOC_SHELL_COMPAT_MAJOR) << 32) | NOC_SHELL_COMPAT_MINOR;
+            default:
+                return 0;
+        }
+    }
+
+    uint64_t read_user_reg(const block_t& block) const
+    {
+        if (block.user_rb_addr == RB_TRAFFIC_COUNTER_ID) {
+            return TRAFFIC_COUNTER_ID;
+        }
+        if (block.user_rb_addr == RB_TRAFFIC_COUNTER_ID + 1) {
+            return block.counter.enabled ? get_counter_ticks(block.counter)
+                                         : block.counter.bus_clock_ticks;
+        }
+        const size_t index = block.user_rb_addr - (RB_TRAFFIC_COUNTER_ID + 2);
+        if (block.user_rb_addr > RB_TRAFFIC_COUNTER_ID and index < NUM_TRAFFIC_COUNTS) {
+            return block.counter.counts[index];
+        }
+        return 0;
+    }
+
+    uint64_t get_ticks(const clock_type::time_point& time) const
+    {
+        return uint64_t(std::chrono::duration<double>(time - _start_time).count()
+                        * _config.bus_clk_rate);
+    }
+
+    clock_type::time_point get_time(const uint64_t ticks) const
+    {
+        return _start_time
+               + std::chrono::duration_cast<clock_type::duration>(
+                     std::chrono::duration<double>(ticks / _config.bus_clk_rate));
+    }
+
+    uint64_t get_counter_ticks(const traffic_counter_t& counter) const
+    {
+        return uint64_t(
+            std::chrono::duration<double>(clock_type::now() - counter.start_time).count()
+            * _config.bus_clk_rate);
+    }
+
+    /***********************************************************************
+     * Timed commands and null sources
+     **********************************************************************/
+    /*! Run the commands of \p block that are due, and send their ACKs
+     *
+     * Must be called with \p lock held, which is released while sending.
+     *
+     * \returns true if any command ran
+     */
+    bool run_due_cmds(block_t& block,
+        std::unique_lock<std::mutex>& lock,
+        clock_type::time_point& wake_time)
+    {
+        bool ran = false;
+        while (not block.cmd_fifo.empty()) {
+            const cmd_t cmd = block.cmd_fifo.front();
+            if (cmd.has_tsf and cmd.tsf > get_ticks(clock_type::now())) {
+                wake_time = std::min(wake_time, get_time(cmd.tsf));
+                break;
+            }
+            block.cmd_fifo.pop_front();
+            uint32_t resp[8];
+            vrt::if_packet_info_t resp_info;
+            resp_info.has_sid             = true;
+            resp_info.sid                 = cmd.sid.reversed().get();
+            resp_info.has_tsf             = false;
+            resp_info.num_payload_words32 = 2;
+            resp_info.num_payload_bytes   = 2 * sizeof(uint32_t);
+            run_cmd(block, cmd, resp, resp_info);
+            ran        = true;
+            auto route = _routes.find(uint16_t(cmd.sid.get_src()));
+            if (route == _routes.end()) {
+                continue;
+            }
+            const asio::ip::udp::endpoint dest = route->second;
+            const size_t resp_size = resp_info.num_packet_words32 * sizeof(uint32_t);
+            block.counter.count(SHELL_TO_XBAR_XFER, resp_size);
+            lock.unlock();
+            send(resp, resp_size, dest);
+            lock.lock();
+        }
+        return ran;
+    }
+
+    void source_loop(void)
+    {
+        std::vector<uint32_t> pkt(MAX_ETHERNET_MTU / sizeof(uint32_t), 0);
+        const size_t max_lines_per_pkt =
+            (MAX_ETHERNET_MTU - vrt::chdr::max_if_hdr_words64 * sizeof(uint64_t))
+            / BYTES_PER_LINE;
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (_running) {
+            const clock_type::time_point now = clock_type::now();
+            clock_type::time_point wake_time =
+                now + std::chrono::milliseconds(int(RECV_TIMEOUT * 1000));
+            bool sent = false;
+            for (block_t& block : _blocks) {
+                sent = run_due_cmds(block, lock, wake_time) or sent;
+                source_t& source = block.source;
+                if (not source.enabled or source.draining or not source.has_dst) {
+                    continue;
+                }
+                auto route = _routes.find(source.dst);
+                if (route == _routes.end()) {
+                    continue;
+                }
+                if (source.next_time > now) {
+                    wake_time = std::min(wake_time, source.next_time);
+                    continue;
+                }
+
+                const size_t lines =
+                    std::min<size_t>(source.lines_per_pkt, max_lines_per_pkt);
+                vrt::if_packet_info_t info;
+                info.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+                info.num_payload_words32 = lines * BYTES_PER_LINE / sizeof(uint32_t);
+                info.num_payload_bytes   = lines * BYTES_PER_LINE;
+                info.packet_count        = source.seq_num;
+                info.has_sid             = true;
+                info.sid                 = (uint32_t(block.address) << 16) | source.dst;
+                info.has_tsf             = true;
+                info.tsf                 = source.tsf;
+                vrt::chdr::if_hdr_pack_be(pkt.data(), info);
+                const size_t pkt_size = info.num_packet_words32 * sizeof(uint32_t);
+                if (not source.has_credit(pkt_size)) {
+                    // We get woken up by the next flow control packet
+                    continue;
+                }
+
+                // One line per (line_rate + 1) bus clock cycles
+                const uint64_t cycles = uint64_t(lines) * (source.line_rate + 1);
+                if (now - source.next_time > MAX_PACING_LAG) {
+                    source.next_time = now;
+                }
+                source.next_time += std::chrono::duration_cast<clock_type::duration>(
+                    std::chrono::duration<double>(cycles / _config.bus_clk_rate));
+                source.tsf += cycles;
+                source.seq_num++;
+                source.bytes_sent += uint32_t(pkt_size);
+                source.pkts_sent++;
+                block.data_out_count++;
+                block.counter.count(CE_TO_SHELL_XFER, pkt_size);
+                block.counter.count(SHELL_TO_XBAR_XFER, pkt_size);
+
+                const asio::ip::udp::endpoint dest = route->second;
+                lock.unlock();
+                send(pkt.data(), pkt_size, dest);
+                lock.lock();
+                sent = true;
+            }
+            if (not sent and _running) {
+                _source_cond.wait_until(lock, wake_time);
+            }
+        }
+    }
+
+    void send(
+        const uint32_t* pkt, const size_t num_bytes, const asio::ip::udp::endpoint& dest)
+    {
+        boost::system::error_code ec;
+        std::lock_guard<std::mutex> lock(_send_mutex);
+        _socket.send_to(asio::buffer(pkt, num_bytes), dest, 0, ec);
+        if (ec) {
+            UHD_LOG_DEBUG("SIM", "Error sending packet: " << ec.message());
+        }
+    }
+
+    const config_t _config;
+    std::vector<block_t> _blocks;
+    const clock_type::time_point _start_time;
+    //! Where to send packets for a host address
+    std::map<uint16_t, asio::ip::udp::endpoint> _routes;
+    //! Protects the blocks and routes
+    std::mutex _mutex;
+    //! Wakes up the source thread when block state changes
+    std::condition_variable _source_cond;
+
+    asio::io_service _io_service;
+    asio::ip::udp::socket _socket;
+    std::mutex _send_mutex;
+
+    std::atomic<bool> _running;
+    boost::thread _recv_thread;
+    boost::thread _source_thread;
+};
+
+sim_fpga::sptr sim_fpga::make(const config_t& config)
+{
+    return sptr(new sim_fpga_impl(config));
+}
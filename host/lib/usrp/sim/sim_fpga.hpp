@@ -0,0 +1,69 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_SIM_FPGA_HPP
+#define INCLUDED_SIM_FPGA_HPP
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <cstdint>
+#include <string>
+
+namespace uhd { namespace usrp { namespace sim {
+
+/*! A simulated RFNoC FPGA, which talks CHDR over a local UDP socket
+ *
+ * It has a crossbar with a number of null source/sink blocks (NoC ID 0) on
+ * it, and answers to the host the same way an FPGA would:
+ * - Control packets are ACKed, and register readbacks are answered
+ *   (NoC ID, compat number, FIFO sizes, traffic counters).
+ * - An enabled null source emits timestamped data packets, paced at the line
+ *   rate it was configured to, and only as far as its flow control window
+ *   allows.
+ * - A null sink drops all data, and sends flow control responses.
+ *
+ * - A timed command waits until the simulator's clock (which starts at 0 when
+ *   the simulator starts, and runs at the bus clock rate) reaches its time,
+ *   and the block's later commands wait for it, like in noc_shell. Its ACK
+ *   is sent when it runs.
+ *
+ * Packets are routed back to the host the same way as on an X300: A transport
+ * sends an 8-byte packet with a 0 word and its SID first, and the simulator
+ * sends everything for that SID's source address to the socket it came from.
+ */
+class sim_fpga : boost::noncopyable
+{
+public:
+    typedef boost::shared_ptr<sim_fpga> sptr;
+
+    struct config_t
+    {
+        //! Number of null source/sink blocks
+        size_t num_blocks;
+        //! Crossbar port of the first block
+        size_t first_xbar_port;
+        //! Crossbar address of the device
+        uint32_t dst_addr;
+        //! Bus clock rate, which paces the null sources and timestamps packets
+        double bus_clk_rate;
+        //! Size of each block's input buffer (i.e., flow control window), in bytes
+        size_t fifo_size;
+        //! Size of the simulator's socket buffers, in bytes
+        size_t buff_size;
+    };
+
+    virtual ~sim_fpga(void) {}
+
+    //! Return the UDP port that the simulator listens on (on 127.0.0.1)
+    virtual std::string get_udp_port(void) const = 0;
+
+    //! Start a simulator with the given configuration
+    static sptr make(const config_t& config);
+};
+
+}}} // namespace uhd::usrp::sim
+
+#endif /* INCLUDED_SIM_FPGA_HPP */
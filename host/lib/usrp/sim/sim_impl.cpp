@@ -0,0 +1,153 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "sim_impl.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/rfnoc/constants.hpp>
+#include <uhd/transport/udp_simple.hpp>
+#include <uhd/transport/udp_zero_copy.hpp>
+#include <uhd/utils/byteswap.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/static.hpp>
+#include <boost/format.hpp>
+
+using namespace uhd;
+using namespace uhd::usrp;
+using namespace uhd::usrp::sim;
+using namespace uhd::transport;
+
+/***********************************************************************
+ * Discovery
+ **********************************************************************/
+static device_addrs_t sim_find(const device_addr_t& hint)
+{
+    // The simulator is never found by accident, it must be asked for
+    device_addrs_t addrs;
+    if (hint.get("type", "") != "sim") {
+        return addrs;
+    }
+    device_addr_t new_addr = hint;
+    new_addr["type"]       = "sim";
+    new_addr["name"]       = "Simulator";
+    new_addr["serial"]     = "SIM0";
+    addrs.push_back(new_addr);
+    return addrs;
+}
+
+/***********************************************************************
+ * Make
+ **********************************************************************/
+static device::sptr sim_make(const device_addr_t& device_addr)
+{
+    return device::sptr(new sim_impl(device_addr));
+}
+
+UHD_STATIC_BLOCK(register_sim_device)
+{
+    device::register_device(&sim_find, &sim_make, device::USRP);
+}
+
+/***********************************************************************
+ * Structors
+ **********************************************************************/
+sim_impl::sim_impl(const device_addr_t& dev_addr) : _sid_framer(0)
+{
+    UHD_LOGGER_INFO("SIM") << "Initializing simulated device...";
+
+    sim_fpga::config_t config;
+    config.num_blocks      = dev_addr.cast<size_t>("num_blocks", DEFAULT_NUM_BLOCKS);
+    config.first_xbar_port = FIRST_XBAR_PORT;
+    config.dst_addr        = DST_ADDR;
+    config.bus_clk_rate = dev_addr.cast<double>("bus_clk_rate", DEFAULT_BUS_CLK_RATE);
+    config.fifo_size    = dev_addr.cast<size_t>("fifo_size", DEFAULT_FIFO_SIZE);
+    config.buff_size    = dev_addr.cast<size_t>("sim_buff_size", DEFAULT_BUFF_SIZE);
+    _fpga               = sim_fpga::make(config);
+
+    _tree->create<std::string>("/name").set("Simulated Device");
+    const fs_path mb_path = fs_path("/mboards") / 0;
+    _tree->create<std::string>(mb_path / "name").set("Simulator");
+    _tree->create<std::string>(mb_path / "codename").set("Sim");
+    _tree->create<double>(mb_path / "tick_rate").set(config.bus_clk_rate);
+
+    enumerate_rfnoc_blocks(0,
+        config.num_blocks,
+        FIRST_XBAR_PORT,
+        uhd::sid_t(SRC_ADDR, 0, DST_ADDR, 0),
+        dev_addr);
+}
+
+sim_impl::~sim_impl(void)
+{
+    // The block controllers talk to the simulator when they go away, so they
+    // go first
+    boost::lock_guard<boost::mutex> lock(_block_ctrl_mutex);
+    _rfnoc_block_ctrl.clear();
+}
+
+/***********************************************************************
+ * Transports
+ **********************************************************************/
+uhd::sid_t sim_impl::allocate_sid(const uhd::sid_t& address)
+{
+    std::lock_guard<std::mutex> lock(_sid_mutex);
+    uhd::sid_t sid = address;
+    sid.set_src_addr(SRC_ADDR);
+    sid.set_src_endpoint(_sid_framer++);
+    return sid;
+}
+
+uhd::both_xports_t sim_impl::make_transport(const uhd::sid_t& address,
+    const xport_type_t xport_type,
+    const uhd::device_addr_t& args)
+{
+    const uhd::device_addr_t& xport_args = (xport_type == CTRL) ? uhd::device_addr_t()
+                                                                : args;
+    both_xports_t xports;
+    xports.endianness = ENDIANNESS_BIG;
+    xports.lossless   = false;
+    xports.send_sid   = allocate_sid(address);
+    xports.recv_sid   = xports.send_sid.reversed();
+
+    zero_copy_xport_params default_buff_args;
+    default_buff_args.send_frame_size = udp_simple::mtu;
+    default_buff_args.recv_frame_size = udp_simple::mtu;
+    default_buff_args.num_send_frames = 1;
+    default_buff_args.num_recv_frames = 1;
+    default_buff_args.send_buff_size  = DEFAULT_BUFF_SIZE;
+    default_buff_args.recv_buff_size  = DEFAULT_BUFF_SIZE;
+    if (xport_type == CTRL) {
+        // ctrl_iface uses the number of recv frames to determine how many
+        // control packets can be in flight
+        default_buff_args.num_recv_frames =
+            uhd::rfnoc::CMD_FIFO_SIZE / uhd::rfnoc::MAX_CMD_PKT_SIZE;
+    } else if (xport_type == TX_DATA) {
+        default_buff_args.send_frame_size =
+            xport_args.cast<size_t>("send_frame_size", DATA_FRAME_SIZE);
+        default_buff_args.num_send_frames = DATA_NUM_FRAMES;
+    } else if (xport_type == RX_DATA) {
+        default_buff_args.recv_frame_size =
+            xport_args.cast<size_t>("recv_frame_size", DATA_FRAME_SIZE);
+        default_buff_args.num_recv_frames = DATA_NUM_FRAMES;
+    }
+
+    udp_zero_copy::buff_params buff_params;
+    xports.recv = udp_zero_copy::make(
+        "127.0.0.1", _fpga->get_udp_port(), default_buff_args, buff_params, xport_args);
+    xports.send           = xports.recv;
+    xports.recv_buff_size = buff_params.recv_buff_size;
+    xports.send_buff_size = buff_params.send_buff_size;
+
+    // Same as on the X300: A mini packet with the SID tells the simulator
+    // where to send the packets for this transport
+    UHD_LOGGER_TRACE("SIM") << "Registering new xport for sid " << xports.send_sid;
+    managed_send_buffer::sptr buff = xports.recv->get_send_buff();
+    buff->cast<uint32_t*>()[0]     = 0;
+    buff->cast<uint32_t*>()[1]     = uhd::htonx(xports.send_sid.get());
+    buff->commit(8);
+    buff.reset();
+
+    return xports;
+}
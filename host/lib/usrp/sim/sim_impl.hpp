@@ -0,0 +1,65 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_SIM_IMPL_HPP
+#define INCLUDED_SIM_IMPL_HPP
+
+#include "../device3/device3_impl.hpp"
+#include "sim_fpga.hpp"
+#include <uhd/types/device_addr.hpp>
+#include <uhd/types/sid.hpp>
+#include <mutex>
+
+namespace uhd { namespace usrp { namespace sim {
+
+//! Crossbar address of the host
+static const uint32_t SRC_ADDR = 0;
+//! Crossbar address of the simulated device
+static const uint32_t DST_ADDR = 2;
+//! The first crossbar port with a block on it
+static const size_t FIRST_XBAR_PORT = 1;
+
+static const size_t DEFAULT_NUM_BLOCKS   = 2;
+static const double DEFAULT_BUS_CLK_RATE = 187.5e6;
+static const size_t DEFAULT_FIFO_SIZE    = 0x10000; // Bytes
+static const size_t DEFAULT_BUFF_SIZE    = 0x30000; // Bytes, fits the default rmem_max
+static const size_t DATA_FRAME_SIZE      = 8000; // Bytes
+static const size_t DATA_NUM_FRAMES      = 32;
+
+}}} // namespace uhd::usrp::sim
+
+/*! A simulated RFNoC device, which needs no hardware
+ *
+ * It's a device3 like any other, but its transports go to a simulated FPGA on
+ * the loopback interface (see sim_fpga), which has nothing but null
+ * source/sink blocks. This makes it possible to measure, and profile, the
+ * host side of streaming (CHDR packing, flow control, converters and the
+ * transports) without a USRP.
+ *
+ * There are no radio or DSP blocks, so multi_usrp (and the tools built on it,
+ * like benchmark_rate) refuse this device. It's used through the device3 API,
+ * e.g. with benchmark_streamer.
+ */
+class sim_impl : public uhd::usrp::device3_impl
+{
+public:
+    sim_impl(const uhd::device_addr_t& dev_addr);
+    ~sim_impl(void);
+
+protected:
+    uhd::both_xports_t make_transport(const uhd::sid_t& address,
+        const xport_type_t xport_type,
+        const uhd::device_addr_t& args);
+
+private:
+    uhd::sid_t allocate_sid(const uhd::sid_t& address);
+
+    uhd::usrp::sim::sim_fpga::sptr _fpga;
+    std::mutex _sid_mutex;
+    uint32_t _sid_framer;
+};
+
+#endif /* INCLUDED_SIM_IMPL_HPP */
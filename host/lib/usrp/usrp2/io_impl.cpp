@@ -441,7 +441,9 @@ rx_streamer::sptr usrp2_impl::get_rx_stream(const uhd::stream_args_t &args_){
     id.num_inputs = 1;
     id.output_format = args.cpu_format;
     id.num_outputs = 1;
+    my_streamer->set_convert_worker_pool(convert_worker_pool::make(args.args));
     my_streamer->set_converter(id);
+    my_streamer->set_resampler(polyphase_resampler::make(args.channels.size(), args.args));
 
     //bind callbacks for the handler
     for (size_t chan_i = 0; chan_i < args.channels.size(); chan_i++){
@@ -510,7 +512,9 @@ tx_streamer::sptr usrp2_impl::get_tx_stream(const uhd::stream_args_t &args_){
     id.num_inputs = 1;
     id.output_format = args.otw_format + "_item32_be";
     id.num_outputs = 1;
+    my_streamer->set_convert_worker_pool(convert_worker_pool::make(args.args));
     my_streamer->set_converter(id);
+    my_streamer->set_resampler(polyphase_resampler::make(args.channels.size(), args.args));
 
     //bind callbacks for the handler
     for (size_t chan_i = 0; chan_i < args.channels.size(); chan_i++){
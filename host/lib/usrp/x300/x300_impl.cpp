@@ -24,6 +24,9 @@
 #include <uhd/utils/safe_call.hpp>
 #include <uhd/utils/static.hpp>
 #include <uhdlib/usrp/common/apply_corrections.hpp>
+#ifdef HAVE_XDP
+#    include <uhdlib/transport/xdp_zero_copy.hpp>
+#endif
 #include <boost/algorithm/string.hpp>
 #include <boost/asio.hpp>
 #include <boost/make_shared.hpp>
@@ -700,6 +703,8 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t& dev_addr)
             mb.recv_args[key] = dev_addr[key];
         if (key.find("send") != std::string::npos)
             mb.send_args[key] = dev_addr[key];
+        if (key == "use_xdp" or key.find("xdp_") == 0)
+            mb.xdp_args[key] = dev_addr[key];
     }
 
     // create basic communication
@@ -1424,15 +1429,40 @@ uhd::both_xports_t x300_impl::make_transport(const uhd::sid_t& address,
 
         // make a new transport - fpga has no idea how to talk to us on this yet
         udp_zero_copy::buff_params buff_params;
-        xports.recv = udp_zero_copy::make(conn.addr,
-            BOOST_STRINGIZE(X300_VITA_UDP_PORT),
-            default_buff_args,
-            buff_params,
-            xport_args);
+        bool use_xdp = false;
+        if ((xport_type == TX_DATA or xport_type == RX_DATA)
+            and mb.xdp_args.has_key("use_xdp")) {
+#ifdef HAVE_XDP
+            uhd::device_addr_t xdp_xport_args = xport_args;
+            for (const std::string& key : mb.xdp_args.keys()) {
+                if (not xdp_xport_args.has_key(key)) {
+                    xdp_xport_args[key] = mb.xdp_args[key];
+                }
+            }
+            xports.recv = xdp_zero_copy::make(conn.addr,
+                BOOST_STRINGIZE(X300_VITA_UDP_PORT),
+                default_buff_args,
+                buff_params,
+                xdp_xport_args);
+            use_xdp = true;
+#else
+            UHD_LOGGER_WARNING("X300")
+                << "use_xdp was given, but UHD was built without AF_XDP support. "
+                   "Using regular UDP sockets.";
+#endif
+        }
+        if (not use_xdp) {
+            xports.recv = udp_zero_copy::make(conn.addr,
+                BOOST_STRINGIZE(X300_VITA_UDP_PORT),
+                default_buff_args,
+                buff_params,
+                xport_args);
+        }
 
         // Create a threaded transport for the receive chain only
-        // Note that this shouldn't affect PCIe
-        if (xport_type == RX_DATA) {
+        // Note that this shouldn't affect PCIe. AF_XDP reads its rings
+        // without system calls, so it does not need the offload thread.
+        if (xport_type == RX_DATA and not use_xdp) {
             xports.recv = zero_copy_recv_offload::make(
                 xports.recv, x300::RECV_OFFLOAD_BUFFER_TIMEOUT);
         }
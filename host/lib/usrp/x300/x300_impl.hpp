@@ -116,6 +116,7 @@ private:
 
         uhd::device_addr_t send_args;
         uhd::device_addr_t recv_args;
+        uhd::device_addr_t xdp_args;
         bool if_pkt_is_big_endian;
         uhd::niusrprio::niusrprio_session::sptr rio_fpga_interface;
 
@@ -11,14 +11,22 @@
 #include <uhd/utils/paths.hpp>
 #include <uhd/transport/bounded_buffer.hpp>
 #include <uhd/version.hpp>
+#include <uhdlib/transport/spsc_queue.hpp>
+#include <boost/date_time/c_local_time_adjustor.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/format.hpp>
 #include <boost/make_shared.hpp>
 #include <fstream>
 #include <cctype>
+#include <cstring>
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
 #include <memory>
 #include <thread>
+#include <vector>
 
 namespace pt = boost::posix_time;
 
@@ -79,6 +87,92 @@ namespace {
         return path.substr(path.find_last_of("/\\") + 1);
     }
 
+    //! Number of records in the fast log queue of each thread
+    constexpr size_t FAST_LOG_QUEUE_SIZE = 1024;
+
+    //! How often the logging thread checks the fast log queues
+    constexpr std::chrono::milliseconds FAST_LOG_POLL_PERIOD(10);
+
+    //! A thread's queue of UHD_LOG_FAST and UHD_LOG_FASTPATH records
+    struct fast_log_queue_t
+    {
+        fast_log_queue_t()
+            : records(FAST_LOG_QUEUE_SIZE)
+            , thread_id(boost::this_thread::get_id())
+            , orphaned(false)
+            , num_dropped(0)
+            , num_reported(0)
+        {
+        }
+
+        uhd::transport::spsc_queue<uhd::_log::fast_log_record> records;
+        const boost::thread::id thread_id;
+        //! Set when the thread exits, the queue is removed once it's empty
+        std::atomic<bool> orphaned;
+        //! Number of records that didn't fit into the queue
+        std::atomic<size_t> num_dropped;
+        //! Value of num_dropped that was last logged (logging thread only)
+        size_t num_reported;
+    };
+
+    //! The owner of a thread's queue, marks it orphaned when the thread exits
+    struct fast_log_queue_owner_t
+    {
+        ~fast_log_queue_owner_t()
+        {
+            if (queue) {
+                queue->orphaned = true;
+            }
+        }
+
+        std::shared_ptr<fast_log_queue_t> queue;
+    };
+
+    //! A UHD_LOG_FAST call site
+    struct fast_log_site_t
+    {
+        uhd::log::severity_level level;
+        std::string component;
+        std::string format;
+        std::string file;
+        unsigned int line;
+    };
+
+    //! Turn a fast log record into a message
+    std::string format_fast_log(
+        const fast_log_site_t& site, const uhd::_log::fast_log_record& record)
+    {
+        typedef uhd::_log::fast_log_record record_t;
+        try {
+            boost::format message(site.format);
+            for (size_t i = 0; i < record.num_args; i++) {
+                switch (record.arg_types[i]) {
+                    case record_t::ARG_INT: {
+                        int64_t value;
+                        std::memcpy(&value, &record.args[i], sizeof(value));
+                        message % value;
+                        break;
+                    }
+                    case record_t::ARG_DOUBLE: {
+                        double value;
+                        std::memcpy(&value, &record.args[i], sizeof(value));
+                        message % value;
+                        break;
+                    }
+                    case record_t::ARG_BOOL:
+                        message % (record.args[i] != 0);
+                        break;
+                    default:
+                        message % record.args[i];
+                        break;
+                }
+            }
+            return message.str();
+        } catch (const boost::io::format_error& ex) {
+            return site.format + " (invalid log format: " + ex.what() + ")";
+        }
+    }
+
 }
 
 /***********************************************************************
@@ -172,9 +266,8 @@ public:
     log_resource(void):
         global_level(uhd::log::off),
         _exit(false),
-#ifndef UHD_LOG_FASTPATH_DISABLE
-        _fastpath_queue(10),
-#endif
+        _fastpath_enabled(true),
+        _fast_log_sites(1), // Site 0 is UHD_LOG_FASTPATH
         _log_queue(10)
     {
         //allow override from macro definition
@@ -212,27 +305,12 @@ public:
             std::thread([this](){this->pop_task();})
         );
 
-        // Fastpath message consumer
+        // Fastpath and fast log message consumer
 #ifndef UHD_LOG_FASTPATH_DISABLE
         //allow override from environment variables
-        const bool enable_fastpath = [](){
-            const char* disable_fastpath_env =
-                std::getenv("UHD_LOG_FASTPATH_DISABLE");
-            if (disable_fastpath_env != NULL
-                    && disable_fastpath_env[0] != '\0') {
-                return false;
-            }
-            return true;
-        }();
-
-        if (enable_fastpath) {
-            _pop_fastpath_task = std::make_shared<std::thread>(
-                std::thread([this](){this->pop_fastpath_task();})
-            );
-        } else {
-            _pop_fastpath_task = std::make_shared<std::thread>(
-                std::thread([this](){this->pop_fastpath_dummy_task();})
-            );
+        const char* disable_fastpath_env = std::getenv("UHD_LOG_FASTPATH_DISABLE");
+        if (disable_fastpath_env != NULL && disable_fastpath_env[0] != '\0') {
+            _fastpath_enabled = false;
             _publish_log_msg("Fastpath logging disabled at runtime.");
         }
 #else
@@ -240,6 +318,9 @@ public:
             _publish_log_msg("Fastpath logging disabled at compile time.");
         }
 #endif
+        _pop_fast_log_task = std::make_shared<std::thread>(
+            std::thread([this](){this->pop_fast_log_task();})
+        );
     }
 
     ~log_resource(void){
@@ -257,19 +338,18 @@ public:
         );
         final_message.message = "";
         push(final_message);
-#ifndef UHD_LOG_FASTPATH_DISABLE
-        push_fastpath("");
-#endif
+        {
+            std::lock_guard<std::mutex> l(_fast_log_wait_mutex);
+            _fast_log_cond.notify_one();
+        }
         _pop_task->join();
+        _pop_fast_log_task->join();
         {
             std::lock_guard<std::mutex> l(_logmap_mutex);
             _loggers.clear();
         }
         _pop_task.reset();
-#ifndef UHD_LOG_FASTPATH_DISABLE
-        _pop_fastpath_task->join();
-        _pop_fastpath_task.reset();
-#endif
+        _pop_fast_log_task.reset();
     }
 
     void push(const uhd::log::logging_info& log_info)
@@ -278,14 +358,30 @@ public:
         _log_queue.push_with_timed_wait(log_info, PUSH_TIMEOUT);
     }
 
-#ifndef UHD_LOG_FASTPATH_DISABLE
-    void push_fastpath(const std::string &message)
+    //! Queue a fast log record on this thread's queue
+    void push_fast_log(uhd::_log::fast_log_record& record)
+    {
+        // Each thread gets its own queue the first time it logs
+        static thread_local fast_log_queue_owner_t owner;
+        if (not owner.queue) {
+            owner.queue = std::make_shared<fast_log_queue_t>();
+            std::lock_guard<std::mutex> l(_fast_log_mutex);
+            _fast_log_queues.push_back(owner.queue);
+        }
+        record.time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        // Never wait. If the queue is full, the record is counted and dropped.
+        if (not owner.queue->records.push_with_haste(record)) {
+            owner.queue->num_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    uint32_t register_fast_log_site(const fast_log_site_t& site)
     {
-        // Never wait. If the buffer is full, we just don't see the message.
-        // Too bad.
-        _fastpath_queue.push_with_haste(message);
+        std::lock_guard<std::mutex> l(_fast_log_mutex);
+        _fast_log_sites.push_back(std::make_shared<fast_log_site_t>(site));
+        return uint32_t(_fast_log_sites.size() - 1);
     }
-#endif
 
     void _handle_log_info(const uhd::log::logging_info& log_info)
     {
@@ -321,33 +417,105 @@ public:
         // Terminate this thread.
     }
 
-    void pop_fastpath_task()
+    void pop_fast_log_task()
     {
-#ifndef UHD_LOG_FASTPATH_DISABLE
-        std::string msg;
+        // The producers never wake us up, that would cost them a system call.
+        // Instead, we poll the queues.
         while (!_exit) {
-            _fastpath_queue.pop_with_wait(msg);
-            std::cerr << msg << std::flush;
+            if (not _handle_fast_logs()) {
+                std::unique_lock<std::mutex> l(_fast_log_wait_mutex);
+                _fast_log_cond.wait_for(
+                    l, FAST_LOG_POLL_PERIOD, [this]() { return _exit.load(); });
+            }
         }
 
-        // Exit procedure: Clear the queue
-        while (_fastpath_queue.pop_with_haste(msg)) {
-            std::cerr << msg << std::flush;
-        }
-#endif
+        // Exit procedure: Clear the queues
+        _handle_fast_logs();
     }
 
-    void pop_fastpath_dummy_task()
+    /*! Empty all fast log queues, and handle their records in time order
+     *
+     * \returns true if there were any records
+     */
+    bool _handle_fast_logs()
     {
-#ifndef UHD_LOG_FASTPATH_DISABLE
-        std::string msg;
-        while (!_exit) {
-            _fastpath_queue.pop_with_wait(msg);
+        typedef std::pair<uhd::_log::fast_log_record, boost::thread::id> entry_t;
+        std::vector<std::shared_ptr<fast_log_queue_t>> queues;
+        {
+            std::lock_guard<std::mutex> l(_fast_log_mutex);
+            queues = _fast_log_queues;
+            if (_site_cache.size() != _fast_log_sites.size()) {
+                _site_cache = _fast_log_sites;
+            }
         }
 
-        // Exit procedure: Clear the queue
-        while (_fastpath_queue.pop_with_haste(msg));
-#endif
+        std::vector<entry_t> entries;
+        uhd::_log::fast_log_record record;
+        for (const auto& queue : queues) {
+            // Check first, so nothing can be pushed after the last pop
+            const bool orphaned = queue->orphaned;
+            while (queue->records.pop_with_haste(record)) {
+                entries.push_back(entry_t(record, queue->thread_id));
+            }
+            const size_t num_dropped = queue->num_dropped;
+            if (num_dropped != queue->num_reported) {
+                auto log_info = uhd::log::logging_info(
+                    pt::microsec_clock::local_time(),
+                    uhd::log::warning,
+                    __FILE__,
+                    __LINE__,
+                    "LOGGING",
+                    queue->thread_id);
+                log_info.message = str(
+                    boost::format("Dropped %d fast log messages, the queue was full")
+                    % (num_dropped - queue->num_reported));
+                _handle_log_info(log_info);
+                queue->num_reported = num_dropped;
+            }
+            if (orphaned) {
+                std::lock_guard<std::mutex> l(_fast_log_mutex);
+                _fast_log_queues.erase(std::remove(_fast_log_queues.begin(),
+                                           _fast_log_queues.end(),
+                                           queue),
+                    _fast_log_queues.end());
+            }
+        }
+
+        std::stable_sort(entries.begin(),
+            entries.end(),
+            [](const entry_t& lhs, const entry_t& rhs) {
+                return lhs.first.time_ns < rhs.first.time_ns;
+            });
+        for (const entry_t& entry : entries) {
+            _handle_fast_log(entry.first, entry.second);
+        }
+        return not entries.empty();
+    }
+
+    void _handle_fast_log(
+        const uhd::_log::fast_log_record& record, const boost::thread::id& thread_id)
+    {
+        if (record.site == 0) {
+            if (_fastpath_enabled) {
+                std::cerr << std::string(
+                                 reinterpret_cast<const char*>(record.args),
+                                 record.num_args)
+                          << std::flush;
+            }
+            return;
+        }
+        const fast_log_site_t& site = *_site_cache.at(record.site);
+        const pt::ptime utc_time    = pt::from_time_t(0)
+                                   + pt::microseconds(record.time_ns / 1000);
+        auto log_info = uhd::log::logging_info(
+            boost::date_time::c_local_adjustor<pt::ptime>::utc_to_local(utc_time),
+            site.level,
+            site.file,
+            site.line,
+            site.component,
+            thread_id);
+        log_info.message = format_fast_log(site, record);
+        _handle_log_info(log_info);
     }
 
     void add_logger(
@@ -368,9 +536,7 @@ public:
 
 private:
     std::shared_ptr<std::thread> _pop_task;
-#ifndef UHD_LOG_FASTPATH_DISABLE
-    std::shared_ptr<std::thread> _pop_fastpath_task;
-#endif
+    std::shared_ptr<std::thread> _pop_fast_log_task;
     uhd::log::severity_level _get_log_level(const std::string &log_level_str,
                                             const uhd::log::severity_level &previous_level){
         if (std::isdigit(log_level_str[0])) {
@@ -470,9 +636,15 @@ private:
     using level_logfn_pair =
         std::pair<uhd::log::severity_level, uhd::log::log_fn_t>;
     std::map<std::string, level_logfn_pair> _loggers;
-#ifndef UHD_LOG_FASTPATH_DISABLE
-    uhd::transport::bounded_buffer<std::string> _fastpath_queue;
-#endif
+    bool _fastpath_enabled;
+    //! Protects _fast_log_queues and _fast_log_sites
+    std::mutex _fast_log_mutex;
+    std::vector<std::shared_ptr<fast_log_queue_t>> _fast_log_queues;
+    std::vector<std::shared_ptr<const fast_log_site_t>> _fast_log_sites;
+    //! Copy of _fast_log_sites for the logging thread
+    std::vector<std::shared_ptr<const fast_log_site_t>> _site_cache;
+    std::mutex _fast_log_wait_mutex;
+    std::condition_variable _fast_log_cond;
     uhd::transport::bounded_buffer<uhd::log::logging_info> _log_queue;
 };
 
@@ -515,7 +687,11 @@ uhd::_log::log::~log(void)
 #ifndef UHD_LOG_FASTPATH_DISABLE
 void uhd::_log::log_fastpath(const std::string &msg)
 {
-    log_rs().push_fastpath(msg);
+    uhd::_log::fast_log_record record;
+    record.site = 0;
+    record.num_args = uint8_t(std::min(msg.size(), sizeof(record.args)));
+    std::memcpy(record.args, msg.data(), record.num_args);
+    log_rs().push_fast_log(record);
 }
 #else
 void uhd::_log::log_fastpath(const std::string &)
@@ -524,6 +700,24 @@ void uhd::_log::log_fastpath(const std::string &)
 }
 #endif
 
+uint32_t uhd::_log::register_fast_log_site(const uhd::log::severity_level level,
+    const char* component,
+    const char* format,
+    const char* file,
+    const unsigned int line)
+{
+    return log_rs().register_fast_log_site(
+        fast_log_site_t{level, component, format, file, line});
+}
+
+void uhd::_log::push_fast_log(
+    const uhd::log::severity_level level, uhd::_log::fast_log_record& record)
+{
+    if (level >= log_rs().global_level) {
+        log_rs().push_fast_log(record);
+    }
+}
+
 /***********************************************************************
  * Public API calls
  **********************************************************************/
@@ -0,0 +1,391 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhdlib/utils/reactor.hpp>
+#include <boost/lexical_cast.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+#ifdef HAVE_EPOLL
+#    include <sys/epoll.h>
+#    include <sys/eventfd.h>
+#    include <unistd.h>
+#    include <cerrno>
+#    include <cstring>
+#endif /* HAVE_EPOLL */
+
+using namespace uhd;
+
+namespace {
+//! Number of threads of the shared reactor, unless set by UHD_REACTOR_THREADS
+constexpr size_t DEFAULT_NUM_THREADS = 2;
+
+typedef std::chrono::steady_clock clock_type;
+
+//! A registered callback
+struct entry_t
+{
+    entry_t(const std::string& name_,
+        const reactor::callback_type& callback_,
+        const int fd_,
+        const clock_type::duration period_)
+        : name(name_), callback(callback_), fd(fd_), period(period_)
+    {
+    }
+
+    const std::string name;
+    const reactor::callback_type callback;
+    //! File descriptor to wait for, or -1 for a periodic callback
+    const int fd;
+    const clock_type::duration period;
+
+    //! Held while the callback runs, so it never runs twice at once
+    std::mutex run_mutex;
+    //! Cleared when the entry is removed (protected by run_mutex)
+    bool active = true;
+    //! Thread that's currently running the callback, if any
+    std::atomic<std::thread::id> running_in{std::thread::id()};
+};
+
+typedef std::shared_ptr<entry_t> entry_sptr;
+typedef std::pair<clock_type::time_point, entry_sptr> deadline_t;
+} // namespace
+
+class reactor_impl : public reactor, public std::enable_shared_from_this<reactor_impl>
+{
+public:
+    reactor_impl(const size_t num_threads)
+    {
+#ifdef HAVE_EPOLL
+        _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        _event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (_epoll_fd < 0 or _event_fd < 0) {
+            throw uhd::os_error(
+                std::string("reactor: Could not create epoll instance: ")
+                + std::strerror(errno));
+        }
+        // The wake-up event is level triggered and has no entry
+        epoll_event event;
+        event.events   = EPOLLIN;
+        event.data.ptr = nullptr;
+        epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _event_fd, &event);
+#endif /* HAVE_EPOLL */
+        for (size_t i = 0; i < std::max<size_t>(num_threads, 1); i++) {
+            _threads.push_back(std::thread([this]() { this->worker_loop(); }));
+        }
+    }
+
+    ~reactor_impl(void)
+    {
+        _exit = true;
+        _wake(true);
+        for (std::thread& thread : _threads) {
+            // A callback might drop the last reference to its own reactor
+            if (thread.get_id() == std::this_thread::get_id()) {
+                thread.detach();
+            } else {
+                thread.join();
+            }
+        }
+#ifdef HAVE_EPOLL
+        close(_event_fd);
+        close(_epoll_fd);
+#endif /* HAVE_EPOLL */
+    }
+
+    // The arguments are unused when the reactor only runs timers
+    task::sptr add_fd(UHD_UNUSED(const int fd),
+        UHD_UNUSED(const callback_type& callback),
+        UHD_UNUSED(const std::string& name))
+    {
+#ifdef HAVE_EPOLL
+        auto entry = std::make_shared<entry_t>(name, callback, fd, clock_type::duration());
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _fd_entries[entry.get()] = entry;
+        }
+        // One-shot, so only one thread gets the event until we re-arm
+        epoll_event event;
+        event.events   = EPOLLIN | EPOLLONESHOT;
+        event.data.ptr = entry.get();
+        if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _fd_entries.erase(entry.get());
+            throw uhd::os_error(
+                std::string("reactor: Could not add file descriptor: ")
+                + std::strerror(errno));
+        }
+        return task::sptr(new reactor_task(shared_from_this(), entry));
+#else
+        return task::sptr();
+#endif /* HAVE_EPOLL */
+    }
+
+    task::sptr add_periodic(const std::chrono::milliseconds period,
+        const std::function<void(void)>& callback,
+        const std::string& name)
+    {
+        auto entry = std::make_shared<entry_t>(
+            name, [callback]() { callback(); return false; }, -1, period);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _timers.push(deadline_t(clock_type::now(), entry));
+        }
+        _wake(false);
+        return task::sptr(new reactor_task(shared_from_this(), entry));
+    }
+
+    //! Stop calling the callback of \p entry
+    void remove(const entry_sptr& entry)
+    {
+#ifdef HAVE_EPOLL
+        if (entry->fd >= 0) {
+            epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, entry->fd, nullptr);
+            std::lock_guard<std::mutex> lock(_mutex);
+            _fd_entries.erase(entry.get());
+        }
+#endif /* HAVE_EPOLL */
+        // Timers stay in the queue until they're due, and then get dropped.
+        // If the callback removes itself, we already hold its run_mutex.
+        if (entry->running_in.load() == std::this_thread::get_id()) {
+            entry->active = false;
+            return;
+        }
+        std::lock_guard<std::mutex> lock(entry->run_mutex);
+        entry->active = false;
+    }
+
+private:
+    //! Keeps an entry registered for as long as it's alive
+    class reactor_task : public task
+    {
+    public:
+        reactor_task(std::shared_ptr<reactor_impl> reactor, entry_sptr entry)
+            : _reactor(reactor), _entry(entry)
+        {
+        }
+
+        ~reactor_task(void)
+        {
+            _reactor->remove(_entry);
+        }
+
+    private:
+        std::shared_ptr<reactor_impl> _reactor;
+        entry_sptr _entry;
+    };
+
+    void worker_loop(void)
+    {
+        while (not _exit) {
+            size_t generation;
+            const int timeout_ms = _run_due_timers(generation);
+            _wait_and_run(timeout_ms, generation);
+        }
+    }
+
+    /*! Run the callback of \p entry until it returns false
+     *
+     * Must be called with the entry's run_mutex held.
+     * \returns false if the entry was removed, or threw
+     */
+    bool _run_locked(const entry_sptr& entry)
+    {
+        if (not entry->active) {
+            return false;
+        }
+        entry->running_in = std::this_thread::get_id();
+        try {
+            while (entry->callback() and entry->active and not _exit) {
+            }
+        } catch (const std::exception& e) {
+            UHD_LOGGER_ERROR("UHD")
+                << "An unexpected exception was caught in reactor task "
+                << (entry->name.empty() ? "" : "`" + entry->name + "' ")
+                << "and it won't run again, things may not work. " << e.what();
+            entry->active = false;
+        }
+        entry->running_in = std::thread::id();
+        return entry->active;
+    }
+
+    /*! Run all timers that are due
+     *
+     * \param generation Set to the wake-up count when the timers were checked
+     * \returns milliseconds until the next timer is due, or -1 if there's none
+     */
+    int _run_due_timers(size_t& generation)
+    {
+        generation = 0;
+        while (not _exit) {
+            entry_sptr entry;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                generation = _generation;
+                if (_timers.empty()) {
+                    return -1;
+                }
+                const auto now = clock_type::now();
+                if (_timers.top().first > now) {
+                    // Round up, or we'd wake up before it's due
+                    return int(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                   _timers.top().first - now
+                                   + std::chrono::milliseconds(1))
+                                   .count());
+                }
+                entry = _timers.top().second;
+                _timers.pop();
+            }
+            std::lock_guard<std::mutex> run_lock(entry->run_mutex);
+            if (_run_locked(entry)) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _timers.push(deadline_t(clock_type::now() + entry->period, entry));
+            }
+        }
+        return -1;
+    }
+
+#ifdef HAVE_EPOLL
+    //! Wait for up to \p timeout_ms for one event and handle it
+    void _wait_and_run(const int timeout_ms, const size_t)
+    {
+        // Only take one event, so a slow callback doesn't hold up events that
+        // another thread could handle
+        epoll_event event;
+        if (epoll_wait(_epoll_fd, &event, 1, timeout_ms) != 1 or _exit) {
+            return;
+        }
+        if (event.data.ptr == nullptr) {
+            // Wake-up, so the timers get checked again
+            uint64_t count;
+            if (read(_event_fd, &count, sizeof(count)) < 0) {
+                // Another thread got it first
+            }
+            return;
+        }
+        entry_sptr entry;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _fd_entries.find(static_cast<entry_t*>(event.data.ptr));
+            if (it == _fd_entries.end()) {
+                return;
+            }
+            entry = it->second;
+        }
+        std::lock_guard<std::mutex> run_lock(entry->run_mutex);
+        if (_run_locked(entry)) {
+            // Re-arm while holding run_mutex, so this can't race with remove()
+            epoll_event rearm;
+            rearm.events   = EPOLLIN | EPOLLONESHOT;
+            rearm.data.ptr = entry.get();
+            epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, entry->fd, &rearm);
+        }
+    }
+
+    //! Make a worker re-check the timers, or all of them if \p all is true
+    void _wake(const bool all)
+    {
+        // When exiting, the event is never read, so every thread sees it
+        const uint64_t count = 1;
+        if (write(_event_fd, &count, sizeof(count)) < 0 and not all) {
+            UHD_LOG_WARNING("UHD", "reactor: Could not wake up worker thread");
+        }
+    }
+#else
+    //! Wait for up to \p timeout_ms, or until _wake() was called after \p generation
+    void _wait_and_run(const int timeout_ms, const size_t generation)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        auto woken = [this, generation]() {
+            return _exit or _generation != generation;
+        };
+        if (timeout_ms < 0) {
+            _cond.wait(lock, woken);
+        } else {
+            _cond.wait_for(lock, std::chrono::milliseconds(timeout_ms), woken);
+        }
+    }
+
+    //! Make a worker re-check the timers, or all of them if \p all is true
+    void _wake(const bool all)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _generation++;
+        }
+        if (all) {
+            _cond.notify_all();
+        } else {
+            _cond.notify_one();
+        }
+    }
+#endif /* HAVE_EPOLL */
+
+    std::atomic<bool> _exit{false};
+    //! Protects _timers, _fd_entries and _generation
+    std::mutex _mutex;
+    std::priority_queue<deadline_t, std::vector<deadline_t>, std::greater<deadline_t>> _timers;
+    std::map<entry_t*, entry_sptr> _fd_entries;
+    //! Bumped by _wake(), so a wake-up between checking the timers and
+    //  waiting isn't lost (only needed without epoll)
+    size_t _generation = 0;
+#ifdef HAVE_EPOLL
+    int _epoll_fd = -1;
+    int _event_fd = -1;
+#else
+    std::condition_variable _cond;
+#endif /* HAVE_EPOLL */
+    std::vector<std::thread> _threads;
+};
+
+reactor::sptr reactor::make(const size_t num_threads)
+{
+    return std::make_shared<reactor_impl>(num_threads);
+}
+
+reactor::sptr reactor::get(void)
+{
+    static std::mutex instance_mutex;
+    static reactor::sptr instance;
+    std::lock_guard<std::mutex> lock(instance_mutex);
+    if (not instance) {
+        size_t num_threads = DEFAULT_NUM_THREADS;
+        const char* num_threads_env = std::getenv("UHD_REACTOR_THREADS");
+        if (num_threads_env != nullptr) {
+            try {
+                num_threads = boost::lexical_cast<size_t>(num_threads_env);
+            } catch (const boost::bad_lexical_cast&) {
+                UHD_LOG_WARNING("UHD",
+                    "Invalid value for UHD_REACTOR_THREADS: " << num_threads_env);
+            }
+        }
+        instance = make(num_threads);
+    }
+    return instance;
+}
+
+task::sptr uhd::make_recv_task(transport::zero_copy_if::sptr xport,
+    const std::function<bool(double)>& handler,
+    const std::string& name)
+{
+    const int fd = xport->get_recv_fd();
+    if (fd >= 0) {
+        task::sptr task =
+            reactor::get()->add_fd(fd, [handler]() { return handler(0.0); }, name);
+        if (task) {
+            return task;
+        }
+    }
+    return task::make([handler]() { handler(0.1); }, name);
+}
@@ -0,0 +1,113 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/rfnoc/blockdef.hpp>
+#include <uhd/rfnoc/constants.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+
+using namespace uhd::rfnoc;
+namespace fs = boost::filesystem;
+
+/***********************************************************************
+ * The index is read from UHD_RFNOC_INDEX once per process, so this test
+ * has a process of its own, and sets up the environment before the first
+ * lookup.
+ **********************************************************************/
+static const uint64_t NOC_ID_A = 0xA0A0000000000000;
+static const uint64_t NOC_ID_B = 0xB0B0000000000000;
+static const uint64_t NOC_ID_C = 0xC0C0000000000000;
+
+static void write_blockdef(const fs::path& file, const std::string& name, const uint64_t noc_id)
+{
+    std::ofstream out(file.string().c_str());
+    out << "<nocblock><name>" << name << "</name><blockname>" << name
+        << "</blockname><key>Block</key><ids><id revision=\"0\">" << std::hex
+        << std::uppercase << noc_id << "</id></ids><ports><sink><name>in0</name></sink>"
+        << "<source><name>out0</name></source></ports></nocblock>\n";
+}
+
+static std::string read_file(const fs::path& file)
+{
+    std::ifstream in(file.string().c_str());
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+//! Index files that were touched just now are not stored, so backdate them
+static void backdate(const fs::path& path, const std::time_t age)
+{
+    fs::last_write_time(path, std::time(NULL) - age);
+}
+
+BOOST_AUTO_TEST_CASE(test_blockdef_index_load_save)
+{
+    const fs::path base_dir = fs::temp_directory_path() / fs::unique_path();
+    const fs::path blocks_dir = base_dir / "blocks";
+    const fs::path index_file = base_dir / "index";
+    fs::create_directories(blocks_dir);
+    write_blockdef(blocks_dir / "a.xml", "BlockA", NOC_ID_A);
+    write_blockdef(blocks_dir / "b.xml", "BlockB", NOC_ID_B);
+    backdate(blocks_dir / "a.xml", 100);
+    backdate(blocks_dir / "b.xml", 100);
+    backdate(blocks_dir, 100);
+
+    // A stored index says b.xml defines block C. It's up to date, so it's
+    // trusted and b.xml is not read.
+    {
+        std::ofstream out(index_file.string().c_str());
+        out << "dir\t" << fs::last_write_time(blocks_dir) << "\t" << blocks_dir.string()
+            << "\n"
+            << "file\t" << fs::last_write_time(blocks_dir / "a.xml")
+            << "\ta.xml\tA0A0000000000000\n"
+            << "file\t" << fs::last_write_time(blocks_dir / "b.xml")
+            << "\tb.xml\tC0C0000000000000\n";
+    }
+    ::setenv(XML_PATH_ENV.c_str(), base_dir.string().c_str(), 1);
+    ::setenv(XML_INDEX_ENV.c_str(), index_file.string().c_str(), 1);
+
+    blockdef::sptr block_a = blockdef::make_from_noc_id(NOC_ID_A);
+    BOOST_REQUIRE(block_a);
+    BOOST_CHECK_EQUAL(block_a->get_name(), "BlockA");
+    BOOST_CHECK(not blockdef::make_from_noc_id(NOC_ID_B));
+    blockdef::sptr block_c = blockdef::make_from_noc_id(NOC_ID_C);
+    BOOST_REQUIRE(block_c);
+    BOOST_CHECK_EQUAL(block_c->get_name(), "BlockB");
+
+    // A new file changes the directory, so it's read again and the index is
+    // stored with the real contents
+    write_blockdef(blocks_dir / "c.xml", "BlockC", NOC_ID_C);
+    backdate(blocks_dir / "c.xml", 50);
+    backdate(blocks_dir, 50);
+    block_c = blockdef::make_from_noc_id(NOC_ID_C);
+    BOOST_REQUIRE(block_c);
+    BOOST_CHECK_EQUAL(block_c->get_name(), "BlockC");
+    blockdef::sptr block_b = blockdef::make_from_noc_id(NOC_ID_B);
+    BOOST_REQUIRE(block_b);
+    BOOST_CHECK_EQUAL(block_b->get_name(), "BlockB");
+
+    const std::string index = read_file(index_file);
+    BOOST_TEST_MESSAGE(index);
+    BOOST_CHECK(index.find("\tb.xml\tB0B0000000000000\n") != std::string::npos);
+    BOOST_CHECK(index.find("\tc.xml\tC0C0000000000000\n") != std::string::npos);
+
+    // Only the index itself is left, no temporary files
+    size_t num_files = 0;
+    for (fs::directory_iterator it(base_dir); it != fs::directory_iterator(); ++it) {
+        if (fs::is_regular_file(it->path())) {
+            BOOST_CHECK_EQUAL(it->path(), index_file);
+            num_files++;
+        }
+    }
+    BOOST_CHECK_EQUAL(num_files, 1);
+
+    fs::remove_all(base_dir);
+}
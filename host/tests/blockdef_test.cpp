@@ -6,9 +6,13 @@
 //
 
 #include <uhd/rfnoc/blockdef.hpp>
+#include <uhd/rfnoc/constants.hpp>
 #include <stdint.h>
+#include <boost/filesystem.hpp>
 #include <boost/format.hpp>
 #include <boost/test/unit_test.hpp>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <map>
 
@@ -81,3 +85,59 @@ BOOST_AUTO_TEST_CASE(test_regs)
     BOOST_CHECK_EQUAL(user_regs["RB_FFT_RESET"], 0);
     BOOST_CHECK_EQUAL(user_regs["RB_MAGNITUDE_OUT"], 1);
 }
+
+namespace {
+//! Set an environment variable, or remove it if value is empty
+void set_env(const std::string& name, const std::string& value)
+{
+#ifdef UHD_PLATFORM_WIN32
+    _putenv_s(name.c_str(), value.c_str());
+#else
+    if (value.empty()) {
+        unsetenv(name.c_str());
+    } else {
+        setenv(name.c_str(), value.c_str(), 1);
+    }
+#endif
+}
+
+void write_blockdef(const boost::filesystem::path& filename,
+    const std::string& name,
+    const std::string& noc_id)
+{
+    std::ofstream out(filename.string().c_str());
+    out << "<nocblock><name>" << name << "</name><blockname>" << name
+        << "</blockname><ids><id revision=\"0\">" << noc_id
+        << "</id></ids><ports><sink><name>in</name></sink>"
+           "<source><name>out</name></source></ports></nocblock>\n";
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_index_update)
+{
+    namespace fs = boost::filesystem;
+    const fs::path base_path =
+        fs::temp_directory_path() / fs::unique_path("blockdef_test_%%%%-%%%%");
+    fs::create_directories(base_path / "blocks");
+    const char* old_rfnoc_dir = std::getenv(XML_PATH_ENV.c_str());
+    const std::string old_value(old_rfnoc_dir ? old_rfnoc_dir : "");
+    set_env(XML_PATH_ENV, base_path.string());
+
+    write_blockdef(base_path / "blocks" / "first.xml", "First", "AAAA000000000000");
+    blockdef::sptr block_definition = blockdef::make_from_noc_id(0xAAAA000000000000);
+    BOOST_REQUIRE(block_definition);
+    BOOST_CHECK_EQUAL(block_definition->get_name(), "First");
+
+    // Files added after the first lookup are found, too
+    write_blockdef(base_path / "blocks" / "second.xml", "Second", "BBBB000000000000");
+    block_definition = blockdef::make_from_noc_id(0xBBBB000000000000);
+    BOOST_REQUIRE(block_definition);
+    BOOST_CHECK_EQUAL(block_definition->get_name(), "Second");
+
+    // And removed files aren't
+    fs::remove(base_path / "blocks" / "first.xml");
+    BOOST_CHECK(not blockdef::make_from_noc_id(0xAAAA000000000000));
+
+    set_env(XML_PATH_ENV, old_value);
+    fs::remove_all(base_path);
+}
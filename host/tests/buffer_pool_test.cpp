@@ -0,0 +1,55 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/transport/buffer_pool.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+
+using namespace uhd::transport;
+
+static void check_pool(buffer_pool::sptr pool,
+    const size_t num_buffs,
+    const size_t buff_size,
+    const size_t alignment)
+{
+    BOOST_REQUIRE_EQUAL(pool->size(), num_buffs);
+    for (size_t i = 0; i < num_buffs; i++) {
+        BOOST_CHECK_EQUAL(size_t(pool->at(i)) % alignment, 0);
+        if (i > 0) {
+            BOOST_CHECK_GE(size_t(pool->at(i)) - size_t(pool->at(i - 1)), buff_size);
+        }
+        // Every buffer must be writable over its full size
+        std::memset(pool->at(i), int(i), buff_size);
+    }
+    for (size_t i = 0; i < num_buffs; i++) {
+        BOOST_CHECK_EQUAL(static_cast<unsigned char*>(pool->at(i))[buff_size - 1],
+            static_cast<unsigned char>(i));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_buffer_pool_alignment)
+{
+    check_pool(buffer_pool::make(10, 1000), 10, 1000, 64);
+    check_pool(buffer_pool::make(10, 1000, 16), 10, 1000, 16);
+    check_pool(buffer_pool::make(3, 100, 4096), 3, 100, 4096);
+}
+
+BOOST_AUTO_TEST_CASE(test_buffer_pool_placement)
+{
+    // Huge pages are usually not reserved on build hosts, so this mostly
+    // exercises the fallback to normal pages
+    buffer_pool::alloc_params params;
+    params.use_huge_pages = true;
+    check_pool(buffer_pool::make(1000, 8000, params), 1000, 8000, 64);
+
+    params.use_huge_pages = false;
+    params.numa_node      = buffer_pool::NUMA_NODE_LOCAL;
+    params.alignment      = 4096;
+    check_pool(buffer_pool::make(100, 1472, params), 100, 1472, 4096);
+
+    params.numa_node = 0;
+    check_pool(buffer_pool::make(100, 1472, params), 100, 1472, 4096);
+}
@@ -129,6 +129,11 @@ public:
     template <uhd::endianness_t endianness = uhd::ENDIANNESS_BIG>
     void pop_send_packet(uhd::transport::vrt::if_packet_info_t& ifpi);
 
+    //! Pop a sent packet, and copy its payload words as they are on the wire
+    template <uhd::endianness_t endianness = uhd::ENDIANNESS_BIG>
+    void pop_send_packet(
+        uhd::transport::vrt::if_packet_info_t& ifpi, std::vector<uint32_t>& payload);
+
 private:
     std::list<boost::shared_array<uint8_t>> _tx_mems;
     std::list<size_t> _tx_lens;
@@ -203,6 +208,14 @@ void mock_zero_copy::push_back_inline_message_packet(
 
 template <uhd::endianness_t endianness>
 void mock_zero_copy::pop_send_packet(uhd::transport::vrt::if_packet_info_t& ifpi)
+{
+    std::vector<uint32_t> payload;
+    pop_send_packet<endianness>(ifpi, payload);
+}
+
+template <uhd::endianness_t endianness>
+void mock_zero_copy::pop_send_packet(
+    uhd::transport::vrt::if_packet_info_t& ifpi, std::vector<uint32_t>& payload)
 {
     using namespace uhd::transport;
 
@@ -223,6 +236,8 @@ void mock_zero_copy::pop_send_packet(uhd::transport::vrt::if_packet_info_t& ifpi
             uhd::transport::vrt::if_hdr_unpack_le(tx_buff_ptr, ifpi);
         }
     }
+    const uint32_t* payload_ptr = tx_buff_ptr + ifpi.num_header_words32;
+    payload.assign(payload_ptr, payload_ptr + ifpi.num_payload_words32);
     _tx_mems.pop_front();
     _tx_lens.pop_front();
 }
@@ -6,8 +6,10 @@
 //
 
 #include <uhd/convert.hpp>
+#include <uhd/exception.hpp>
 #include <stdint.h>
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
 #include <complex>
 #include <cstdlib>
 #include <iostream>
@@ -57,6 +59,40 @@ static void loopback(size_t nsamps,
     c1->conv(input1, output1, nsamps);
 }
 
+/***********************************************************************
+ * Find all non-generic priorities registered for a loopback pair, so
+ * every SIMD flavour available on this CPU gets tested, not only the best
+ **********************************************************************/
+//! Highest priority a converter is registered with
+static const int PRIO_MAX = 16;
+
+static bool has_converter(const convert::id_type& id, const int prio)
+{
+    try {
+        convert::get_converter(id, prio);
+        return true;
+    } catch (const uhd::key_error&) {
+        return false;
+    }
+}
+
+static std::vector<int> get_loopback_prios(
+    const convert::id_type& in_id, const convert::id_type& out_id)
+{
+    // Priorities are small and dense: stop after a run without any converter
+    static const int MAX_PRIO_GAP = 8;
+    std::vector<int> prios;
+    for (int prio = 1, gap = 0; gap < MAX_PRIO_GAP; prio++) {
+        const bool has_in  = has_converter(in_id, prio);
+        const bool has_out = has_converter(out_id, prio);
+        gap                = (has_in or has_out) ? 0 : gap + 1;
+        if (has_in and has_out) {
+            prios.push_back(prio);
+        }
+    }
+    return prios;
+}
+
 /***********************************************************************
  * Test short conversion
  **********************************************************************/
@@ -80,6 +116,13 @@ static void test_convert_types_sc16(
     loopback(nsamps, in_id, out_id, input, output);
     BOOST_CHECK_EQUAL_COLLECTIONS(
         input.begin(), input.end(), output.begin(), output.end());
+
+    // loopback foreach specific prio
+    for (const int prio : get_loopback_prios(in_id, out_id)) {
+        loopback(nsamps, in_id, out_id, input, output, prio, prio);
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            input.begin(), input.end(), output.begin(), output.end());
+    }
 }
 
 BOOST_AUTO_TEST_CASE(test_convert_types_be_sc16)
@@ -134,8 +177,11 @@ static void test_convert_types_for_floats(
 
     // make a list of all prio: best/generic combos
     typedef std::pair<int, int> int_pair_t;
-    const std::vector<int_pair_t> prios{
+    std::vector<int_pair_t> prios{
         int_pair_t(0, 0), int_pair_t(-1, 0), int_pair_t(0, -1), int_pair_t(-1, -1)};
+    for (const int prio : get_loopback_prios(in_id, out_id)) {
+        prios.push_back(int_pair_t(prio, prio));
+    }
 
     // loopback foreach prio combo (generic vs best)
     for (const auto& prio : prios) {
@@ -446,6 +492,147 @@ BOOST_AUTO_TEST_CASE(test_convert_types_sc16_and_sc8)
     }
 }
 
+/***********************************************************************
+ * Test longer buffers, so the wide SIMD loops and their remainders run
+ **********************************************************************/
+BOOST_AUTO_TEST_CASE(test_convert_types_simd_lengths)
+{
+    convert::id_type id;
+    id.num_inputs  = 1;
+    id.num_outputs = 1;
+
+    for (const std::string wire : {"le", "be"}) {
+        for (size_t nsamps = 16; nsamps < 80; nsamps += 5) {
+            id.input_format  = "sc16";
+            id.output_format = "sc16_item32_" + wire;
+            test_convert_types_sc16(nsamps, id);
+            id.output_format = "sc8_item32_" + wire;
+            test_convert_types_sc16(nsamps, id, 256);
+
+            id.input_format  = "fc32";
+            id.output_format = "sc16_item32_" + wire;
+            test_convert_types_for_floats<fc32_t>(nsamps, id);
+            id.output_format = "sc8_item32_" + wire;
+            test_convert_types_for_floats<fc32_t>(nsamps, id, 1. / 256);
+
+            id.input_format  = "fc64";
+            id.output_format = "sc16_item32_" + wire;
+            test_convert_types_for_floats<fc64_t>(nsamps, id);
+            id.output_format = "sc8_item32_" + wire;
+            test_convert_types_for_floats<fc64_t>(nsamps, id, 1. / 256);
+        }
+    }
+}
+
+/***********************************************************************
+ * Test IQ imbalance and DC offset correcting conversion
+ **********************************************************************/
+static fc32_t correct_rx(const fc32_t& x, const convert::iq_dc_correction_t& c)
+{
+    const double i = x.real() - c.dc_offset.real(), q = x.imag() - c.dc_offset.imag();
+    return fc32_t(float(c.ii * i + c.iq * q), float(c.qi * i + c.qq * q));
+}
+
+static fc32_t correct_tx(const fc32_t& x, const convert::iq_dc_correction_t& c)
+{
+    const double i = x.real(), q = x.imag();
+    return fc32_t(float(c.ii * i + c.iq * q + c.dc_offset.real()),
+        float(c.qi * i + c.qq * q + c.dc_offset.imag()));
+}
+
+static void test_convert_types_iq_dc(
+    const size_t nsamps, const size_t offset, const std::string& wire)
+{
+    convert::iq_dc_correction_t correction;
+    correction.ii        = 1.05;
+    correction.iq        = -0.1;
+    correction.qi        = 0.07;
+    correction.qq        = 0.93;
+    correction.dc_offset = std::complex<double>(0.02, -0.03);
+
+    std::vector<fc32_t> input(nsamps), expected(nsamps), output(nsamps + offset);
+    for (fc32_t& in : input) {
+        in = fc32_t(((std::rand() / (float(RAND_MAX) / 2)) - 1) / 2,
+            ((std::rand() / (float(RAND_MAX) / 2)) - 1) / 2);
+    }
+    std::vector<uint32_t> interm(nsamps + offset);
+
+    convert::id_type to_wire_id;
+    to_wire_id.input_format  = "fc32";
+    to_wire_id.num_inputs    = 1;
+    to_wire_id.output_format = "sc16_item32_" + wire;
+    to_wire_id.num_outputs   = 1;
+    convert::id_type to_host_id = to_wire_id;
+    std::swap(to_host_id.input_format, to_host_id.output_format);
+    convert::id_type rx_id = to_host_id;
+    rx_id.output_format += convert::IQ_DC_FORMAT_SUFFIX;
+    convert::id_type tx_id = to_wire_id;
+    tx_id.input_format += convert::IQ_DC_FORMAT_SUFFIX;
+
+    convert::converter::sptr to_wire = convert::get_converter(to_wire_id, 0)();
+    to_wire->set_scalar(32767.);
+    convert::converter::sptr to_host = convert::get_converter(to_host_id, 0)();
+    to_host->set_scalar(1 / 32767.);
+
+    for (int prio = 0; prio <= PRIO_MAX; prio++) {
+        // RX: correct the samples that the plain converter gets from the wire
+        if (has_converter(rx_id, prio)) {
+            std::vector<const void*> input0(1, &input[0]), input1(1, &interm[0]);
+            std::vector<void*> output0(1, &interm[0]), output1(1, &expected[0]);
+            to_wire->conv(input0, output0, nsamps);
+            to_host->conv(input1, output1, nsamps);
+
+            convert::converter::sptr rx = convert::get_converter(rx_id, prio)();
+            rx->set_scalar(1 / 32767.);
+            rx->set_iq_dc_correction(correction);
+            std::vector<void*> output2(1, &output[offset]);
+            rx->conv(input1, output2, nsamps);
+            for (size_t i = 0; i < nsamps; i++) {
+                MY_CHECK_CLOSE(
+                    correct_rx(expected[i], correction), output[offset + i], 1e-5f);
+            }
+        }
+
+        // TX: correct the samples on the way to the wire, and read them back
+        if (has_converter(tx_id, prio)) {
+            std::copy(input.begin(), input.end(), output.begin() + offset);
+            convert::converter::sptr tx = convert::get_converter(tx_id, prio)();
+            tx->set_scalar(32767.);
+            tx->set_iq_dc_correction(correction);
+            std::vector<const void*> input0(1, &output[offset]), input1(1, &interm[0]);
+            std::vector<void*> output0(1, &interm[0]), output1(1, &expected[0]);
+            tx->conv(input0, output0, nsamps);
+            to_host->conv(input1, output1, nsamps);
+            for (size_t i = 0; i < nsamps; i++) {
+                MY_CHECK_CLOSE(
+                    correct_tx(input[i], correction), expected[i], float(1. / (1 << 14)));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_types_with_iq_dc)
+{
+    for (const std::string wire : {"le", "be"}) {
+        for (size_t nsamps = 1; nsamps < 40; nsamps += 3) {
+            test_convert_types_iq_dc(nsamps, 0, wire);
+            test_convert_types_iq_dc(nsamps, 1, wire);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_no_iq_dc_correction)
+{
+    convert::id_type id;
+    id.input_format  = "fc32";
+    id.num_inputs    = 1;
+    id.output_format = "sc16_item32_le";
+    id.num_outputs   = 1;
+    convert::converter::sptr c = convert::get_converter(id)();
+    BOOST_CHECK_THROW(c->set_iq_dc_correction(convert::iq_dc_correction_t()),
+        uhd::not_implemented_error);
+}
+
 /***********************************************************************
  * Test u8 conversion
  **********************************************************************/
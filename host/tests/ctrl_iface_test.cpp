@@ -0,0 +1,207 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "mock_zero_copy.hpp"
+#include <uhd/exception.hpp>
+#include <uhdlib/rfnoc/ctrl_iface.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <vector>
+
+using namespace uhd::transport;
+using namespace uhd::rfnoc;
+
+static const uhd::sid_t SEND_SID(0x00000210);
+static const uhd::sid_t RECV_SID(0x02100000);
+
+//! The mock transport holds a single frame, give it a larger ACK window
+class mock_ctrl_xport : public mock_zero_copy
+{
+public:
+    typedef boost::shared_ptr<mock_ctrl_xport> sptr;
+
+    mock_ctrl_xport(const size_t num_recv_frames)
+        : mock_zero_copy(vrt::if_packet_info_t::LINK_TYPE_CHDR)
+        , _num_recv_frames(num_recv_frames)
+    {
+    }
+
+    size_t get_num_recv_frames(void) const
+    {
+        return _num_recv_frames;
+    }
+
+    //! Queue the ACK for the command packet with sequence number \p seq
+    void push_ack(const size_t seq)
+    {
+        vrt::if_packet_info_t ifpi;
+        ifpi.link_type           = vrt::if_packet_info_t::LINK_TYPE_CHDR;
+        ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_RESP;
+        ifpi.num_payload_words32 = 2;
+        ifpi.num_payload_bytes   = 2 * sizeof(uint32_t);
+        ifpi.packet_count        = seq & 0xfff;
+        ifpi.sid                 = RECV_SID.get();
+        ifpi.has_sid             = true;
+        ifpi.has_tsf             = false;
+        ifpi.eob                 = false;
+        ifpi.error               = false;
+        ifpi.fc_ack              = false;
+        push_back_recv_packet<uint32_t, uhd::ENDIANNESS_BIG>(
+            ifpi, std::vector<uint32_t>(2, 0));
+    }
+
+private:
+    const size_t _num_recv_frames;
+};
+
+static ctrl_iface::sptr make_ctrl(mock_ctrl_xport::sptr xport)
+{
+    uhd::both_xports_t xports;
+    xports.send       = xport;
+    xports.recv       = xport;
+    xports.send_sid   = SEND_SID;
+    xports.recv_sid   = RECV_SID;
+    xports.endianness = uhd::ENDIANNESS_BIG;
+    return ctrl_iface::make(xports, "test");
+}
+
+static std::vector<ctrl_iface::reg_write_t> make_writes(const size_t num_writes)
+{
+    std::vector<ctrl_iface::reg_write_t> writes;
+    for (uint32_t i = 0; i < num_writes; i++) {
+        writes.push_back(ctrl_iface::reg_write_t(100 + i, 0xcafe0000 | i));
+    }
+    return writes;
+}
+
+//! Pop a command packet and check its sequence number, register write and time
+static void check_cmd_packet(mock_ctrl_xport::sptr xport,
+    const size_t seq,
+    const ctrl_iface::reg_write_t& write,
+    const uint64_t timestamp)
+{
+    vrt::if_packet_info_t ifpi;
+    std::vector<uint32_t> payload;
+    xport->pop_send_packet<uhd::ENDIANNESS_BIG>(ifpi, payload);
+    BOOST_CHECK_EQUAL(ifpi.packet_type, vrt::if_packet_info_t::PACKET_TYPE_CMD);
+    BOOST_CHECK_EQUAL(ifpi.packet_count, seq & 0xfff);
+    BOOST_CHECK_EQUAL(ifpi.sid, SEND_SID.get());
+    BOOST_CHECK_EQUAL(ifpi.has_tsf, timestamp != 0);
+    if (timestamp) {
+        BOOST_CHECK_EQUAL(ifpi.tsf, timestamp);
+    }
+    BOOST_REQUIRE_EQUAL(payload.size(), 2);
+    BOOST_CHECK_EQUAL(uhd::ntohx(payload[0]), write.first);
+    BOOST_CHECK_EQUAL(uhd::ntohx(payload[1]), write.second);
+}
+
+BOOST_AUTO_TEST_CASE(test_ctrl_iface_burst_order)
+{
+    const size_t num_writes      = 10;
+    const uint64_t timestamp     = 0x123456789;
+    mock_ctrl_xport::sptr xport = boost::make_shared<mock_ctrl_xport>(4);
+    ctrl_iface::sptr ctrl        = make_ctrl(xport);
+    for (size_t seq = 0; seq < num_writes; seq++) {
+        xport->push_ack(seq);
+    }
+
+    const std::vector<ctrl_iface::reg_write_t> writes = make_writes(num_writes);
+    ctrl->send_cmd_burst(writes, timestamp);
+    for (size_t i = 0; i < num_writes; i++) {
+        check_cmd_packet(xport, i, writes[i], timestamp);
+    }
+
+    // The burst leaves nothing in flight, so the next burst only needs its
+    // own ACKs (and one more for the peek in the destructor)
+    for (size_t seq = num_writes; seq <= 2 * num_writes; seq++) {
+        xport->push_ack(seq);
+    }
+    ctrl->send_cmd_burst(writes, 0);
+    for (size_t i = 0; i < num_writes; i++) {
+        check_cmd_packet(xport, num_writes + i, writes[i], 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_ctrl_iface_burst_single_ack_window)
+{
+    const size_t num_writes     = 5;
+    mock_ctrl_xport::sptr xport = boost::make_shared<mock_ctrl_xport>(1);
+    ctrl_iface::sptr ctrl        = make_ctrl(xport);
+    for (size_t seq = 0; seq <= num_writes; seq++) {
+        xport->push_ack(seq);
+    }
+
+    const std::vector<ctrl_iface::reg_write_t> writes = make_writes(num_writes);
+    ctrl->send_cmd_burst(writes, 0);
+    for (size_t i = 0; i < num_writes; i++) {
+        check_cmd_packet(xport, i, writes[i], 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_ctrl_iface_burst_bad_ack)
+{
+    mock_ctrl_xport::sptr xport = boost::make_shared<mock_ctrl_xport>(4);
+    ctrl_iface::sptr ctrl        = make_ctrl(xport);
+    // The third ACK has the wrong sequence number
+    xport->push_ack(0);
+    xport->push_ack(1);
+    xport->push_ack(7);
+    xport->push_ack(3);
+    xport->push_ack(4);
+
+    try {
+        ctrl->send_cmd_burst(make_writes(5), 0);
+        BOOST_FAIL("send_cmd_burst() did not throw");
+    } catch (const uhd::io_error& ex) {
+        BOOST_TEST_MESSAGE(ex.what());
+        BOOST_CHECK(std::string(ex.what()).find("(write 3 of 5 in burst)")
+                    != std::string::npos);
+    }
+    // ACK the peek in the destructor
+    xport->push_ack(5);
+}
+
+BOOST_AUTO_TEST_CASE(test_ctrl_iface_burst_missing_ack)
+{
+    mock_ctrl_xport::sptr xport = boost::make_shared<mock_ctrl_xport>(4);
+    ctrl_iface::sptr ctrl        = make_ctrl(xport);
+    // Only the first four writes get an ACK
+    for (size_t seq = 0; seq < 4; seq++) {
+        xport->push_ack(seq);
+    }
+
+    try {
+        ctrl->send_cmd_burst(make_writes(6), 0);
+        BOOST_FAIL("send_cmd_burst() did not throw");
+    } catch (const uhd::io_error& ex) {
+        BOOST_TEST_MESSAGE(ex.what());
+        BOOST_CHECK(std::string(ex.what()).find("no response packet")
+                    != std::string::npos);
+        BOOST_CHECK(std::string(ex.what()).find("(write 5 of 6 in burst)")
+                    != std::string::npos);
+    }
+    // ACK what is still in flight, and the peek in the destructor
+    for (size_t seq = 4; seq <= 6; seq++) {
+        xport->push_ack(seq);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_ctrl_iface_burst_earlier_errors)
+{
+    mock_ctrl_xport::sptr xport = boost::make_shared<mock_ctrl_xport>(4);
+    ctrl_iface::sptr ctrl        = make_ctrl(xport);
+    // A single write without readback is not ACKed right away. Its bad ACK
+    // shows up before the burst sends anything.
+    ctrl->send_cmd_pkt(100, 1, false, 0);
+    xport->push_ack(5);
+    BOOST_CHECK_THROW(ctrl->send_cmd_burst(make_writes(2), 0), uhd::io_error);
+    vrt::if_packet_info_t ifpi;
+    xport->pop_send_packet<uhd::ENDIANNESS_BIG>(ifpi);
+    BOOST_CHECK_EQUAL(ifpi.packet_count, 0);
+    // ACK the peek in the destructor
+    xport->push_ack(1);
+}
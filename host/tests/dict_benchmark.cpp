@@ -0,0 +1,118 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// This file contains a benchmark of uhd::dict lookups, with and without the
+// hash index, at the sizes used for device args, driver maps and the
+// converter registry.
+
+#include <uhd/convert.hpp>
+#include <uhd/types/dict.hpp>
+#include <uhd/utils/safe_main.hpp>
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace po = boost::program_options;
+
+// Wraps a key so the dict can't index it, i.e. always does a linear scan
+template <typename T> struct scan_key
+{
+    scan_key(const T& k) : key(k) {}
+    bool operator==(const scan_key& rhs) const
+    {
+        return key == rhs.key;
+    }
+    T key;
+};
+
+template <typename Key> double benchmark_lookup(const std::vector<Key>& keys)
+{
+    uhd::dict<Key, size_t> dict;
+    for (size_t i = 0; i < keys.size(); i++) {
+        dict[keys[i]] = i;
+    }
+
+    // Look every key up, the average position is half way through the list
+    const size_t iterations = 2000000 / keys.size() + 1;
+    size_t sum              = 0;
+    const auto start_time   = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        for (const Key& key : keys) {
+            sum += dict[key];
+        }
+    }
+    const auto end_time = std::chrono::steady_clock::now();
+    const std::chrono::duration<double> elapsed_time(end_time - start_time);
+
+    if (sum != iterations * keys.size() * (keys.size() - 1) / 2) {
+        throw uhd::runtime_error("dict returned the wrong values");
+    }
+    return elapsed_time.count() / (iterations * keys.size()) * 1e9;
+}
+
+void benchmark_string_keys(const size_t size)
+{
+    std::vector<std::string> keys;
+    std::vector<scan_key<std::string>> scan_keys;
+    for (size_t i = 0; i < size; i++) {
+        // Device arg style keys, which share a prefix
+        keys.push_back(str(boost::format("recv_frame_size_%d") % i));
+        scan_keys.push_back(keys.back());
+    }
+    std::cout << boost::format("%4d string keys:    %7.1f ns scan, %7.1f ns dict\n")
+                     % size % benchmark_lookup(scan_keys) % benchmark_lookup(keys);
+}
+
+void benchmark_converter_ids(const size_t size)
+{
+    // What get_converter() looks up, e.g. "sc16_item32_le" (1) -> "fc32" (4)
+    static const char* formats[] = {"fc64", "fc32", "sc16", "sc8", "s16", "s8"};
+    static const char* otw[]     = {"item32_le", "item32_be", "chdr", "item16_usrp1"};
+    std::vector<uhd::convert::id_type> keys;
+    std::vector<scan_key<uhd::convert::id_type>> scan_keys;
+    for (size_t i = 0; keys.size() < size; i++) {
+        uhd::convert::id_type id;
+        id.input_format  = std::string("sc16_") + otw[i % 4];
+        id.num_inputs    = 1;
+        id.output_format = formats[(i / 4) % 6];
+        id.num_outputs   = 1 + i / 24;
+        keys.push_back(id);
+        scan_keys.push_back(id);
+    }
+    std::cout << boost::format("%4d converter IDs: %7.1f ns scan, %7.1f ns dict\n")
+                     % size % benchmark_lookup(scan_keys) % benchmark_lookup(keys);
+}
+
+int UHD_SAFE_MAIN(int argc, char* argv[])
+{
+    po::options_description desc("Allowed options");
+    desc.add_options()("help", "help message");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    // Print the help message
+    if (vm.count("help")) {
+        std::cout << boost::format("UHD Dict Benchmark %s") % desc << std::endl;
+        std::cout << "    Benchmark of uhd::dict lookups. Prints the time per lookup\n"
+                     "    with a linear scan and with the dict's own lookup, which\n"
+                     "    uses a hash index for larger dicts.\n"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const size_t sizes[] = {2, 4, 8, 16, 32, 64, 128, 256};
+    for (const size_t size : sizes) {
+        benchmark_string_keys(size);
+    }
+    for (const size_t size : sizes) {
+        benchmark_converter_ids(size);
+    }
+    return EXIT_SUCCESS;
+}
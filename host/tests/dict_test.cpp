@@ -110,3 +110,33 @@ BOOST_AUTO_TEST_CASE(test_dict_equals)
     BOOST_CHECK(not(d0 == d2));
     BOOST_CHECK(not(d0 == d3));
 }
+
+BOOST_AUTO_TEST_CASE(test_dict_large)
+{
+    // Large enough to be indexed
+    uhd::dict<std::string, int> d;
+    for (int i = 0; i < 100; i++) {
+        d[std::to_string(i)] = i;
+    }
+    BOOST_CHECK_EQUAL(d.size(), 100);
+    BOOST_CHECK_EQUAL(d["42"], 42);
+    BOOST_CHECK_EQUAL(d.keys()[42], "42");
+    BOOST_CHECK(not d.has_key("100"));
+    BOOST_CHECK_THROW(d.get("100"), uhd::key_error);
+
+    // Copies have an index of their own
+    uhd::dict<std::string, int> d_copy = d;
+    BOOST_CHECK_EQUAL(d_copy.pop("42"), 42);
+    BOOST_CHECK(not d_copy.has_key("42"));
+    BOOST_CHECK(d.has_key("42"));
+    d_copy["42"] = -42;
+    BOOST_CHECK_EQUAL(d_copy.keys().back(), "42");
+    BOOST_CHECK_EQUAL(d_copy.get("42"), -42);
+    BOOST_CHECK(d != d_copy);
+
+    d = d_copy;
+    BOOST_CHECK(d == d_copy);
+    d_copy["43"] = 0;
+    BOOST_CHECK_EQUAL(d["43"], 43);
+    BOOST_CHECK_EQUAL(d_copy["43"], 0);
+}
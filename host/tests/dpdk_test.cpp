@@ -5,6 +5,10 @@
 //
 /**
  * Benchmark program to check performance of 2 simultaneous links
+ *
+ * With --test burst or --test multi-queue, it checks the burst and multi-queue
+ * paths of the driver instead. Both need ports 0 and 1 cabled to each other.
+ * For multi-queue, list several CPUs in dpdk-io-cpu.
  */
 
 
@@ -36,6 +40,12 @@ constexpr unsigned int NUM_PORTS  = 2; /* Number of NIC ports */
 constexpr unsigned int TX_CREDITS = 28; /* Number of TX credits */
 constexpr unsigned int RX_CREDITS = 64; /* Number of RX credits */
 constexpr unsigned int BENCH_SPP  = 700; /* "Samples" per packet */
+
+constexpr unsigned int TEST_NUM_BURSTS = 1000; /* Bursts sent by the burst test */
+constexpr unsigned int TEST_NUM_PKTS   = 1000; /* Packets per stream, multi-queue test */
+constexpr unsigned int TEST_PKT_SIZE   = 1000; /* Payload bytes per test packet */
+constexpr uint16_t TEST_UDP_PORT       = 48888;
+constexpr double TEST_TIMEOUT          = 1.0;
 } // namespace
 
 struct dpdk_test_args
@@ -295,17 +305,146 @@ void prepare_and_bench_polling(void)
     bench(eth_data, NUM_PORTS, 0.0);
 }
 
+static uhd::transport::dpdk_zero_copy::sptr make_test_xport(unsigned int portid,
+    unsigned int peer_portid,
+    uint16_t udp_port,
+    size_t num_frames)
+{
+    auto& ctx = uhd::transport::uhd_dpdk_ctx::get();
+    uhd::transport::zero_copy_xport_params buff_args;
+    buff_args.recv_frame_size = TEST_PKT_SIZE;
+    buff_args.send_frame_size = TEST_PKT_SIZE;
+    buff_args.num_send_frames = num_frames;
+    buff_args.num_recv_frames = num_frames;
+    return uhd::transport::dpdk_zero_copy::make(ctx,
+        portid,
+        get_ipv4_addr(peer_portid),
+        std::to_string(udp_port),
+        std::to_string(udp_port),
+        buff_args,
+        uhd::device_addr_t());
+}
+
+/*!
+ * Port 0 sends bursts of BURST_SIZE packets, all committed at once, so the
+ * driver dequeues and transmits them in bulk. Port 1 must get every packet,
+ * in order.
+ */
+static int test_burst(void)
+{
+    auto tx = make_test_xport(0, 1, TEST_UDP_PORT, BURST_SIZE);
+    auto rx = make_test_xport(1, 0, TEST_UDP_PORT, 4 * BURST_SIZE);
+    // Let ARP settle
+    sleep(1);
+
+    uint32_t tx_seqno = 0, rx_seqno = 0;
+    for (unsigned int burst = 0; burst < TEST_NUM_BURSTS; burst++) {
+        uhd::transport::managed_send_buffer::sptr bufs[BURST_SIZE];
+        for (unsigned int i = 0; i < BURST_SIZE; i++) {
+            bufs[i] = tx->get_send_buff(TEST_TIMEOUT);
+            if (!bufs[i]) {
+                printf("FAIL: Could not get TX buffer %u of burst %u\n", i, burst);
+                return 1;
+            }
+            auto *tx_data = bufs[i]->cast<uint32_t *>();
+            tx_data[0]    = tx_seqno++;
+            memset(&tx_data[1], burst & 0xff, TEST_PKT_SIZE - sizeof(uint32_t));
+        }
+        for (unsigned int i = 0; i < BURST_SIZE; i++) {
+            bufs[i]->commit(TEST_PKT_SIZE);
+            bufs[i].reset();
+        }
+
+        while (rx_seqno < tx_seqno) {
+            auto buf = rx->get_recv_buff(TEST_TIMEOUT);
+            if (!buf) {
+                printf("FAIL: Packet %u of burst %u never arrived\n", rx_seqno, burst);
+                return 1;
+            }
+            const uint32_t seqno = buf->cast<const uint32_t *>()[0];
+            if (buf->size() != TEST_PKT_SIZE || seqno != rx_seqno) {
+                printf("FAIL: Expected packet %u (%u bytes), got %u (%zu bytes)\n",
+                    rx_seqno, TEST_PKT_SIZE, seqno, buf->size());
+                return 1;
+            }
+            rx_seqno++;
+        }
+    }
+    if (rx->get_drop_count() != 0) {
+        printf("FAIL: Socket reports %u dropped packets\n", rx->get_drop_count());
+        return 1;
+    }
+    printf("PASS: %u packets in %u bursts\n", rx_seqno, TEST_NUM_BURSTS);
+    return 0;
+}
+
+/*!
+ * One stream per possible queue, on consecutive UDP ports, so the streams
+ * land on different queues and I/O threads. The streams are sent
+ * interleaved, and every receiver must see its own stream only, in order.
+ * This covers the steering of ports to queues, and the per-queue tables.
+ */
+static int test_multi_queue(void)
+{
+    constexpr unsigned int num_streams = UHD_DPDK_MAX_QUEUES_PER_PORT;
+    uhd::transport::dpdk_zero_copy::sptr tx[num_streams], rx[num_streams];
+    for (unsigned int i = 0; i < num_streams; i++) {
+        tx[i] = make_test_xport(0, 1, TEST_UDP_PORT + i, 16);
+        rx[i] = make_test_xport(1, 0, TEST_UDP_PORT + i, 64);
+    }
+    sleep(1);
+
+    for (uint32_t seqno = 0; seqno < TEST_NUM_PKTS; seqno++) {
+        for (unsigned int i = 0; i < num_streams; i++) {
+            auto buf = tx[i]->get_send_buff(TEST_TIMEOUT);
+            if (!buf) {
+                printf("FAIL: Could not get TX buffer for stream %u\n", i);
+                return 1;
+            }
+            auto *tx_data = buf->cast<uint32_t *>();
+            tx_data[0]    = i;
+            tx_data[1]    = seqno;
+            buf->commit(TEST_PKT_SIZE);
+        }
+        for (unsigned int i = 0; i < num_streams; i++) {
+            auto buf = rx[i]->get_recv_buff(TEST_TIMEOUT);
+            if (!buf) {
+                printf("FAIL: Packet %u of stream %u (UDP port %u) never arrived\n",
+                    seqno, i, TEST_UDP_PORT + i);
+                return 1;
+            }
+            const uint32_t *rx_data = buf->cast<const uint32_t *>();
+            if (rx_data[0] != i || rx_data[1] != seqno) {
+                printf("FAIL: Stream %u expected packet %u, got packet %u of stream %u\n",
+                    i, seqno, rx_data[1], rx_data[0]);
+                return 1;
+            }
+        }
+    }
+    for (unsigned int i = 0; i < num_streams; i++) {
+        if (rx[i]->get_drop_count() != 0) {
+            printf("FAIL: Stream %u reports %u dropped packets\n",
+                i, rx[i]->get_drop_count());
+            return 1;
+        }
+    }
+    printf("PASS: %u streams of %u packets\n", num_streams, TEST_NUM_PKTS);
+    return 0;
+}
+
 int main(int argc, char **argv)
 {
     int retval, user0_cpu = 0, user1_cpu = 2;
     int status = 0;
     std::string args;
     std::string cpusets;
+    std::string test;
     po::options_description desc("Allowed options");
     desc.add_options()
         ("help", "help message")
         ("args", po::value<std::string>(&args)->default_value(""), "UHD-DPDK args")
         ("polling-mode", "Use polling mode (single thread on own core)")
+        ("test", po::value<std::string>(&test)->default_value("bench"), "bench, burst or multi-queue")
         ("cpusets", po::value<std::string>(&cpusets)->default_value(""), "which core(s) to use for a given thread in blocking mode (specify something like \"user0=0,user1=2\")")
     ;
     po::variables_map vm;
@@ -331,6 +470,15 @@ int main(int argc, char **argv)
     auto& ctx = uhd::transport::uhd_dpdk_ctx::get();
     ctx.init(args);
 
+    if (test == "burst") {
+        return test_burst();
+    } else if (test == "multi-queue") {
+        return test_multi_queue();
+    } else if (test != "bench") {
+        std::cout << "Unknown test: " << test << std::endl;
+        return 1;
+    }
+
     if (vm.count("polling-mode")) {
         prepare_and_bench_polling();
     } else {
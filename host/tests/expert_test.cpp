@@ -264,4 +264,15 @@ BOOST_AUTO_TEST_CASE(test_experts)
     BOOST_CHECK(!nodeC.is_dirty());
     container->resolve_to("Consume_G");
     VALIDATE_ALL_DEPENDENCIES
+
+    // Ensure auto-resolve on write also picks up other dirty nodes
+    nodeB.set(5); // Hack for testing, F depends on B but not on A
+    tree->access<int>("A").set(7);
+    VALIDATE_ALL_DEPENDENCIES
+
+    // Ensure auto-resolve on write still works after the graph changes
+    expert_factory::add_data_node<int>(container, "H", 0);
+    tree->access<int>("A").set(8);
+    BOOST_CHECK(nodeC.get() == nodeA.get() + nodeB.get());
+    BOOST_CHECK(nodeG.get() == nodeE.get() - nodeF.get());
 }
@@ -0,0 +1,148 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhdlib/usrp/common/fe_cal_table.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+
+using uhd::usrp::fe_cal_table;
+namespace fs = boost::filesystem;
+
+namespace {
+//! Creates a temporary directory, and removes it again
+struct tmp_dir_fixture
+{
+    tmp_dir_fixture()
+        : path(fs::temp_directory_path() / fs::unique_path("fe_cal_table_%%%%-%%%%"))
+    {
+        fs::create_directories(path);
+    }
+    ~tmp_dir_fixture()
+    {
+        boost::system::error_code ec;
+        fs::remove_all(path, ec);
+    }
+    fs::path path;
+};
+
+std::vector<fe_cal_table::entry_t> make_entries(void)
+{
+    std::vector<fe_cal_table::entry_t> entries;
+    for (size_t i = 0; i < 100; i++) {
+        fe_cal_table::entry_t entry;
+        entry.lo_freq   = 1e9 + 10e6 * i;
+        entry.corr_real = 0.01 * i;
+        entry.corr_imag = -0.02 * i;
+        entries.push_back(entry);
+    }
+    return entries;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_get_correction)
+{
+    std::vector<fe_cal_table::entry_t> entries = make_entries();
+    // Unsorted input is fine
+    std::swap(entries[3], entries[50]);
+    fe_cal_table::sptr table = fe_cal_table::make(entries);
+    BOOST_REQUIRE_EQUAL(table->size(), 100);
+
+    // On an entry, or close to it
+    BOOST_CHECK_CLOSE(table->get_correction(1.5e9).real(), 0.5, 1e-9);
+    BOOST_CHECK_CLOSE(table->get_correction(1.5e9 + 0.05).imag(), -1.0, 1e-9);
+    // Between two entries
+    BOOST_CHECK_CLOSE(table->get_correction(1.505e9).real(), 0.505, 1e-9);
+    BOOST_CHECK_CLOSE(table->get_correction(1.505e9).imag(), -1.01, 1e-9);
+    // Outside of the table, and between the first two entries
+    BOOST_CHECK_EQUAL(table->get_correction(1e8).real(), 0.0);
+    BOOST_CHECK_EQUAL(table->get_correction(1.005e9).real(), 0.0);
+    BOOST_CHECK_CLOSE(table->get_correction(6e9).real(), 0.99, 1e-9);
+
+    BOOST_CHECK_THROW(fe_cal_table::make({})->get_correction(1e9), uhd::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_csv_and_binary)
+{
+    tmp_dir_fixture tmp_dir;
+    const std::string csv_path = (tmp_dir.path / "rx_iq_cal_v0.2_TEST.csv").string();
+    {
+        std::ofstream csv(csv_path.c_str());
+        csv << "name, RX Frontend Calibration\n"
+            << "serial, TEST\n"
+            << "timestamp, 1234567890\n"
+            << "version, 0, 1\n"
+            << "DATA STARTS HERE\n"
+            << "lo_frequency, correction_real, correction_imag, measured, delta\n"
+            << "2.000000e+09, 0.500000, -0.100000, 0, 0\n"
+            << "1.000000e+09, 0.100000, 0.300000, 0, 0\n"
+            << "3.000000e+09, 0.200000, 0.000000, 0, 0\n";
+    }
+    fe_cal_table::sptr csv_table = fe_cal_table::import_csv(csv_path);
+    BOOST_REQUIRE_EQUAL(csv_table->size(), 3);
+    BOOST_CHECK_EQUAL(csv_table->entries()[0].lo_freq, 1e9);
+    BOOST_CHECK_EQUAL(csv_table->entries()[2].corr_real, 0.2);
+
+    // load() writes the binary copy, and uses it the next time
+    fe_cal_table::load(csv_path);
+    BOOST_REQUIRE(fs::exists(csv_path + ".bin"));
+    fe_cal_table::sptr bin_table = fe_cal_table::load_binary(csv_path + ".bin");
+    BOOST_REQUIRE_EQUAL(bin_table->size(), 3);
+    for (const double freq : {0.5e9, 1e9, 1.7e9, 2e9, 2.5e9, 4e9}) {
+        BOOST_CHECK(bin_table->get_correction(freq) == csv_table->get_correction(freq));
+        BOOST_CHECK(
+            fe_cal_table::load(csv_path)->get_correction(freq)
+            == csv_table->get_correction(freq));
+    }
+
+    // Anything else is rejected
+    {
+        std::ofstream bad((csv_path + ".bin").c_str(), std::ios::binary);
+        bad << "not a calibration file, but long enough";
+    }
+    BOOST_CHECK_THROW(fe_cal_table::load_binary(csv_path + ".bin"), uhd::runtime_error);
+    BOOST_CHECK_EQUAL(fe_cal_table::load(csv_path)->size(), 3);
+    BOOST_CHECK_THROW(
+        fe_cal_table::load_binary((tmp_dir.path / "missing.bin").string()),
+        uhd::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_stale_binary)
+{
+    tmp_dir_fixture tmp_dir;
+    const std::string csv_path = (tmp_dir.path / "tx_dc_cal_v0.2_TEST.csv").string();
+    auto write_csv = [&csv_path](const std::string& data_rows) {
+        std::ofstream csv(csv_path.c_str(), std::ios::trunc);
+        csv << "name, TX Frontend Calibration\n"
+            << "DATA STARTS HERE\n"
+            << "lo_frequency, correction_real, correction_imag, measured, delta\n"
+            << data_rows;
+    };
+    write_csv("1.000000e+09, 0.100000, 0.300000, 0, 0\n");
+    const std::time_t csv_time = fs::last_write_time(csv_path);
+    BOOST_CHECK_EQUAL(fe_cal_table::load(csv_path)->size(), 1);
+    BOOST_REQUIRE(fs::exists(csv_path + ".bin"));
+
+    // A CSV file that's rewritten within the same second isn't newer than its
+    // binary copy, but it has a different size
+    write_csv("1.000000e+09, 0.100000, 0.300000, 0, 0\n"
+              "2.000000e+09, 0.500000, -0.100000, 0, 0\n");
+    fs::last_write_time(csv_path, csv_time);
+    fs::last_write_time(csv_path + ".bin", csv_time);
+    BOOST_CHECK_EQUAL(fe_cal_table::load(csv_path)->size(), 2);
+
+    // Same size, but a different time
+    write_csv("1.000000e+09, 0.100000, 0.300000, 0, 0\n"
+              "3.000000e+09, 0.500000, -0.100000, 0, 0\n");
+    fs::last_write_time(csv_path, csv_time - 10);
+    fe_cal_table::sptr table = fe_cal_table::load(csv_path);
+    BOOST_REQUIRE_EQUAL(table->size(), 2);
+    BOOST_CHECK_EQUAL(table->entries()[1].lo_freq, 3e9);
+    // The binary copy was refreshed, and is used now
+    BOOST_CHECK_EQUAL(fe_cal_table::load(csv_path)->entries()[1].lo_freq, 3e9);
+    BOOST_CHECK(fs::last_write_time(csv_path + ".bin") > fs::last_write_time(csv_path));
+}
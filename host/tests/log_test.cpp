@@ -8,7 +8,11 @@
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/log_add.hpp>
 #include <boost/test/unit_test.hpp>
+#include <chrono>
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 BOOST_AUTO_TEST_CASE(test_messages)
 {
@@ -28,3 +32,51 @@ BOOST_AUTO_TEST_CASE(test_messages)
     const int x = 42;
     UHD_VAR(x);
 }
+
+BOOST_AUTO_TEST_CASE(test_fast_messages)
+{
+    std::mutex mutex;
+    std::vector<uhd::log::logging_info> messages;
+    uhd::log::set_log_level(uhd::log::debug);
+    uhd::log::add_logger("fast_test", [&mutex, &messages](const uhd::log::logging_info& I) {
+        if (I.component == "fast_test") {
+            std::lock_guard<std::mutex> l(mutex);
+            messages.push_back(I);
+        }
+    });
+    uhd::log::set_logger_level("fast_test", uhd::log::debug);
+
+    UHD_LOG_FAST(uhd::log::info, "fast_test", "No arguments");
+    UHD_LOG_FAST(uhd::log::warning,
+        "fast_test",
+        "int %d, unsigned %d, double %.2f, bool %s",
+        -3,
+        size_t(42),
+        1.5,
+        true);
+    // Below the log level, so it's never queued
+    UHD_LOG_FAST(uhd::log::trace, "fast_test", "Trace %d", 1);
+
+    // The messages are formatted by the logging thread
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (std::chrono::steady_clock::now() < timeout) {
+        {
+            std::lock_guard<std::mutex> l(mutex);
+            if (messages.size() >= 2) {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    std::lock_guard<std::mutex> l(mutex);
+    BOOST_REQUIRE_EQUAL(messages.size(), 2);
+    BOOST_CHECK_EQUAL(messages[0].message, "No arguments");
+    BOOST_CHECK_EQUAL(messages[0].verbosity, uhd::log::info);
+    BOOST_CHECK_EQUAL(
+        messages[1].message, "int -3, unsigned 42, double 1.50, bool 1");
+    BOOST_CHECK_EQUAL(messages[1].verbosity, uhd::log::warning);
+    BOOST_CHECK_EQUAL(messages[1].thread_id, boost::this_thread::get_id());
+    uhd::log::set_logger_level("fast_test", uhd::log::off);
+}
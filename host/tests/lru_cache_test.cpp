@@ -0,0 +1,72 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/utils/lru_cache.hpp>
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <tuple>
+
+using namespace uhd;
+
+BOOST_AUTO_TEST_CASE(test_lru_cache_get_put)
+{
+    lru_cache<int, std::string> cache(2);
+    std::string value;
+    BOOST_CHECK(not cache.get(1, value));
+
+    cache.put(1, "one");
+    cache.put(2, "two");
+    BOOST_CHECK_EQUAL(cache.size(), 2);
+    BOOST_REQUIRE(cache.get(1, value));
+    BOOST_CHECK_EQUAL(value, "one");
+
+    // 2 is the least recently used now
+    cache.put(3, "three");
+    BOOST_CHECK_EQUAL(cache.size(), 2);
+    BOOST_CHECK(not cache.get(2, value));
+    BOOST_CHECK(cache.get(1, value));
+    BOOST_REQUIRE(cache.get(3, value));
+    BOOST_CHECK_EQUAL(value, "three");
+
+    // replacing a value doesn't evict anything
+    cache.put(1, "uno");
+    BOOST_CHECK_EQUAL(cache.size(), 2);
+    BOOST_REQUIRE(cache.get(1, value));
+    BOOST_CHECK_EQUAL(value, "uno");
+    BOOST_CHECK(cache.get(3, value));
+
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.size(), 0);
+    BOOST_CHECK(not cache.get(1, value));
+}
+
+BOOST_AUTO_TEST_CASE(test_lru_cache_capacity)
+{
+    typedef std::tuple<double, bool> key_type;
+    lru_cache<key_type, int> cache(4);
+    for (int i = 0; i < 4; i++) {
+        cache.put(key_type(i * 1e6, i % 2 == 0), i);
+    }
+    BOOST_CHECK_EQUAL(cache.get_capacity(), 4);
+
+    // shrinking evicts the least recently used values
+    int value = 0;
+    BOOST_CHECK(cache.get(key_type(0.0, true), value));
+    cache.set_capacity(2);
+    BOOST_CHECK_EQUAL(cache.size(), 2);
+    BOOST_CHECK(cache.get(key_type(0.0, true), value));
+    BOOST_CHECK_EQUAL(value, 0);
+    BOOST_CHECK(cache.get(key_type(3e6, false), value));
+    BOOST_CHECK(not cache.get(key_type(1e6, false), value));
+    BOOST_CHECK(not cache.get(key_type(2e6, true), value));
+
+    // growing keeps everything
+    cache.set_capacity(8);
+    for (int i = 4; i < 10; i++) {
+        cache.put(key_type(i * 1e6, i % 2 == 0), i);
+    }
+    BOOST_CHECK_EQUAL(cache.size(), 8);
+}
@@ -0,0 +1,275 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/device.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/property_tree.hpp>
+#include <uhd/types/ranges.hpp>
+#include <uhd/usrp/multi_usrp.hpp>
+#include <uhd/usrp/subdev_spec.hpp>
+#include <uhd/utils/static.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace uhd;
+using namespace uhd::usrp;
+
+/***********************************************************************
+ * A device with nothing but a property tree:
+ * - Motherboard 0 has RX channels 0 and 1
+ * - Motherboard 1 has RX channel 2
+ * - Motherboard 2 has RX channel 3, and no timed commands
+ * TX has one channel per motherboard.
+ **********************************************************************/
+namespace {
+const std::string DEVICE_TYPE = "multi_usrp_batch_test";
+
+class batch_test_device : public device
+{
+public:
+    //! Which thread set which channel's frequency, in order
+    struct freq_event_t
+    {
+        size_t chan;
+        std::thread::id thread_id;
+    };
+
+    batch_test_device(void)
+    {
+        _type = device::USRP;
+        _tree = property_tree::make();
+        size_t rx_chan = 0;
+        for (size_t mb = 0; mb < 3; mb++) {
+            const fs_path mb_path = "/mboards/" + std::to_string(mb);
+            if (mb != 2) {
+                _tree->create<time_spec_t>(mb_path / "time/cmd")
+                    .add_coerced_subscriber([this, mb](const time_spec_t& time) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        cmd_times[mb].push_back(time);
+                    });
+            }
+            make_codec(mb_path, "rx");
+            make_codec(mb_path, "tx");
+            const size_t num_rx_chans = (mb == 0) ? 2 : 1;
+            subdev_spec_t rx_spec;
+            for (size_t c = 0; c < num_rx_chans; c++) {
+                rx_spec.push_back(subdev_spec_pair_t("A", std::to_string(c)));
+                make_chan(mb_path, "rx", c, rx_chan++);
+            }
+            _tree->create<subdev_spec_t>(mb_path / "rx_subdev_spec").set(rx_spec);
+            make_chan(mb_path, "tx", 0, 0);
+            _tree->create<subdev_spec_t>(mb_path / "tx_subdev_spec")
+                .set(subdev_spec_t("A:0"));
+        }
+    }
+
+    rx_streamer::sptr get_rx_stream(const stream_args_t&)
+    {
+        throw uhd::not_implemented_error("no streaming");
+    }
+
+    tx_streamer::sptr get_tx_stream(const stream_args_t&)
+    {
+        throw uhd::not_implemented_error("no streaming");
+    }
+
+    bool recv_async_msg(async_metadata_t&, double)
+    {
+        return false;
+    }
+
+    std::mutex mutex;
+    std::map<size_t, std::vector<time_spec_t>> cmd_times;
+    std::vector<freq_event_t> freq_events;
+    //! Setting the RX frequency of this channel throws
+    size_t failing_chan = size_t(-1);
+
+private:
+    void make_codec(const fs_path& mb_path, const std::string& dir)
+    {
+        const fs_path gain_path = mb_path / (dir + "_codecs") / "A/gains/CODEC";
+        _tree->create<meta_range_t>(gain_path / "range").set(meta_range_t(0.0, 0.0, 1.0));
+        _tree->create<double>(gain_path / "value").set(0.0);
+    }
+
+    void make_chan(
+        const fs_path& mb_path, const std::string& dir, const size_t c, const size_t chan)
+    {
+        const fs_path dsp_path   = mb_path / (dir + "_dsps") / c;
+        const fs_path rf_fe_path = mb_path / "dboards/A" / (dir + "_frontends")
+                                   / std::to_string(c);
+        _tree->create<meta_range_t>(dsp_path / "freq/range")
+            .set(meta_range_t(-10e6, 10e6));
+        _tree->create<double>(dsp_path / "freq/value").set(0.0);
+        _tree->create<double>(dsp_path / "rate/value").set(1e6);
+        _tree->create<meta_range_t>(rf_fe_path / "freq/range")
+            .set(meta_range_t(1e9, 6e9));
+        _tree->create<double>(rf_fe_path / "bandwidth/value").set(20e6);
+        _tree->create<meta_range_t>(rf_fe_path / "gains/PGA/range")
+            .set(meta_range_t(0.0, 30.0, 1.0));
+        _tree->create<double>(rf_fe_path / "gains/PGA/value").set(0.0);
+        auto& freq = _tree->create<double>(rf_fe_path / "freq/value").set(1e9);
+        if (dir == "rx") {
+            freq.add_coerced_subscriber([this, chan](const double) {
+                std::lock_guard<std::mutex> lock(mutex);
+                freq_events.push_back({chan, std::this_thread::get_id()});
+                if (chan == failing_chan) {
+                    throw uhd::runtime_error("tune failed");
+                }
+            });
+        }
+    }
+};
+
+boost::shared_ptr<batch_test_device> the_device;
+
+device_addrs_t batch_test_find(const device_addr_t& hint)
+{
+    device_addrs_t addrs;
+    if (hint.get("type", "") == DEVICE_TYPE) {
+        addrs.push_back(device_addr_t("type=" + DEVICE_TYPE));
+    }
+    return addrs;
+}
+
+device::sptr batch_test_make(const device_addr_t&)
+{
+    return the_device;
+}
+
+UHD_STATIC_BLOCK(register_batch_test_device)
+{
+    device::register_device(&batch_test_find, &batch_test_make, device::USRP);
+}
+
+multi_usrp::sptr make_usrp(void)
+{
+    the_device = boost::make_shared<batch_test_device>();
+    return multi_usrp::make(device_addr_t("type=" + DEVICE_TYPE));
+}
+
+double get_rx_pga(const size_t mb, const size_t c)
+{
+    return the_device->get_tree()
+        ->access<double>("/mboards/" + std::to_string(mb) + "/dboards/A/rx_frontends/"
+                         + std::to_string(c) + "/gains/PGA/value")
+        .get();
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_batch_freqs_by_mboard)
+{
+    multi_usrp::sptr usrp = make_usrp();
+    const time_spec_t cmd_time(1.5);
+    const std::vector<tune_request_t> requests{
+        tune_request_t(2.1e9), tune_request_t(2.2e9), tune_request_t(2.3e9)};
+    const std::vector<size_t> chans{2, 0, 1};
+    const std::vector<tune_result_t> results =
+        usrp->set_rx_freqs(requests, chans, cmd_time);
+
+    BOOST_REQUIRE_EQUAL(results.size(), 3);
+    for (size_t i = 0; i < chans.size(); i++) {
+        BOOST_CHECK_CLOSE(results[i].actual_rf_freq, requests[i].target_freq, 1e-9);
+        BOOST_CHECK_CLOSE(usrp->get_rx_freq(chans[i]), requests[i].target_freq, 1e-9);
+    }
+
+    // Channels 0 and 1 are tuned in order, on the same thread, and channel
+    // 2 on a thread of its own
+    const std::vector<batch_test_device::freq_event_t>& events =
+        the_device->freq_events;
+    BOOST_REQUIRE_EQUAL(events.size(), 3);
+    std::map<size_t, std::thread::id> threads;
+    std::vector<size_t> mb0_chans;
+    for (const auto& event : events) {
+        threads[event.chan] = event.thread_id;
+        if (event.chan != 2) {
+            mb0_chans.push_back(event.chan);
+        }
+    }
+    BOOST_CHECK(threads[0] == threads[1]);
+    BOOST_CHECK(threads[0] != threads[2]);
+    BOOST_CHECK(mb0_chans == std::vector<size_t>({0, 1}));
+
+    // The command time is set and cleared on the motherboards involved only
+    const std::vector<time_spec_t> expected_times{cmd_time, time_spec_t(0.0)};
+    BOOST_CHECK(the_device->cmd_times[0] == expected_times);
+    BOOST_CHECK(the_device->cmd_times[1] == expected_times);
+    BOOST_CHECK(the_device->cmd_times.count(2) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_single_setting)
+{
+    multi_usrp::sptr usrp = make_usrp();
+    usrp->set_rx_gains({12.0}, {0, 1, 2, 3});
+    BOOST_CHECK_EQUAL(get_rx_pga(0, 0), 12.0);
+    BOOST_CHECK_EQUAL(get_rx_pga(0, 1), 12.0);
+    BOOST_CHECK_EQUAL(get_rx_pga(1, 0), 12.0);
+    BOOST_CHECK_EQUAL(get_rx_pga(2, 0), 12.0);
+
+    // A single motherboard is handled on the calling thread, untimed
+    const std::vector<tune_result_t> results =
+        usrp->set_rx_freqs({tune_request_t(3e9)}, {0, 1});
+    BOOST_REQUIRE_EQUAL(results.size(), 2);
+    BOOST_CHECK_CLOSE(usrp->get_rx_freq(0), 3e9, 1e-9);
+    BOOST_CHECK_CLOSE(usrp->get_rx_freq(1), 3e9, 1e-9);
+    for (const auto& event : the_device->freq_events) {
+        BOOST_CHECK(event.thread_id == std::this_thread::get_id());
+    }
+    BOOST_CHECK(the_device->cmd_times.empty());
+
+    usrp->set_tx_gains({7.0}, {0, 1, 2});
+    for (size_t mb = 0; mb < 3; mb++) {
+        BOOST_CHECK_EQUAL(usrp->get_tx_gain(mb), 7.0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_clears_cmd_time_on_error)
+{
+    multi_usrp::sptr usrp = make_usrp();
+    const time_spec_t cmd_time(3.0);
+    const std::vector<time_spec_t> expected_times{cmd_time, time_spec_t(0.0)};
+
+    // A setting fails. The other motherboard still gets its setting, and
+    // the command time is cleared on both.
+    the_device->failing_chan = 0;
+    BOOST_CHECK_THROW(usrp->set_rx_freqs({tune_request_t(2e9)}, {0, 1, 2}, cmd_time),
+        uhd::runtime_error);
+    BOOST_CHECK_CLOSE(usrp->get_rx_freq(2), 2e9, 1e-9);
+    BOOST_CHECK(the_device->cmd_times[0] == expected_times);
+    BOOST_CHECK(the_device->cmd_times[1] == expected_times);
+    the_device->failing_chan = size_t(-1);
+
+    // Motherboard 2 can't time commands. Motherboard 0 got the time first,
+    // and must not keep it.
+    the_device->cmd_times.clear();
+    the_device->freq_events.clear();
+    BOOST_CHECK_THROW(usrp->set_rx_freqs({tune_request_t(2e9)}, {0, 3}, cmd_time),
+        uhd::not_implemented_error);
+    BOOST_CHECK(the_device->cmd_times[0] == expected_times);
+    BOOST_CHECK(the_device->freq_events.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_errors)
+{
+    multi_usrp::sptr usrp = make_usrp();
+    // The number of settings must be 1 or match the channels
+    BOOST_CHECK_THROW(usrp->set_rx_gains({1.0, 2.0}, {0, 1, 2}), uhd::value_error);
+    BOOST_CHECK_THROW(
+        usrp->set_tx_freqs({tune_request_t(2e9), tune_request_t(2e9)}, {0}),
+        uhd::value_error);
+    // Channels which don't exist are caught before anything is set
+    BOOST_CHECK_THROW(
+        usrp->set_rx_freqs({tune_request_t(2e9)}, {0, 4}, time_spec_t(1.0)),
+        uhd::index_error);
+    BOOST_CHECK_THROW(usrp->set_tx_gains({1.0}, {3}), uhd::index_error);
+    BOOST_CHECK(the_device->freq_events.empty());
+    BOOST_CHECK(the_device->cmd_times.empty());
+    BOOST_CHECK_EQUAL(get_rx_pga(0, 0), 0.0);
+}
@@ -0,0 +1,294 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/transport/muxed_zero_copy_if.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/weak_ptr.hpp>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace uhd::transport;
+
+static const size_t NUM_FRAMES = 8;
+static const size_t FRAME_SIZE = 64;
+
+/***********************************************************************
+ * A base transport which hands out packets pushed by the test and
+ * counts the frames that are not released yet
+ **********************************************************************/
+class fake_base_xport : public zero_copy_if
+{
+public:
+    typedef boost::shared_ptr<fake_base_xport> sptr;
+
+    class fake_mrb : public managed_recv_buffer
+    {
+    public:
+        fake_mrb(std::atomic<size_t>& num_held) : _num_held(num_held), _busy(false) {}
+
+        void release(void)
+        {
+            _num_held--;
+            _busy = false;
+        }
+
+        sptr get_new(const uint32_t stream_num)
+        {
+            _num_held++;
+            _mem[0] = stream_num;
+            return make(this, _mem, sizeof(_mem));
+        }
+
+        //! Claim the frame for a packet, until it is released
+        bool try_claim(void)
+        {
+            bool expected = false;
+            return _busy.compare_exchange_strong(expected, true);
+        }
+
+        const void* mem(void) const
+        {
+            return _mem;
+        }
+
+    private:
+        std::atomic<size_t>& _num_held;
+        std::atomic<bool> _busy;
+        uint32_t _mem[FRAME_SIZE / sizeof(uint32_t)];
+    };
+
+    fake_base_xport(void) : _num_held(0)
+    {
+        for (size_t i = 0; i < NUM_FRAMES; i++) {
+            _mrbs.push_back(boost::make_shared<fake_mrb>(_num_held));
+        }
+    }
+
+    //! Queue a packet for the given stream, returns the frame memory
+    const void* push_packet(const uint32_t stream_num)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (size_t index = 0; index < NUM_FRAMES; index++) {
+            if (_mrbs[index]->try_claim()) {
+                _packets.push_back(std::make_pair(index, stream_num));
+                return _mrbs[index]->mem();
+            }
+        }
+        BOOST_FAIL("fake_base_xport: out of frames");
+        return nullptr;
+    }
+
+    size_t get_num_held(void) const
+    {
+        return _num_held;
+    }
+
+    //! Number of packets the demuxer did not pick up yet
+    size_t get_num_pending(void)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _packets.size();
+    }
+
+    managed_recv_buffer::sptr get_recv_buff(double)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_packets.empty()) {
+            return managed_recv_buffer::sptr();
+        }
+        const std::pair<size_t, uint32_t> packet = _packets.front();
+        _packets.pop_front();
+        return _mrbs[packet.first]->get_new(packet.second);
+    }
+
+    managed_send_buffer::sptr get_send_buff(double)
+    {
+        return managed_send_buffer::sptr();
+    }
+
+    size_t get_num_recv_frames(void) const
+    {
+        return NUM_FRAMES;
+    }
+    size_t get_num_send_frames(void) const
+    {
+        return NUM_FRAMES;
+    }
+    size_t get_recv_frame_size(void) const
+    {
+        return FRAME_SIZE;
+    }
+    size_t get_send_frame_size(void) const
+    {
+        return FRAME_SIZE;
+    }
+
+private:
+    std::vector<boost::shared_ptr<fake_mrb>> _mrbs;
+    std::list<std::pair<size_t, uint32_t>> _packets;
+    std::atomic<size_t> _num_held;
+    std::mutex _mutex;
+};
+
+static uint32_t classify(void* mem, size_t)
+{
+    return static_cast<const uint32_t*>(mem)[0];
+}
+
+//! The demux thread is asynchronous, give it some time to catch up
+template <typename cond_t> static bool wait_for(cond_t cond)
+{
+    for (size_t i = 0; i < 1000; i++) {
+        if (cond()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+BOOST_AUTO_TEST_CASE(test_muxed_zero_copy_no_copy)
+{
+    fake_base_xport::sptr base = boost::make_shared<fake_base_xport>();
+    muxed_zero_copy_if::sptr muxed = muxed_zero_copy_if::make(base, &classify, 4);
+    zero_copy_if::sptr stream0     = muxed->make_stream(0);
+    zero_copy_if::sptr stream1     = muxed->make_stream(1);
+
+    const void* mem0 = base->push_packet(0);
+    const void* mem1 = base->push_packet(1);
+
+    managed_recv_buffer::sptr buff1 = stream1->get_recv_buff(1.0);
+    BOOST_REQUIRE(buff1);
+    managed_recv_buffer::sptr buff0 = stream0->get_recv_buff(1.0);
+    BOOST_REQUIRE(buff0);
+
+    // the streams get the base transport's frames, not copies of them
+    BOOST_CHECK_EQUAL(buff0->cast<const void*>(), mem0);
+    BOOST_CHECK_EQUAL(buff1->cast<const void*>(), mem1);
+    BOOST_CHECK_EQUAL(buff0->size(), FRAME_SIZE);
+
+    // the base frames are only released when the consumer releases them
+    BOOST_CHECK_EQUAL(base->get_num_held(), 2);
+    buff0.reset();
+    BOOST_CHECK_EQUAL(base->get_num_held(), 1);
+    buff1.reset();
+    BOOST_CHECK_EQUAL(base->get_num_held(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_muxed_zero_copy_quota)
+{
+    fake_base_xport::sptr base = boost::make_shared<fake_base_xport>();
+    muxed_zero_copy_if::sptr muxed = muxed_zero_copy_if::make(base, &classify, 4);
+    zero_copy_if::sptr stream0     = muxed->make_stream(0);
+    zero_copy_if::sptr stream1     = muxed->make_stream(1);
+    // the quota is internal, the streams can pipeline as much as the base
+    BOOST_CHECK_EQUAL(stream0->get_num_recv_frames(), NUM_FRAMES);
+    const size_t quota = NUM_FRAMES / 2;
+
+    // stream 0 holds on to its quota of base frames
+    std::vector<managed_recv_buffer::sptr> held;
+    for (size_t i = 0; i < quota; i++) {
+        const void* mem = base->push_packet(0);
+        held.push_back(stream0->get_recv_buff(1.0));
+        BOOST_REQUIRE(held.back());
+        BOOST_CHECK_EQUAL(held.back()->cast<const void*>(), mem);
+    }
+    BOOST_CHECK_EQUAL(base->get_num_held(), quota);
+
+    // beyond its quota, stream 0 gets copies and the base frames go back
+    const void* mem = base->push_packet(0);
+    held.push_back(stream0->get_recv_buff(1.0));
+    BOOST_REQUIRE(held.back());
+    BOOST_CHECK(held.back()->cast<const void*>() != mem);
+    BOOST_CHECK_EQUAL(held.back()->cast<const uint32_t*>()[0], 0);
+    BOOST_CHECK_EQUAL(base->get_num_held(), quota);
+
+    // stream 1 is served while stream 0 is still at its quota
+    base->push_packet(1);
+    managed_recv_buffer::sptr buff1 = stream1->get_recv_buff(1.0);
+    BOOST_REQUIRE(buff1);
+    BOOST_CHECK_EQUAL(buff1->cast<const uint32_t*>()[0], 1);
+    buff1.reset();
+
+    // releasing the held frames gives them back to the base transport
+    held.clear();
+    BOOST_CHECK_EQUAL(base->get_num_held(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_muxed_zero_copy_full_stream)
+{
+    fake_base_xport::sptr base = boost::make_shared<fake_base_xport>();
+    muxed_zero_copy_if::sptr muxed = muxed_zero_copy_if::make(base, &classify, 4);
+    zero_copy_if::sptr stream0     = muxed->make_stream(0);
+    zero_copy_if::sptr stream1     = muxed->make_stream(1);
+
+    // stream 0 is never drained, and fills up all its buffers
+    for (size_t i = 0; i < stream0->get_num_recv_frames(); i++) {
+        base->push_packet(0);
+    }
+    BOOST_CHECK(wait_for([base]() { return base->get_num_held() == NUM_FRAMES / 2; }));
+    BOOST_CHECK_EQUAL(muxed->get_num_dropped_frames(), 0);
+
+    // one more packet for stream 0 is dropped instead of stalling the demuxer
+    base->push_packet(0);
+    BOOST_CHECK(wait_for([muxed]() { return muxed->get_num_dropped_frames() == 1; }));
+
+    // stream 1 keeps receiving
+    base->push_packet(1);
+    managed_recv_buffer::sptr buff1 = stream1->get_recv_buff(1.0);
+    BOOST_REQUIRE(buff1);
+    BOOST_CHECK_EQUAL(buff1->cast<const uint32_t*>()[0], 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_muxed_zero_copy_stalled_streams)
+{
+    fake_base_xport::sptr base = boost::make_shared<fake_base_xport>();
+    muxed_zero_copy_if::sptr muxed = muxed_zero_copy_if::make(base, &classify, 4);
+    std::vector<zero_copy_if::sptr> streams;
+    for (uint32_t i = 0; i < 3; i++) {
+        streams.push_back(muxed->make_stream(i));
+    }
+    const size_t quota = NUM_FRAMES / streams.size();
+
+    // streams 0 and 1 are never drained, and only hold their share of the
+    // base frames
+    for (uint32_t stream_num = 0; stream_num < 2; stream_num++) {
+        for (size_t i = 0; i < NUM_FRAMES; i++) {
+            base->push_packet(stream_num);
+            BOOST_REQUIRE(wait_for([base]() { return base->get_num_pending() == 0; }));
+        }
+    }
+    BOOST_CHECK_EQUAL(base->get_num_held(), 2 * quota);
+    BOOST_CHECK_EQUAL(muxed->get_num_dropped_frames(), 0);
+
+    // stream 2 still gets the base frames without a copy
+    const void* mem                 = base->push_packet(2);
+    managed_recv_buffer::sptr buff2 = streams[2]->get_recv_buff(1.0);
+    BOOST_REQUIRE(buff2);
+    BOOST_CHECK_EQUAL(buff2->cast<const void*>(), mem);
+}
+
+BOOST_AUTO_TEST_CASE(test_muxed_zero_copy_teardown)
+{
+    fake_base_xport::sptr base = boost::make_shared<fake_base_xport>();
+    muxed_zero_copy_if::sptr muxed = muxed_zero_copy_if::make(base, &classify, 4);
+    zero_copy_if::sptr stream0     = muxed->make_stream(0);
+
+    // the stream keeps the muxer alive, and tears it down when it goes away
+    boost::weak_ptr<muxed_zero_copy_if> muxed_wptr = muxed;
+    muxed.reset();
+    base->push_packet(0);
+    BOOST_CHECK(stream0->get_recv_buff(1.0));
+    BOOST_CHECK(not muxed_wptr.expired());
+    stream0.reset();
+    BOOST_CHECK(muxed_wptr.expired());
+    BOOST_CHECK_EQUAL(base->get_num_held(), 0);
+}
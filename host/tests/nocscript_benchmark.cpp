@@ -0,0 +1,106 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// This file contains a benchmark of NocScript argument checks, comparing
+// parsing the code for every run (what happens without the expression cache)
+// with evaluating an expression tree that was parsed once.
+
+#include "../lib/rfnoc/nocscript/function_table.hpp"
+#include "../lib/rfnoc/nocscript/parser.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/utils/safe_main.hpp>
+#include <boost/bind.hpp>
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace po = boost::program_options;
+using namespace uhd::rfnoc::nocscript;
+
+// Checks from the block definitions
+static const char* CHECKS[] = {"GE($input_rate, 0.0)",
+    "GE($spp, 16) AND LE($spp, 4096) AND IS_PWR_OF_2($spp)",
+    "EQUAL($shift, \"normal\") OR EQUAL($shift, \"reverse\") OR "
+    "EQUAL($shift, \"natural\")",
+    "LE($spp, SHIFT_LEFT(1, 12)) AND GE($input_rate, MULT(2.0, 1.5))"};
+
+expression::type_t get_arg_type(const std::string& arg_name)
+{
+    if (arg_name == "spp") {
+        return expression::TYPE_INT;
+    }
+    if (arg_name == "shift") {
+        return expression::TYPE_STRING;
+    }
+    return expression::TYPE_DOUBLE;
+}
+
+expression_literal get_arg_value(const std::string& arg_name)
+{
+    if (arg_name == "spp") {
+        return expression_literal(256);
+    }
+    if (arg_name == "shift") {
+        return expression_literal(std::string("natural"));
+    }
+    return expression_literal(200e6);
+}
+
+template <typename run_type> double benchmark(const size_t iterations, run_type run)
+{
+    const auto start_time = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        if (not run().to_bool()) {
+            throw uhd::runtime_error("NocScript check returned false");
+        }
+    }
+    const auto end_time = std::chrono::steady_clock::now();
+    const std::chrono::duration<double> elapsed_time(end_time - start_time);
+    return elapsed_time.count() / iterations * 1e9;
+}
+
+int UHD_SAFE_MAIN(int argc, char* argv[])
+{
+    size_t iterations;
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "help message")
+        ("iterations", po::value<size_t>(&iterations)->default_value(100000), "number of times each check is run")
+    ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    // Print the help message
+    if (vm.count("help")) {
+        std::cout << boost::format("UHD NocScript Benchmark %s") % desc << std::endl;
+        std::cout << "    Benchmark of NocScript argument checks. Prints the time per\n"
+                     "    check when the code is parsed for every run, and when a\n"
+                     "    parsed expression tree is evaluated.\n"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    function_table::sptr ft = function_table::make();
+    parser::sptr p          = parser::make(
+        ft, boost::bind(&get_arg_type, _1), boost::bind(&get_arg_value, _1));
+
+    for (const std::string code : CHECKS) {
+        const double parse_ns = benchmark(iterations / 10 + 1,
+            [&p, &code]() { return p->create_expr_tree(code)->eval(); });
+        expression::sptr e    = p->create_expr_tree(code);
+        const double eval_ns  = benchmark(iterations, [&e]() { return e->eval(); });
+        std::cout << code << std::endl
+                  << boost::format("    %9.1f ns parse and eval, %7.1f ns eval\n")
+                         % parse_ns % eval_ns;
+    }
+    return EXIT_SUCCESS;
+}
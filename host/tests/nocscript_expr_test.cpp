@@ -290,11 +290,30 @@ public:
         throw uhd::syntax_error("eval(): unknown function");
     }
 
+    function_table::function_ptr get_function(const std::string& name,
+        const expression_function::argtype_list_type& arg_types) const
+    {
+        if (not function_exists(name, arg_types)) {
+            throw uhd::syntax_error("get_function(): unknown function");
+        }
+        return boost::bind(&functable_mockup_impl::eval,
+            const_cast<functable_mockup_impl*>(this),
+            name,
+            arg_types,
+            _1);
+    }
+
+    bool is_pure(const std::string&, const expression_function::argtype_list_type&) const
+    {
+        return false;
+    }
+
     // We don't actually need this
     void register_function(const std::string&,
         const function_table::function_ptr&,
         const expression::type_t,
-        const expression_function::argtype_list_type&){};
+        const expression_function::argtype_list_type&,
+        const bool){};
 };
 
 
@@ -117,6 +117,30 @@ BOOST_AUTO_TEST_CASE(test_add_funcs)
     BOOST_CHECK_EQUAL(e.get_int(), 7);
 }
 
+BOOST_AUTO_TEST_CASE(test_get_function)
+{
+    function_table::sptr ft = function_table::make();
+
+    function_table::function_ptr add = ft->get_function("ADD", two_int_args);
+    expression_container::expr_list_type add_int_values{E(2), E(3)};
+    BOOST_CHECK_EQUAL(add(add_int_values).get_int(), 5);
+    BOOST_REQUIRE_THROW(ft->get_function("ADD", one_int_arg), uhd::syntax_error);
+
+    // Basic functions are pure, except the ones with side effects
+    BOOST_CHECK(ft->is_pure("ADD", two_int_args));
+    BOOST_CHECK(not ft->is_pure("SLEEP", one_double_arg));
+    BOOST_CHECK(not ft->is_pure("ADD", one_int_arg));
+    ft->register_function(
+        "ADD_PLUS_2", boost::bind(&add_plus2_int, _1), expression::TYPE_INT, two_int_args);
+    BOOST_CHECK(not ft->is_pure("ADD_PLUS_2", two_int_args));
+    ft->register_function("ADD_PLUS_2",
+        boost::bind(&add_plus2_int, _1),
+        expression::TYPE_INT,
+        two_int_args,
+        true);
+    BOOST_CHECK(ft->is_pure("ADD_PLUS_2", two_int_args));
+}
+
 int dummy_true_counter = 0;
 // Some bogus function to test the registry
 expression_literal dummy_true(expression_container::expr_list_type)
@@ -145,3 +145,38 @@ BOOST_AUTO_TEST_CASE(test_multi_commmand)
     p->create_expr_tree("DUMMY() OR DUMMY() OR DUMMY()")->eval();
     BOOST_CHECK_EQUAL(dummy_false_counter, 3);
 }
+
+BOOST_AUTO_TEST_CASE(test_constant_folding)
+{
+    SETUP_FT_AND_PARSER();
+
+    // Pure functions of literals are evaluated by the parser
+    expression::sptr e = p->create_expr_tree("ADD(1, ADD(2, MULT(3, 4)))");
+    BOOST_REQUIRE(boost::dynamic_pointer_cast<expression_literal>(e));
+    BOOST_CHECK_EQUAL(e->eval().get_int(), 1 + 2 + 3 * 4);
+    e = p->create_expr_tree("GE(16, 16) AND IS_PWR_OF_2(64)");
+    BOOST_REQUIRE(boost::dynamic_pointer_cast<expression_literal>(e));
+    BOOST_CHECK(e->eval().get_bool());
+
+    // With a variable, only the constant part is folded, and the tree can be
+    // evaluated many times
+    e = p->create_expr_tree("ADD($spp, ADD(2, 3))");
+    BOOST_REQUIRE(not boost::dynamic_pointer_cast<expression_literal>(e));
+    for (int i = 0; i < 3; i++) {
+        BOOST_CHECK_EQUAL(e->eval().get_int(), SPP_VALUE + 5);
+    }
+
+    // Errors still happen when the code is run, not when it's parsed
+    e = p->create_expr_tree("LOG2(-1)");
+    BOOST_REQUIRE_THROW(e->eval(), uhd::runtime_error);
+
+    // Functions with side effects are never run by the parser
+    ft->register_function(
+        "DUMMY", boost::bind(&dummy_false, _1), expression::TYPE_BOOL, no_args);
+    dummy_false_counter = 0;
+    e = p->create_expr_tree("NOT(DUMMY())");
+    BOOST_CHECK_EQUAL(dummy_false_counter, 0);
+    BOOST_CHECK(e->eval().get_bool());
+    BOOST_CHECK(e->eval().get_bool());
+    BOOST_CHECK_EQUAL(dummy_false_counter, 2);
+}
@@ -0,0 +1,127 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhdlib/transport/polyphase_resampler.hpp>
+#include <boost/math/constants/constants.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+using namespace uhd::transport;
+typedef polyphase_resampler::sample_type sample_type;
+
+namespace {
+//! Resample num_in samples of both channels, in chunks of at most chunk samples
+std::vector<sample_type> resample(polyphase_resampler::sptr resampler,
+    const std::vector<sample_type>& input,
+    const size_t chunk,
+    std::vector<double>& offsets)
+{
+    std::vector<sample_type> output(input.size() * 8), output1(output.size());
+    size_t num_in = 0, num_out = 0;
+    offsets.clear();
+    while (num_in < input.size()) {
+        const sample_type* in[2]     = {&input[num_in], &input[num_in]};
+        sample_type* out[2]          = {&output[num_out], &output1[num_out]};
+        const double offset          = resampler->get_next_output_offset();
+        const size_t this_num_in     = std::min(chunk, input.size() - num_in);
+        size_t num_consumed          = 0;
+        const size_t this_num_out =
+            resampler->process(in, this_num_in, out, chunk / 2 + 1, num_consumed);
+        for (size_t i = 0; i < this_num_out; i++) {
+            offsets.push_back(double(num_in) + offset
+                              + double(i) * resampler->get_decim()
+                                    / resampler->get_interp());
+        }
+        num_in += num_consumed;
+        num_out += this_num_out;
+    }
+    BOOST_CHECK(std::equal(output.begin(), output.begin() + num_out, output1.begin()));
+    output.resize(num_out);
+    return output;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_resampler_make)
+{
+    uhd::device_addr_t args;
+    BOOST_CHECK(not polyphase_resampler::make(1, args));
+    args["resamp_interp"] = "3";
+    args["resamp_decim"]  = "6";
+    polyphase_resampler::sptr resampler = polyphase_resampler::make(1, args);
+    BOOST_REQUIRE(resampler);
+    BOOST_CHECK_EQUAL(resampler->get_interp(), 1);
+    BOOST_CHECK_EQUAL(resampler->get_decim(), 2);
+    BOOST_CHECK_THROW(polyphase_resampler::make(1, 0, 1), uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_resampler_tone)
+{
+    const double pi = boost::math::constants::pi<double>();
+    for (const auto& ratio : std::vector<std::pair<size_t, size_t>>{
+             {1, 2}, {2, 1}, {3, 4}, {4, 3}, {5, 7}, {1, 5}}) {
+        // A tone at a fifth of the lower Nyquist rate, in cycles per input sample
+        const double freq = 0.1 * std::min(1.0, double(ratio.first) / ratio.second);
+        std::vector<sample_type> input(2000);
+        for (size_t n = 0; n < input.size(); n++) {
+            input[n] = std::polar(0.5f, float(2 * pi * freq * n));
+        }
+
+        std::vector<sample_type> reference;
+        std::vector<double> reference_offsets;
+        for (const size_t chunk : {1000, 1, 7, 64}) {
+            polyphase_resampler::sptr resampler =
+                polyphase_resampler::make(2, ratio.first, ratio.second);
+            std::vector<double> offsets;
+            const std::vector<sample_type> output =
+                resample(resampler, input, chunk, offsets);
+            BOOST_REQUIRE_EQUAL(output.size(), offsets.size());
+
+            // The outputs are the tone at the reported positions, after the
+            // filter has settled
+            const double settled = 20.0 * ratio.second / ratio.first;
+            for (size_t i = 0; i < output.size(); i++) {
+                const double pos = offsets[i];
+                if (pos < settled) {
+                    continue;
+                }
+                const sample_type expected = std::polar(0.5f, float(2 * pi * freq * pos));
+                BOOST_CHECK_SMALL(std::abs(output[i] - expected), 2e-3f);
+            }
+            // All but the last half filter length of inputs come out
+            BOOST_CHECK_GT(offsets.back(), input.size() - settled);
+
+            // Chunking doesn't change anything
+            if (reference.empty()) {
+                reference         = output;
+                reference_offsets = offsets;
+            } else {
+                BOOST_REQUIRE_EQUAL(output.size(), reference.size());
+                for (size_t i = 0; i < output.size(); i++) {
+                    BOOST_CHECK_SMALL(std::abs(output[i] - reference[i]), 1e-6f);
+                    BOOST_CHECK_SMALL(offsets[i] - reference_offsets[i], 1e-9);
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_resampler_reset)
+{
+    std::vector<sample_type> input(100, sample_type(1, 0));
+    polyphase_resampler::sptr resampler = polyphase_resampler::make(2, 2, 3);
+    std::vector<double> offsets;
+    const std::vector<sample_type> first = resample(resampler, input, 100, offsets);
+    resampler->reset();
+    BOOST_CHECK_EQUAL(resampler->get_next_output_offset(), 0.0);
+    const std::vector<sample_type> second = resample(resampler, input, 100, offsets);
+    BOOST_REQUIRE_EQUAL(first.size(), second.size());
+    for (size_t i = 0; i < first.size(); i++) {
+        BOOST_CHECK_EQUAL(first[i], second[i]);
+    }
+}
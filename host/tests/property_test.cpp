@@ -212,6 +212,55 @@ BOOST_AUTO_TEST_CASE(test_prop_tree)
     BOOST_CHECK(not tree->exists("/test/prop1"));
 }
 
+BOOST_AUTO_TEST_CASE(test_prop_tree_paths)
+{
+    uhd::property_tree::sptr tree = uhd::property_tree::make();
+
+    tree->create<int>("/test/b");
+    tree->create<int>("test//a/");
+    tree->create<int>("/test/c/d");
+
+    // all spellings of a path lead to the same node
+    tree->access<int>("/test/a").set(7);
+    BOOST_CHECK_EQUAL(tree->access<int>("test/a/").get(), 7);
+    BOOST_CHECK_EQUAL(tree->access<int>("//test//a").get(), 7);
+    BOOST_CHECK_THROW(tree->create<int>("/test/a/"), uhd::runtime_error);
+
+    // list in order of creation
+    const std::vector<std::string> dirs = tree->list("/test");
+    BOOST_REQUIRE_EQUAL(dirs.size(), 3);
+    BOOST_CHECK_EQUAL(dirs[0], "b");
+    BOOST_CHECK_EQUAL(dirs[1], "a");
+    BOOST_CHECK_EQUAL(dirs[2], "c");
+    BOOST_CHECK_THROW(tree->list("/test/x"), uhd::lookup_error);
+    BOOST_CHECK_THROW(tree->remove("/"), uhd::runtime_error);
+
+    // a removed directory is gone with everything below it
+    tree->remove("/test/c");
+    BOOST_CHECK(not tree->exists("/test/c/d"));
+    BOOST_CHECK_EQUAL(tree->list("/test").size(), 2);
+    tree->create<int>("/test/c/d");
+    BOOST_CHECK(tree->exists("/test/c/d"));
+}
+
+BOOST_AUTO_TEST_CASE(test_prop_handle)
+{
+    uhd::property_tree::sptr tree = uhd::property_tree::make();
+    setter_type setter;
+
+    tree->create<int>("/test/prop")
+        .add_coerced_subscriber(boost::bind(&setter_type::doit, &setter, _1));
+    uhd::property<int>::sptr prop = tree->get_handle<int>("/test/prop");
+    BOOST_CHECK_EQUAL(prop.get(), &tree->access<int>("/test/prop"));
+    BOOST_CHECK_THROW(tree->get_handle<int>("/test/none"), uhd::lookup_error);
+
+    // the handle outlives the tree entry
+    tree->remove("/test");
+    prop->set(42);
+    BOOST_CHECK_EQUAL(prop->get(), 42);
+    BOOST_CHECK_EQUAL(setter._x, 42);
+}
+
 BOOST_AUTO_TEST_CASE(test_prop_subtree)
 {
     uhd::property_tree::sptr tree = uhd::property_tree::make();
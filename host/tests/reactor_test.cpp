@@ -0,0 +1,96 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/config.hpp>
+#include <uhd/exception.hpp>
+#include <uhdlib/utils/reactor.hpp>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#ifndef UHD_PLATFORM_WIN32
+#    include <fcntl.h>
+#    include <unistd.h>
+#endif
+
+namespace {
+//! Wait until \p condition is true, or give up after a second
+template <typename condition_type> bool wait_for(condition_type condition)
+{
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (not condition()) {
+        if (std::chrono::steady_clock::now() > timeout) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_periodic)
+{
+    uhd::reactor::sptr reactor = uhd::reactor::make(2);
+    std::atomic<size_t> count{0};
+    uhd::task::sptr task = reactor->add_periodic(
+        std::chrono::milliseconds(5), [&count]() { count++; }, "test_periodic");
+    BOOST_CHECK(wait_for([&count]() { return count >= 3; }));
+
+    // Once the task is gone, the callback isn't called anymore
+    task.reset();
+    const size_t final_count = count;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    BOOST_CHECK_EQUAL(count, final_count);
+}
+
+BOOST_AUTO_TEST_CASE(test_exception)
+{
+    uhd::reactor::sptr reactor = uhd::reactor::make(1);
+    std::atomic<size_t> count{0};
+    uhd::task::sptr task =
+        reactor->add_periodic(std::chrono::milliseconds(1), [&count]() {
+            count++;
+            throw uhd::runtime_error("test_exception");
+        });
+    BOOST_CHECK(wait_for([&count]() { return count >= 1; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    BOOST_CHECK_EQUAL(count, 1);
+}
+
+#ifndef UHD_PLATFORM_WIN32
+BOOST_AUTO_TEST_CASE(test_fd)
+{
+    int fds[2];
+    BOOST_REQUIRE_EQUAL(pipe(fds), 0);
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+
+    uhd::reactor::sptr reactor = uhd::reactor::make(2);
+    std::atomic<size_t> count{0};
+    const int read_fd    = fds[0];
+    uhd::task::sptr task = reactor->add_fd(read_fd, [&count, read_fd]() {
+        char byte;
+        if (read(read_fd, &byte, 1) != 1) {
+            return false;
+        }
+        count++;
+        return true;
+    });
+    if (task) {
+        const char bytes[] = "12345";
+        BOOST_REQUIRE_EQUAL(write(fds[1], bytes, 5), 5);
+        BOOST_CHECK(wait_for([&count]() { return count == 5; }));
+        BOOST_REQUIRE_EQUAL(write(fds[1], bytes, 2), 2);
+        BOOST_CHECK(wait_for([&count]() { return count == 7; }));
+
+        task.reset();
+        BOOST_REQUIRE_EQUAL(write(fds[1], bytes, 1), 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        BOOST_CHECK_EQUAL(count, 7);
+    }
+    close(fds[0]);
+    close(fds[1]);
+}
+#endif /* UHD_PLATFORM_WIN32 */
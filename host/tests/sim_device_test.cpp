@@ -0,0 +1,211 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "../lib/usrp/sim/sim_fpga.hpp"
+#include <uhd/device.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/property_tree.hpp>
+#include <uhd/rfnoc/constants.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/transport/chdr.hpp>
+#include <uhd/transport/udp_zero_copy.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/types/sid.hpp>
+#include <uhd/usrp/multi_usrp.hpp>
+#include <uhd/utils/byteswap.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <complex>
+#include <string>
+#include <vector>
+
+using namespace uhd;
+using namespace uhd::transport;
+
+/***********************************************************************
+ * These tests only use the device and property tree API, which libuhd
+ * exports without ENABLE_RFNOC, so they build wherever the simulator does.
+ **********************************************************************/
+namespace {
+constexpr size_t SAMPS_PER_PACKET = 256;
+constexpr size_t NUM_PACKETS      = 100;
+
+device::sptr make_sim(void)
+{
+    device::sptr dev = device::make(device_addr_t("type=sim,num_blocks=2"));
+    BOOST_REQUIRE(dev);
+    return dev;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_sim_blocks)
+{
+    device::sptr dev               = make_sim();
+    const property_tree::sptr tree = dev->get_tree();
+    const std::vector<std::string> blocks = tree->list("/mboards/0/xbar");
+    BOOST_REQUIRE_EQUAL(blocks.size(), 2);
+    BOOST_CHECK_EQUAL(blocks[0], "NullSrcSink_0");
+    BOOST_CHECK_EQUAL(blocks[1], "NullSrcSink_1");
+    BOOST_CHECK_EQUAL(
+        tree->access<uint64_t>("/mboards/0/xbar/NullSrcSink_0/noc_id").get(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_sim_rx)
+{
+    device::sptr dev           = make_sim();
+    const fs_path args_path    = "/mboards/0/xbar/NullSrcSink_0/args/0";
+    const property_tree::sptr tree = dev->get_tree();
+    tree->access<int>(args_path / "line_rate" / "value").set(100);
+    tree->access<int>(args_path / "bpp" / "value")
+        .set(int(SAMPS_PER_PACKET * sizeof(uint32_t)));
+
+    stream_args_t stream_args("sc16", "sc16");
+    stream_args.args["block_id"] = "0/NullSrcSink_0";
+    stream_args.args["spp"]      = std::to_string(SAMPS_PER_PACKET);
+    rx_streamer::sptr rx_stream  = dev->get_rx_stream(stream_args);
+    BOOST_REQUIRE_EQUAL(rx_stream->get_max_num_samps(), SAMPS_PER_PACKET);
+
+    std::vector<std::complex<int16_t>> buff(SAMPS_PER_PACKET);
+    rx_metadata_t md;
+    rx_stream->issue_stream_cmd(stream_cmd_t::STREAM_MODE_START_CONTINUOUS);
+    time_spec_t last_time;
+    for (size_t i = 0; i < NUM_PACKETS; i++) {
+        const size_t num_rx = rx_stream->recv(&buff.front(), buff.size(), md, 1.0);
+        BOOST_REQUIRE_EQUAL(md.error_code, rx_metadata_t::ERROR_CODE_NONE);
+        BOOST_REQUIRE_EQUAL(num_rx, SAMPS_PER_PACKET);
+        BOOST_REQUIRE(md.has_time_spec);
+        if (i > 0) {
+            BOOST_CHECK(md.time_spec > last_time);
+        }
+        last_time = md.time_spec;
+    }
+    rx_stream->issue_stream_cmd(stream_cmd_t::STREAM_MODE_STOP_CONTINUOUS);
+}
+
+BOOST_AUTO_TEST_CASE(test_sim_tx)
+{
+    device::sptr dev = make_sim();
+
+    stream_args_t stream_args("sc16", "sc16");
+    stream_args.args["block_id"] = "0/NullSrcSink_1";
+    tx_streamer::sptr tx_stream  = dev->get_tx_stream(stream_args);
+    const size_t spp             = tx_stream->get_max_num_samps();
+    BOOST_REQUIRE(spp > 0);
+
+    // This is several flow control windows, so it only goes through if the
+    // null sink's flow control responses do
+    std::vector<std::complex<int16_t>> buff(spp);
+    tx_metadata_t md;
+    md.start_of_burst = true;
+    for (size_t i = 0; i < NUM_PACKETS; i++) {
+        md.end_of_burst = (i == NUM_PACKETS - 1);
+        BOOST_REQUIRE_EQUAL(tx_stream->send(&buff.front(), buff.size(), md, 1.0), spp);
+        md.start_of_burst = false;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_sim_no_multi_usrp)
+{
+    // There are no radios to make channels from
+    BOOST_CHECK_THROW(
+        usrp::multi_usrp::make(device_addr_t("type=sim")), uhd::runtime_error);
+}
+
+/***********************************************************************
+ * Timed commands, straight on the simulated FPGA
+ **********************************************************************/
+namespace {
+constexpr double BUS_CLK_RATE = 100e6;
+//! Host address 0 talks to the first block (crossbar port 1 on address 2)
+const sid_t CMD_SID(0, 0x10, 2, 0x10);
+
+void send_cmd(zero_copy_if::sptr xport,
+    const size_t seq,
+    const uint32_t addr,
+    const uint32_t data,
+    const uint64_t tsf = 0)
+{
+    managed_send_buffer::sptr buff = xport->get_send_buff(1.0);
+    BOOST_REQUIRE(buff);
+    uint32_t* pkt = buff->cast<uint32_t*>();
+    vrt::if_packet_info_t info;
+    info.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_CMD;
+    info.num_payload_words32 = 2;
+    info.num_payload_bytes   = 2 * sizeof(uint32_t);
+    info.packet_count        = seq;
+    info.has_sid             = true;
+    info.sid                 = CMD_SID.get();
+    info.has_tsf             = (tsf != 0);
+    info.tsf                 = tsf;
+    vrt::chdr::if_hdr_pack_be(pkt, info);
+    pkt[info.num_header_words32 + 0] = uhd::htonx(addr);
+    pkt[info.num_header_words32 + 1] = uhd::htonx(data);
+    buff->commit(info.num_packet_words32 * sizeof(uint32_t));
+}
+
+//! Wait for an ACK, and return its sequence number
+size_t recv_ack(zero_copy_if::sptr xport, const double timeout)
+{
+    managed_recv_buffer::sptr buff = xport->get_recv_buff(timeout);
+    BOOST_REQUIRE(buff);
+    vrt::if_packet_info_t info;
+    info.num_packet_words32 = buff->size() / sizeof(uint32_t);
+    vrt::chdr::if_hdr_unpack_be(buff->cast<const uint32_t*>(), info);
+    BOOST_CHECK_EQUAL(info.packet_type, vrt::if_packet_info_t::PACKET_TYPE_RESP);
+    BOOST_CHECK_EQUAL(info.sid, CMD_SID.reversed().get());
+    return info.packet_count;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_sim_timed_commands)
+{
+    typedef std::chrono::steady_clock clock_type;
+    usrp::sim::sim_fpga::config_t config;
+    config.num_blocks      = 1;
+    config.first_xbar_port = 1;
+    config.dst_addr        = 2;
+    config.bus_clk_rate    = BUS_CLK_RATE;
+    config.fifo_size       = 0x10000;
+    config.buff_size       = 0x30000;
+    // The simulator's clock starts after this
+    const clock_type::time_point start_time = clock_type::now();
+    usrp::sim::sim_fpga::sptr fpga          = usrp::sim::sim_fpga::make(config);
+
+    zero_copy_xport_params xport_params;
+    xport_params.recv_frame_size = 1472;
+    xport_params.send_frame_size = 1472;
+    xport_params.num_recv_frames = 8;
+    xport_params.num_send_frames = 8;
+    xport_params.recv_buff_size  = 0;
+    xport_params.send_buff_size  = 0;
+    udp_zero_copy::buff_params buff_params;
+    zero_copy_if::sptr xport = udp_zero_copy::make(
+        "127.0.0.1", fpga->get_udp_port(), xport_params, buff_params);
+    {
+        managed_send_buffer::sptr buff = xport->get_send_buff(1.0);
+        buff->cast<uint32_t*>()[0]     = 0;
+        buff->cast<uint32_t*>()[1]     = uhd::htonx(CMD_SID.get());
+        buff->commit(8);
+    }
+
+    // A command for a time that's past runs right away
+    send_cmd(xport, 0, rfnoc::SR_READBACK, rfnoc::SR_READBACK_REG_ID, 1);
+    BOOST_CHECK_EQUAL(recv_ack(xport, 0.1), 0);
+
+    // A command for 0.5 s runs then, and holds up the command behind it
+    const double cmd_time = 0.5;
+    send_cmd(xport,
+        1,
+        rfnoc::SR_READBACK,
+        rfnoc::SR_READBACK_REG_ID,
+        uint64_t(cmd_time * BUS_CLK_RATE));
+    send_cmd(xport, 2, rfnoc::SR_READBACK, rfnoc::SR_READBACK_REG_ID);
+    BOOST_CHECK(not xport->get_recv_buff(0.1));
+    BOOST_CHECK_EQUAL(recv_ack(xport, 1.0), 1);
+    BOOST_CHECK(clock_type::now() - start_time
+                >= std::chrono::duration<double>(cmd_time));
+    BOOST_CHECK_EQUAL(recv_ack(xport, 0.1), 2);
+}
@@ -196,6 +196,12 @@ BOOST_AUTO_TEST_CASE(test_sph_recv_one_channel_sequence_error)
         BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
     }
 
+    // the lost packet shows up in the counters
+    const uhd::stream_stats_t stats = handler.get_stream_counters()->get_stats();
+    BOOST_CHECK_EQUAL(stats.num_packets, NUM_PKTS_TO_TEST - 1);
+    BOOST_CHECK_EQUAL(stats.num_seq_errors, 1);
+    BOOST_CHECK_EQUAL(stats.num_overflows, 0);
+
     // simulate the transport failing
     xport.set_simulate_io_error(true);
     BOOST_REQUIRE_THROW(
@@ -297,12 +303,121 @@ BOOST_AUTO_TEST_CASE(test_sph_recv_one_channel_inline_message)
         BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
     }
 
+    // the overflow message is counted, but not as a data packet
+    const uhd::stream_stats_t stats = handler.get_stream_counters()->get_stats();
+    BOOST_CHECK_EQUAL(stats.num_packets, NUM_PKTS_TO_TEST);
+    BOOST_CHECK_EQUAL(stats.num_overflows, 1);
+    BOOST_CHECK_EQUAL(stats.num_seq_errors, 0);
+
     // simulate the transport failing
     xport.set_simulate_io_error(true);
     BOOST_REQUIRE_THROW(
         handler.recv(&buff.front(), buff.size(), metadata, 1.0, true), uhd::io_error);
 }
 
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_recv_one_channel_views)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "sc16_item32_be";
+    id.num_inputs    = 1;
+    id.output_format = "sc16";
+    id.num_outputs   = 1;
+
+    mock_zero_copy xport(vrt::if_packet_info_t::LINK_TYPE_VRLP);
+
+    vrt::if_packet_info_t ifpi;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 0;
+    ifpi.packet_count        = 0;
+    ifpi.sob                 = true;
+    ifpi.eob                 = false;
+    ifpi.has_sid             = false;
+    ifpi.has_cid             = false;
+    ifpi.has_tsi             = true;
+    ifpi.has_tsf             = true;
+    ifpi.tsi                 = 0;
+    ifpi.tsf                 = 0;
+    ifpi.has_tlr             = false;
+
+    static const double TICK_RATE        = 100e6;
+    static const double SAMP_RATE        = 10e6;
+    static const size_t NUM_PKTS_TO_TEST = 30;
+
+    // generate a bunch of packets, each word tagged with packet and offset
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        ifpi.num_payload_words32 = 10 + i % 10;
+        std::vector<uint32_t> data(ifpi.num_payload_words32);
+        for (size_t j = 0; j < data.size(); j++) {
+            data[j] = uint32_t(i << 16 | j);
+        }
+        xport.push_back_recv_packet(ifpi, data);
+        ifpi.packet_count++;
+        ifpi.tsf += ifpi.num_payload_words32 * size_t(TICK_RATE / SAMP_RATE);
+    }
+
+    // create the super receive packet handler
+    uhd::transport::sph::recv_packet_handler handler(1);
+    handler.set_vrt_unpacker(&uhd::transport::vrt::if_hdr_unpack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    handler.set_xport_chan_get_buff(
+        0, [&xport](double timeout) { return xport.get_recv_buff(timeout); });
+    handler.set_converter(id);
+
+    // leave a fragment of the first packet behind
+    std::vector<std::complex<short>> buff(4);
+    uhd::rx_metadata_t metadata;
+    BOOST_CHECK_EQUAL(handler.recv(&buff.front(), buff.size(), metadata, 1.0, true), 4);
+    BOOST_CHECK(metadata.more_fragments);
+
+    // the views point at the payload, starting with the fragment
+    size_t num_accum_samps = 4;
+    uhd::rx_view_batch_t batch;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST / 2; i++) {
+        std::cout << "view check " << i << std::endl;
+        BOOST_REQUIRE_EQUAL(handler.recv_views(batch, 1, 1.0), 1);
+        const uhd::rx_view_t& view = batch.views[0];
+        BOOST_CHECK_EQUAL(view.metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+        BOOST_CHECK(not view.metadata.more_fragments);
+        BOOST_CHECK_EQUAL(view.metadata.fragment_offset, i == 0 ? 4 : 0);
+        BOOST_CHECK_TS_CLOSE(view.metadata.time_spec,
+            uhd::time_spec_t::from_ticks(num_accum_samps, SAMP_RATE));
+        const size_t first = i == 0 ? 4 : 0;
+        BOOST_REQUIRE_EQUAL(view.nsamps, 10 + i % 10 - first);
+        BOOST_REQUIRE_EQUAL(view.buffs.size(), 1);
+        const uint32_t* words = reinterpret_cast<const uint32_t*>(view.buffs[0]);
+        for (size_t j = 0; j < view.nsamps; j++) {
+            BOOST_CHECK_EQUAL(words[j], uint32_t(i << 16 | (first + j)));
+        }
+        BOOST_CHECK_EQUAL(batch.frames.size(), 1);
+        num_accum_samps += view.nsamps;
+        batch.frames.clear(); // what rx_streamer::release_views() does
+    }
+
+    // the rest comes in one batch, which the timeout cuts short
+    BOOST_CHECK_EQUAL(
+        handler.recv_views(batch, NUM_PKTS_TO_TEST, 1.0), NUM_PKTS_TO_TEST / 2);
+    BOOST_CHECK_EQUAL(batch.frames.size(), NUM_PKTS_TO_TEST / 2);
+    for (size_t i = 0; i < batch.views.size(); i++) {
+        const uhd::rx_view_t& view = batch.views[i];
+        BOOST_CHECK_EQUAL(view.metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+        BOOST_CHECK_TS_CLOSE(view.metadata.time_spec,
+            uhd::time_spec_t::from_ticks(num_accum_samps, SAMP_RATE));
+        BOOST_CHECK_EQUAL(view.nsamps, 10 + (i + NUM_PKTS_TO_TEST / 2) % 10);
+        num_accum_samps += view.nsamps;
+    }
+    batch.frames.clear(); // what rx_streamer::release_views() does
+
+    // subsequent receives should be a timeout
+    BOOST_CHECK_EQUAL(handler.recv_views(batch, NUM_PKTS_TO_TEST, 1.0), 1);
+    BOOST_CHECK_EQUAL(
+        batch.views[0].metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+    BOOST_CHECK_EQUAL(batch.views[0].nsamps, 0);
+    BOOST_CHECK(batch.frames.empty());
+}
+
 ////////////////////////////////////////////////////////////////////////
 BOOST_AUTO_TEST_CASE(test_sph_recv_multi_channel_normal)
 {
@@ -399,6 +514,99 @@ BOOST_AUTO_TEST_CASE(test_sph_recv_multi_channel_normal)
         handler.recv(buffs, NUM_SAMPS_PER_BUFF, metadata, 1.0, true), uhd::io_error);
 }
 
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_recv_multi_channel_convert_threads)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "sc16_item32_be";
+    id.num_inputs    = 1;
+    id.output_format = "fc32";
+    id.num_outputs   = 1;
+
+    vrt::if_packet_info_t ifpi;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 0;
+    ifpi.packet_count        = 0;
+    ifpi.sob                 = true;
+    ifpi.eob                 = false;
+    ifpi.has_sid             = false;
+    ifpi.has_cid             = false;
+    ifpi.has_tsi             = true;
+    ifpi.has_tsf             = true;
+    ifpi.tsi                 = 0;
+    ifpi.tsf                 = 0;
+    ifpi.has_tlr             = false;
+
+    static const double TICK_RATE          = 100e6;
+    static const double SAMP_RATE          = 10e6;
+    static const size_t NUM_PKTS_TO_TEST   = 30;
+    static const size_t NUM_SAMPS_PER_BUFF = 20;
+    static const size_t NCHANNELS          = 4;
+
+    std::vector<mock_zero_copy::sptr> xports;
+    for (size_t i = 0; i < NCHANNELS; i++) {
+        xports.push_back(
+            boost::make_shared<mock_zero_copy>(vrt::if_packet_info_t::LINK_TYPE_VRLP));
+    }
+
+    // generate a bunch of packets, each channel with its own sample value
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        ifpi.num_payload_words32 = 10 + i % 10;
+        for (size_t ch = 0; ch < NCHANNELS; ch++) {
+            // sc16_item32_be: I in the upper half of each big endian item
+            std::vector<uint32_t> data(
+                ifpi.num_payload_words32, uhd::htonx(uint32_t(ch + 1)));
+            xports[ch]->push_back_recv_packet(ifpi, data);
+        }
+        ifpi.packet_count++;
+        ifpi.tsf += ifpi.num_payload_words32 * size_t(TICK_RATE / SAMP_RATE);
+    }
+
+    // create the super receive packet handler, converting on 3 threads
+    sph::recv_packet_handler handler(NCHANNELS);
+    handler.set_vrt_unpacker(&vrt::if_hdr_unpack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        mock_zero_copy::sptr xport = xports[ch];
+        handler.set_xport_chan_get_buff(
+            ch, [xport](double timeout) { return xport->get_recv_buff(timeout); });
+    }
+    handler.set_converter(id);
+    handler.set_convert_worker_pool(
+        convert_worker_pool::make(uhd::device_addr_t("convert_threads=3")));
+    handler.set_scale_factor(1.0);
+
+    // check the received packets
+    size_t num_accum_samps = 0;
+    std::complex<float> mem[NUM_SAMPS_PER_BUFF * NCHANNELS];
+    std::vector<std::complex<float>*> buffs(NCHANNELS);
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        buffs[ch] = &mem[ch * NUM_SAMPS_PER_BUFF];
+    }
+    uhd::rx_metadata_t metadata;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        std::cout << "data check " << i << std::endl;
+        size_t num_samps_ret =
+            handler.recv(buffs, NUM_SAMPS_PER_BUFF, metadata, 1.0, true);
+        BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+        BOOST_CHECK_TS_CLOSE(
+            metadata.time_spec, uhd::time_spec_t::from_ticks(num_accum_samps, SAMP_RATE));
+        BOOST_REQUIRE_EQUAL(num_samps_ret, 10 + i % 10);
+        for (size_t ch = 0; ch < NCHANNELS; ch++) {
+            for (size_t n = 0; n < num_samps_ret; n++) {
+                BOOST_CHECK_EQUAL(buffs[ch][n], std::complex<float>(0, float(ch + 1)));
+            }
+        }
+        num_accum_samps += num_samps_ret;
+    }
+
+    // subsequent receives should be a timeout
+    handler.recv(buffs, NUM_SAMPS_PER_BUFF, metadata, 1.0, true);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+}
+
 ////////////////////////////////////////////////////////////////////////
 BOOST_AUTO_TEST_CASE(test_sph_recv_multi_channel_sequence_error)
 {
@@ -794,3 +1002,154 @@ BOOST_AUTO_TEST_CASE(test_sph_recv_multi_channel_fragment)
     BOOST_REQUIRE_THROW(
         handler.recv(buffs, NUM_SAMPS_PER_BUFF, metadata, 1.0, true), uhd::io_error);
 }
+
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_recv_one_channel_iq_dc_correction)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "sc16_item32_be";
+    id.num_inputs    = 1;
+    id.output_format = "fc32";
+    id.num_outputs   = 1;
+
+    mock_zero_copy xport(vrt::if_packet_info_t::LINK_TYPE_VRLP);
+
+    vrt::if_packet_info_t ifpi;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 10;
+    ifpi.packet_count        = 0;
+    ifpi.sob                 = true;
+    ifpi.eob                 = false;
+    ifpi.has_sid             = false;
+    ifpi.has_cid             = false;
+    ifpi.has_tsi             = true;
+    ifpi.has_tsf             = true;
+    ifpi.tsi                 = 0;
+    ifpi.tsf                 = 0;
+    ifpi.has_tlr             = false;
+
+    static const double TICK_RATE        = 100e6;
+    static const double SAMP_RATE        = 10e6;
+    static const size_t NUM_PKTS_TO_TEST = 2;
+
+    // generate packets full of zeros, which only get the DC offset
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        std::vector<uint32_t> data(ifpi.num_payload_words32, 0);
+        xport.push_back_recv_packet(ifpi, data);
+        ifpi.packet_count++;
+        ifpi.tsf += ifpi.num_payload_words32 * size_t(TICK_RATE / SAMP_RATE);
+    }
+
+    // create the super receive packet handler
+    uhd::transport::sph::recv_packet_handler handler(1);
+    handler.set_vrt_unpacker(&uhd::transport::vrt::if_hdr_unpack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    handler.set_xport_chan_get_buff(
+        0, [&xport](double timeout) { return xport.get_recv_buff(timeout); });
+    handler.set_converter(id);
+
+    uhd::convert::iq_dc_correction_t correction;
+    correction.qq        = 2.0;
+    correction.dc_offset = std::complex<double>(0.25, -0.5);
+    BOOST_CHECK_THROW(handler.set_iq_dc_correction(1, correction), uhd::index_error);
+    handler.set_iq_dc_correction(0, correction);
+
+    // the correction survives a new scale factor
+    handler.set_scale_factor(1 / 16384.);
+
+    std::vector<std::complex<float>> buff(10);
+    uhd::rx_metadata_t metadata;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        const size_t num_samps_ret =
+            handler.recv(&buff.front(), buff.size(), metadata, 1.0, true);
+        BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+        BOOST_REQUIRE_EQUAL(num_samps_ret, 10);
+        for (const auto& samp : buff) {
+            BOOST_CHECK_CLOSE(samp.real(), -0.25f, 0.001);
+            BOOST_CHECK_CLOSE(samp.imag(), 1.0f, 0.001);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_recv_one_channel_resampled)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "sc16_item32_be";
+    id.num_inputs    = 1;
+    id.output_format = "fc32";
+    id.num_outputs   = 1;
+
+    mock_zero_copy xport(vrt::if_packet_info_t::LINK_TYPE_VRLP);
+
+    vrt::if_packet_info_t ifpi;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 100;
+    ifpi.packet_count        = 0;
+    ifpi.sob                 = true;
+    ifpi.eob                 = false;
+    ifpi.has_sid             = false;
+    ifpi.has_cid             = false;
+    ifpi.has_tsi             = true;
+    ifpi.has_tsf             = true;
+    ifpi.tsi                 = 0;
+    ifpi.tsf                 = 0;
+    ifpi.has_tlr             = false;
+
+    static const double TICK_RATE        = 100e6;
+    static const double SAMP_RATE        = 10e6;
+    static const size_t NUM_PKTS_TO_TEST = 4;
+
+    // generate a burst of a constant, which is byte order independent
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        ifpi.eob = (i == NUM_PKTS_TO_TEST - 1);
+        std::vector<uint32_t> data(ifpi.num_payload_words32, 0x40404040);
+        xport.push_back_recv_packet(ifpi, data);
+        ifpi.sob = false;
+        ifpi.packet_count++;
+        ifpi.tsf += ifpi.num_payload_words32 * size_t(TICK_RATE / SAMP_RATE);
+    }
+
+    // create the super receive packet handler
+    uhd::transport::sph::recv_packet_handler handler(1);
+    handler.set_vrt_unpacker(&uhd::transport::vrt::if_hdr_unpack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    handler.set_xport_chan_get_buff(
+        0, [&xport](double timeout) { return xport.get_recv_buff(timeout); });
+    handler.set_converter(id);
+    handler.set_resampler(uhd::transport::polyphase_resampler::make(1, 2, 1));
+
+    // only fc32 samples can be resampled
+    uhd::convert::id_type sc16_id = id;
+    sc16_id.output_format         = "sc16";
+    BOOST_CHECK_THROW(handler.set_converter(sc16_id), uhd::value_error);
+    handler.set_converter(id);
+
+    // the whole burst comes in one call, at twice the rate
+    std::vector<std::complex<float>> buff(2 * NUM_PKTS_TO_TEST * 100);
+    uhd::rx_metadata_t metadata;
+    const size_t num_samps_ret =
+        handler.recv(&buff.front(), buff.size(), metadata, 1.0, false);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+    BOOST_CHECK(metadata.has_time_spec);
+    BOOST_CHECK(metadata.start_of_burst);
+    BOOST_CHECK(metadata.end_of_burst);
+    BOOST_CHECK_CLOSE(metadata.time_spec.get_real_secs(), 0.0, 1e-9);
+    BOOST_CHECK_GT(num_samps_ret, buff.size() - 32);
+    BOOST_CHECK_LE(num_samps_ret, buff.size());
+
+    // after the transient of the filter, the constant comes through
+    const float expected = 0x4040 / 32767.f;
+    for (size_t i = 32; i < num_samps_ret; i++) {
+        BOOST_CHECK_SMALL(buff[i].real() - expected, 1e-2f);
+        BOOST_CHECK_SMALL(buff[i].imag() - expected, 1e-2f);
+    }
+
+    // the next call times out
+    handler.recv(&buff.front(), buff.size(), metadata, 0.0, false);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+}
@@ -73,6 +73,12 @@ BOOST_AUTO_TEST_CASE(test_sph_send_one_channel_one_packet_mode)
         BOOST_CHECK_EQUAL(ifpi.eob, i == NUM_PKTS_TO_TEST - 1);
         num_accum_samps += ifpi.num_payload_words32;
     }
+
+    // every packet and payload byte shows up in the counters
+    const uhd::stream_stats_t stats = handler.get_stream_counters()->get_stats();
+    BOOST_CHECK_EQUAL(stats.num_packets, NUM_PKTS_TO_TEST);
+    BOOST_CHECK_EQUAL(stats.num_bytes, num_accum_samps * sizeof(uint32_t));
+    BOOST_CHECK_EQUAL(stats.num_seq_errors, 0);
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -127,3 +133,224 @@ BOOST_AUTO_TEST_CASE(test_sph_send_one_channel_full_buffer_mode)
         num_accum_samps += ifpi.num_payload_words32;
     }
 }
+
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_send_multi_channel_convert_threads)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "fc32";
+    id.num_inputs    = 1;
+    id.output_format = "sc16_item32_be";
+    id.num_outputs   = 1;
+
+    static const double TICK_RATE        = 100e6;
+    static const double SAMP_RATE        = 10e6;
+    static const size_t NUM_PKTS_TO_TEST = 30;
+    static const size_t NCHANNELS        = 4;
+
+    std::vector<mock_zero_copy::sptr> xports;
+    for (size_t i = 0; i < NCHANNELS; i++) {
+        xports.push_back(
+            boost::make_shared<mock_zero_copy>(vrt::if_packet_info_t::LINK_TYPE_VRLP));
+    }
+
+    // create the super send packet handler, converting on 3 threads
+    sph::send_packet_handler handler(NCHANNELS);
+    handler.set_vrt_packer(&vrt::if_hdr_pack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        mock_zero_copy::sptr xport = xports[ch];
+        handler.set_xport_chan_get_buff(
+            ch, [xport](double timeout) { return xport->get_send_buff(timeout); });
+    }
+    handler.set_converter(id);
+    handler.set_convert_worker_pool(convert_worker_pool::make(3));
+    handler.set_max_samples_per_packet(20);
+
+    handler.set_scale_factor(1.0);
+
+    // allocate metadata and buffers, each channel with its own sample values
+    std::vector<std::complex<float>> mem(20 * NCHANNELS);
+    std::vector<std::complex<float>*> buffs(NCHANNELS);
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        buffs[ch] = &mem[ch * 20];
+        for (size_t n = 0; n < 20; n++) {
+            buffs[ch][n] = std::complex<float>(float(ch + 1), float(n));
+        }
+    }
+    uhd::tx_metadata_t metadata;
+    metadata.has_time_spec = true;
+    metadata.time_spec     = uhd::time_spec_t(0.0);
+
+    // generate the test data
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        metadata.start_of_burst = (i == 0);
+        metadata.end_of_burst   = (i == NUM_PKTS_TO_TEST - 1);
+        const size_t num_sent   = handler.send(buffs, 10 + i % 10, metadata, 1.0);
+        BOOST_CHECK_EQUAL(num_sent, 10 + i % 10);
+        metadata.time_spec += uhd::time_spec_t(0, num_sent, SAMP_RATE);
+    }
+
+    // check the sent packets on every channel
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        size_t num_accum_samps = 0;
+        vrt::if_packet_info_t ifpi;
+        std::vector<uint32_t> payload;
+        for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+            std::cout << "data check " << ch << ":" << i << std::endl;
+            xports[ch]->pop_send_packet(ifpi, payload);
+            BOOST_CHECK_EQUAL(ifpi.num_payload_words32, 10 + i % 10);
+            // the VRT packet count is 4 bits wide
+            BOOST_CHECK_EQUAL(ifpi.packet_count, i % 16);
+            BOOST_CHECK_EQUAL(ifpi.tsf, num_accum_samps * TICK_RATE / SAMP_RATE);
+            BOOST_CHECK_EQUAL(ifpi.sob, i == 0);
+            BOOST_CHECK_EQUAL(ifpi.eob, i == NUM_PKTS_TO_TEST - 1);
+            // I in the upper half of each big endian item, Q in the lower one
+            BOOST_REQUIRE_EQUAL(payload.size(), ifpi.num_payload_words32);
+            for (size_t n = 0; n < payload.size(); n++) {
+                BOOST_CHECK_EQUAL(uhd::ntohx(payload[n]), uint32_t(((ch + 1) << 16) | n));
+            }
+            num_accum_samps += ifpi.num_payload_words32;
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_sph_send_one_channel_resampled)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "fc32";
+    id.num_inputs    = 1;
+    id.output_format = "sc16_item32_be";
+    id.num_outputs   = 1;
+
+    mock_zero_copy xport(vrt::if_packet_info_t::LINK_TYPE_VRLP);
+
+    static const double TICK_RATE       = 100e6;
+    static const double SAMP_RATE       = 10e6;
+    static const size_t NUM_SENDS       = 4;
+    static const size_t SAMPS_PER_SEND  = 100;
+
+    // create the super send packet handler, decimating by 2 on the host
+    sph::send_packet_handler handler(1);
+    handler.set_vrt_packer(&vrt::if_hdr_pack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    handler.set_xport_chan_get_buff(
+        0, [&xport](double timeout) { return xport.get_send_buff(timeout); });
+    handler.set_converter(id);
+    handler.set_max_samples_per_packet(20);
+    handler.set_resampler(uhd::transport::polyphase_resampler::make(1, 1, 2));
+
+    // send a burst, all inputs are consumed
+    std::vector<std::complex<float>> buff(SAMPS_PER_SEND, std::complex<float>(0.5f));
+    uhd::tx_metadata_t metadata;
+    metadata.has_time_spec = true;
+    metadata.time_spec     = uhd::time_spec_t(1.0);
+    for (size_t i = 0; i < NUM_SENDS; i++) {
+        metadata.start_of_burst = (i == 0);
+        metadata.end_of_burst   = (i == NUM_SENDS - 1);
+        const size_t num_sent =
+            handler.send(&buff.front(), SAMPS_PER_SEND, metadata, 1.0);
+        BOOST_CHECK_EQUAL(num_sent, SAMPS_PER_SEND);
+        metadata.has_time_spec = false;
+    }
+
+    // the flushed burst has half the samples, and keeps the time spec
+    size_t num_accum_samps = 0;
+    vrt::if_packet_info_t ifpi;
+    for (size_t i = 0; i < 2 * NUM_SENDS * SAMPS_PER_SEND; i++) {
+        xport.pop_send_packet(ifpi);
+        BOOST_CHECK_EQUAL(ifpi.sob, i == 0);
+        if (i == 0) {
+            BOOST_CHECK(ifpi.has_tsf);
+            BOOST_CHECK_EQUAL(ifpi.tsf, TICK_RATE);
+        }
+        num_accum_samps += ifpi.num_payload_words32;
+        if (ifpi.eob) {
+            break;
+        }
+        // outputs are held back until they fill a packet
+        BOOST_CHECK_EQUAL(ifpi.num_payload_words32, 20);
+    }
+    BOOST_CHECK(ifpi.eob);
+    BOOST_CHECK_EQUAL(num_accum_samps, NUM_SENDS * SAMPS_PER_SEND / 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_sph_send_resampled_timeout)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "fc32";
+    id.num_inputs    = 1;
+    id.output_format = "sc16_item32_be";
+    id.num_outputs   = 1;
+
+    mock_zero_copy xport(vrt::if_packet_info_t::LINK_TYPE_VRLP);
+
+    static const double TICK_RATE      = 100e6;
+    static const double SAMP_RATE      = 10e6;
+    static const size_t SAMPS_PER_SEND = 100;
+
+    // the transport times out once it handed out num_buffs_left buffers
+    size_t num_buffs_left = 0;
+    sph::send_packet_handler handler(1);
+    handler.set_vrt_packer(&vrt::if_hdr_pack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    handler.set_xport_chan_get_buff(
+        0, [&xport, &num_buffs_left](double timeout) -> managed_send_buffer::sptr {
+            if (num_buffs_left == 0) {
+                return managed_send_buffer::sptr();
+            }
+            num_buffs_left--;
+            return xport.get_send_buff(timeout);
+        });
+    handler.set_converter(id);
+    handler.set_max_samples_per_packet(20);
+    handler.set_resampler(uhd::transport::polyphase_resampler::make(1, 1, 2));
+
+    std::vector<std::complex<float>> buff(SAMPS_PER_SEND, std::complex<float>(0.5f));
+    uhd::tx_metadata_t start_md;
+    start_md.start_of_burst = true;
+    start_md.has_time_spec  = true;
+    start_md.time_spec      = uhd::time_spec_t(1.0);
+    uhd::tx_metadata_t end_md;
+    end_md.end_of_burst = true;
+
+    // Nothing goes out, but the filter took all inputs. The outputs, the
+    // start of burst and the time spec wait for the next call.
+    BOOST_CHECK_EQUAL(
+        handler.send(&buff.front(), SAMPS_PER_SEND, start_md, 0.0), SAMPS_PER_SEND);
+    num_buffs_left = 100;
+    BOOST_CHECK_EQUAL(handler.send(&buff.front(), 0, end_md, 1.0), 0);
+
+    // Only the first packet goes out, and takes the start of burst along
+    start_md.time_spec = uhd::time_spec_t(2.0);
+    num_buffs_left     = 1;
+    BOOST_CHECK_EQUAL(
+        handler.send(&buff.front(), SAMPS_PER_SEND, start_md, 0.0), SAMPS_PER_SEND);
+    num_buffs_left = 100;
+    BOOST_CHECK_EQUAL(handler.send(&buff.front(), 0, end_md, 1.0), 0);
+
+    for (size_t burst = 0; burst < 2; burst++) {
+        size_t num_accum_samps = 0;
+        vrt::if_packet_info_t ifpi;
+        for (size_t i = 0; i < SAMPS_PER_SEND; i++) {
+            xport.pop_send_packet(ifpi);
+            BOOST_CHECK_EQUAL(ifpi.sob, i == 0);
+            if (i == 0) {
+                BOOST_CHECK(ifpi.has_tsf);
+                BOOST_CHECK_EQUAL(ifpi.tsf, (burst + 1) * TICK_RATE);
+            }
+            num_accum_samps += ifpi.num_payload_words32;
+            if (ifpi.eob) {
+                break;
+            }
+        }
+        BOOST_CHECK(ifpi.eob);
+        BOOST_CHECK_EQUAL(num_accum_samps, SAMPS_PER_SEND / 2);
+    }
+}
@@ -0,0 +1,72 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/transport/spsc_queue.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/shared_ptr.hpp>
+#include <thread>
+
+using namespace uhd::transport;
+
+static const double timeout = 0.01 /*secs*/;
+
+BOOST_AUTO_TEST_CASE(test_spsc_queue_with_timed_wait)
+{
+    spsc_queue<int> queue(3);
+
+    // push elements, check for timeout
+    BOOST_CHECK(queue.push_with_timed_wait(0, timeout));
+    BOOST_CHECK(queue.push_with_timed_wait(1, timeout));
+    BOOST_CHECK(queue.push_with_timed_wait(2, timeout));
+    BOOST_CHECK(not queue.push_with_timed_wait(3, timeout));
+
+    int val;
+    // pop elements, check for timeout and check values
+    BOOST_CHECK(queue.pop_with_timed_wait(val, timeout));
+    BOOST_CHECK_EQUAL(val, 0);
+    BOOST_CHECK(queue.pop_with_timed_wait(val, timeout));
+    BOOST_CHECK_EQUAL(val, 1);
+    BOOST_CHECK(queue.pop_with_timed_wait(val, timeout));
+    BOOST_CHECK_EQUAL(val, 2);
+    BOOST_CHECK(not queue.pop_with_timed_wait(val, timeout));
+}
+
+BOOST_AUTO_TEST_CASE(test_spsc_queue_releases_elements)
+{
+    spsc_queue<boost::shared_ptr<int>> queue(2);
+    boost::shared_ptr<int> elem(new int(5));
+
+    BOOST_CHECK(queue.push_with_haste(elem));
+    BOOST_CHECK_EQUAL(elem.use_count(), 2);
+
+    boost::shared_ptr<int> val;
+    BOOST_CHECK(queue.pop_with_haste(val));
+    BOOST_CHECK_EQUAL(*val, 5);
+    val.reset();
+    // the queue must not hold on to a popped element
+    BOOST_CHECK_EQUAL(elem.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_spsc_queue_threaded)
+{
+    static const size_t NUM_ELEMS = 100000;
+    spsc_queue<size_t> queue(16);
+
+    // the consumer sleeps on an empty queue, the producer on a full one
+    std::thread producer([&queue]() {
+        for (size_t i = 0; i < NUM_ELEMS; i++) {
+            queue.push_with_wait(i);
+        }
+    });
+    for (size_t i = 0; i < NUM_ELEMS; i++) {
+        size_t val = 0;
+        BOOST_REQUIRE(queue.pop_with_timed_wait(val, 1.0));
+        BOOST_REQUIRE_EQUAL(val, i);
+    }
+    producer.join();
+    size_t val;
+    BOOST_CHECK(not queue.pop_with_haste(val));
+}
@@ -0,0 +1,107 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/usrp/common/adf435x.hpp>
+#include <uhdlib/usrp/common/max287x.hpp>
+#include <boost/test/unit_test.hpp>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+/***********************************************************************
+ * The divider search of the synthesizers is cached. A tune which hits
+ * the cache must leave the same registers in the chip as a tune on a new
+ * synthesizer, which has to run the search.
+ **********************************************************************/
+namespace {
+//! The registers of the chip, by address (the low 3 bits of each word)
+typedef std::map<uint32_t, uint32_t> reg_file_t;
+
+void write_regs(std::shared_ptr<reg_file_t> reg_file, const std::vector<uint32_t>& regs)
+{
+    for (const uint32_t reg : regs) {
+        (*reg_file)[reg & 0x7] = reg;
+    }
+}
+
+struct tune_t
+{
+    double freq;
+    bool is_int_n;
+};
+
+// Repeats hit the cache, int-N and fractional tunes of a frequency don't
+// share an entry
+const std::vector<tune_t> TUNES{{1.2e9, false},
+    {2.4501e9, false},
+    {1.2e9, false},
+    {4.1e9, false},
+    {2.4501e9, true},
+    {4.1e9, false},
+    {2.4501e9, false},
+    {0.4e9, false},
+    {1.2e9, false},
+    {2.4501e9, true}};
+
+constexpr double REF_FREQ = 50e6;
+
+//! Tune like the SBX does
+double tune_adf4351(adf435x_iface::sptr lo, const tune_t& tune)
+{
+    lo->set_feedback_select(adf435x_iface::FB_SEL_DIVIDED);
+    lo->set_reference_freq(REF_FREQ);
+    lo->set_prescaler(tune.freq > 3.6e9 ? adf435x_iface::PRESCALER_8_9
+                                        : adf435x_iface::PRESCALER_4_5);
+    const double actual_freq = lo->set_frequency(tune.freq, tune.is_int_n);
+    lo->commit();
+    return actual_freq;
+}
+
+//! Tune like the CBX and UBX do
+double tune_max287x(max287x_iface::sptr lo, const tune_t& tune)
+{
+    const double actual_freq =
+        lo->set_frequency(tune.freq, REF_FREQ, 25e6, tune.is_int_n);
+    lo->commit();
+    return actual_freq;
+}
+
+template <typename synth_sptr, typename make_fn_t, typename tune_fn_t>
+void check_cached_tunes(make_fn_t make, tune_fn_t tune)
+{
+    auto cached_regs      = std::make_shared<reg_file_t>();
+    synth_sptr cached_lo = make(std::bind(&write_regs, cached_regs, std::placeholders::_1));
+    for (const tune_t& t : TUNES) {
+        auto new_regs      = std::make_shared<reg_file_t>();
+        synth_sptr new_lo = make(std::bind(&write_regs, new_regs, std::placeholders::_1));
+        BOOST_TEST_MESSAGE("Tuning to " << t.freq << (t.is_int_n ? " (int-N)" : ""));
+        BOOST_CHECK_EQUAL(tune(cached_lo, t), tune(new_lo, t));
+        BOOST_CHECK(*cached_regs == *new_regs);
+    }
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_adf4351_cached_dividers)
+{
+    check_cached_tunes<adf435x_iface::sptr>(
+        [](adf435x_iface::write_fn_t write) { return adf435x_iface::make_adf4351(write); },
+        &tune_adf4351);
+}
+
+BOOST_AUTO_TEST_CASE(test_max2870_cached_dividers)
+{
+    check_cached_tunes<max287x_iface::sptr>(
+        [](max287x_iface::write_fn write) { return max287x_iface::make<max2870>(write); },
+        &tune_max287x);
+}
+
+BOOST_AUTO_TEST_CASE(test_max2871_cached_dividers)
+{
+    check_cached_tunes<max287x_iface::sptr>(
+        [](max287x_iface::write_fn write) { return max287x_iface::make<max2871>(write); },
+        &tune_max287x);
+}
@@ -0,0 +1,70 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/utils/tick_converter.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+using uhd::tick_converter;
+using uhd::time_spec_t;
+
+BOOST_AUTO_TEST_CASE(test_ticks_per_samp)
+{
+    BOOST_CHECK_EQUAL(tick_converter(200e6, 1e6).get_ticks_per_samp(), 200);
+    BOOST_CHECK_EQUAL(tick_converter(200e6, 200e6 / 3).get_ticks_per_samp(), 3);
+    BOOST_CHECK_EQUAL(tick_converter(184.32e6, 30.72e6).get_ticks_per_samp(), 6);
+    // Not a whole number of ticks per sample, or not a whole tick rate
+    BOOST_CHECK_EQUAL(tick_converter(200e6, 3e6).get_ticks_per_samp(), 0);
+    BOOST_CHECK_EQUAL(tick_converter(100.5, 100.5).get_ticks_per_samp(), 0);
+
+    tick_converter ticks(200e6, 1e6);
+    ticks.set_samp_rate(50e6);
+    BOOST_CHECK_EQUAL(ticks.get_ticks_per_samp(), 4);
+    BOOST_CHECK_EQUAL(ticks.samps_to_ticks(1000), 4000);
+    ticks.set_tick_rate(100e6);
+    BOOST_CHECK_EQUAL(ticks.get_ticks_per_samp(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_same_as_time_spec)
+{
+    const double rates[]     = {200e6, 184.32e6, 100.5};
+    const long long ticks[] = {0, 1, 199999999, 200000000, 123456789012345LL};
+    for (const double rate : rates) {
+        tick_converter converter(rate, rate);
+        for (const long long tick : ticks) {
+            const time_spec_t time_spec = time_spec_t::from_ticks(tick, rate);
+            BOOST_CHECK(converter.to_time_spec(tick) == time_spec);
+            BOOST_CHECK_EQUAL(converter.to_ticks(time_spec), time_spec.to_ticks(rate));
+            BOOST_CHECK_EQUAL(converter.to_ticks(time_spec), tick);
+        }
+    }
+    // Negative times
+    tick_converter converter(200e6, 1e6);
+    BOOST_CHECK_EQUAL(converter.to_time_spec(-1).get_full_secs(), -1);
+    BOOST_CHECK_EQUAL(converter.to_ticks(converter.to_time_spec(-1)), -1);
+}
+
+BOOST_AUTO_TEST_CASE(test_sample_offsets)
+{
+    // Packets of 364 samples at 1/3 of the tick rate, for an hour
+    const double tick_rate = 200e6;
+    const double samp_rate = tick_rate / 3;
+    tick_converter converter(tick_rate, samp_rate);
+    const time_spec_t start(1000, 0.25);
+    const int64_t start_ticks = converter.to_ticks(start);
+    const int64_t num_samps   = int64_t(3600 * samp_rate) / 364 * 364;
+
+    // Counted in ticks, every offset is exact
+    BOOST_CHECK_EQUAL(converter.to_ticks(start, num_samps), start_ticks + 3 * num_samps);
+    const time_spec_t end = converter.to_time_spec(start_ticks, num_samps);
+    BOOST_CHECK_EQUAL(end.get_full_secs(), 4600);
+    BOOST_CHECK_EQUAL(converter.to_ticks(end), start_ticks + 3 * num_samps);
+
+    // Without a whole number of ticks per sample, it matches time_spec_t
+    tick_converter fallback(tick_rate, 3e6);
+    BOOST_CHECK_EQUAL(fallback.to_ticks(start, 1000),
+        (start + time_spec_t::from_ticks(1000, 3e6)).to_ticks(tick_rate));
+}
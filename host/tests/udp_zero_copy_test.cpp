@@ -0,0 +1,126 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/transport/udp_zero_copy.hpp>
+#include <boost/asio.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace uhd::transport;
+namespace asio = boost::asio;
+
+static const size_t NUM_FRAMES = 16;
+static const size_t FRAME_SIZE = 1000;
+
+//! A plain UDP socket on the loopback interface for the transport to talk to
+struct loopback_peer
+{
+    loopback_peer(void) : socket(io_service)
+    {
+        socket.open(asio::ip::udp::v4());
+        socket.bind(asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0));
+    }
+
+    std::string port(void) const
+    {
+        return std::to_string(socket.local_endpoint().port());
+    }
+
+    asio::io_service io_service;
+    asio::ip::udp::socket socket;
+};
+
+static udp_zero_copy::sptr make_xport(
+    const loopback_peer& peer, const std::string& hints)
+{
+    zero_copy_xport_params default_buff_args;
+    default_buff_args.recv_frame_size = FRAME_SIZE;
+    default_buff_args.send_frame_size = FRAME_SIZE;
+    default_buff_args.num_recv_frames = NUM_FRAMES;
+    default_buff_args.num_send_frames = NUM_FRAMES;
+    udp_zero_copy::buff_params buff_params;
+    return udp_zero_copy::make(
+        "127.0.0.1", peer.port(), default_buff_args, buff_params, hints);
+}
+
+static void check_recv(const std::string& hints)
+{
+    loopback_peer peer;
+    udp_zero_copy::sptr xport = make_xport(peer, hints);
+    const asio::ip::udp::endpoint xport_endpoint(
+        asio::ip::address_v4::loopback(), xport->get_local_port());
+
+    // more packets than there are frames, so the batches wrap around
+    static const size_t NUM_PACKETS = 3 * NUM_FRAMES + 5;
+    for (size_t i = 0; i < NUM_PACKETS; i++) {
+        std::vector<uint8_t> data(10 + i, uint8_t(i));
+        peer.socket.send_to(asio::buffer(data), xport_endpoint);
+
+        // hold on to a few buffers so batches cannot claim every frame
+        if (i % 4 == 3) {
+            std::vector<managed_recv_buffer::sptr> held;
+            for (size_t j = i - 3; j <= i; j++) {
+                managed_recv_buffer::sptr buff = xport->get_recv_buff(1.0);
+                BOOST_REQUIRE(buff);
+                BOOST_CHECK_EQUAL(buff->size(), 10 + j);
+                BOOST_CHECK_EQUAL(buff->cast<const uint8_t*>()[0], uint8_t(j));
+                held.push_back(buff);
+            }
+        }
+    }
+    for (size_t i = NUM_PACKETS - NUM_PACKETS % 4; i < NUM_PACKETS; i++) {
+        managed_recv_buffer::sptr buff = xport->get_recv_buff(1.0);
+        BOOST_REQUIRE(buff);
+        BOOST_CHECK_EQUAL(buff->size(), 10 + i);
+    }
+
+    // nothing left to receive
+    BOOST_CHECK(not xport->get_recv_buff(0.01));
+}
+
+static void check_send(const std::string& hints)
+{
+    loopback_peer peer;
+    udp_zero_copy::sptr xport = make_xport(peer, hints);
+
+    static const size_t NUM_PACKETS = 2 * NUM_FRAMES + 3;
+    for (size_t i = 0; i < NUM_PACKETS; i++) {
+        managed_send_buffer::sptr buff = xport->get_send_buff(1.0);
+        BOOST_REQUIRE(buff);
+        std::memset(buff->cast<void*>(), int(i), 10 + i);
+        buff->commit(10 + i);
+    }
+
+    // the last partial batch is sent when the batch timeout expires
+    std::vector<uint8_t> data(FRAME_SIZE);
+    for (size_t i = 0; i < NUM_PACKETS; i++) {
+        const size_t len = peer.socket.receive(asio::buffer(data));
+        BOOST_CHECK_EQUAL(len, 10 + i);
+        BOOST_CHECK_EQUAL(data[0], uint8_t(i));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_udp_zero_copy_recv)
+{
+    check_recv("recv_batch_size=1");
+}
+
+BOOST_AUTO_TEST_CASE(test_udp_zero_copy_recv_batched)
+{
+    check_recv("recv_batch_size=8");
+}
+
+BOOST_AUTO_TEST_CASE(test_udp_zero_copy_send)
+{
+    check_send("send_batch_size=1");
+}
+
+BOOST_AUTO_TEST_CASE(test_udp_zero_copy_send_batched)
+{
+    check_send("send_batch_size=8,send_batch_timeout=0.001");
+}
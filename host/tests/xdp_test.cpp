@@ -0,0 +1,123 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+/**
+ * Loopback test for the AF_XDP transport. Sends numbered packets to a UDP
+ * echo server (e.g. in a network namespace behind a veth pair, see the
+ * transport notes) and checks that they come back intact.
+ */
+
+#include <uhd/exception.hpp>
+#include <uhdlib/transport/xdp_zero_copy.hpp>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace po = boost::program_options;
+using namespace uhd::transport;
+
+int main(int argc, char** argv)
+{
+    std::string addr, port, args;
+    size_t num_packets, payload_size;
+    double timeout;
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "help message")
+        ("addr", po::value<std::string>(&addr)->default_value("10.11.0.2"), "IPv4 address of the echo server")
+        ("port", po::value<std::string>(&port)->default_value("49153"), "UDP port of the echo server")
+        ("args", po::value<std::string>(&args)->default_value(""), "transport args (xdp_queues, xdp_iface, xdp_mode, ...)")
+        ("num-packets", po::value<size_t>(&num_packets)->default_value(100000), "number of packets to send")
+        ("size", po::value<size_t>(&payload_size)->default_value(1400), "payload size in bytes")
+        ("timeout", po::value<double>(&timeout)->default_value(0.1), "receive timeout in seconds")
+    ;
+    // clang-format on
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+    if (vm.count("help")) {
+        std::cout << "AF_XDP loopback test " << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+    payload_size = std::max(payload_size, sizeof(uint32_t)) & ~size_t(3);
+
+    // The frame sizes are limited to what the MTU allows
+    zero_copy_xport_params default_buff_args;
+    default_buff_args.recv_frame_size = 9000;
+    default_buff_args.send_frame_size = 9000;
+    default_buff_args.num_recv_frames = 1024;
+    default_buff_args.num_send_frames = 1024;
+    udp_zero_copy::buff_params buff_params;
+    xdp_zero_copy::sptr xport;
+    try {
+        xport = xdp_zero_copy::make(
+            addr, port, default_buff_args, buff_params, uhd::device_addr_t(args));
+    } catch (const uhd::exception& e) {
+        std::cerr << "Cannot create the transport: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Sending from " << xport->get_local_addr() << ":"
+              << xport->get_local_port() << " to " << addr << ":" << port
+              << std::endl;
+
+    // Keep a window of packets in flight, so the echo server and both
+    // rings stay busy
+    const size_t window = xport->get_num_recv_frames() / 2;
+    size_t num_sent = 0, num_recvd = 0, num_lost = 0, num_bad = 0;
+    uint32_t next_expected = 0;
+    const auto start       = std::chrono::steady_clock::now();
+    while (num_recvd + num_lost < num_packets) {
+        while (num_sent < num_packets and num_sent - num_recvd - num_lost < window) {
+            managed_send_buffer::sptr buff = xport->get_send_buff(timeout);
+            if (not buff) {
+                break;
+            }
+            uint32_t* words = buff->cast<uint32_t*>();
+            for (size_t i = 0; i < payload_size / sizeof(uint32_t); i++) {
+                words[i] = uint32_t(num_sent + i);
+            }
+            buff->commit(payload_size);
+            num_sent++;
+        }
+        managed_recv_buffer::sptr buff = xport->get_recv_buff(timeout);
+        if (not buff) {
+            // Everything in flight is lost, ignore it if it shows up later
+            num_lost += num_sent - num_recvd - num_lost;
+            next_expected = uint32_t(num_sent);
+            continue;
+        }
+        const uint32_t* words = buff->cast<const uint32_t*>();
+        const uint32_t seq    = words[0];
+        if (seq < next_expected) {
+            continue;
+        }
+        bool good             = buff->size() == payload_size;
+        for (size_t i = 1; good and i < payload_size / sizeof(uint32_t); i++) {
+            good = words[i] == seq + i;
+        }
+        if (not good) {
+            num_bad++;
+        }
+        if (seq > next_expected) {
+            num_lost += seq - next_expected;
+        }
+        next_expected = seq + 1;
+        num_recvd++;
+    }
+    const double elapsed =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Sent:     " << num_sent << std::endl
+              << "Received: " << num_recvd << std::endl
+              << "Lost:     " << num_lost << std::endl
+              << "Corrupt:  " << num_bad << std::endl
+              << "Rate:     " << (num_recvd * payload_size * 8 / elapsed / 1e6)
+              << " Mbps" << std::endl;
+    return (num_recvd > 0 and num_bad == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,294 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhdlib/transport/xdp_zero_copy.hpp>
+#include <boost/test/unit_test.hpp>
+#include <arpa/inet.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace uhd::transport;
+
+/***********************************************************************
+ * The test runs in a network namespace of its own, with a veth pair:
+ * the transport uses uhdxdp0, and the test plays the device on the peer
+ * end uhdxdp1 with a packet socket. The device's address is a static
+ * neighbor entry, so no ARP is involved.
+ **********************************************************************/
+static const char* HOST_IFACE    = "uhdxdp0";
+static const char* DEVICE_IFACE  = "uhdxdp1";
+static const char* HOST_ADDR     = "10.11.0.1";
+static const char* DEVICE_ADDR   = "10.11.0.2";
+static const char* DEVICE_MAC    = "02:00:00:00:11:02";
+static const uint16_t DEVICE_PORT = 49153;
+static const size_t MTU           = 3000;
+
+static bool xdp_available = false;
+
+struct veth_fixture
+{
+    veth_fixture(void)
+    {
+        if (::geteuid() != 0 or ::unshare(CLONE_NEWNET) != 0) {
+            BOOST_TEST_MESSAGE("Cannot create a network namespace, skipping AF_XDP tests");
+            return;
+        }
+        const std::string cmd =
+            std::string("ip link add ") + HOST_IFACE + " mtu " + std::to_string(MTU)
+            + " type veth peer name " + DEVICE_IFACE + " mtu " + std::to_string(MTU)
+            + " address " + DEVICE_MAC + " && ip addr add " + HOST_ADDR + "/24 dev "
+            + HOST_IFACE + " && ip link set " + HOST_IFACE + " up && ip link set "
+            + DEVICE_IFACE + " up && ip neigh add " + DEVICE_ADDR + " lladdr "
+            + DEVICE_MAC + " dev " + HOST_IFACE + " nud permanent";
+        if (std::system(cmd.c_str()) != 0) {
+            BOOST_TEST_MESSAGE("Cannot set up the veth pair, skipping AF_XDP tests");
+            return;
+        }
+        xdp_available = true;
+    }
+};
+BOOST_GLOBAL_FIXTURE(veth_fixture);
+
+#define SKIP_WITHOUT_XDP()                                                  \
+    if (not xdp_available) {                                                \
+        BOOST_TEST_MESSAGE("AF_XDP is not available, skipping this test"); \
+        return;                                                             \
+    }
+
+static xdp_zero_copy::sptr make_xport(const std::string& args)
+{
+    zero_copy_xport_params default_buff_args;
+    default_buff_args.recv_frame_size = 8000;
+    default_buff_args.send_frame_size = 8000;
+    udp_zero_copy::buff_params buff_params;
+    return xdp_zero_copy::make(DEVICE_ADDR,
+        std::to_string(DEVICE_PORT),
+        default_buff_args,
+        buff_params,
+        uhd::device_addr_t(args + ",num_recv_frames=64,num_send_frames=64"));
+}
+
+//! A packet socket on the device's end of the veth pair
+class device_socket
+{
+public:
+    device_socket(void)
+    {
+        _fd = ::socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+        BOOST_REQUIRE(_fd >= 0);
+        std::memset(&_addr, 0, sizeof(_addr));
+        _addr.sll_family   = AF_PACKET;
+        _addr.sll_protocol = htons(ETH_P_ALL);
+        _addr.sll_ifindex  = int(::if_nametoindex(DEVICE_IFACE));
+        _addr.sll_halen    = ETH_ALEN;
+        BOOST_REQUIRE_EQUAL(
+            ::bind(_fd, reinterpret_cast<sockaddr*>(&_addr), sizeof(_addr)), 0);
+    }
+
+    ~device_socket(void)
+    {
+        ::close(_fd);
+    }
+
+    //! Send a UDP packet from the device to the host
+    void send(const uint16_t dst_port, const std::vector<uint8_t>& payload)
+    {
+        std::vector<uint8_t> pkt(42 + payload.size(), 0);
+        const uint8_t device_mac[ETH_ALEN] = {0x02, 0, 0, 0, 0x11, 0x02};
+        get_mac(HOST_IFACE, &pkt[0]);
+        std::memcpy(&pkt[6], device_mac, ETH_ALEN);
+        pkt[12] = 0x08;
+        pkt[13] = 0x00;
+
+        uint8_t* ip             = &pkt[14];
+        const uint16_t ip_len   = htons(uint16_t(28 + payload.size()));
+        ip[0]                   = 0x45;
+        std::memcpy(ip + 2, &ip_len, 2);
+        ip[8] = 64;
+        ip[9] = IPPROTO_UDP;
+        ::inet_pton(AF_INET, DEVICE_ADDR, ip + 12);
+        ::inet_pton(AF_INET, HOST_ADDR, ip + 16);
+        uint32_t sum = 0;
+        for (size_t i = 0; i < 20; i += 2) {
+            sum += (uint32_t(ip[i]) << 8) | ip[i + 1];
+        }
+        while (sum >> 16) {
+            sum = (sum & 0xffff) + (sum >> 16);
+        }
+        const uint16_t csum = htons(uint16_t(~sum));
+        std::memcpy(ip + 10, &csum, 2);
+
+        uint8_t* udp              = ip + 20;
+        const uint16_t src_port   = htons(DEVICE_PORT);
+        const uint16_t dst_port_n = htons(dst_port);
+        const uint16_t udp_len    = htons(uint16_t(8 + payload.size()));
+        std::memcpy(udp, &src_port, 2);
+        std::memcpy(udp + 2, &dst_port_n, 2);
+        std::memcpy(udp + 4, &udp_len, 2);
+        std::copy(payload.begin(), payload.end(), udp + 8);
+
+        BOOST_REQUIRE_EQUAL(::sendto(_fd,
+                                pkt.data(),
+                                pkt.size(),
+                                0,
+                                reinterpret_cast<sockaddr*>(&_addr),
+                                sizeof(_addr)),
+            ssize_t(pkt.size()));
+    }
+
+    //! Wait for the next UDP packet from the host, return its frame
+    std::vector<uint8_t> recv_udp(void)
+    {
+        std::vector<uint8_t> buff(MTU + 14);
+        for (size_t tries = 0; tries < 100; tries++) {
+            pollfd pfd;
+            pfd.fd     = _fd;
+            pfd.events = POLLIN;
+            if (::poll(&pfd, 1, 100) != 1) {
+                continue;
+            }
+            const ssize_t len = ::recv(_fd, buff.data(), buff.size(), 0);
+            // Skip IPv6 neighbor discovery and the like
+            if (len >= 42 and buff[12] == 0x08 and buff[13] == 0x00
+                and buff[23] == IPPROTO_UDP) {
+                buff.resize(size_t(len));
+                return buff;
+            }
+        }
+        return std::vector<uint8_t>();
+    }
+
+private:
+    static void get_mac(const char* iface, uint8_t* mac)
+    {
+        const int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+        ifreq ifr;
+        std::memset(&ifr, 0, sizeof(ifr));
+        std::strncpy(ifr.ifr_name, iface, IFNAMSIZ - 1);
+        BOOST_REQUIRE_EQUAL(::ioctl(fd, SIOCGIFHWADDR, &ifr), 0);
+        ::close(fd);
+        std::memcpy(mac, ifr.ifr_hwaddr.sa_data, ETH_ALEN);
+    }
+
+    int _fd;
+    sockaddr_ll _addr;
+};
+
+BOOST_AUTO_TEST_CASE(test_xdp_requires_queues)
+{
+    SKIP_WITHOUT_XDP();
+    BOOST_CHECK_THROW(make_xport("xdp_mode=copy"), uhd::value_error);
+    BOOST_CHECK_THROW(make_xport("xdp_mode=copy,xdp_queues=zero"), uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_xdp_frame_size_from_mtu)
+{
+    SKIP_WITHOUT_XDP();
+    xdp_zero_copy::sptr xport = make_xport("xdp_mode=copy,xdp_queues=0");
+    // The IPv4 and UDP headers come off the MTU, rounded down to 8 bytes
+    BOOST_CHECK_EQUAL(xport->get_recv_frame_size(), (MTU - 28) & ~size_t(7));
+    BOOST_CHECK_EQUAL(xport->get_send_frame_size(), (MTU - 28) & ~size_t(7));
+    BOOST_CHECK_EQUAL(xport->get_num_recv_frames(), 64);
+    BOOST_CHECK_EQUAL(xport->get_local_addr(), HOST_ADDR);
+}
+
+BOOST_AUTO_TEST_CASE(test_xdp_one_transport_per_queue)
+{
+    SKIP_WITHOUT_XDP();
+    xdp_zero_copy::sptr xport0 = make_xport("xdp_mode=copy,xdp_queues=0");
+    BOOST_CHECK_THROW(make_xport("xdp_mode=copy,xdp_queues=0"), uhd::runtime_error);
+    // The queue is free again when the transport goes away
+    xport0.reset();
+    BOOST_CHECK(make_xport("xdp_mode=copy,xdp_queues=0"));
+}
+
+BOOST_AUTO_TEST_CASE(test_xdp_send)
+{
+    SKIP_WITHOUT_XDP();
+    device_socket device;
+    xdp_zero_copy::sptr xport = make_xport("xdp_mode=copy,xdp_queues=0");
+
+    const size_t payload_len       = xport->get_send_frame_size();
+    managed_send_buffer::sptr buff = xport->get_send_buff(1.0);
+    BOOST_REQUIRE(buff);
+    uint8_t* mem = buff->cast<uint8_t*>();
+    for (size_t i = 0; i < payload_len; i++) {
+        mem[i] = uint8_t(i);
+    }
+    buff->commit(payload_len);
+    buff.reset();
+
+    const std::vector<uint8_t> pkt = device.recv_udp();
+    BOOST_REQUIRE_EQUAL(pkt.size(), 42 + payload_len);
+    uint16_t src_port, dst_port;
+    std::memcpy(&src_port, &pkt[34], 2);
+    std::memcpy(&dst_port, &pkt[36], 2);
+    BOOST_CHECK_EQUAL(ntohs(src_port), xport->get_local_port());
+    BOOST_CHECK_EQUAL(ntohs(dst_port), DEVICE_PORT);
+    for (size_t i = 0; i < payload_len; i++) {
+        if (pkt[42 + i] != uint8_t(i)) {
+            BOOST_FAIL("Payload mismatch at byte " << i);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_xdp_recv)
+{
+    SKIP_WITHOUT_XDP();
+    device_socket device;
+    xdp_zero_copy::sptr xport = make_xport("xdp_mode=copy,xdp_queues=0");
+    BOOST_CHECK(not xport->get_recv_buff(0.01));
+
+    const std::vector<uint8_t> payload(xport->get_recv_frame_size(), 0x5a);
+    for (size_t i = 0; i < 2 * xport->get_num_recv_frames(); i++) {
+        device.send(xport->get_local_port(), payload);
+        managed_recv_buffer::sptr buff = xport->get_recv_buff(1.0);
+        BOOST_REQUIRE(buff);
+        BOOST_REQUIRE_EQUAL(buff->size(), payload.size());
+        BOOST_CHECK(std::equal(
+            payload.begin(), payload.end(), buff->cast<const uint8_t*>()));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_xdp_other_traffic_passes)
+{
+    SKIP_WITHOUT_XDP();
+    device_socket device;
+    xdp_zero_copy::sptr xport = make_xport("xdp_mode=copy,xdp_queues=0");
+
+    // A regular socket on another port of the host still gets its packets
+    const int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in local;
+    std::memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    ::inet_pton(AF_INET, HOST_ADDR, &local.sin_addr);
+    socklen_t local_len = sizeof(local);
+    BOOST_REQUIRE_EQUAL(::bind(fd, reinterpret_cast<sockaddr*>(&local), sizeof(local)), 0);
+    BOOST_REQUIRE_EQUAL(
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&local), &local_len), 0);
+
+    device.send(ntohs(local.sin_port), std::vector<uint8_t>(16, 0x11));
+    pollfd pfd;
+    pfd.fd     = fd;
+    pfd.events = POLLIN;
+    BOOST_CHECK_EQUAL(::poll(&pfd, 1, 1000), 1);
+    uint8_t buff[64];
+    BOOST_CHECK_EQUAL(::recv(fd, buff, sizeof(buff), MSG_DONTWAIT), 16);
+    ::close(fd);
+
+    // ... and the transport does not
+    BOOST_CHECK(not xport->get_recv_buff(0.1));
+}
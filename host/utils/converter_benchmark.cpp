@@ -277,7 +277,7 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         ("samples",  po::value<size_t>(&n_samples)->default_value(1000000), "Number of samples per iteration")
         ("iterations",  po::value<size_t>(&iterations)->default_value(10000), "Number of iterations per benchmark")
         ("priorities", po::value<std::string>(&priorities)->default_value("default"), "Converter priorities. Can be 'default', 'all', or a comma-separated list of priorities.")
-        ("max-prio", po::value<priority_type>(&max_prio)->default_value(4), "Largest available priority (advanced feature)")
+        ("max-prio", po::value<priority_type>(&max_prio)->default_value(6), "Largest available priority (advanced feature)")
         ("n-inputs",   po::value<size_t>(&n_inputs)->default_value(1),  "Number of input vectors")
         ("n-outputs",  po::value<size_t>(&n_outputs)->default_value(1), "Number of output vectors")
         ("debug-converter", "Skip benchmark and print conversion results. Implies iterations==1 and will only run on a single converter.")